@@ -33,6 +33,11 @@ if(ENABLE_NNDEPLOY_OP)
   include(${ROOT_PATH}/demo/op/config.cmake)
 endif()
 
+nndeploy_option(ENABLE_NNDEPLOY_DEMO_OP_BENCHMARK "ENABLE_NNDEPLOY_DEMO_OP_BENCHMARK" OFF)
+if(ENABLE_NNDEPLOY_OP AND ENABLE_NNDEPLOY_DEMO_OP_BENCHMARK)
+  include(${ROOT_PATH}/demo/op_benchmark/config.cmake)
+endif()
+
 if(ENABLE_NNDEPLOY_NET)
   include(${ROOT_PATH}/demo/net/config.cmake)
 endif()
@@ -78,11 +83,21 @@ if(ENABLE_NNDEPLOY_OPENCV AND ENABLE_NNDEPLOY_PLUGIN_STABLE_DIFFUSION)
   include(${ROOT_PATH}/demo/stable_diffusion/config.cmake)
 endif()
 
+nndeploy_option(ENABLE_NNDEPLOY_DEMO_DIFFUSION_SCHEDULER "ENABLE_NNDEPLOY_DEMO_DIFFUSION_SCHEDULER" OFF)
+if(ENABLE_NNDEPLOY_PLUGIN_STABLE_DIFFUSION AND ENABLE_NNDEPLOY_DEMO_DIFFUSION_SCHEDULER)
+  include(${ROOT_PATH}/demo/diffusion_scheduler/config.cmake)
+endif()
+
 nndeploy_option(ENABLE_NNDEPLOY_DEMO_LLAMA "ENABLE_NNDEPLOY_DEMO_LLAMA" OFF)
 if(ENABLE_NNDEPLOY_DEMO_LLAMA)
   include(${ROOT_PATH}/demo/llama/config.cmake)
 endif()
 
+nndeploy_option(ENABLE_NNDEPLOY_DEMO_LLM_SAMPLER "ENABLE_NNDEPLOY_DEMO_LLM_SAMPLER" OFF)
+if(ENABLE_NNDEPLOY_PLUGIN_LLM AND ENABLE_NNDEPLOY_DEMO_LLM_SAMPLER)
+  include(${ROOT_PATH}/demo/llm_sampler/config.cmake)
+endif()
+
 nndeploy_option(ENABLE_NNDEPLOY_DEMO_TENSOR_POOL "ENABLE_NNDEPLOY_DEMO_TENSOR_POOL" OFF)
 if(ENABLE_NNDEPLOY_DEMO_TENSOR_POOL)
   include(${ROOT_PATH}/demo/tensor_pool/config.cmake)
@@ -0,0 +1,447 @@
+#include <chrono>
+#include <random>
+
+#include "nndeploy/base/glic_stl_include.h"
+#include "nndeploy/device/device.h"
+#include "nndeploy/device/tensor.h"
+#include "nndeploy/framework.h"
+#include "nndeploy/op/op_add.h"
+#include "nndeploy/op/op_cache.h"
+#include "nndeploy/op/op_div.h"
+#include "nndeploy/op/op_mul.h"
+#include "nndeploy/op/op_sub.h"
+#include "nndeploy/stable_diffusion/ddim_scheduler.h"
+#include "nndeploy/stable_diffusion/dpm_solver_scheduler.h"
+#include "nndeploy/stable_diffusion/euler_ancestral_scheduler.h"
+#include "nndeploy/stable_diffusion/scheduler.h"
+
+using namespace nndeploy;
+
+/**
+ * @brief 扩散模型调度器测试
+ * @note
+ * # step性能，与double精度的标量实现对比误差
+ *   - legacy：原来的写法，每个标量与临时张量都新建device::Tensor，
+ *     函数式算子不缓存(每次createOp/init/deinit/delete)
+ *   - ops：同样的写法，函数式算子实例缓存
+ *   - fused：DDIMScheduler::step，fusedSchedulerStep一次遍历
+ * # 各调度器的步数与质量，数据分布为N(mu, s^2)时最优的模型输出有解析解，
+ *   确定性采样(DDIM/DPM-Solver++)的终点也有解析解，与之对比误差；
+ *   Euler ancestral是随机采样，检查终点的均值与标准差
+ * # 用法：nndeploy_demo_diffusion_scheduler [loop_count]
+ */
+
+struct StepCase {
+  std::string name_;
+  std::string prediction_type_;
+  int latent_size_;
+};
+
+static void fillRandom(device::Tensor *tensor, std::mt19937 &rng) {
+  std::normal_distribution<float> dist(0.0f, 1.0f);
+  float *data = static_cast<float *>(tensor->getData());
+  size_t size = tensor->getSize() / sizeof(float);
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = dist(rng);
+  }
+}
+
+static float maxAbsDiff(device::Tensor *a, const std::vector<double> &b) {
+  const float *pa = static_cast<const float *>(a->getData());
+  float diff = 0.0f;
+  for (size_t i = 0; i < b.size(); ++i) {
+    diff = std::max(diff, (float)std::fabs(pa[i] - b[i]));
+  }
+  return diff;
+}
+
+/**
+ * @brief 原来的step写法(eta = 0)
+ */
+static base::Status legacyStep(stable_diffusion::DDIMScheduler *scheduler,
+                               stable_diffusion::SchedulerParam *param,
+                               device::Tensor *output, device::Tensor *sample,
+                               int idx) {
+  device::Device *host_device = device::getDefaultHostDevice();
+  device::TensorDesc scalar_desc(base::dataTypeOf<float>(), base::kDataFormatN,
+                                 {1});
+  int64_t step_ratio =
+      param->num_train_timesteps_ / param->num_inference_steps_;
+  int64_t t = (int64_t)scheduler->timesteps_[idx];
+  int64_t prev_t = t - step_ratio;
+  float alpha_prod_t = scheduler->alphas_cumprod_[t];
+  float alpha_prod_t_prev = prev_t >= 0 ? scheduler->alphas_cumprod_[prev_t]
+                                        : scheduler->final_alpha_cumprod_;
+  float beta_prod_t = 1.0f - alpha_prod_t;
+  device::Tensor alpha_prod_t_sqrt_tensor(host_device, scalar_desc);
+  alpha_prod_t_sqrt_tensor.set(std::sqrt(alpha_prod_t));
+  device::Tensor beta_prod_t_sqrt_tensor(host_device, scalar_desc);
+  beta_prod_t_sqrt_tensor.set(std::sqrt(beta_prod_t));
+
+  device::Tensor pred_original_sample(sample->getDevice(), sample->getDesc());
+  device::Tensor pred_epsilon(sample->getDevice(), sample->getDesc());
+  if (param->prediction_type_ == "epsilon") {
+    device::Tensor tmp1(sample->getDevice(), sample->getDesc());
+    op::mul(output, &beta_prod_t_sqrt_tensor, &tmp1);
+    device::Tensor tmp2(sample->getDevice(), sample->getDesc());
+    op::sub(sample, &tmp1, &tmp2);
+    op::div(&tmp2, &alpha_prod_t_sqrt_tensor, &pred_original_sample);
+    output->copyTo(&pred_epsilon);
+  } else {
+    device::Tensor sample_tmp(sample->getDevice(), sample->getDesc());
+    op::mul(sample, &alpha_prod_t_sqrt_tensor, &sample_tmp);
+    device::Tensor model_output_tmp(sample->getDevice(), sample->getDesc());
+    op::mul(output, &beta_prod_t_sqrt_tensor, &model_output_tmp);
+    op::sub(&sample_tmp, &model_output_tmp, &pred_original_sample);
+    op::mul(sample, &beta_prod_t_sqrt_tensor, &sample_tmp);
+    op::mul(output, &alpha_prod_t_sqrt_tensor, &model_output_tmp);
+    op::add(&sample_tmp, &model_output_tmp, &pred_epsilon);
+  }
+
+  device::Tensor coff_model_output_tensor(host_device, scalar_desc);
+  coff_model_output_tensor.set(std::sqrt(1.0f - alpha_prod_t_prev));
+  device::Tensor pred_sample_direction(sample->getDevice(), sample->getDesc());
+  op::mul(&pred_epsilon, &coff_model_output_tensor, &pred_sample_direction);
+  device::Tensor alpha_prod_t_prev_sqrt_tensor(host_device, scalar_desc);
+  alpha_prod_t_prev_sqrt_tensor.set(std::sqrt(alpha_prod_t_prev));
+  device::Tensor pred_original_sample_tmp(sample->getDevice(),
+                                          sample->getDesc());
+  op::mul(&pred_original_sample, &alpha_prod_t_prev_sqrt_tensor,
+          &pred_original_sample_tmp);
+  return op::add(&pred_original_sample_tmp, &pred_sample_direction, sample);
+}
+
+/**
+ * @brief double精度的参考实现(eta = 0)
+ */
+static void referenceStep(stable_diffusion::DDIMScheduler *scheduler,
+                          stable_diffusion::SchedulerParam *param,
+                          const float *output, std::vector<double> &sample,
+                          int idx) {
+  int64_t step_ratio =
+      param->num_train_timesteps_ / param->num_inference_steps_;
+  int64_t t = (int64_t)scheduler->timesteps_[idx];
+  int64_t prev_t = t - step_ratio;
+  double alpha_prod_t = scheduler->alphas_cumprod_[t];
+  double alpha_prod_t_prev = prev_t >= 0 ? scheduler->alphas_cumprod_[prev_t]
+                                         : scheduler->final_alpha_cumprod_;
+  double alpha_sqrt = std::sqrt(alpha_prod_t);
+  double beta_sqrt = std::sqrt(1.0 - alpha_prod_t);
+  for (size_t i = 0; i < sample.size(); ++i) {
+    double x0, eps;
+    if (param->prediction_type_ == "epsilon") {
+      x0 = (sample[i] - beta_sqrt * output[i]) / alpha_sqrt;
+      eps = output[i];
+    } else {
+      x0 = alpha_sqrt * sample[i] - beta_sqrt * output[i];
+      eps = alpha_sqrt * output[i] + beta_sqrt * sample[i];
+    }
+    sample[i] = std::sqrt(alpha_prod_t_prev) * x0 +
+                std::sqrt(1.0 - alpha_prod_t_prev) * eps;
+  }
+}
+
+template <typename Func>
+static double timeMs(Func func, int loop_count) {
+  func();
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < loop_count; ++i) {
+    func();
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count() /
+         loop_count;
+}
+
+static base::Status benchmark(const StepCase &c, int loop_count) {
+  stable_diffusion::SchedulerParam param;
+  param.prediction_type_ = c.prediction_type_;
+  param.num_inference_steps_ = 50;
+  auto scheduler = dynamic_cast<stable_diffusion::DDIMScheduler *>(
+      stable_diffusion::createScheduler(stable_diffusion::kSchedulerTypeDDIM));
+  if (scheduler == nullptr) {
+    NNDEPLOY_LOGE("createScheduler failed.\n");
+    return base::kStatusCodeErrorNotImplement;
+  }
+  scheduler->setParam(&param);
+  scheduler->init();
+  scheduler->setTimesteps();
+  scheduler->configure();
+
+  device::Device *device = device::getDefaultHostDevice();
+  device::TensorDesc desc(base::dataTypeOf<float>(), base::kDataFormatNCHW,
+                          {1, param.unet_channels_, c.latent_size_,
+                           c.latent_size_});
+  device::Tensor output(device, desc);
+  device::Tensor init_sample(device, desc);
+  device::Tensor sample(device, desc);
+  std::mt19937 rng(2024);
+  fillRandom(&output, rng);
+  fillRandom(&init_sample, rng);
+
+  // 整个去噪过程(固定的模型输出)的精度
+  std::vector<double> ref(init_sample.getSize() / sizeof(float));
+  const float *init_data = static_cast<const float *>(init_sample.getData());
+  ref.assign(init_data, init_data + ref.size());
+  for (int i = 0; i < param.num_inference_steps_; ++i) {
+    referenceStep(scheduler, &param, static_cast<float *>(output.getData()),
+                  ref, i);
+  }
+  op::OpCache *cache = op::getGlobalOpCache();
+  size_t capacity = cache->getCapacity();
+  cache->setCapacity(0);
+  init_sample.copyTo(&sample);
+  for (int i = 0; i < param.num_inference_steps_; ++i) {
+    legacyStep(scheduler, &param, &output, &sample, i);
+  }
+  float legacy_diff = maxAbsDiff(&sample, ref);
+  cache->setCapacity(capacity);
+  init_sample.copyTo(&sample);
+  for (int i = 0; i < param.num_inference_steps_; ++i) {
+    scheduler->step(&output, &sample, i, scheduler->timesteps_[i]);
+  }
+  float fused_diff = maxAbsDiff(&sample, ref);
+
+  // 在中间的一步上反复计时，sample会不断变化，不影响耗时
+  const int idx = param.num_inference_steps_ / 2;
+  cache->setCapacity(0);
+  double legacy_ms = timeMs(
+      [&]() { legacyStep(scheduler, &param, &output, &sample, idx); },
+      loop_count);
+  cache->setCapacity(capacity);
+  double ops_ms = timeMs(
+      [&]() { legacyStep(scheduler, &param, &output, &sample, idx); },
+      loop_count);
+  double fused_ms = timeMs(
+      [&]() {
+        scheduler->step(&output, &sample, idx, scheduler->timesteps_[idx]);
+      },
+      loop_count);
+
+  NNDEPLOY_LOGI(
+      "%s: legacy %.4f ms, ops %.4f ms, fused %.4f ms, speedup %.2fx/%.2fx, "
+      "max diff legacy %g fused %g\n",
+      c.name_.c_str(), legacy_ms, ops_ms, fused_ms, legacy_ms / fused_ms,
+      ops_ms / fused_ms, legacy_diff, fused_diff);
+
+  scheduler->deinit();
+  delete scheduler;
+  if (legacy_diff > 1e-3f || fused_diff > 1e-3f) {
+    NNDEPLOY_LOGE("%s: result mismatch.\n", c.name_.c_str());
+    return base::kStatusCodeErrorInvalidValue;
+  }
+  return base::kStatusCodeOk;
+}
+
+struct SolverCase {
+  std::string name_;
+  stable_diffusion::SchedulerType type_;
+  std::string prediction_type_;
+  int num_inference_steps_;
+  double max_rms_error_;  // 确定性采样与解析解的均方根误差上限
+};
+
+/**
+ * @brief x0 ~ N(mu, s^2)，x_t = a * x0 + b * eps时的最优模型输出
+ *  E[eps | x_t] = b * (x_t - a * mu) / (a^2 * s^2 + b^2)
+ *  E[x0 | x_t] = mu + a * s^2 * (x_t - a * mu) / (a^2 * s^2 + b^2)
+ *  v = a * eps - b * x0
+ */
+static void gaussianModel(const std::string &prediction_type,
+                          double alpha_prod, const std::vector<float> &mu,
+                          float s, device::Tensor *input,
+                          device::Tensor *output) {
+  double a = std::sqrt(alpha_prod);
+  double b = std::sqrt(1.0 - alpha_prod);
+  double var = a * a * s * s + b * b;
+  const float *x = static_cast<const float *>(input->getData());
+  float *y = static_cast<float *>(output->getData());
+  for (size_t i = 0; i < mu.size(); ++i) {
+    double r = (x[i] - a * mu[i]) / var;
+    double eps = b * r;
+    double x0 = mu[i] + a * s * s * r;
+    y[i] = prediction_type == "epsilon" ? eps : a * eps - b * x0;
+  }
+}
+
+static base::Status solverQuality(const SolverCase &c, int latent_size) {
+  stable_diffusion::SchedulerParam param;
+  param.prediction_type_ = c.prediction_type_;
+  param.num_inference_steps_ = c.num_inference_steps_;
+  std::unique_ptr<stable_diffusion::Scheduler> scheduler(
+      stable_diffusion::createScheduler(c.type_));
+  if (scheduler == nullptr) {
+    NNDEPLOY_LOGE("createScheduler failed.\n");
+    return base::kStatusCodeErrorNotImplement;
+  }
+  scheduler->setParam(&param);
+  base::Status status = scheduler->init();
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "init failed");
+  scheduler->setTimesteps();
+  scheduler->configure();
+
+  device::Device *device = device::getDefaultHostDevice();
+  device::TensorDesc desc(base::dataTypeOf<float>(), base::kDataFormatNCHW,
+                          {1, param.unet_channels_, latent_size, latent_size});
+  device::Tensor sample(device, desc);
+  device::Tensor output(device, desc);
+  std::mt19937 rng(2024);
+  std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+  std::vector<float> mu(sample.getSize() / sizeof(float));
+  for (auto &m : mu) {
+    m = uniform(rng);
+  }
+  const float s = 0.5f;
+  std::mt19937 generator(2024);
+  status = stable_diffusion::initializeLatents(
+      generator, scheduler->getInitNoiseSigma(), &sample);
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                         "initializeLatents failed");
+
+  // 确定性采样的终点：x_t = a * mu + sqrt(a^2 * s^2 + b^2) * w，w在轨迹上不变
+  std::vector<float> &timesteps = scheduler->getTimestep();
+  const float *x = static_cast<const float *>(sample.getData());
+  device::Tensor *model_input = scheduler->scaleModelInput(&sample, 0);
+  const float *xin = static_cast<const float *>(model_input->getData());
+  // 每一步模型输入对应的alpha累积乘积
+  std::vector<double> alpha_prods;
+  double alpha_prod_final = 1.0;
+  std::vector<float> sigmas;
+  if (c.type_ == stable_diffusion::kSchedulerTypeDDIM) {
+    auto ddim =
+        dynamic_cast<stable_diffusion::DDIMScheduler *>(scheduler.get());
+    for (auto t : timesteps) {
+      alpha_prods.push_back(ddim->alphas_cumprod_[(int64_t)t]);
+    }
+    alpha_prod_final = ddim->final_alpha_cumprod_;
+  } else {
+    if (c.type_ == stable_diffusion::kSchedulerTypeDPM) {
+      sigmas = dynamic_cast<stable_diffusion::DPMSolverScheduler *>(
+                   scheduler.get())
+                   ->sigmas_;
+    } else {
+      sigmas = dynamic_cast<stable_diffusion::EulerAncestralScheduler *>(
+                   scheduler.get())
+                   ->sigmas_;
+    }
+    for (size_t i = 0; i + 1 < sigmas.size(); ++i) {
+      alpha_prods.push_back(1.0 / (1.0 + sigmas[i] * sigmas[i]));
+    }
+    alpha_prod_final = 1.0 / (1.0 + sigmas.back() * sigmas.back());
+  }
+  std::vector<double> w(mu.size());
+  for (size_t i = 0; i < mu.size(); ++i) {
+    double a = std::sqrt(alpha_prods[0]);
+    w[i] = (xin[i] - a * mu[i]) /
+           std::sqrt(a * a * s * s + 1.0 - alpha_prods[0]);
+  }
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < (int)timesteps.size(); ++i) {
+    model_input = scheduler->scaleModelInput(&sample, i);
+    gaussianModel(c.prediction_type_, alpha_prods[i], mu, s, model_input,
+                  &output);
+    status = scheduler->step(&output, &sample, i, timesteps[i], 0.0f, false,
+                             generator);
+    NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "step failed");
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+  bool ok = true;
+  if (c.type_ == stable_diffusion::kSchedulerTypeEulerA) {
+    // 终点按(x - mu) / s标准化后均值为0，步数有限时标准差小于1，
+    // 由每一步x' = k * x + sigma_up * noise的方差递推得到期望的标准差
+    double var = scheduler->getInitNoiseSigma() *
+                 scheduler->getInitNoiseSigma();
+    for (size_t i = 0; i + 1 < sigmas.size(); ++i) {
+      double from = sigmas[i], to = sigmas[i + 1];
+      double up = std::sqrt(to * to * (from * from - to * to) / (from * from));
+      double down = std::sqrt(std::max(to * to - up * up, 0.0));
+      double k = 1.0 + (down - from) * from / (s * s + from * from);
+      var = k * k * var + up * up;
+    }
+    double expect_std = std::sqrt(var) / s;
+    double sum = 0.0, sum2 = 0.0;
+    for (size_t i = 0; i < mu.size(); ++i) {
+      double z = (x[i] - mu[i]) / s;
+      sum += z;
+      sum2 += z * z;
+    }
+    double mean = sum / mu.size();
+    double std = std::sqrt(sum2 / mu.size() - mean * mean);
+    NNDEPLOY_LOGI(
+        "%s: %d steps, %.3f ms, standardized result mean %.4f std %.4f "
+        "(expect %.4f)\n",
+        c.name_.c_str(), c.num_inference_steps_, ms, mean, std, expect_std);
+    ok = std::fabs(mean) < 0.05 && std::fabs(std - expect_std) < 0.02;
+  } else {
+    double a = std::sqrt(alpha_prod_final);
+    double scale = std::sqrt(a * a * s * s + 1.0 - alpha_prod_final);
+    double max_err = 0.0, sum2 = 0.0;
+    for (size_t i = 0; i < mu.size(); ++i) {
+      double err = std::fabs(x[i] - (a * mu[i] + scale * w[i]));
+      max_err = std::max(max_err, err);
+      sum2 += err * err;
+    }
+    double rms = std::sqrt(sum2 / mu.size());
+    NNDEPLOY_LOGI("%s: %d steps, %.3f ms, rms error %.5f max error %.5f\n",
+                  c.name_.c_str(), c.num_inference_steps_, ms, rms, max_err);
+    ok = rms < c.max_rms_error_;
+  }
+
+  scheduler->deinit();
+  if (!ok) {
+    NNDEPLOY_LOGE("%s: result mismatch.\n", c.name_.c_str());
+    return base::kStatusCodeErrorInvalidValue;
+  }
+  return base::kStatusCodeOk;
+}
+
+int main(int argc, char *argv[]) {
+  int ret = nndeployFrameworkInit();
+  if (ret != 0) {
+    NNDEPLOY_LOGE("nndeployFrameworkInit failed. ERROR: %d\n", ret);
+    return ret;
+  }
+  int loop_count = argc > 1 ? std::max(1, atoi(argv[1])) : 200;
+
+  // 512x512与768x768图像对应的潜空间大小
+  std::vector<StepCase> cases = {
+      {"ddim epsilon 64x64", "epsilon", 64},
+      {"ddim v_prediction 64x64", "v_prediction", 64},
+      {"ddim v_prediction 96x96", "v_prediction", 96},
+  };
+  int failed = 0;
+  for (const auto &c : cases) {
+    if (benchmark(c, loop_count) != base::kStatusCodeOk) {
+      failed++;
+    }
+  }
+
+  using stable_diffusion::kSchedulerTypeDDIM;
+  using stable_diffusion::kSchedulerTypeDPM;
+  using stable_diffusion::kSchedulerTypeEulerA;
+  std::vector<SolverCase> solver_cases = {
+      {"ddim epsilon", kSchedulerTypeDDIM, "epsilon", 50, 0.03},
+      {"ddim epsilon", kSchedulerTypeDDIM, "epsilon", 20, 0.07},
+      {"dpm++ 2m epsilon", kSchedulerTypeDPM, "epsilon", 20, 0.01},
+      {"dpm++ 2m epsilon", kSchedulerTypeDPM, "epsilon", 10, 0.03},
+      {"dpm++ 2m v_prediction", kSchedulerTypeDPM, "v_prediction", 20, 0.01},
+      {"euler a epsilon", kSchedulerTypeEulerA, "epsilon", 20, 0.0},
+      {"euler a v_prediction", kSchedulerTypeEulerA, "v_prediction", 30, 0.0},
+  };
+  for (const auto &c : solver_cases) {
+    if (solverQuality(c, 64) != base::kStatusCodeOk) {
+      failed++;
+    }
+  }
+
+  op::getGlobalOpCache()->clear();
+  ret = nndeployFrameworkDeinit();
+  if (ret != 0) {
+    NNDEPLOY_LOGE("nndeployFrameworkDeinit failed. ERROR: %d\n", ret);
+    return ret;
+  }
+  return failed == 0 ? 0 : -1;
+}
@@ -0,0 +1,245 @@
+#include <chrono>
+#include <random>
+
+#include "nndeploy/base/glic_stl_include.h"
+#include "nndeploy/framework.h"
+#include "nndeploy/llm/sampler.h"
+
+using namespace nndeploy;
+
+/**
+ * @brief llm采样性能测试
+ * @note
+ * # 词表大小为32000(llama2)与128256(llama3)，历史长度1024
+ * # greedy与旧的SampleNode::sample（unordered_set去重 + 标量argmax）对比
+ * # 各种采样参数与朴素实现（全词表softmax + 全排序）对比，并校验采样结果都在
+ *   朴素实现的候选集合中
+ * # 每次采样前都从原始logits拷贝一份（重复惩罚会原地修改logits），计入耗时
+ * # 用法：nndeploy_demo_llm_sampler [loop_count]
+ */
+
+struct SampleCase {
+  std::string name_;
+  llm::SamplerConfig config_;
+};
+
+static int32_t legacySample(float *scores, int size,
+                            const std::vector<int32_t> &history_ids) {
+  std::unordered_set<int> ids_set(history_ids.begin(), history_ids.end());
+  const float repetition_penalty = 1.1;
+  for (auto id : ids_set) {
+    float score = scores[id];
+    scores[id] =
+        score < 0 ? score * repetition_penalty : score / repetition_penalty;
+  }
+  float max_score = 0;
+  int token_id = 0;
+  for (int i = 0; i < size; i++) {
+    if (scores[i] > max_score) {
+      max_score = scores[i];
+      token_id = i;
+    }
+  }
+  return token_id;
+}
+
+/**
+ * @brief 朴素实现，返回候选集合，sample不为nullptr时从中采样
+ */
+static std::vector<int32_t> naiveCandidates(
+    float *logits, int vocab_size, const std::vector<int32_t> &history_ids,
+    const llm::SamplerConfig &config, std::mt19937_64 &rng, int32_t *sample) {
+  std::set<int32_t> ids(history_ids.begin(), history_ids.end());
+  for (int32_t id : ids) {
+    float score = logits[id];
+    logits[id] = score < 0 ? score * config.repetition_penalty_
+                           : score / config.repetition_penalty_;
+  }
+  float max_logit = *std::max_element(logits, logits + vocab_size);
+  std::vector<std::pair<float, int32_t>> probs(vocab_size);
+  for (int i = 0; i < vocab_size; ++i) {
+    probs[i] = {std::exp((logits[i] - max_logit) / config.temperature_), i};
+  }
+  std::sort(probs.begin(), probs.end(),
+            [](const std::pair<float, int32_t> &a,
+               const std::pair<float, int32_t> &b) {
+              return a.first > b.first ||
+                     (a.first == b.first && a.second < b.second);
+            });
+  int n = vocab_size;
+  if (config.top_k_ > 0) {
+    n = std::min(n, config.top_k_);
+  }
+  double sum = 0.0;
+  for (int i = 0; i < n; ++i) {
+    sum += probs[i].first;
+  }
+  if (config.top_p_ < 1.0f) {
+    double cumulative = 0.0;
+    int keep = 0;
+    while (keep < n) {
+      cumulative += probs[keep++].first;
+      if (cumulative >= config.top_p_ * sum) {
+        break;
+      }
+    }
+    n = keep;
+  }
+  std::vector<int32_t> candidates;
+  double kept = 0.0;
+  for (int i = 0; i < n; ++i) {
+    if (probs[i].first >= config.min_p_) {
+      candidates.push_back(probs[i].second);
+      kept += probs[i].first;
+    }
+  }
+  if (sample != nullptr) {
+    std::uniform_real_distribution<double> dist(0.0, kept);
+    double r = dist(rng);
+    *sample = candidates.back();
+    for (int32_t id : candidates) {
+      r -= probs[std::find_if(probs.begin(), probs.end(),
+                              [id](const std::pair<float, int32_t> &p) {
+                                return p.second == id;
+                              }) -
+                 probs.begin()]
+               .first;
+      if (r < 0.0) {
+        *sample = id;
+        break;
+      }
+    }
+  }
+  return candidates;
+}
+
+template <typename Func>
+static double timeUs(Func func, int loop_count) {
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < loop_count; ++i) {
+    func();
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration<double, std::micro>(end - start).count() /
+         loop_count;
+}
+
+static int benchmark(int vocab_size, const std::vector<SampleCase> &cases,
+                     int loop_count) {
+  std::mt19937 gen(vocab_size);
+  std::normal_distribution<float> normal(0.0f, 2.0f);
+  std::vector<float> logits(vocab_size);
+  for (auto &logit : logits) {
+    logit = normal(gen);
+  }
+  // 少量明显更高的logit，接近真实模型的输出
+  std::uniform_int_distribution<int> token(0, vocab_size - 1);
+  for (int i = 0; i < 16; ++i) {
+    logits[token(gen)] += 8.0f;
+  }
+  std::vector<int32_t> history_ids(1024);
+  for (auto &id : history_ids) {
+    id = token(gen);
+  }
+  std::vector<float> work(vocab_size);
+  auto reset = [&]() {
+    std::copy(logits.begin(), logits.end(), work.begin());
+  };
+
+  int failed = 0;
+  printf("vocab_size: %d\n", vocab_size);
+  double legacy_us = timeUs(
+      [&]() {
+        reset();
+        legacySample(work.data(), vocab_size, history_ids);
+      },
+      loop_count);
+  printf("  %-28s %10.1f us\n", "legacy greedy", legacy_us);
+
+  for (const auto &c : cases) {
+    llm::Sampler sampler(c.config_);
+    std::mt19937_64 rng(c.config_.seed_);
+    bool greedy = c.config_.temperature_ <= 0.0f;
+
+    // 校验
+    reset();
+    std::vector<int32_t> candidates;
+    if (greedy) {
+      std::vector<float> ref(logits);
+      naiveCandidates(ref.data(), vocab_size, history_ids,
+                      {1.0f, 1, 1.0f, 0.0f, c.config_.repetition_penalty_, 0},
+                      rng, nullptr)
+          .swap(candidates);
+    } else {
+      std::vector<float> ref(logits);
+      naiveCandidates(ref.data(), vocab_size, history_ids, c.config_, rng,
+                      nullptr)
+          .swap(candidates);
+    }
+    std::set<int32_t> allowed(candidates.begin(), candidates.end());
+    int bad = 0;
+    for (int i = 0; i < 200; ++i) {
+      reset();
+      int32_t id = sampler.sample(work.data(), vocab_size, history_ids);
+      if (allowed.count(id) == 0) {
+        bad++;
+      }
+    }
+    if (bad != 0) {
+      failed++;
+    }
+
+    double us = timeUs(
+        [&]() {
+          reset();
+          sampler.sample(work.data(), vocab_size, history_ids);
+        },
+        loop_count);
+    double naive_us = -1.0;
+    if (!greedy) {
+      naive_us = timeUs(
+          [&]() {
+            reset();
+            int32_t id;
+            naiveCandidates(work.data(), vocab_size, history_ids, c.config_,
+                            rng, &id);
+          },
+          std::max(1, loop_count / 10));
+    }
+    printf("  %-28s %10.1f us  naive %10.1f us  candidates %6zu  %s\n",
+           c.name_.c_str(), us, naive_us, candidates.size(),
+           bad == 0 ? "ok" : "FAILED");
+  }
+  return failed;
+}
+
+int main(int argc, char *argv[]) {
+  int ret = nndeployFrameworkInit();
+  if (ret != 0) {
+    NNDEPLOY_LOGE("nndeployFrameworkInit failed. ERROR: %d\n", ret);
+    return ret;
+  }
+  int loop_count = argc > 1 ? std::max(1, atoi(argv[1])) : 200;
+
+  // temperature, top_k, top_p, min_p, repetition_penalty, seed
+  std::vector<SampleCase> cases = {
+      {"greedy", {0.0f, 0, 1.0f, 0.0f, 1.1f, 0}},
+      {"temperature", {0.8f, 0, 1.0f, 0.0f, 1.1f, 1}},
+      {"top_k=40", {0.8f, 40, 1.0f, 0.0f, 1.1f, 2}},
+      {"top_p=0.9", {0.8f, 0, 0.9f, 0.0f, 1.1f, 3}},
+      {"top_k=40,top_p=0.95", {0.8f, 40, 0.95f, 0.0f, 1.1f, 4}},
+      {"min_p=0.05", {0.8f, 0, 1.0f, 0.05f, 1.1f, 5}},
+      {"top_p=0.9,min_p=0.05", {1.0f, 0, 0.9f, 0.05f, 1.1f, 6}},
+  };
+  int failed = 0;
+  for (int vocab_size : {32000, 128256}) {
+    failed += benchmark(vocab_size, cases, loop_count);
+  }
+
+  ret = nndeployFrameworkDeinit();
+  if (ret != 0) {
+    NNDEPLOY_LOGE("nndeployFrameworkDeinit failed. ERROR: %d\n", ret);
+    return ret;
+  }
+  return failed == 0 ? 0 : -1;
+}
@@ -0,0 +1,355 @@
+#include <chrono>
+#include <random>
+
+#include "nndeploy/base/glic_stl_include.h"
+#include "nndeploy/device/device.h"
+#include "nndeploy/device/tensor.h"
+#include "nndeploy/framework.h"
+#include "nndeploy/ir/ir.h"
+#include "nndeploy/op/elementwise_kernel.h"
+#include "nndeploy/op/op.h"
+#include "nndeploy/op/op_conv.h"
+#include "nndeploy/op/op_gemm.h"
+#include "nndeploy/op/op_mat_mul.h"
+
+using namespace nndeploy;
+
+/**
+ * @brief 算子性能测试
+ * @note
+ * # 以kDeviceTypeCodeCpu上的参考实现为基准，对比kDeviceTypeCodeX86上的实现
+ * # 校验最大绝对误差，并输出耗时与GFLOPS(逐元素运算为GB/s)
+ * # 用法：nndeploy_demo_op_benchmark [loop_count]
+ */
+
+struct ConvCase {
+  std::string name_;
+  int batch_;
+  int channel_in_;
+  int height_;
+  int width_;
+  int channel_out_;
+  int kernel_;
+  int stride_;
+  int pad_;
+  int group_;
+  ir::OpType activate_op_;
+};
+
+struct MatMulCase {
+  std::string name_;
+  base::IntVector shape_a_;
+  base::IntVector shape_b_;
+};
+
+struct ElementwiseCase {
+  std::string name_;
+  op::ElementwiseBinaryType type_;
+  base::IntVector shape_a_;
+  base::IntVector shape_b_;
+  std::vector<op::ElementwiseUnary> epilogue_;
+};
+
+static void fillRandom(device::Tensor *tensor, std::mt19937 &rng) {
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  float *data = static_cast<float *>(tensor->getData());
+  size_t size = tensor->getSize() / sizeof(float);
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = dist(rng);
+  }
+}
+
+static float maxAbsDiff(device::Tensor *a, device::Tensor *b) {
+  const float *a_data = static_cast<const float *>(a->getData());
+  const float *b_data = static_cast<const float *>(b->getData());
+  size_t size = a->getSize() / sizeof(float);
+  float max_diff = 0.0f;
+  for (size_t i = 0; i < size; ++i) {
+    max_diff = std::max(max_diff, std::fabs(a_data[i] - b_data[i]));
+  }
+  return max_diff;
+}
+
+template <typename Func>
+static double timeMs(Func func, int loop_count) {
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < loop_count; ++i) {
+    func();
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count() /
+         loop_count;
+}
+
+static base::Status benchmarkConv(const ConvCase &c, device::Device *ref_device,
+                                  device::Device *device, int loop_count) {
+  std::mt19937 rng(0);
+  base::DataType data_type = base::dataTypeOf<float>();
+  device::TensorDesc input_desc(data_type, base::kDataFormatNCHW,
+                                {c.batch_, c.channel_in_, c.height_, c.width_});
+  device::TensorDesc weight_desc(
+      data_type, base::kDataFormatOIHW,
+      {c.channel_out_, c.channel_in_ / c.group_, c.kernel_, c.kernel_});
+  device::TensorDesc bias_desc(data_type, base::kDataFormatN, {c.channel_out_});
+
+  device::Tensor input(device, input_desc, "input");
+  device::Tensor weight(device, weight_desc, "weight");
+  device::Tensor bias(device, bias_desc, "bias");
+  device::Tensor output("output");
+  fillRandom(&input, rng);
+  fillRandom(&weight, rng);
+  fillRandom(&bias, rng);
+
+  auto param = std::make_shared<ir::ConvParam>();
+  param->kernel_shape_ = {c.kernel_, c.kernel_};
+  param->strides_ = {c.stride_, c.stride_};
+  param->pads_ = {c.pad_, c.pad_, c.pad_, c.pad_};
+  param->dilations_ = {1, 1};
+  param->group_ = c.group_;
+  param->activate_op_ = c.activate_op_;
+
+  base::Status status = op::conv(&input, &weight, &bias, param, &output);
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "conv failed");
+  double time = timeMs(
+      [&]() { op::conv(&input, &weight, &bias, param, &output); }, loop_count);
+
+  // 参考实现不支持group，只对普通卷积做数值校验
+  std::string error = "-";
+  double ref_time = 0.0;
+  if (c.group_ == 1) {
+    device::Tensor ref_input(ref_device, input_desc, "ref_input");
+    device::Tensor ref_weight(ref_device, weight_desc, "ref_weight");
+    device::Tensor ref_bias(ref_device, bias_desc, "ref_bias");
+    device::Tensor ref_output("ref_output");
+    input.copyTo(&ref_input);
+    weight.copyTo(&ref_weight);
+    bias.copyTo(&ref_bias);
+    ref_time = timeMs(
+        [&]() {
+          op::conv(&ref_input, &ref_weight, &ref_bias, param, &ref_output);
+        },
+        1);
+    error = std::to_string(maxAbsDiff(&output, &ref_output));
+  }
+
+  base::IntVector output_shape = output.getShape();
+  double flops = 2.0 * output_shape[0] * output_shape[1] * output_shape[2] *
+                 output_shape[3] * (c.channel_in_ / c.group_) * c.kernel_ *
+                 c.kernel_;
+  printf("%-24s ref %10.3f ms | opt %8.3f ms %8.2f GFLOPS | max_abs_err %s\n",
+         c.name_.c_str(), ref_time, time, flops / (time * 1e6), error.c_str());
+  return status;
+}
+
+/**
+ * @brief 矩阵乘性能测试
+ * @note Cpu与X86上的OpMatMul共用sgemm，因此用朴素三重循环校验第一个batch
+ */
+static base::Status benchmarkMatMul(const MatMulCase &c,
+                                    device::Device *device, int loop_count) {
+  std::mt19937 rng(0);
+  base::DataType data_type = base::dataTypeOf<float>();
+  device::Tensor a(device, device::TensorDesc(data_type, base::kDataFormatAuto,
+                                              c.shape_a_),
+                   "a");
+  device::Tensor b(device, device::TensorDesc(data_type, base::kDataFormatAuto,
+                                              c.shape_b_),
+                   "b");
+  device::Tensor output("output");
+  fillRandom(&a, rng);
+  fillRandom(&b, rng);
+
+  base::Status status = op::matmul(&a, &b, &output);
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "matmul failed");
+  double time = timeMs([&]() { op::matmul(&a, &b, &output); }, loop_count);
+
+  const int m = c.shape_a_[c.shape_a_.size() - 2];
+  const int k = c.shape_a_[c.shape_a_.size() - 1];
+  const int n = c.shape_b_[c.shape_b_.size() - 1];
+  const float *a_data = static_cast<const float *>(a.getData());
+  const float *b_data = static_cast<const float *>(b.getData());
+  const float *c_data = static_cast<const float *>(output.getData());
+  float max_diff = 0.0f;
+  double ref_time = timeMs(
+      [&]() {
+        for (int i = 0; i < m; ++i) {
+          for (int j = 0; j < n; ++j) {
+            float sum = 0.0f;
+            for (int p = 0; p < k; ++p) {
+              sum += a_data[(size_t)i * k + p] * b_data[(size_t)p * n + j];
+            }
+            max_diff =
+                std::max(max_diff, std::fabs(sum - c_data[(size_t)i * n + j]));
+          }
+        }
+      },
+      1);
+
+  double flops = 2.0 * output.getSize() / sizeof(float) * k;
+  printf("%-24s ref %10.3f ms | opt %8.3f ms %8.2f GFLOPS | max_abs_err %f\n",
+         c.name_.c_str(), ref_time, time, flops / (time * 1e6), max_diff);
+  return status;
+}
+
+static base::Status benchmarkElementwise(const ElementwiseCase &c,
+                                         device::Device *device,
+                                         int loop_count) {
+  std::mt19937 rng(0);
+  base::DataType data_type = base::dataTypeOf<float>();
+  const int ndim = static_cast<int>(c.shape_a_.size());
+  base::IntVector shape_c(ndim);
+  for (int i = 0; i < ndim; ++i) {
+    shape_c[i] = std::max(c.shape_a_[i], c.shape_b_[i]);
+  }
+  device::Tensor a(device, device::TensorDesc(data_type, base::kDataFormatAuto,
+                                              c.shape_a_),
+                   "a");
+  device::Tensor b(device, device::TensorDesc(data_type, base::kDataFormatAuto,
+                                              c.shape_b_),
+                   "b");
+  device::Tensor output(device, device::TensorDesc(data_type,
+                                                   base::kDataFormatAuto,
+                                                   shape_c),
+                        "output");
+  fillRandom(&a, rng);
+  fillRandom(&b, rng);
+
+  auto run = [&]() {
+    return op::elementwiseBinary(c.type_, op::ElementwiseOperand(&a),
+                                 op::ElementwiseOperand(&b),
+                                 op::ElementwiseOperand(&output),
+                                 c.epilogue_);
+  };
+  base::Status status = run();
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                         "elementwiseBinary failed");
+  double time = timeMs(run, loop_count);
+
+  // 参考实现：逐元素计算输入下标后分别做二元与一元运算
+  const float *a_data = static_cast<const float *>(a.getData());
+  const float *b_data = static_cast<const float *>(b.getData());
+  const float *c_data = static_cast<const float *>(output.getData());
+  size_t size = output.getSize() / sizeof(float);
+  std::vector<float> ref(size);
+  double ref_time = timeMs(
+      [&]() {
+        for (size_t i = 0; i < size; ++i) {
+          size_t index = i, offset_a = 0, offset_b = 0;
+          size_t stride_a = 1, stride_b = 1;
+          for (int d = ndim - 1; d >= 0; --d) {
+            size_t coord = index % shape_c[d];
+            index /= shape_c[d];
+            offset_a += (c.shape_a_[d] == 1 ? 0 : coord) * stride_a;
+            offset_b += (c.shape_b_[d] == 1 ? 0 : coord) * stride_b;
+            stride_a *= c.shape_a_[d];
+            stride_b *= c.shape_b_[d];
+          }
+          float value = op::elementwiseBinaryScalar(c.type_, a_data[offset_a],
+                                                    b_data[offset_b]);
+          for (auto &unary : c.epilogue_) {
+            value = op::elementwiseUnaryScalar(unary, value);
+          }
+          ref[i] = value;
+        }
+      },
+      1);
+  float max_diff = 0.0f;
+  for (size_t i = 0; i < size; ++i) {
+    max_diff = std::max(max_diff, std::fabs(ref[i] - c_data[i]));
+  }
+
+  double bytes = static_cast<double>(a.getSize() + b.getSize() +
+                                     output.getSize());
+  printf("%-24s ref %10.3f ms | opt %8.3f ms %8.2f GB/s   | max_abs_err %f\n",
+         c.name_.c_str(), ref_time, time, bytes / (time * 1e6), max_diff);
+  return status;
+}
+
+int main(int argc, char *argv[]) {
+  int ret = nndeployFrameworkInit();
+  if (ret != 0) {
+    NNDEPLOY_LOGE("nndeployFrameworkInit failed. ERROR: %d\n", ret);
+    return ret;
+  }
+  int loop_count = argc > 1 ? std::max(1, atoi(argv[1])) : 10;
+
+  device::Device *ref_device =
+      device::getDevice(base::DeviceType(base::kDeviceTypeCodeCpu, 0));
+  base::DeviceType device_type(base::kDeviceTypeCodeX86, 0);
+  device::Device *device = device::getDevice(device_type);
+  if (device == nullptr) {
+    NNDEPLOY_LOGE("device[%s] is not available.\n",
+                  base::deviceTypeToString(device_type).c_str());
+    return -1;
+  }
+
+  // resnet/yolo 中常见的卷积形状
+  std::vector<ConvCase> conv_cases = {
+      {"resnet_conv1_7x7s2", 1, 3, 224, 224, 64, 7, 2, 3, 1, ir::kOpTypeRelu},
+      {"resnet_3x3_64", 1, 64, 56, 56, 64, 3, 1, 1, 1, ir::kOpTypeRelu},
+      {"resnet_1x1_256to64", 1, 256, 56, 56, 64, 1, 1, 0, 1, ir::kOpTypeRelu},
+      {"resnet_3x3_256s2", 1, 128, 28, 28, 256, 3, 2, 1, 1, ir::kOpTypeNone},
+      {"yolo_focus_6x6s2", 1, 3, 320, 320, 32, 6, 2, 2, 1, ir::kOpTypeSigmoid},
+      {"yolo_3x3_128", 1, 128, 40, 40, 128, 3, 1, 1, 1, ir::kOpTypeSigmoid},
+      {"mobilenet_dw_3x3", 1, 144, 56, 56, 144, 3, 1, 1, 144, ir::kOpTypeRelu},
+  };
+  for (auto &conv_case : conv_cases) {
+    base::Status status =
+        benchmarkConv(conv_case, ref_device, device, loop_count);
+    if (status != base::kStatusCodeOk) {
+      NNDEPLOY_LOGE("benchmark %s failed.\n", conv_case.name_.c_str());
+    }
+  }
+
+  // 全连接层与transformer中常见的矩阵乘形状
+  std::vector<MatMulCase> matmul_cases = {
+      {"fc_1x2048x1000", {1, 2048}, {2048, 1000}},
+      {"square_512", {512, 512}, {512, 512}},
+      {"attention_qk_12x128", {12, 128, 64}, {12, 64, 128}},
+      {"llm_proj_32x4096", {32, 4096}, {4096, 1024}},
+  };
+  for (auto &matmul_case : matmul_cases) {
+    base::Status status = benchmarkMatMul(matmul_case, device, loop_count);
+    if (status != base::kStatusCodeOk) {
+      NNDEPLOY_LOGE("benchmark %s failed.\n", matmul_case.name_.c_str());
+    }
+  }
+
+  // 残差相加、bias与激活融合、注意力mask等广播形状
+  std::vector<ElementwiseCase> elementwise_cases = {
+      {"residual_add_relu",
+       op::kElementwiseBinaryTypeAdd,
+       {1, 256, 56, 56},
+       {1, 256, 56, 56},
+       {op::ElementwiseUnary(op::kElementwiseUnaryTypeRelu)}},
+      {"bias_add_silu",
+       op::kElementwiseBinaryTypeAdd,
+       {1, 256, 56, 56},
+       {1, 256, 1, 1},
+       {op::ElementwiseUnary(op::kElementwiseUnaryTypeSilu)}},
+      {"scale_mul_row",
+       op::kElementwiseBinaryTypeMul,
+       {32, 4096},
+       {1, 4096},
+       {}},
+      {"attention_mask_sub",
+       op::kElementwiseBinaryTypeSub,
+       {12, 128, 128},
+       {1, 1, 128},
+       {}},
+  };
+  for (auto &elementwise_case : elementwise_cases) {
+    base::Status status =
+        benchmarkElementwise(elementwise_case, device, loop_count);
+    if (status != base::kStatusCodeOk) {
+      NNDEPLOY_LOGE("benchmark %s failed.\n", elementwise_case.name_.c_str());
+    }
+  }
+
+  ret = nndeployFrameworkDeinit();
+  if (ret != 0) {
+    NNDEPLOY_LOGE("nndeployFrameworkInit failed. ERROR: %d\n", ret);
+    return ret;
+  }
+  return 0;
+}
@@ -0,0 +1,222 @@
+#include "flag.h"
+#include "nndeploy/framework.h"
+#include "nndeploy/ir/default_interpret.h"
+#include "nndeploy/ir/interpret.h"
+#include "nndeploy/ir/ir.h"
+#include "nndeploy/net/net.h"
+#include "nndeploy/net/tensor_pool.h"
+#include "nndeploy/net/tensor_pool/tensor_pool_1d_offset_calculate_optimal.h"
+
+using namespace nndeploy;
+
+DEFINE_string(model_corpus, "",
+              "models separated by ';', each one has the same format as "
+              "--model_value");
+DEFINE_int32(time_limit_ms, 1000, "time limit of the optimal tensor pool");
+
+/**
+ * @brief 只构图、推理shape和图优化，不创建runtime，由benchmark逐个调用tensor
+ * pool分配内存
+ */
+class PlanNet : public net::Net {
+ public:
+  std::vector<net::TensorWrapper *> &getTensorRepository() {
+    return tensor_repository_;
+  }
+  std::vector<net::OpWrapper *> &getOpRepository() { return op_repository_; }
+
+ protected:
+  virtual base::Status runtime() { return base::kStatusCodeOk; }
+};
+
+std::string getTensorPoolTypeName(net::TensorPoolType type) {
+  switch (type) {
+    case net::kTensorPool1DSharedObjectTypeGreedyByBreadth:
+      return "SharedObjectGreedyByBreadth";
+    case net::kTensorPool1DSharedObjectTypeGreedyBySize:
+      return "SharedObjectGreedyBySize";
+    case net::kTensorPool1DSharedObjectTypeGreedyBySizeImprove:
+      return "SharedObjectGreedyBySizeImprove";
+    case net::kTensorPool1DOffsetCalculateTypeGreedyBySize:
+      return "OffsetCalculateGreedyBySize";
+    case net::kTensorPool1DOffsetCalculateTypeGreedyByBreadth:
+      return "OffsetCalculateGreedyByBreadth";
+    case net::kTensorPool1DOffsetCalculateTypeInplace:
+      return "OffsetCalculateInplace";
+    case net::kTensorPool1DOffsetCalculateTypeOptimal:
+      return "OffsetCalculateOptimal";
+    default:
+      return "Unknown";
+  }
+}
+
+std::vector<std::vector<std::string>> getModelCorpus() {
+  std::vector<std::vector<std::string>> corpus;
+  std::string corpus_str = FLAGS_model_corpus;
+  if (corpus_str.empty()) {
+    corpus.emplace_back(demo::getModelValue());
+    return corpus;
+  }
+  std::string::size_type pos1 = 0, pos2 = corpus_str.find(";");
+  while (true) {
+    std::string model = corpus_str.substr(pos1, pos2 - pos1);
+    if (!model.empty()) {
+      demo::FLAGS_model_value = model;
+      corpus.emplace_back(demo::getModelValue());
+    }
+    if (pos2 == std::string::npos) {
+      break;
+    }
+    pos1 = pos2 + 1;
+    pos2 = corpus_str.find(";", pos1);
+  }
+  return corpus;
+}
+
+size_t getTensorSize(device::Device *device, device::Tensor *tensor) {
+  device::BufferDesc buffer_desc =
+      device->toBufferDesc(tensor->getDesc(), base::IntVector());
+  return buffer_desc.getSize();
+}
+
+// 同一时刻存活的激活值大小之和的最大值，任何分配方法都不可能低于该值
+size_t getLowerBound(device::Device *device,
+                     std::vector<net::TensorWrapper *> &tensor_repository,
+                     std::vector<net::OpWrapper *> &op_repository) {
+  std::vector<size_t> live(op_repository.size(), 0);
+  for (auto tensor_wrapper : tensor_repository) {
+    if (tensor_wrapper->is_weight_) {
+      continue;
+    }
+    int min = op_repository.size() - 1;
+    int max = 0;
+    std::vector<int> order_index =
+        net::getOpOrderIndex(tensor_wrapper->producers_,
+                             tensor_wrapper->consumers_, op_repository);
+    for (int index : order_index) {
+      min = std::min(min, index);
+      max = std::max(max, index);
+    }
+    if (tensor_wrapper->input_output_type_ != net::kNone) {
+      min = 0;
+      max = op_repository.size() - 1;
+    }
+    size_t size = getTensorSize(device, tensor_wrapper->tensor_);
+    for (int i = min; i <= max; i++) {
+      live[i] += size;
+    }
+  }
+  size_t lower_bound = 0;
+  for (size_t size : live) {
+    lower_bound = std::max(lower_bound, size);
+  }
+  return lower_bound;
+}
+
+// 激活值实际占用的地址范围的并集
+size_t getFootprint(device::Device *device,
+                    std::vector<net::TensorWrapper *> &tensor_repository) {
+  std::vector<std::pair<size_t, size_t>> ranges;
+  for (auto tensor_wrapper : tensor_repository) {
+    if (tensor_wrapper->is_weight_ ||
+        tensor_wrapper->tensor_->getData() == nullptr) {
+      continue;
+    }
+    size_t begin = (size_t)tensor_wrapper->tensor_->getData();
+    ranges.emplace_back(begin,
+                        begin + getTensorSize(device, tensor_wrapper->tensor_));
+  }
+  std::sort(ranges.begin(), ranges.end());
+  size_t footprint = 0;
+  size_t end = 0;
+  for (auto &range : ranges) {
+    size_t begin = std::max(range.first, end);
+    if (range.second > begin) {
+      footprint += range.second - begin;
+      end = range.second;
+    }
+  }
+  return footprint;
+}
+
+int main(int argc, char *argv[]) {
+  gflags::ParseCommandLineNonHelpFlags(&argc, &argv, true);
+  if (demo::FLAGS_usage) {
+    demo::showUsage();
+    return -1;
+  }
+
+  base::ModelType model_type = demo::getModelType();
+  base::DeviceType device_type = demo::getDeviceType();
+  device::Device *device = device::getDevice(device_type);
+  if (device == nullptr) {
+    NNDEPLOY_LOGE("device::getDevice failed.\n");
+    return -1;
+  }
+
+  printf("%-40s %-32s %14s %14s %12s %10s\n", "model", "tensor_pool",
+         "arena(byte)", "bound(byte)", "frag(%)", "time(ms)");
+  for (auto &model_value : getModelCorpus()) {
+    auto interpret =
+        std::shared_ptr<ir::Interpret>(ir::createInterpret(model_type));
+    if (interpret == nullptr) {
+      NNDEPLOY_LOGE("ir::createInterpret failed.\n");
+      return -1;
+    }
+    base::Status status = interpret->interpret(model_value);
+    if (status != base::kStatusCodeOk) {
+      NNDEPLOY_LOGE("interpret %s failed\n", model_value[0].c_str());
+      continue;
+    }
+
+    auto net = std::make_shared<PlanNet>();
+    net->setDeviceType(device_type);
+    net->setInterpret(interpret.get());
+    status = net->init();
+    if (status != base::kStatusCodeOk) {
+      NNDEPLOY_LOGE("net init %s failed\n", model_value[0].c_str());
+      continue;
+    }
+    auto &tensor_repository = net->getTensorRepository();
+    auto &op_repository = net->getOpRepository();
+    size_t lower_bound =
+        getLowerBound(device, tensor_repository, op_repository);
+
+    std::string model_name = model_value[0];
+    model_name = model_name.substr(model_name.find_last_of("/\\") + 1);
+    for (auto &iter : net::getGlobalTensorPoolCreatorMap()) {
+      net::TensorPool *tensor_pool = net::createTensorPool(
+          iter.first, device, tensor_repository, op_repository);
+      if (tensor_pool == nullptr) {
+        continue;
+      }
+      auto optimal =
+          dynamic_cast<net::TensorPool1DOffsetCalculateOptimal *>(tensor_pool);
+      if (optimal != nullptr) {
+        optimal->setTimeLimit(FLAGS_time_limit_ms);
+      }
+      auto start = std::chrono::steady_clock::now();
+      status = tensor_pool->allocate();
+      auto end = std::chrono::steady_clock::now();
+      if (status == base::kStatusCodeOk) {
+        double time_ms =
+            std::chrono::duration<double, std::milli>(end - start).count();
+        size_t footprint = getFootprint(device, tensor_repository);
+        double fragmentation =
+            footprint > 0 ? 100.0 * (footprint - lower_bound) / footprint : 0.0;
+        printf("%-40s %-32s %14zu %14zu %12.2f %10.3f\n", model_name.c_str(),
+               getTensorPoolTypeName(iter.first).c_str(), footprint,
+               lower_bound, fragmentation, time_ms);
+      } else {
+        NNDEPLOY_LOGE("%s allocate failed\n",
+                      getTensorPoolTypeName(iter.first).c_str());
+      }
+      tensor_pool->deallocate();
+      delete tensor_pool;
+    }
+
+    net->deinit();
+  }
+
+  return 0;
+}
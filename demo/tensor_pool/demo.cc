@@ -22,6 +22,10 @@ net::TensorPoolType getTensorPoolType() {
     return net::kTensorPool1DOffsetCalculateTypeGreedyBySize;
   } else if (FLAGS_tensor_pool_type == "kTensorPool1DOffsetCalculateTypeGreedyByBreadth") {
     return net::kTensorPool1DOffsetCalculateTypeGreedyByBreadth;
+  } else if (FLAGS_tensor_pool_type == "kTensorPool1DOffsetCalculateTypeInplace") {
+    return net::kTensorPool1DOffsetCalculateTypeInplace;
+  } else if (FLAGS_tensor_pool_type == "kTensorPool1DOffsetCalculateTypeOptimal") {
+    return net::kTensorPool1DOffsetCalculateTypeOptimal;
   } else if (FLAGS_tensor_pool_type == "kTensorPool1DNone") {
     return net::kTensorPool1DNone;
   }
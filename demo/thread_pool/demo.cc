@@ -1,12 +1,83 @@
+#include <chrono>
+
 #include "flag.h"
 #include "nndeploy/base/glic_stl_include.h"
 #include "nndeploy/base/shape.h"
 #include "nndeploy/base/time_profiler.h"
 #include "nndeploy/framework.h"
+#include "nndeploy/thread_pool/thread_pool.h"
 
 using namespace nndeploy;
 
-void printHelloWorld() { std::cout << "hello world!" << std::endl; }
+/**
+ * @brief 线程池微基准
+ * @note
+ * # throughput：主线程提交大量空任务，统计每秒完成的任务数
+ * # nested：任务内部再提交子任务（dag并行执行时的典型场景）
+ * # latency：线程全部休眠后提交单个任务，统计从commit到开始执行的时延
+ * # 用法：nndeploy_demo_thread_pool [thread_num] [task_num]
+ */
+
+typedef std::chrono::steady_clock Clock;
+
+static double elapsedUs(Clock::time_point start, Clock::time_point end) {
+  return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+static void benchmarkThroughput(thread_pool::ThreadPool &pool, int task_num) {
+  std::atomic<int> counter{0};
+  std::vector<std::future<void>> futures;
+  futures.reserve(task_num);
+  auto start = Clock::now();
+  for (int i = 0; i < task_num; ++i) {
+    futures.emplace_back(pool.commit([&counter]() { counter++; }));
+  }
+  for (auto &future : futures) {
+    future.get();
+  }
+  double us = elapsedUs(start, Clock::now());
+  printf("throughput: %d tasks in %.3f ms, %.2f M tasks/s\n", counter.load(),
+         us / 1000.0, counter.load() / us);
+}
+
+static void benchmarkNested(thread_pool::ThreadPool &pool, int task_num) {
+  const int root_num = 16;
+  const int child_num = std::max(1, task_num / root_num);
+  const int total = root_num * child_num;
+  std::atomic<int> counter{0};
+  auto start = Clock::now();
+  for (int r = 0; r < root_num; ++r) {
+    // 根任务只负责派发，不在工作线程中阻塞等待子任务
+    pool.commit([&pool, &counter, child_num]() {
+      for (int i = 0; i < child_num; ++i) {
+        pool.commit([&counter]() { counter++; });
+      }
+    });
+  }
+  while (counter.load() < total) {
+    std::this_thread::yield();
+  }
+  double us = elapsedUs(start, Clock::now());
+  printf("nested: %d tasks in %.3f ms, %.2f M tasks/s\n", total, us / 1000.0,
+         total / us);
+}
+
+static void benchmarkLatency(thread_pool::ThreadPool &pool, int sample_num) {
+  std::vector<double> latency;
+  latency.reserve(sample_num);
+  for (int i = 0; i < sample_num; ++i) {
+    // 等待工作线程进入休眠
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    Clock::time_point begin;
+    auto start = Clock::now();
+    pool.commit([&begin]() { begin = Clock::now(); }).get();
+    latency.push_back(elapsedUs(start, begin));
+  }
+  std::sort(latency.begin(), latency.end());
+  printf("latency: p50 %.1f us, p99 %.1f us, max %.1f us\n",
+         latency[latency.size() / 2], latency[latency.size() * 99 / 100],
+         latency.back());
+}
 
 int main(int argc, char const *argv[]) {
   int ret = nndeployFrameworkInit();
@@ -14,11 +85,21 @@ int main(int argc, char const *argv[]) {
     NNDEPLOY_LOGE("nndeployFrameworkInit failed. ERROR: %d\n", ret);
     return ret;
   }
-  printHelloWorld();
+  int thread_num = argc > 1 ? std::max(1, atoi(argv[1])) : 4;
+  int task_num = argc > 2 ? std::max(1, atoi(argv[2])) : 200000;
+
+  thread_pool::ThreadPool pool(thread_num);
+  pool.init();
+  printf("thread_num: %d\n", thread_num);
+  benchmarkThroughput(pool, task_num);
+  benchmarkNested(pool, task_num);
+  benchmarkLatency(pool, 200);
+  pool.destroy();
+
   ret = nndeployFrameworkDeinit();
   if (ret != 0) {
     NNDEPLOY_LOGE("nndeployFrameworkInit failed. ERROR: %d\n", ret);
     return ret;
   }
   return 0;
-}
\ No newline at end of file
+}
@@ -198,6 +198,7 @@ enum MemoryPoolType : int {
   kMemoryPoolTypeEmbed = 0x0000,
   kMemoryPoolTypeUnity,
   kMemoryPoolTypeChunkIndepend,
+  kMemoryPoolTypeCaching,
 };
 
 enum TensorType : int {
@@ -354,6 +355,14 @@ enum EdgeUpdateFlag : int {
   kEdgeUpdateFlagError = 0x0001 << 2,
 };
 
+/**
+ * @brief 有界流水线边写满时生产者的行为
+ */
+enum QueueOverflowPolicy : int {
+  kQueueOverflowPolicyBlock = 0x0000,  // 阻塞直到消费者取走数据
+  kQueueOverflowPolicyDropNewest,      // 丢弃新写入的数据，生产者不阻塞
+};
+
 enum NodeColorType : int {
   kNodeColorWhite = 0x0000,
   kNodeColorGray,
@@ -0,0 +1,69 @@
+#ifndef _NNDEPLOY_BASE_MAPPED_FILE_H_
+#define _NNDEPLOY_BASE_MAPPED_FILE_H_
+
+#include "nndeploy/base/glic_stl_include.h"
+#include "nndeploy/base/macro.h"
+#include "nndeploy/base/object.h"
+#include "nndeploy/base/status.h"
+
+namespace nndeploy {
+namespace base {
+
+/**
+ * @brief 对映射区域的访问提示，对应madvise
+ */
+enum MappedFileAdvice : int {
+  kMappedFileAdviceNormal = 0x0000,
+  kMappedFileAdviceSequential,
+  kMappedFileAdviceRandom,
+  kMappedFileAdviceWillNeed,  // 异步预读
+  kMappedFileAdviceDontNeed,  // 释放本进程的常驻页，再次访问时从page cache读回
+};
+
+/**
+ * @brief 只读的文件内存映射
+ * @note
+ * # 以只读共享方式映射，同一文件的多个进程共享page cache中的物理页
+ * # 不可拷贝，通常以std::shared_ptr的方式被多个持有者共享
+ */
+class NNDEPLOY_CC_API MappedFile : public NonCopyable {
+ public:
+  MappedFile();
+  virtual ~MappedFile();
+
+  base::Status open(const std::string &path);
+  void close();
+
+  bool isOpen() const;
+  const std::string &getPath() const;
+  const uint8_t *getData() const;
+  size_t getSize() const;
+
+  /**
+   * @brief 对[offset, offset + size)区域给出访问提示，区域会按页对齐扩展
+   */
+  base::Status advise(size_t offset, size_t size, MappedFileAdvice advice);
+
+  /**
+   * @brief [offset, offset + size)区域中已在物理内存（page cache）中的字节数
+   * @note 基于mincore，页被其他进程读入时同样计入
+   */
+  size_t getResidentSize(size_t offset, size_t size) const;
+  size_t getResidentSize() const;
+
+ private:
+  std::string path_;
+  uint8_t *data_ = nullptr;
+  size_t size_ = 0;
+#if NNDEPLOY_OS_WINDOWS
+  void *file_handle_ = nullptr;
+  void *mapping_handle_ = nullptr;
+#endif
+};
+
+extern NNDEPLOY_CC_API size_t getPageSize();
+
+}  // namespace base
+}  // namespace nndeploy
+
+#endif
@@ -0,0 +1,161 @@
+
+#ifndef _NNDEPLOY_BASE_TRACE_H_
+#define _NNDEPLOY_BASE_TRACE_H_
+
+#include "nndeploy/base/common.h"
+#include "nndeploy/base/glic_stl_include.h"
+#include "nndeploy/base/macro.h"
+#include "nndeploy/base/object.h"
+#include "nndeploy/base/status.h"
+
+namespace nndeploy {
+namespace base {
+
+enum TraceCategory : int {
+  kTraceCategoryNode = 0x0000,
+  kTraceCategoryOp,
+  kTraceCategoryEdgeWait,
+  kTraceCategoryRuntime,
+  kTraceCategoryUser,
+
+  kTraceCategoryNotSupport,
+};
+
+extern NNDEPLOY_CC_API std::string traceCategoryToString(
+    TraceCategory category);
+
+struct NNDEPLOY_CC_API TraceStatistics {
+  std::string name_;
+  TraceCategory category_;
+  size_t count_ = 0;
+  double total_us_ = 0.0;
+  double avg_us_ = 0.0;
+  double p50_us_ = 0.0;
+  double p99_us_ = 0.0;
+  double max_us_ = 0.0;
+};
+
+struct TraceBuffer;
+
+/**
+ * @brief 分层的tracing profiler
+ * @note
+ * # 每个线程写自己的事件缓冲(分块链表)，记录时不加锁；导出与统计可以与记录并发
+ * # 名字通过intern转为id，调用方缓存id，记录时不构造字符串
+ * # begin/end在每个线程上嵌套，事件记录嵌套深度；在span进行中切换setEnabled
+ *   可能使begin/end不配对
+ * # 导出为Chrome trace_event格式(chrome://tracing或perfetto打开)，
+ *   统计按名字与类别汇总调用次数、平均与p50/p99
+ * # reset只丢弃之前的事件，不释放缓冲，可以与记录并发
+ */
+class NNDEPLOY_CC_API Tracer : public NonCopyable {
+ public:
+  Tracer();
+  virtual ~Tracer();
+
+  void setEnabled(bool enabled);
+  bool isEnabled() const {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief 名字转为id，相同的名字返回相同的id，id从1开始
+   */
+  uint32_t intern(const std::string &name);
+  std::string getName(uint32_t name_id);
+
+  /**
+   * @brief 在当前线程开始一个span，name_id为0时用name intern并写回name_id
+   */
+  void begin(std::atomic<uint32_t> &name_id, const std::string &name,
+             TraceCategory category);
+  void begin(uint32_t name_id, TraceCategory category);
+  /**
+   * @brief 结束当前线程最近开始的span
+   */
+  void end();
+
+  void reset();
+
+  std::vector<TraceStatistics> getStatistics();
+  void printStatistics(const std::string &title = "");
+  base::Status exportChromeTrace(const std::string &path);
+
+ private:
+  TraceBuffer *getThreadBuffer();
+  uint64_t now() const;
+  /**
+   * @brief 按线程遍历reset之后的事件
+   */
+  template <typename Func>
+  void forEachEvent(Func func);
+
+ private:
+  std::atomic<bool> enabled_;
+  std::atomic<uint64_t> reset_ns_;
+  std::chrono::steady_clock::time_point epoch_;
+  uint64_t serial_;  // 区分Tracer实例，用于线程局部的缓冲缓存
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, uint32_t> name_ids_;
+  std::vector<std::string> names_;
+  std::vector<std::unique_ptr<TraceBuffer>> buffers_;
+};
+
+extern NNDEPLOY_CC_API Tracer *getGlobalTracer();
+
+/**
+ * @brief 作用域内的span
+ */
+class NNDEPLOY_CC_API TraceScope : public NonCopyable {
+ public:
+  TraceScope(std::atomic<uint32_t> &name_id, const std::string &name,
+             TraceCategory category);
+  TraceScope(uint32_t name_id, TraceCategory category);
+  ~TraceScope();
+
+ private:
+  bool active_;
+};
+
+}  // namespace base
+}  // namespace nndeploy
+
+#define NNDEPLOY_TRACE_CONCAT_IMPL(a, b) a##b
+#define NNDEPLOY_TRACE_CONCAT(a, b) NNDEPLOY_TRACE_CONCAT_IMPL(a, b)
+
+#ifdef ENABLE_NNDEPLOY_TIME_PROFILER
+#define NNDEPLOY_TRACE_ENABLE(flag) \
+  nndeploy::base::getGlobalTracer()->setEnabled(flag)
+#define NNDEPLOY_TRACE_BEGIN(name_id, name, category)          \
+  do {                                                         \
+    nndeploy::base::Tracer *nndeploy_tracer =                  \
+        nndeploy::base::getGlobalTracer();                     \
+    if (nndeploy_tracer->isEnabled()) {                        \
+      nndeploy_tracer->begin(name_id, name, category);         \
+    }                                                          \
+  } while (0)
+#define NNDEPLOY_TRACE_END() nndeploy::base::getGlobalTracer()->end()
+/**
+ * @brief 同一调用点的名字只intern一次，name不变时使用
+ */
+#define NNDEPLOY_TRACE_SCOPE(name, category)                              \
+  static std::atomic<uint32_t> NNDEPLOY_TRACE_CONCAT(nndeploy_trace_id_, \
+                                                     __LINE__)(0);       \
+  nndeploy::base::TraceScope NNDEPLOY_TRACE_CONCAT(nndeploy_trace_scope_, \
+                                                   __LINE__)(             \
+      NNDEPLOY_TRACE_CONCAT(nndeploy_trace_id_, __LINE__), name, category)
+#define NNDEPLOY_TRACE_PRINT(title) \
+  nndeploy::base::getGlobalTracer()->printStatistics(title)
+#define NNDEPLOY_TRACE_EXPORT(path) \
+  nndeploy::base::getGlobalTracer()->exportChromeTrace(path)
+#else
+#define NNDEPLOY_TRACE_ENABLE(flag)
+#define NNDEPLOY_TRACE_BEGIN(name_id, name, category)
+#define NNDEPLOY_TRACE_END()
+#define NNDEPLOY_TRACE_SCOPE(name, category)
+#define NNDEPLOY_TRACE_PRINT(title)
+#define NNDEPLOY_TRACE_EXPORT(path)
+#endif
+
+#endif  // _NNDEPLOY_BASE_TRACE_H_
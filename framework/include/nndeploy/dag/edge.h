@@ -46,6 +46,17 @@ class NNDEPLOY_CC_API Edge : public base::NonCopyable {
   base::Status setParallelType(const base::ParallelType &paralle_type);
   base::ParallelType getParallelType();
 
+  /**
+   * @brief 设置流水线模式下边的容量，0表示不限制（默认）
+   *
+   * @param queue_max_size 最多缓存的未被消费的数据包个数
+   * @note 写满时按溢出策略阻塞生产者或丢弃新数据，数据包及其内部的tensor循环复用
+   */
+  void setQueueMaxSize(int queue_max_size);
+  int getQueueMaxSize();
+  void setQueueOverflowPolicy(base::QueueOverflowPolicy policy);
+  base::QueueOverflowPolicy getQueueOverflowPolicy();
+
   base::Status construct();
 
   base::Status set(device::Buffer *buffer, int index, bool is_external = true);
@@ -122,6 +133,7 @@ class NNDEPLOY_CC_API Edge : public base::NonCopyable {
   int getGraphOutputPosition();
 
   base::EdgeUpdateFlag update(const Node *node);
+  bool waitNext(const Node *node, int timeout_ms);
 
   /**
    * @brief
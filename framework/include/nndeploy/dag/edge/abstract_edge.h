@@ -167,6 +167,11 @@ class AbstractEdge : public base::NonCopyable {
   virtual int getGraphOutputPosition() = 0;
 
   virtual base::EdgeUpdateFlag update(const Node *node) = 0;
+  /**
+   * @brief 等待node的下一个数据包，最多等待timeout_ms毫秒，不消费该数据包
+   * @return 数据包已就绪返回true，之后调用update不会阻塞；默认总是返回true
+   */
+  virtual bool waitNext(const Node *node, int timeout_ms);
 
   virtual bool markGraphOutput();
 
@@ -178,6 +183,15 @@ class AbstractEdge : public base::NonCopyable {
   std::vector<Node *> getConsumers();
   base::Status increaseConsumers(std::vector<Node *> &consumers);
 
+  /**
+   * @brief 流水线边最多缓存多少个未被消费的数据包，0表示不限制
+   * @note 只对流水线边生效，需要在construct之前设置
+   */
+  void setQueueMaxSize(int queue_max_size);
+  int getQueueMaxSize();
+  void setQueueOverflowPolicy(base::QueueOverflowPolicy policy);
+  base::QueueOverflowPolicy getQueueOverflowPolicy();
+
   virtual bool requestTerminate() = 0;
 
  protected:
@@ -188,6 +202,9 @@ class AbstractEdge : public base::NonCopyable {
   std::vector<Node *> producers_;
   std::vector<Node *> consumers_;
   bool terminate_flag_ = false;
+  int queue_max_size_ = 0;
+  base::QueueOverflowPolicy queue_overflow_policy_ =
+      base::kQueueOverflowPolicyBlock;
 
   DataPacket *data_packet_ = nullptr;
 };
@@ -210,6 +210,13 @@ class PipelineDataPacket : public DataPacket {
   int getConsumersSize();
   int getConsumersCount();
 
+  /**
+   * @brief 数据包被环形队列复用前重置状态
+   * @note 保留内部创建的buffer/tensor等，下次create时描述一致则直接复用；
+   * 外部数据不归数据包所有，直接丢弃
+   */
+  void recycle();
+
  protected:
   std::mutex mutex_;
   std::condition_variable cv_;
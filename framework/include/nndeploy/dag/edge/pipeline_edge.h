@@ -22,6 +22,10 @@ namespace dag {
 /**
  * @brief
  * 1. 只能一个线程得到整个图的结果
+ * 2. 数据包存放在按序号索引的环形队列中，被所有消费者用完后循环复用，
+ * 内部创建的buffer/tensor随数据包一起复用
+ * 3. queue_max_size_大于0时为有界队列：最慢的消费者还有queue_max_size_个数据包
+ * 未取走时，生产者按溢出策略阻塞，或丢弃本次写入的数据
  * @note
  * # 问题一：对于多输入的节点，会不会产生输入不匹配的情况呢？
  * ## 答：不会，因为节点内部会一直等待多输入的数据都到来，才会开始执行。
@@ -76,22 +80,57 @@ class PipelineEdge : public AbstractEdge {
   virtual int getGraphOutputPosition();
 
   virtual base::EdgeUpdateFlag update(const Node *node);
+  virtual bool waitNext(const Node *node, int timeout_ms);
 
   virtual bool requestTerminate();
 
  private:
   PipelineDataPacket *getPipelineDataPacket(const Node *node);
 
+  /**
+   * @brief 生产者获取一个可写的数据包并发布给消费者
+   * @return 队列已满且策略为丢弃时返回不会被发布的数据包；终止时返回nullptr
+   */
+  PipelineDataPacket *acquirePacket();
+  /**
+   * @brief 回收所有消费者都不再使用的数据包，需持有mutex_
+   */
+  void releasePackets();
+  /**
+   * @brief 不限容量时环形队列扩容为两倍，需持有mutex_
+   */
+  void growRing();
+  /**
+   * @brief 查找producer正在写入的数据包，需持有mutex_
+   */
+  template <typename Func>
+  bool findWritingPacket(Func func) {
+    for (int64_t seq = tail_seq_ - 1; seq >= head_seq_; --seq) {
+      if (func(ring_[seq % ring_.size()])) {
+        return true;
+      }
+    }
+    return drop_dp_ != nullptr && func(drop_dp_);
+  }
+
  private:
   std::once_flag once_;
   std::mutex mutex_;
   std::condition_variable cv_;
   // 有多少个消费者
   int consumers_size_;
-  // 数据包
-  std::list<PipelineDataPacket *> data_packets_;
-  // 每个消费者 消费 的数据包最新索引  与下面当前数据包的关系为该索引为其+1
-  std::map<Node *, int> to_consume_index_;
+  // 环形队列，序号为seq的数据包存放在ring_[seq % ring_.size()]
+  std::vector<PipelineDataPacket *> ring_;
+  // 仍可能被使用的最早的数据包序号
+  int64_t head_seq_ = 0;
+  // 下一个发布的数据包序号
+  int64_t tail_seq_ = 0;
+  // 队列满且策略为丢弃时，生产者写入该数据包，不会被消费
+  PipelineDataPacket *drop_dp_ = nullptr;
+  // 每个消费者 下一个要消费 的数据包序号  与下面当前数据包的关系为该序号为其+1
+  std::map<Node *, int64_t> to_consume_index_;
+  // 每个消费者 等待输入 的trace名字id，首次阻塞时intern
+  std::map<Node *, std::atomic<uint32_t>> wait_trace_id_;
   // 每个消费者 消费 的当前数据包
   std::map<Node *, PipelineDataPacket *> consuming_dp_;
 };
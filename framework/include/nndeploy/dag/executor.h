@@ -42,6 +42,15 @@ class NNDEPLOY_CC_API Executor : public base::NonCopyable {
 
   virtual base::Status run() = 0;
 
+  /**
+   * @brief 异步执行一次，默认同步执行run后返回已就绪的future
+   */
+  virtual std::future<base::Status> runAsync() {
+    std::promise<base::Status> promise;
+    promise.set_value(this->run());
+    return promise.get_future();
+  }
+
  protected:
   // must be set by user
   bool is_external_stream_ = false;
@@ -0,0 +1,89 @@
+#ifndef _NNDEPLOY_DAG_EXECUTOR_PARALLEL_PIPELINE_TASK_EXECUTOR_H_
+#define _NNDEPLOY_DAG_EXECUTOR_PARALLEL_PIPELINE_TASK_EXECUTOR_H_
+
+#include "nndeploy/dag/executor.h"
+#include "nndeploy/thread_pool/thread_pool.h"
+
+namespace nndeploy {
+namespace dag {
+
+/**
+ * @brief 基于共享线程池的流水线执行器，同时处理多帧
+ * @note
+ * # 与ParallelPipelineExecutor相同，边为PipelineEdge，每帧的数据在边上按序号区分；
+ *   但不为每个节点常驻一个线程，节点在第k帧的输入都就绪后才作为任务提交到全局线程池
+ * # 同一节点按帧的顺序依次执行且不会并发执行；不同节点可以同时处理不同的帧
+ * # 最多同时处理max_inflight_帧，超过时run/runAsync阻塞直到最早的一帧完成
+ * # 节点执行失败后不再调度新的任务，所有未完成的帧都返回该错误
+ */
+class ParallelPipelineTaskExecutor : public Executor {
+ public:
+  ParallelPipelineTaskExecutor();
+
+  virtual ~ParallelPipelineTaskExecutor();
+
+  /**
+   * @brief 设置同时处理的最大帧数，需在init之前调用
+   */
+  void setMaxInflight(int max_inflight);
+  int getMaxInflight();
+
+  virtual base::Status init(std::vector<EdgeWrapper*>& edge_repository,
+                            std::vector<NodeWrapper*>& node_repository);
+
+  virtual base::Status deinit();
+
+  /**
+   * @brief 提交一帧后立即返回，与ParallelPipelineExecutor一致
+   */
+  virtual base::Status run();
+
+  /**
+   * @brief 提交一帧，返回的future在该帧所有节点执行完成后就绪
+   */
+  virtual std::future<base::Status> runAsync();
+
+ private:
+  struct Frame {
+    int remaining_ = 0;  // 该帧尚未执行完成的节点个数
+    base::Status status_ = base::kStatusCodeOk;
+    std::promise<base::Status> promise_;
+  };
+
+  /**
+   * @brief 节点可以执行下一帧时标记为运行中并加入ready，需持有mutex_
+   */
+  void tryStart(int index, std::vector<std::pair<int, int64_t>>& ready);
+  void submit(const std::vector<std::pair<int, int64_t>>& ready);
+  void runNode(int index, int64_t frame);
+  void afterNodeRun(int index, int64_t frame, base::Status status);
+  /**
+   * @brief 所有未完成的帧以status结束，需持有mutex_
+   */
+  void failAllFrames(base::Status status);
+
+ private:
+  thread_pool::ThreadPool* thread_pool_ = nullptr;
+  std::vector<NodeWrapper*> topo_sort_node_;
+  std::vector<EdgeWrapper*> edge_repository_;
+  int all_task_count_ = 0;
+  int max_inflight_ = 4;
+
+  // 以下以节点在topo_sort_node_中的下标索引
+  std::vector<std::vector<int>> predecessors_;
+  std::vector<std::vector<int>> successors_;
+  std::vector<int64_t> done_frames_;  // 已执行完成的帧数
+  std::vector<bool> running_;
+  int running_count_ = 0;
+
+  int64_t submitted_frames_ = 0;
+  std::map<int64_t, Frame> frames_;  // 未完成的帧
+  bool failed_ = false;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+};
+
+}  // namespace dag
+}  // namespace nndeploy
+
+#endif /* _NNDEPLOY_DAG_EXECUTOR_PARALLEL_PIPELINE_TASK_EXECUTOR_H_ */
@@ -3,12 +3,20 @@
 #define _NNDEPLOY_DAG_EXECUTOR_PARALLEL_TASK_EXECUTOR_H_
 
 #include "nndeploy/dag/executor.h"
-#include "nndeploy/thread_pool/safe_ws_queue.h"
 #include "nndeploy/thread_pool/thread_pool.h"
 
 namespace nndeploy {
 namespace dag {
 
+/**
+ * @brief 按关键路径优先级调度的并行执行器
+ * @note
+ * # 节点的优先级为从该节点到汇点的最长路径耗时，耗时为每个节点实测时间的滑动平均，
+ *   尚未测量的节点按已测节点的平均耗时估计（都未测量时即为路径上的节点个数）
+ * # 就绪节点放入按优先级排序的堆中，每个就绪节点对应线程池中的一个任务，
+ *   任务执行时取堆中优先级最高的节点，保证长分支（如backbone）不会排在廉价的旁路节点之后
+ * # 前驱是否全部完成通过原子计数判断，节点完成时不再加锁遍历前驱的颜色
+ */
 class ParallelTaskExecutor : public Executor {
  public:
   ParallelTaskExecutor();
@@ -23,32 +31,37 @@ class ParallelTaskExecutor : public Executor {
   virtual base::Status run();
 
   /**
-   * @brief 提交一个节点执行
+   * @brief 将一个就绪节点加入优先级队列并提交执行
    * @param  node_wrapper
    */
   void process(NodeWrapper* node_wrapper);
 
   /**
-   * @brief 状态更新；加入后续节点执行；唤醒主线程
+   * @brief 状态更新；后继节点的前驱计数减一，减到0时加入执行；唤醒主线程
    * @param  node_wrapper
    */
   void afterNodeRun(NodeWrapper* node_wrapper);
 
-  /**
-   * @brief  一个节点有多个前驱节点时，防止多次加入执行
-   * @param  node_wrapper
-   */
-  void submitTaskSynchronized(NodeWrapper* node_wrapper);
-
   /**
    * @brief 等待所有节点执行完成
    */
   void wait();
   /**
-   * @brief 初始化每次执行的状态信息
+   * @brief 初始化每次执行的状态信息，并根据本次的耗时更新优先级
    */
   void afterGraphRun();
 
+  /**
+   * @brief 节点的优先级（到汇点的最长路径耗时），节点不在图中时返回-1
+   */
+  double getPriority(NodeWrapper* node_wrapper);
+
+ private:
+  void submit(const std::vector<int>& ready);
+  void runReadyNode();
+  bool isLowerPriority(int a, int b) const;
+  void updatePriority();
+
  private:
   thread_pool::ThreadPool* thread_pool_ = nullptr;
   std::vector<NodeWrapper*> topo_sort_node_;
@@ -56,9 +69,18 @@ class ParallelTaskExecutor : public Executor {
   std::atomic<int> completed_task_count_{0};  // 已执行结束的元素个数
   int all_task_count_ = 0;  // 需要执行的所有节点个数
   std::mutex main_lock_;
-  std::mutex commit_lock_;
   std::condition_variable cv_;
   std::vector<EdgeWrapper*> edge_repository_;
+
+  // 以下以节点在topo_sort_node_中的下标（即拓扑序）索引
+  std::unordered_map<NodeWrapper*, int> node_index_;
+  std::vector<std::vector<int>> successors_;
+  std::vector<int> predecessor_count_;
+  std::unique_ptr<std::atomic<int>[]> pending_count_;  // 尚未完成的前驱个数
+  std::vector<double> cost_;      // 耗时(ms)的滑动平均，未测量时为0
+  std::vector<double> priority_;  // 到汇点的最长路径耗时
+  std::mutex ready_lock_;
+  std::vector<int> ready_;  // 按优先级组织的堆
 };
 
 }  // namespace dag
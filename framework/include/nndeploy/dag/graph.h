@@ -421,6 +421,15 @@ class NNDEPLOY_CC_API Graph : public Node {
   void setGraphNodeShareStream(bool flag);
   bool getGraphNodeShareStream();
 
+  /**
+   * @brief 流水线并行时同时处理的最大帧数，需在init之前设置
+   * @note
+   * # 0（默认）为ParallelPipelineExecutor，每个节点常驻一个线程
+   * # 大于0时为ParallelPipelineTaskExecutor，节点作为任务在全局线程池中执行
+   */
+  void setPipelineInflight(int num);
+  int getPipelineInflight();
+
   base::Status updateNodeIO(Node *node, std::vector<Edge *> inputs,
                             std::vector<Edge *> outputs);
   base::Status markInputEdge(std::vector<Edge *> inputs) {
@@ -441,6 +450,10 @@ class NNDEPLOY_CC_API Graph : public Node {
   virtual base::Status deinit();
 
   virtual base::Status run();
+  /**
+   * @brief 异步执行一次，返回的future在本次执行完成后就绪
+   */
+  std::future<base::Status> runAsync();
 
   // This method must be implemented by subclasses
   // Subclasses should override this method to define their own operator()
@@ -533,6 +546,7 @@ class NNDEPLOY_CC_API Graph : public Node {
 
  protected:
   bool is_graph_node_share_stream_ = true;
+  int pipeline_inflight_ = 0;
   std::vector<EdgeWrapper *> edge_repository_;
   std::vector<NodeWrapper *> node_repository_;
   std::vector<std::shared_ptr<Edge>> shared_edge_repository_;
@@ -11,6 +11,7 @@
 #include "nndeploy/base/status.h"
 #include "nndeploy/base/string.h"
 #include "nndeploy/base/time_profiler.h"
+#include "nndeploy/base/trace.h"
 #include "nndeploy/dag/base.h"
 #include "nndeploy/dag/edge.h"
 #include "nndeploy/device/buffer.h"
@@ -146,6 +147,14 @@ class NNDEPLOY_CC_API Node {
   void setRunningFlag(bool flag);
   bool isRunning();
 
+  /**
+   * @brief 节点是否独占一个线程循环执行updateInput与run
+   * @note 由ParallelPipelineExecutor设置，此时run中可以自行消费后续帧的输入；
+   *       由执行器按帧调度run的场景(如ParallelPipelineTaskExecutor)为false
+   */
+  void setDedicatedThreadFlag(bool flag);
+  bool getDedicatedThreadFlag();
+
   void setCompiledFlag(bool flag);
   bool getCompiledFlag();
 
@@ -245,11 +254,14 @@ class NNDEPLOY_CC_API Node {
   base::ParallelType parallel_type_ = base::kParallelTypeNone;
   bool initialized_ = false;
   bool is_running_ = false;
+  bool is_dedicated_thread_ = false;
   bool is_time_profile_ = false;
   bool is_debug_ = false;
   bool is_compiled_ = false;
   bool is_graph_ = false;
   NodeType node_type_ = NodeType::kNodeTypeIntermediate;
+  // Tracer中name_的id，首次run时intern
+  std::atomic<uint32_t> trace_name_id_{0};
 };
 
 /**
@@ -0,0 +1,90 @@
+
+#ifndef _NNDEPLOY_DEVICE_CACHING_MEMORY_POOL_H_
+#define _NNDEPLOY_DEVICE_CACHING_MEMORY_POOL_H_
+
+#include "nndeploy/base/common.h"
+#include "nndeploy/base/glic_stl_include.h"
+#include "nndeploy/base/log.h"
+#include "nndeploy/base/macro.h"
+#include "nndeploy/base/object.h"
+#include "nndeploy/base/status.h"
+#include "nndeploy/device/device.h"
+#include "nndeploy/device/memory_pool.h"
+
+namespace nndeploy {
+namespace device {
+
+/**
+ * @brief 按size class缓存的内存池，适用于所有设备
+ * @note
+ * # 申请大小向上取整到size class（每个2的幂区间分4档，浪费不超过25%），
+ *   释放后按size class缓存，下次同档申请直接复用，不再调用设备的allocate
+ * # 每个线程有一个小的本地缓存，命中时不竞争全局锁；本地缓存满了再放回全局缓存
+ * # 返回的地址按kAlignment对齐
+ * # 超过kMaxCachedBlockSize的申请直接向设备申请和释放
+ * # init(size)设置全局缓存的上限，超出时多余的空闲块归还设备；trim归还所有空闲块
+ * # deinit/析构前，从该内存池申请的内存必须都已释放
+ */
+class NNDEPLOY_CC_API CachingMemoryPool : public MemoryPool {
+ public:
+  static const size_t kAlignment = 64;
+  static const size_t kMinBlockSize = 256;
+  static const size_t kMaxCachedBlockSize = size_t(1) << 30;
+
+  CachingMemoryPool(Device *device);
+  virtual ~CachingMemoryPool();
+
+  virtual base::Status init();
+  virtual base::Status init(size_t size);
+
+  virtual base::Status deinit();
+
+  virtual void *allocate(size_t size);
+  virtual void *allocate(const BufferDesc &desc);
+
+  virtual void deallocate(void *ptr);
+
+  virtual void *allocatePinned(size_t size);
+  virtual void *allocatePinned(const BufferDesc &desc);
+
+  virtual void deallocatePinned(void *ptr);
+
+  virtual base::Status trim();
+  virtual MemoryPoolStats getStats();
+
+  /**
+   * @brief 申请大小对应的size class，超过kMaxCachedBlockSize时返回-1
+   */
+  static int getSizeClass(size_t size, size_t &block_size);
+
+ private:
+  struct Block {
+    void *base_ = nullptr;  // 设备返回的原始地址
+    void *ptr_ = nullptr;   // 对齐后返回给使用者的地址
+    size_t size_ = 0;       // size class的大小
+    int size_class_ = -1;
+    bool in_use_ = false;
+  };
+  struct ThreadCache;
+  struct Arena;
+
+  void *allocateFrom(Arena &arena, size_t size);
+  void deallocateTo(Arena &arena, void *ptr);
+  ThreadCache *getThreadCache(Arena &arena);
+  void releaseBlock(Arena &arena, const Block &block);
+  // 全局缓存超过上限时归还设备，需持有arena.mutex_
+  void shrinkCentral(Arena &arena);
+  void trimArena(Arena &arena);
+
+ private:
+  // 每个内存池唯一的id，用于区分线程本地缓存
+  uint64_t id_;
+  size_t max_cached_size_;
+  Arena *arena_;
+  Arena *pinned_arena_;
+};
+
+}  // namespace device
+}  // namespace nndeploy
+
+#endif
@@ -84,6 +84,11 @@ class NNDEPLOY_CC_API CudaDevice : public Device {
 
   virtual void deallocate(void *ptr);
 
+  virtual void *allocatePinned(size_t size);
+  virtual void *allocatePinned(const BufferDesc &desc);
+
+  virtual void deallocatePinned(void *ptr);
+
   virtual base::Status copy(void *src, void *dst, size_t size,
                             Stream *stream = nullptr) override;
   virtual base::Status download(void *src, void *dst, size_t size,
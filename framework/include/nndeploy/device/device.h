@@ -18,6 +18,7 @@ class Stream;
 class Event;
 
 class Buffer;
+class MemoryPool;
 
 struct NNDEPLOY_CC_API DeviceInfo {
   base::DeviceType device_type_;
@@ -140,16 +141,28 @@ class NNDEPLOY_CC_API Device : public base::NonCopyable {
 
   base::DeviceType getDeviceType() const;
 
+  /**
+   * @brief 为设备开启内存池，之后经由设备创建的Buffer/Tensor都从内存池分配
+   * @note 需在创建Buffer/Tensor之前调用
+   */
+  base::Status enableMemoryPool(base::MemoryPoolType memory_pool_type);
+  /**
+   * @brief 关闭内存池，内存池中仍有内存被使用时失败
+   */
+  base::Status disableMemoryPool();
+  MemoryPool *getMemoryPool();
+
  public:
   Device(base::DeviceType device_type, std::string library_path = "")
       : device_type_(device_type) {};
-  virtual ~Device() {};
+  virtual ~Device();
 
   virtual base::Status init() = 0;
   virtual base::Status deinit() = 0;
 
  protected:
   base::DeviceType device_type_;
+  MemoryPool *memory_pool_ = nullptr;
 };
 
 class NNDEPLOY_CC_API Stream : public base::NonCopyable {
@@ -295,6 +308,11 @@ extern NNDEPLOY_CC_API base::Status enableDevice(base::DeviceType device_type,
 
 extern NNDEPLOY_CC_API Device *getDevice(base::DeviceType device_type);
 
+extern NNDEPLOY_CC_API base::Status enableMemoryPool(
+    base::DeviceType device_type, base::MemoryPoolType memory_pool_type);
+extern NNDEPLOY_CC_API base::Status disableMemoryPool(
+    base::DeviceType device_type);
+
 extern NNDEPLOY_CC_API Stream *createStream(base::DeviceType device_type);
 extern NNDEPLOY_CC_API Stream *createStream(base::DeviceType device_type,
                                             void *stream);
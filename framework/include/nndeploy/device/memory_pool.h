@@ -16,6 +16,22 @@ namespace device {
 
 class Buffer;
 
+/**
+ * @brief 内存池统计信息，单位为字节
+ */
+struct NNDEPLOY_CC_API MemoryPoolStats {
+  // 从设备申请的内存
+  size_t reserved_size_ = 0;
+  // 正在被使用的内存
+  size_t allocated_size_ = 0;
+  size_t peak_allocated_size_ = 0;
+  // 缓存中空闲的内存
+  size_t cached_size_ = 0;
+  size_t allocate_count_ = 0;
+  // 从缓存中直接得到内存的次数
+  size_t cache_hit_count_ = 0;
+};
+
 class NNDEPLOY_CC_API MemoryPool {
  public:
   MemoryPool(Device *device, base::MemoryPoolType memory_pool_type);
@@ -38,6 +54,12 @@ class NNDEPLOY_CC_API MemoryPool {
 
   virtual void deallocatePinned(void *ptr) = 0;
 
+  /**
+   * @brief 把缓存的空闲内存归还给设备
+   */
+  virtual base::Status trim();
+  virtual MemoryPoolStats getStats();
+
   Device *getDevice();
   base::MemoryPoolType getMemoryPoolType();
 
@@ -46,6 +68,12 @@ class NNDEPLOY_CC_API MemoryPool {
   base::MemoryPoolType memory_pool_type_;
 };
 
+/**
+ * @brief 创建内存池，当前实现了kMemoryPoolTypeCaching
+ */
+extern NNDEPLOY_CC_API MemoryPool *createMemoryPool(
+    Device *device, base::MemoryPoolType memory_pool_type);
+
 }  // namespace device
 }  // namespace nndeploy
 
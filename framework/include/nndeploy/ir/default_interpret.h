@@ -36,14 +36,6 @@ class DefaultInterpret : public Interpret {
   virtual base::Status interpret(
       const std::vector<std::string> &model_value,
       const std::vector<ValueDesc> &input = std::vector<ValueDesc>());
-
- private:
-  /**
-   * @brief 模型权重
-   *
-   * 用于存储模型权重信息
-   */
-  std::vector<std::shared_ptr<safetensors::safetensors_t>> st_ptr_;
 };
 
 }  // namespace ir
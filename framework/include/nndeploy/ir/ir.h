@@ -15,6 +15,7 @@
 #include "nndeploy/base/string.h"
 #include "nndeploy/device/tensor.h"
 #include "nndeploy/ir/op_param.h"
+#include "nndeploy/ir/weight_store.h"
 #include "safetensors.hh"
 
 namespace nndeploy {
@@ -135,6 +136,9 @@ class NNDEPLOY_CC_API ModelDesc {
   base::Status deserializeWeightsFromSafetensors(
       std::shared_ptr<safetensors::safetensors_t> &st_ptr);
 
+  // 权重所在的mmap权重存储，不是来自权重存储时返回nullptr
+  WeightStore *getWeightStore(const std::string &weight_name);
+
  public:
   // 描述模型的名称
   std::string name_;
@@ -148,6 +152,8 @@ class NNDEPLOY_CC_API ModelDesc {
   std::vector<std::shared_ptr<OpDesc>> op_descs_;
   // 模型权重
   std::map<std::string, device::Tensor *> weights_;
+  // 权重的mmap存储，weights_中的权重可能直接指向其映射区域
+  std::vector<std::shared_ptr<WeightStore>> weight_stores_;
   // 模型中间值，一般通常为空，多用于调试
   std::vector<std::shared_ptr<ValueDesc>> values_;
 };
@@ -0,0 +1,63 @@
+
+#ifndef _NNDEPLOY_IR_WEIGHT_STORE_H_
+#define _NNDEPLOY_IR_WEIGHT_STORE_H_
+
+#include <memory>
+
+#include "nndeploy/base/glic_stl_include.h"
+#include "nndeploy/base/macro.h"
+#include "nndeploy/base/mapped_file.h"
+#include "nndeploy/base/object.h"
+#include "nndeploy/base/status.h"
+#include "safetensors.hh"
+
+namespace nndeploy {
+namespace ir {
+
+/**
+ * @brief 基于mmap的safetensors权重存储
+ * @note
+ * # 权重文件只读共享映射，权重tensor直接指向映射区域，不拷贝
+ * # 同一权重文件的多个模型副本（同进程或跨进程）共享page cache中的物理页
+ * # 权重所在页在第一次被访问时才读入；prefetch通过madvise提前异步预读，
+ *   release在权重上传到其他设备后释放本进程的常驻页
+ * # 由ModelDesc持有，生命周期不短于指向映射区域的权重tensor
+ */
+class NNDEPLOY_CC_API WeightStore : public base::NonCopyable {
+ public:
+  WeightStore();
+  virtual ~WeightStore();
+
+  /**
+   * @brief 映射并解析safetensors文件
+   *
+   * @param path 权重文件路径
+   * @param prefetch 是否对整个权重区域预读
+   */
+  base::Status load(const std::string &path, bool prefetch = false);
+
+  std::shared_ptr<safetensors::safetensors_t> &getSafetensors();
+
+  bool hasWeight(const std::string &name);
+
+  base::Status prefetch();
+  base::Status prefetch(const std::string &name);
+  base::Status release(const std::string &name);
+
+  // 映射的字节数
+  size_t getMappedSize();
+  // 已在物理内存中的字节数
+  size_t getResidentSize();
+
+ private:
+  bool getWeightRange(const std::string &name, size_t &offset, size_t &size);
+
+ private:
+  std::shared_ptr<base::MappedFile> file_;
+  std::shared_ptr<safetensors::safetensors_t> st_ptr_;
+};
+
+}  // namespace ir
+}  // namespace nndeploy
+
+#endif /* _NNDEPLOY_IR_WEIGHT_STORE_H_ */
@@ -33,6 +33,10 @@ class NNDEPLOY_CC_API Net : public op::Op {
   bool isWeight(const std::string &name);
   // 有转移所有权属性
   device::Tensor *getWeight(const std::string &weight);
+  // 有转移所有权属性，创建算子时把权重放到算子所在设备上，
+  // 非host设备拷贝一次后释放映射页
+  device::Tensor *getWeight(const std::string &weight,
+                            base::DeviceType device_type);
 
   op::Op *createOp(base::DeviceType device_type, const std::string &name,
                    ir::OpType op_type,
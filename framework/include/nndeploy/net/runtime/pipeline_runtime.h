@@ -36,6 +36,23 @@ class PipelineRuntime : public Runtime {
                           std::vector<base::DeviceType> device_types =
                               std::vector<base::DeviceType>());
 
+  /**
+   * @brief 设置每个op的耗时(ms)，key为op的名称，需在init之前调用
+   * @note 例如由一次预热运行统计得到；未覆盖所有op时改用Op::getFlops()估算
+   */
+  void setOpCosts(const std::map<std::string, float> &op_costs);
+  /**
+   * @brief 设置按flops估算时的计算速度与阶段间传输tensor的带宽
+   *
+   * @param flops_per_ms 每ms的浮点运算次数，默认1e8
+   * @param bytes_per_ms 每ms拷贝的字节数，默认1e7
+   */
+  void setCostModel(double flops_per_ms, double bytes_per_ms);
+  /**
+   * @brief init之后得到切分后预计的吞吐(帧/s)，由耗时最长的阶段决定
+   */
+  float getExpectedThroughput();
+
   virtual base::Status init(
       std::vector<TensorWrapper *> &tensor_repository,
       std::vector<OpWrapper *> &op_repository,
@@ -61,6 +78,22 @@ class PipelineRuntime : public Runtime {
                                                   base::DataFormat data_format);
 
  private:
+  /**
+   * @brief 按拓扑序把op切分为至多worker_num_个连续的阶段，最小化耗时最长的阶段
+   * @note 阶段耗时 = 阶段内op的耗时 + 从前面阶段(或外部)拷入的tensor的传输耗时
+   *
+   * @param stage_begin 每个阶段第一个op的下标，最后追加op总数
+   */
+  base::Status partition(std::vector<TensorWrapper *> &tensor_repository,
+                         std::vector<OpWrapper *> &op_repository,
+                         std::vector<int> &stage_begin);
+
+ private:
+  std::map<std::string, float> op_costs_;
+  double flops_per_ms_ = 1e8;
+  double bytes_per_ms_ = 1e7;
+  float expected_throughput_ = 0.0f;
+
   std::vector<SequentialRuntime *> sequential_runtimes_;
   std::map<SequentialRuntime *, std::shared_ptr<PipelineRuntimeStage>>
       sequential_runtime_stage_stages_;
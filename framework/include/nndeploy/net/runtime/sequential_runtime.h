@@ -50,6 +50,8 @@ class NNDEPLOY_CC_API SequentialRuntime : public Runtime {
   uint64_t workspace_size_ = 0;
   void *workspace_ = nullptr;
   base::ShapeMap shape_map_;
+  // 与op_repository_一一对应，Tracer中op名字的id
+  std::vector<std::atomic<uint32_t>> op_trace_ids_;
 };
 
 }  // namespace net
@@ -18,8 +18,8 @@
  * 2. 生命周期的优化
  * 3. 多模型共享内存的优化
  * 4. workspace的优化
- * 5. inplace算子的优化（TODO）
- * 6. 更精细的内存优化（基于多生命周期的优化）（TODO）
+ * 5. inplace算子的优化（kTensorPool1DOffsetCalculateTypeInplace）
+ * 6. 更精细的内存优化（基于多生命周期的优化）（kTensorPool1DOffsetCalculateTypeInplace）
  */
 
 namespace nndeploy {
@@ -31,6 +31,8 @@ enum TensorPoolType : int {
   kTensorPool1DSharedObjectTypeGreedyBySizeImprove,  // 正确
   kTensorPool1DOffsetCalculateTypeGreedyBySize,      // 正确
   kTensorPool1DOffsetCalculateTypeGreedyByBreadth,   // 正确
+  kTensorPool1DOffsetCalculateTypeInplace,           // inplace + 多段生命周期
+  kTensorPool1DOffsetCalculateTypeOptimal,  // inplace + 分支定界求最优偏移量
   kTensorPool1DNone,
 };
 
@@ -0,0 +1,100 @@
+#ifndef _NNDEPLOY_NET_TENSOR_POOL_TENSOR_POOL_1D_OFFSET_CALCULATE_INPLACE_H_
+#define _NNDEPLOY_NET_TENSOR_POOL_TENSOR_POOL_1D_OFFSET_CALCULATE_INPLACE_H_
+
+#include "nndeploy/base/any.h"
+#include "nndeploy/base/common.h"
+#include "nndeploy/base/glic_stl_include.h"
+#include "nndeploy/base/log.h"
+#include "nndeploy/base/macro.h"
+#include "nndeploy/base/object.h"
+#include "nndeploy/base/status.h"
+#include "nndeploy/base/string.h"
+#include "nndeploy/net/tensor_pool.h"
+#include "nndeploy/net/tensor_pool/tensor_pool_1d_base.h"
+#include "nndeploy/net/util.h"
+
+namespace nndeploy {
+namespace net {
+
+/**
+ * @brief 共享同一块内存的一组tensor（inplace算子的输入与输出）
+ * @note
+ * # 组内tensor的生命周期可以是多段不相交的区间，两个组只要各段区间都不相交即可复用同一地址
+ * # size_为组内最大的tensor
+ */
+struct TensorAliasGroup {
+  std::vector<std::shared_ptr<TensorUsageRecord>> tensor_usage_records_;
+  std::vector<std::array<int, 2>> intervals_;
+  size_t size_ = 0;
+  size_t offset_ = 0;
+  // 组内最后一次使用的op序号
+  int end_ = -1;
+  // 组内有图的输入输出tensor时不允许被inplace覆盖
+  bool is_io_ = false;
+};
+
+/**
+ * @brief 支持inplace与多段生命周期的偏移量分配
+ * @note
+ * # inplace：Relu/Sigmoid/Add/Mul的输入在该op之后不再被使用时，输出直接写入输入的内存；
+ *   Reshape/Flatten的输出与输入数据完全相同，总是与输入共享内存
+ * # 多段生命周期：以组为单位分配，组的生命周期为组内所有tensor区间的并集
+ * # 偏移量分配：按组大小从大到小，在与其生命周期相交的已分配组之间寻找最合适的空隙（best
+ *   fit），而非以整块为单位复用
+ */
+class TensorPool1DOffsetCalculateInplace : public TensorPool1D {
+ public:
+  TensorPool1DOffsetCalculateInplace(
+      device::Device *device, std::vector<TensorWrapper *> &tensor_repository,
+      std::vector<OpWrapper *> &op_repository);
+
+  virtual ~TensorPool1DOffsetCalculateInplace();
+
+  virtual base::Status allocate();
+  virtual base::Status deallocate();
+
+  /**
+   * @brief 获取推理所需的内存大小
+   *
+   * @return int64_t
+   */
+  virtual int64_t getMemorySize();
+  /**
+   * @brief 设置推理所需的内存（推理内存由外部分配）
+   *
+   * @param buffer
+   * @return base::Status
+   */
+  virtual base::Status setMemory(device::Buffer *buffer);
+
+  /**
+   * @brief 该op能否将输出写入输入的内存
+   */
+  static bool isInplaceOp(ir::OpType op_type);
+  /**
+   * @brief 该op的输出与输入数据完全相同，只改变shape
+   */
+  static bool isViewOp(ir::OpType op_type);
+
+ protected:
+  base::Status initAliasGroup(bool enable_inplace);
+  base::Status deinitAliasGroup();
+  /**
+   * @brief 为alias_groups_计算偏移量
+   *
+   * @return size_t 所需内存大小
+   */
+  virtual size_t calculateOffset();
+
+ protected:
+  std::vector<std::shared_ptr<TensorAliasGroup>> alias_groups_;
+  int64_t total_consumption_ = -1;
+  bool is_external_ = false;
+  device::Buffer *mem_block_ = nullptr;
+};
+
+}  // namespace net
+}  // namespace nndeploy
+
+#endif /* _NNDEPLOY_NET_TENSOR_POOL_TENSOR_POOL_1D_OFFSET_CALCULATE_INPLACE_H_ \
+        */
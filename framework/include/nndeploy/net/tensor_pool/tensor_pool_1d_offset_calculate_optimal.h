@@ -0,0 +1,59 @@
+#ifndef _NNDEPLOY_NET_TENSOR_POOL_TENSOR_POOL_1D_OFFSET_CALCULATE_OPTIMAL_H_
+#define _NNDEPLOY_NET_TENSOR_POOL_TENSOR_POOL_1D_OFFSET_CALCULATE_OPTIMAL_H_
+
+#include "nndeploy/base/any.h"
+#include "nndeploy/base/common.h"
+#include "nndeploy/base/glic_stl_include.h"
+#include "nndeploy/base/log.h"
+#include "nndeploy/base/macro.h"
+#include "nndeploy/base/object.h"
+#include "nndeploy/base/status.h"
+#include "nndeploy/base/string.h"
+#include "nndeploy/net/tensor_pool.h"
+#include "nndeploy/net/tensor_pool/tensor_pool_1d_offset_calculate_inplace.h"
+#include "nndeploy/net/util.h"
+
+namespace nndeploy {
+namespace net {
+
+/**
+ * @brief 分支定界求解偏移量分配
+ * @note
+ * # 与kTensorPool1DOffsetCalculateTypeInplace相同的inplace分组，只替换偏移量的计算
+ * # 任意合法布局都可以把每一块往低地址压到不能再压，此时按偏移量排序后，
+ *   每一块都位于“不低于前一块偏移量的最低可行位置”；搜索这一类布局即可得到最优解
+ * # 下界：同一时刻存活的组大小之和的最大值；剪枝：剩余组都在当前偏移量之上，
+ *   每个时刻至少再叠加该时刻剩余存活组的大小
+ * # 以贪心best fit的结果为初始解，达到下界或搜索完成即为最优，超过时间预算时返回当前最好的解
+ */
+class TensorPool1DOffsetCalculateOptimal
+    : public TensorPool1DOffsetCalculateInplace {
+ public:
+  TensorPool1DOffsetCalculateOptimal(
+      device::Device *device, std::vector<TensorWrapper *> &tensor_repository,
+      std::vector<OpWrapper *> &op_repository);
+
+  virtual ~TensorPool1DOffsetCalculateOptimal();
+
+  /**
+   * @brief 设置搜索的时间预算，默认1000ms
+   */
+  void setTimeLimit(int time_limit_ms);
+  int getTimeLimit();
+
+ protected:
+  virtual size_t calculateOffset();
+
+ private:
+  struct Search;
+  void search(Search &s, int last, size_t last_offset, size_t peak);
+
+ private:
+  int time_limit_ms_ = 1000;
+};
+
+}  // namespace net
+}  // namespace nndeploy
+
+#endif /* _NNDEPLOY_NET_TENSOR_POOL_TENSOR_POOL_1D_OFFSET_CALCULATE_OPTIMAL_H_ \
+        */
@@ -0,0 +1,194 @@
+
+#ifndef _NNDEPLOY_OP_ELEMENTWISE_KERNEL_H_
+#define _NNDEPLOY_OP_ELEMENTWISE_KERNEL_H_
+
+#include "nndeploy/base/common.h"
+#include "nndeploy/base/glic_stl_include.h"
+#include "nndeploy/base/log.h"
+#include "nndeploy/base/macro.h"
+#include "nndeploy/base/status.h"
+#include "nndeploy/device/tensor.h"
+
+namespace nndeploy {
+namespace op {
+
+enum ElementwiseBinaryType : int {
+  kElementwiseBinaryTypeAdd = 0x0000,
+  kElementwiseBinaryTypeSub,
+  kElementwiseBinaryTypeMul,
+  kElementwiseBinaryTypeDiv,
+
+  kElementwiseBinaryTypeNotSupport,
+};
+
+enum ElementwiseUnaryType : int {
+  kElementwiseUnaryTypeRelu = 0x0000,
+  kElementwiseUnaryTypeSigmoid,
+  kElementwiseUnaryTypeSilu,
+  kElementwiseUnaryTypeTanh,
+  kElementwiseUnaryTypeExp,
+  kElementwiseUnaryTypeSqrt,
+  kElementwiseUnaryTypeAbs,
+  kElementwiseUnaryTypeNeg,
+  kElementwiseUnaryTypeLinear,  // alpha_ * x + beta_
+  kElementwiseUnaryTypeClip,    // min(max(x, alpha_), beta_)
+
+  kElementwiseUnaryTypeNotSupport,
+};
+
+struct NNDEPLOY_CC_API ElementwiseUnary {
+  ElementwiseUnary() {}
+  ElementwiseUnary(ElementwiseUnaryType type, float alpha = 0.0f,
+                   float beta = 0.0f)
+      : type_(type), alpha_(alpha), beta_(beta) {}
+
+  ElementwiseUnaryType type_ = kElementwiseUnaryTypeNotSupport;
+  float alpha_ = 0.0f;
+  float beta_ = 0.0f;
+};
+
+inline float elementwiseBinaryScalar(ElementwiseBinaryType type, float a,
+                                     float b) {
+  switch (type) {
+    case kElementwiseBinaryTypeAdd:
+      return a + b;
+    case kElementwiseBinaryTypeSub:
+      return a - b;
+    case kElementwiseBinaryTypeMul:
+      return a * b;
+    default:
+      return a / b;
+  }
+}
+
+inline float elementwiseUnaryScalar(const ElementwiseUnary &unary, float x) {
+  switch (unary.type_) {
+    case kElementwiseUnaryTypeRelu:
+      return x > 0.0f ? x : 0.0f;
+    case kElementwiseUnaryTypeSigmoid:
+      return 1.0f / (1.0f + std::exp(-x));
+    case kElementwiseUnaryTypeSilu:
+      return x / (1.0f + std::exp(-x));
+    case kElementwiseUnaryTypeTanh:
+      return std::tanh(x);
+    case kElementwiseUnaryTypeExp:
+      return std::exp(x);
+    case kElementwiseUnaryTypeSqrt:
+      return std::sqrt(x);
+    case kElementwiseUnaryTypeAbs:
+      return std::fabs(x);
+    case kElementwiseUnaryTypeNeg:
+      return -x;
+    case kElementwiseUnaryTypeLinear:
+      return unary.alpha_ * x + unary.beta_;
+    case kElementwiseUnaryTypeClip:
+      x = x > unary.alpha_ ? x : unary.alpha_;
+      return x < unary.beta_ ? x : unary.beta_;
+    default:
+      return x;
+  }
+}
+
+/**
+ * @brief c[i] = a[i * a_step] op b[i * b_step]，a_step/b_step为0或1，0为广播的标量
+ */
+typedef void (*ElementwiseBinaryFunc)(ElementwiseBinaryType type,
+                                      const float *a, int a_step,
+                                      const float *b, int b_step, float *c,
+                                      int n);
+/**
+ * @brief y[i] = unary(x[i])，x与y可以相同
+ */
+typedef void (*ElementwiseUnaryFunc)(const ElementwiseUnary &unary,
+                                     const float *x, float *y, int n);
+/**
+ * @brief 与fp32之间的转换，转为int8时四舍五入(ties to even)并饱和，NaN转为-128
+ */
+typedef void (*ElementwiseLoadFunc)(const void *src, float *dst, int n);
+typedef void (*ElementwiseStoreFunc)(const float *src, void *dst, int n);
+
+/**
+ * @brief 按块计算的fp32向量核与类型转换
+ * @note
+ * # 各架构在自己的目录下按cpu特性注册，运行时按priority_从低到高合并，
+ *   为nullptr的成员沿用低优先级(最终为标量)的实现
+ */
+struct NNDEPLOY_CC_API ElementwiseKernel {
+  ElementwiseKernel() {}
+  ElementwiseKernel(const std::string &name, int priority)
+      : name_(name), priority_(priority) {}
+
+  std::string name_;
+  int priority_ = 0;
+  ElementwiseBinaryFunc binary_ = nullptr;
+  ElementwiseUnaryFunc unary_ = nullptr;
+  ElementwiseLoadFunc load_fp16_ = nullptr;
+  ElementwiseStoreFunc store_fp16_ = nullptr;
+  ElementwiseLoadFunc load_bfp16_ = nullptr;
+  ElementwiseStoreFunc store_bfp16_ = nullptr;
+  ElementwiseLoadFunc load_int8_ = nullptr;
+  ElementwiseStoreFunc store_int8_ = nullptr;
+};
+
+extern NNDEPLOY_CC_API void registerElementwiseKernel(
+    const ElementwiseKernel &kernel);
+
+/**
+ * @brief 当前cpu上可用的最优实现，所有成员均不为nullptr
+ * @note 返回已注册实现的合并结果，每次注册时更新，调用方不要缓存其成员
+ */
+extern NNDEPLOY_CC_API const ElementwiseKernel &getElementwiseKernel();
+
+/**
+ * @brief 按数据类型取当前cpu上最优的转换函数
+ * @note fp32为直接拷贝，不支持的类型(fp32/fp16/bf16/int8以外)返回nullptr
+ */
+extern NNDEPLOY_CC_API ElementwiseLoadFunc
+getElementwiseLoadFunc(const base::DataType &data_type);
+extern NNDEPLOY_CC_API ElementwiseStoreFunc
+getElementwiseStoreFunc(const base::DataType &data_type);
+
+/**
+ * @brief 参与逐元素运算的连续内存
+ */
+struct NNDEPLOY_CC_API ElementwiseOperand {
+  ElementwiseOperand() {}
+  ElementwiseOperand(void *data, base::DataType data_type,
+                     const base::IntVector &shape)
+      : data_(data), data_type_(data_type), shape_(shape) {}
+  explicit ElementwiseOperand(device::Tensor *tensor);
+
+  void *data_ = nullptr;
+  base::DataType data_type_;
+  base::IntVector shape_;
+};
+
+/**
+ * @brief output = epilogue(input0 op input1)，按NumPy规则广播
+ * @note
+ * # output的形状必须是两个输入广播后的形状
+ * # 去掉长度为1的维度并合并访问连续的相邻维度，最内层维度上每个输入的步长为0或1
+ * # 支持fp32/fp16/bf16/int8，各操作数的类型可以不同；非fp32的操作数按块转为
+ *   fp32计算，结果按输出类型写回
+ * # epilogue中的一元运算在L1中的块上依次执行，不额外读写整个张量
+ * # 按行与行内的段划分任务，通过thread_pool::parallelFor多线程执行，
+ *   小张量在调用线程上执行
+ * # output可以与形状相同的输入是同一块内存
+ */
+extern NNDEPLOY_CC_API base::Status elementwiseBinary(
+    ElementwiseBinaryType type, const ElementwiseOperand &input0,
+    const ElementwiseOperand &input1, const ElementwiseOperand &output,
+    const std::vector<ElementwiseUnary> &epilogue =
+        std::vector<ElementwiseUnary>());
+
+/**
+ * @brief output = ops[n-1](...ops[0](input))，ops为空时只做类型转换
+ */
+extern NNDEPLOY_CC_API base::Status elementwiseUnary(
+    const std::vector<ElementwiseUnary> &ops, const ElementwiseOperand &input,
+    const ElementwiseOperand &output);
+
+}  // namespace op
+}  // namespace nndeploy
+
+#endif /* _NNDEPLOY_OP_ELEMENTWISE_KERNEL_H_ */
@@ -0,0 +1,96 @@
+#ifndef _NNDEPLOY_OP_GEMM_KERNEL_H_
+#define _NNDEPLOY_OP_GEMM_KERNEL_H_
+
+#include "nndeploy/base/common.h"
+#include "nndeploy/base/glic_stl_include.h"
+#include "nndeploy/base/log.h"
+#include "nndeploy/base/macro.h"
+#include "nndeploy/base/status.h"
+
+namespace nndeploy {
+namespace op {
+
+/**
+ * @brief 计算 C[mr x nr] (+)= A_panel * B_panel
+ * @param kc 累加维度长度
+ * @param a 打包后的A微面板，按k连续，每个k有mr个元素
+ * @param b 打包后的B微面板，按k连续，每个k有nr个元素
+ * @param c 输出，行主序，行跨度为ldc
+ * @param accumulate 为true时累加到c上，否则直接覆盖
+ */
+typedef void (*SgemmMicroKernelFunc)(int kc, const float *a, const float *b,
+                                     float *c, int ldc, bool accumulate);
+
+/**
+ * @brief 寄存器分块的fp32微核
+ * @note 各架构在自己的目录下按cpu特性注册，运行时选择priority_最高的微核
+ */
+struct NNDEPLOY_CC_API SgemmMicroKernel {
+  SgemmMicroKernel() {}
+  SgemmMicroKernel(const std::string &name, int mr, int nr,
+                   SgemmMicroKernelFunc func, int priority)
+      : name_(name), mr_(mr), nr_(nr), func_(func), priority_(priority) {}
+
+  std::string name_;
+  int mr_ = 0;
+  int nr_ = 0;
+  SgemmMicroKernelFunc func_ = nullptr;
+  int priority_ = 0;
+};
+
+extern NNDEPLOY_CC_API void registerSgemmMicroKernel(
+    const SgemmMicroKernel &kernel);
+
+/**
+ * @brief 当前cpu上可用的最优微核，标量实现保底
+ * @note 返回已注册的最优微核，每次注册时更新，调用方不要跨调用缓存
+ */
+extern NNDEPLOY_CC_API const SgemmMicroKernel &getSgemmMicroKernel();
+
+/**
+ * @brief C = alpha * op(A) * op(B) + beta * C
+ * @note
+ * # 所有矩阵行主序，op(A)为[m x k]，op(B)为[k x n]
+ * # trans_a为true时A按[k x m]存储，lda为存储上的行跨度，B同理
+ * # beta为0时不读取C
+ * # 内部做KC/MC/NC分块打包，按输出块通过thread_pool::parallelFor多线程执行
+ */
+extern NNDEPLOY_CC_API void sgemm(bool trans_a, bool trans_b, int m, int n,
+                                  int k, float alpha, const float *a, int lda,
+                                  const float *b, int ldb, float beta, float *c,
+                                  int ldc);
+
+/**
+ * @brief 批量sgemm，每个batch的A/B/C由指针数组给出，支持batch间共享A或B
+ * @note 所有batch的输出块一起参与多线程划分
+ */
+extern NNDEPLOY_CC_API void sgemmBatch(bool trans_a, bool trans_b, int m,
+                                       int n, int k, float alpha,
+                                       const float *const *a, int lda,
+                                       const float *const *b, int ldb,
+                                       float beta, float *const *c, int ldc,
+                                       int batch);
+
+/**
+ * @brief 混合精度sgemm，A/B可以是fp32/fp16/bf16/int8，C为fp32
+ * @note
+ * # A/B在打包时按块转为fp32，不需要事先把整个矩阵转为fp32，
+ *   fp16/bf16的权重在内存中保持半精度
+ * # 累加在fp32上进行，其余与sgemm相同
+ * # 不支持的数据类型返回kStatusCodeErrorNotSupport
+ */
+extern NNDEPLOY_CC_API base::Status sgemmMixed(
+    bool trans_a, bool trans_b, int m, int n, int k, float alpha,
+    const void *a, const base::DataType &a_data_type, int lda, const void *b,
+    const base::DataType &b_data_type, int ldb, float beta, float *c, int ldc);
+
+extern NNDEPLOY_CC_API base::Status sgemmBatchMixed(
+    bool trans_a, bool trans_b, int m, int n, int k, float alpha,
+    const void *const *a, const base::DataType &a_data_type, int lda,
+    const void *const *b, const base::DataType &b_data_type, int ldb,
+    float beta, float *const *c, int ldc, int batch);
+
+}  // namespace op
+}  // namespace nndeploy
+
+#endif /* _NNDEPLOY_OP_GEMM_KERNEL_H_ */
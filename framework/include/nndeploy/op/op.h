@@ -126,6 +126,14 @@ class NNDEPLOY_CC_API Op {
   void setRunningFlag(bool flag);
   bool isRunning();
 
+  /**
+   * @brief 权重在两次执行之间是否不变
+   * @note 为true时算子可以按权重的地址缓存打包后的权重；函数式接口的缓存实例
+   *       每次调用都可能换绑或原地修改权重，设为false，每次preRun都重新打包
+   */
+  void setConstWeightFlag(bool flag);
+  bool getConstWeightFlag();
+
   /**
    * @brief 类型推理
    *
@@ -177,6 +185,8 @@ class NNDEPLOY_CC_API Op {
   virtual void setWorkspace(void *workspace);
   /**
    * @brief 得到op的flops
+   * @note 未设置flops_时按输入输出的shape估算：Conv/Gemm/MatMul为
+   * 2*输出元素个数*累加长度，其余op为输出元素个数
    *
    * @return uint64_t
    */
@@ -278,6 +288,7 @@ class NNDEPLOY_CC_API Op {
   bool is_running_ = false;
   bool is_time_profile_ = false;
   bool is_debug_ = false;
+  bool is_const_weight_ = true;
 };
 
 /**
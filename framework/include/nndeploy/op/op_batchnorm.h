@@ -17,6 +17,14 @@ class OpBatchNorm : public Op {
   virtual base::Status inferShape();
 
   virtual base::Status run();
+
+ private:
+  template <typename T>
+  base::Status runImpl();
+
+ private:
+  // 非fp32时一个平面的输入与输出
+  std::vector<float> buffer_;
 };
 
 NNDEPLOY_CC_API base::Status batchNorm(
@@ -0,0 +1,131 @@
+
+#ifndef _NNDEPLOY_OP_OP_CACHE_H_
+#define _NNDEPLOY_OP_OP_CACHE_H_
+
+#include "nndeploy/base/common.h"
+#include "nndeploy/base/glic_stl_include.h"
+#include "nndeploy/base/log.h"
+#include "nndeploy/base/macro.h"
+#include "nndeploy/base/param.h"
+#include "nndeploy/base/status.h"
+#include "nndeploy/device/device.h"
+#include "nndeploy/device/tensor.h"
+#include "nndeploy/ir/ir.h"
+#include "nndeploy/op/op.h"
+
+namespace nndeploy {
+namespace op {
+
+/**
+ * @brief 函数式接口(op::add/op::conv ...)的算子实例缓存
+ * @note
+ * # 以(设备, 算子类型, 参数, 各输入的数据类型与形状)为键缓存已init的算子，
+ *   命中时只重新绑定输入输出，不再createOp/init/deinit/delete
+ * # 参数按序列化结果比较，内容相同的不同参数对象命中同一实例
+ * # 同一个键可以有多个实例，多线程并发调用时各自取出不同的空闲实例
+ * # 每次调用都重新推导输出(输出形状可能依赖输入的数值，如slice/resize)
+ * # 非host设备上的算子可能在init中绑定输入(如ascend_cl)，输入输出变化时重新init
+ * # 缓存的算子不按权重地址缓存打包后的权重(setConstWeightFlag(false))，
+ *   地址可能被内存池复用，内容也可能被原地修改
+ * # x86/arm上没有专门实现的算子使用cpu上的实现
+ * # 实例数达到容量时淘汰最久未使用的空闲实例，容量为0时不缓存，
+ *   每次调用都创建并销毁算子
+ */
+class NNDEPLOY_CC_API OpCache {
+ public:
+  OpCache();
+  virtual ~OpCache();
+
+  /**
+   * @brief 执行一次算子，inputs/outputs中为nullptr的可选张量跳过，
+   *        可选输入只能在末尾
+   */
+  base::Status run(base::DeviceType device_type, ir::OpType op_type,
+                   std::shared_ptr<base::Param> param,
+                   std::initializer_list<device::Tensor *> inputs,
+                   std::initializer_list<device::Tensor *> outputs);
+  base::Status run(base::DeviceType device_type, ir::OpType op_type,
+                   std::shared_ptr<base::Param> param,
+                   const std::vector<device::Tensor *> &inputs,
+                   const std::vector<device::Tensor *> &outputs);
+
+  void setCapacity(size_t capacity);
+  size_t getCapacity();
+  /**
+   * @brief 当前缓存的实例数，包括正在执行的实例
+   */
+  size_t getSize();
+  uint64_t getHitCount();
+  uint64_t getMissCount();
+
+  /**
+   * @brief 销毁所有空闲实例，正在执行的实例在执行完成后照常放回
+   * @note 需要在nndeployFrameworkDeinit之前调用
+   */
+  void clear();
+
+ private:
+  struct Entry;
+
+  base::Status run(base::DeviceType device_type, ir::OpType op_type,
+                   std::shared_ptr<base::Param> param,
+                   device::Tensor *const *inputs, size_t input_size,
+                   device::Tensor *const *outputs, size_t output_size);
+  base::Status acquire(Entry &key, bool cacheable,
+                       std::shared_ptr<base::Param> param, Entry *&entry);
+  void release(Entry *entry, bool keep);
+  void destroy(Entry *entry);
+
+ private:
+  std::mutex mutex_;
+  size_t capacity_ = 256;
+  size_t size_ = 0;
+  uint64_t tick_ = 0;
+  uint64_t hit_count_ = 0;
+  uint64_t miss_count_ = 0;
+  std::unordered_map<uint64_t, std::vector<Entry *>> idle_;
+};
+
+/**
+ * @brief 函数式接口使用的全局缓存
+ */
+extern NNDEPLOY_CC_API OpCache *getGlobalOpCache();
+
+/**
+ * @brief 函数式接口的临时张量区
+ * @note
+ * # 按调用顺序分配临时张量，reset后按相同顺序再次分配时复用上一轮的张量与内存，
+ *   描述变化但内存足够时只修改描述，否则重新分配
+ * # 返回的张量在下一次reset/clear之前有效
+ * # 非线程安全，通常作为调用者(如扩散模型的调度器)的成员
+ */
+class NNDEPLOY_CC_API TensorArena {
+ public:
+  TensorArena();
+  virtual ~TensorArena();
+
+  device::Tensor *allocate(device::Device *device,
+                           const device::TensorDesc &desc);
+  /**
+   * @brief 形状为{1}的host fp32张量，可以按NumPy规则与任意张量广播
+   * @note 作为二元运算的第二个输入，输出的数据类型与格式沿用第一个输入
+   */
+  device::Tensor *scalar(float value);
+
+  void reset();
+  void clear();
+
+  /**
+   * @brief 当前持有的张量数
+   */
+  size_t getSize();
+
+ private:
+  std::vector<device::Tensor *> tensors_;
+  size_t cursor_ = 0;
+};
+
+}  // namespace op
+}  // namespace nndeploy
+
+#endif /* _NNDEPLOY_OP_OP_CACHE_H_ */
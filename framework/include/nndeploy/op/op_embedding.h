@@ -13,6 +13,7 @@ class OpEmbedding : public Op {
   OpEmbedding() : Op() {}
   virtual ~OpEmbedding() {}
 
+  virtual base::Status inferDataType();
   virtual base::Status inferShape();
 
   virtual base::Status run();
@@ -8,6 +8,12 @@
 namespace nndeploy {
 namespace op {
 
+/**
+ * @brief Y = alpha * A' * B' + beta * C
+ * @note
+ * # A/B/C可以是fp32/fp16/bf16，各自保持原有精度，在打包时按块转为fp32
+ * # 按输出类型(与A相同)实例化runImpl，fp32累加，非fp32输出最后统一写回
+ */
 class OpGemm : public Op {
  public:
   OpGemm() : Op() {}
@@ -16,6 +22,14 @@ class OpGemm : public Op {
   virtual base::Status inferShape();
 
   virtual base::Status run();
+
+ private:
+  template <typename T>
+  base::Status runImpl();
+
+ private:
+  // 非fp32输出时的fp32累加缓冲区
+  std::vector<float> accumulator_;
 };
 
 NNDEPLOY_CC_API base::Status gemm(device::Tensor *inputs_a,
@@ -16,6 +16,14 @@ class OpMatMul : public Op {
   virtual base::Status inferShape();
 
   virtual base::Status run();
+
+ private:
+  template <typename T>
+  base::Status runImpl();
+
+ private:
+  // 非fp32输出时的fp32累加缓冲区
+  std::vector<float> accumulator_;
 };
 
 NNDEPLOY_CC_API base::Status matmul(device::Tensor *inputs_a,
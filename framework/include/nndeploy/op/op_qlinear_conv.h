@@ -8,21 +8,43 @@
 namespace nndeploy {
 namespace op {
 
+/**
+ * @brief QLinearConv 展开后的量化参数
+ * @note w_scale/w_zero_point 可以是标量或按输出通道，这里统一展开到每个输出通道
+ */
+struct QLinearConvQuantParam {
+  float x_scale_ = 1.0f;
+  int32_t x_zero_point_ = 0;
+  std::vector<float> w_scale_;
+  std::vector<int32_t> w_zero_point_;
+  float y_scale_ = 1.0f;
+  int32_t y_zero_point_ = 0;
+};
+
+/**
+ * @brief QLinearConv 参考实现
+ * @note
+ * # x/w/y 各自可以是int8或uint8，y的类型与y_zero_point相同，bias为int32
+ * # 支持group与按输出通道的w_scale/w_zero_point
+ * # 整数累加后按输出通道的 x_scale * w_scale / y_scale 重量化，
+ *   四舍五入(ties to even)后加上y_zero_point并饱和
+ */
 class OpQLinearConv : public Op {
  public:
+  virtual base::Status inferDataType();
+
   virtual base::Status inferShape();
 
   virtual base::Status run();
 
+ protected:
+  /**
+   * @brief 检查输入输出的数据类型与量化参数的形状，并展开量化参数
+   */
+  base::Status getQuantParam(QLinearConvQuantParam& quant_param);
+
  private:
-  template <typename T>
-  base::Status qLinearConvImpl(device::Tensor* x, device::Tensor* x_scale,
-                               device::Tensor* x_zero_point, device::Tensor* w,
-                               device::Tensor* w_scale,
-                               device::Tensor* w_zero_point,
-                               device::Tensor* y_scale,
-                               device::Tensor* y_zero_point, device::Tensor* B,
-                               void* output_data);
+  base::Status qLinearConvImpl(const QLinearConvQuantParam& quant_param);
 };
 
 NNDEPLOY_CC_API base::Status qLinearConv(
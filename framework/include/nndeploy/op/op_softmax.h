@@ -16,6 +16,14 @@ class OpSoftmax : public Op {
   virtual base::Status inferShape();
 
   virtual base::Status run();
+
+ private:
+  template <typename T>
+  base::Status runImpl();
+
+ private:
+  // 非fp32时一个切片的输入与输出
+  std::vector<float> buffer_;
 };
 
 NNDEPLOY_CC_API base::Status softmax(device::Tensor *input,
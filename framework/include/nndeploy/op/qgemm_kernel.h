@@ -0,0 +1,94 @@
+
+#ifndef _NNDEPLOY_OP_QGEMM_KERNEL_H_
+#define _NNDEPLOY_OP_QGEMM_KERNEL_H_
+
+#include "nndeploy/base/common.h"
+#include "nndeploy/base/glic_stl_include.h"
+#include "nndeploy/base/log.h"
+#include "nndeploy/base/macro.h"
+#include "nndeploy/base/status.h"
+
+namespace nndeploy {
+namespace op {
+
+/**
+ * @brief 计算 C[mr x nr] (+)= A_panel * B_panel，A为s8，B为u8，int32累加
+ * @param k4 累加维度按4个一组的组数(打包时k补零到4的倍数)
+ * @param a 打包后的A微面板，每组有mr行，每行4个连续的k
+ * @param b 打包后的B微面板，每组有nr列，每列4个连续的k
+ * @param c 输出，行主序，行跨度为ldc
+ * @param accumulate 为true时累加到c上，否则直接覆盖
+ * @note 4个k一组与vpdpbusd(u8 x s8 -> s32)的操作数布局一致
+ */
+typedef void (*QgemmMicroKernelFunc)(int k4, const int8_t *a,
+                                     const uint8_t *b, int32_t *c, int ldc,
+                                     bool accumulate);
+
+/**
+ * @brief 寄存器分块的int8微核
+ * @note 各架构在自己的目录下按cpu特性注册，运行时选择priority_最高的微核
+ */
+struct NNDEPLOY_CC_API QgemmMicroKernel {
+  QgemmMicroKernel() {}
+  QgemmMicroKernel(const std::string &name, int mr, int nr,
+                   QgemmMicroKernelFunc func, int priority)
+      : name_(name), mr_(mr), nr_(nr), func_(func), priority_(priority) {}
+
+  std::string name_;
+  int mr_ = 0;
+  int nr_ = 0;
+  QgemmMicroKernelFunc func_ = nullptr;
+  int priority_ = 0;
+};
+
+extern NNDEPLOY_CC_API void registerQgemmMicroKernel(
+    const QgemmMicroKernel &kernel);
+
+/**
+ * @brief 当前cpu上可用的最优微核，标量实现保底
+ * @note 返回已注册的最优微核，每次注册时更新，调用方不要跨调用缓存
+ */
+extern NNDEPLOY_CC_API const QgemmMicroKernel &getQgemmMicroKernel();
+
+/**
+ * @brief 打包后k的长度
+ */
+inline int qgemmPaddedK(int k) { return (k + 3) / 4 * 4; }
+
+/**
+ * @brief 打包A：[m x k] 行主序的s8 -> mr行一组的微面板
+ * @note
+ * # 不足mr的行与补齐到4的倍数的k都补零
+ * # dst的大小为 round_up(m, mr) * qgemmPaddedK(k)，第i0行所在的微面板从
+ *   dst + i0 * qgemmPaddedK(k) 开始
+ */
+extern NNDEPLOY_CC_API void packQgemmA(const int8_t *a, int lda, int m, int k,
+                                       int mr, int8_t *dst);
+
+/**
+ * @brief 打包B：[k x n] 行主序的u8 -> nr列一组的微面板
+ * @note
+ * # 不足nr的列与补齐到4的倍数的k都补零
+ * # dst的大小为 round_up(n, nr) * qgemmPaddedK(k)
+ * # col_sum不为nullptr时输出每列的和，供零点修正使用
+ */
+extern NNDEPLOY_CC_API void packQgemmB(const uint8_t *b, int ldb, int k,
+                                       int n, int nr, uint8_t *dst,
+                                       int32_t *col_sum);
+
+/**
+ * @brief C = A * B，A为packQgemmA打包后的s8，B为[k x n]行主序的u8，C为int32
+ * @note
+ * # 零点与重量化由调用方处理：对A、B的零点，
+ *   sum((a - za) * (b - zb)) = A * B - za * col_sum(B) - zb * row_sum(A)
+ *   + k * za * zb
+ * # 按输出列块通过thread_pool::parallelFor多线程执行
+ */
+extern NNDEPLOY_CC_API void qgemm(int m, int n, int k, const int8_t *packed_a,
+                                  const uint8_t *b, int ldb, int32_t *c,
+                                  int ldc);
+
+}  // namespace op
+}  // namespace nndeploy
+
+#endif /* _NNDEPLOY_OP_QGEMM_KERNEL_H_ */
@@ -0,0 +1,70 @@
+
+#ifndef _NNDEPLOY_OP_TYPE_DISPATCH_H_
+#define _NNDEPLOY_OP_TYPE_DISPATCH_H_
+
+#include "nndeploy/base/common.h"
+#include "nndeploy/base/glic_stl_include.h"
+#include "nndeploy/base/half.h"
+#include "nndeploy/base/half.hpp"
+#include "nndeploy/base/log.h"
+#include "nndeploy/base/macro.h"
+#include "nndeploy/base/status.h"
+#include "nndeploy/op/elementwise_kernel.h"
+
+namespace nndeploy {
+namespace op {
+
+/**
+ * @brief 按块读取为fp32，T为float时直接返回src，否则转换到buffer中
+ * @note 转换使用getElementwiseKernel中按cpu特性注册的实现(F16C/AVX512-BF16等)
+ */
+template <typename T>
+inline const float *loadAsFloat(const T *src, float *buffer, int n) {
+  if (std::is_same<T, float>::value) {
+    return reinterpret_cast<const float *>(src);
+  }
+  getElementwiseLoadFunc(base::dataTypeOf<T>())(src, buffer, n);
+  return buffer;
+}
+
+/**
+ * @brief 把fp32的块写回为T，src与dst为同一块内存(T为float)时不做任何事
+ */
+template <typename T>
+inline void storeFromFloat(const float *src, T *dst, int n) {
+  if (static_cast<const void *>(src) == static_cast<const void *>(dst)) {
+    return;
+  }
+  getElementwiseStoreFunc(base::dataTypeOf<T>())(src, dst, n);
+}
+
+template <typename T>
+struct TypeTag {
+  typedef T type;
+};
+
+/**
+ * @brief 浮点数据类型(fp32/fp16/bf16)到模板实例的分发
+ * @note
+ * # 调用func(TypeTag<T>())，func通常为泛型lambda，在其中调用模板化的实现
+ * # 其他数据类型返回kStatusCodeErrorNotSupport
+ */
+template <typename Func>
+base::Status dispatchFloatDataType(const base::DataType &data_type,
+                                   Func &&func) {
+  if (data_type == base::dataTypeOf<float>()) {
+    return func(TypeTag<float>());
+  } else if (data_type == base::dataTypeOf<half_float::half>()) {
+    return func(TypeTag<half_float::half>());
+  } else if (data_type == base::dataTypeOf<base::bfp16_t>()) {
+    return func(TypeTag<base::bfp16_t>());
+  }
+  NNDEPLOY_LOGE("data type %s is not supported.\n",
+                base::dataTypeToString(data_type).c_str());
+  return base::kStatusCodeErrorNotSupport;
+}
+
+}  // namespace op
+}  // namespace nndeploy
+
+#endif /* _NNDEPLOY_OP_TYPE_DISPATCH_H_ */
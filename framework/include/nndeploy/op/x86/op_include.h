@@ -0,0 +1,36 @@
+#ifndef _NNDEPLOY_OP_X86_OP_INCLUDE_H_
+#define _NNDEPLOY_OP_X86_OP_INCLUDE_H_
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#include <immintrin.h>
+
+/**
+ * @brief 按函数粒度开启指令集
+ * @note
+ * # 框架整体不加 -mavx2/-mavx512f 编译选项，保证在老cpu上可以加载
+ * # 用到avx2/avx512 intrinsics的函数需要加上对应的target属性
+ * # 具体走哪条路径由运行时的cpu特性检测决定
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define NNDEPLOY_X86_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define NNDEPLOY_X86_TARGET_AVX512 \
+  __attribute__((target("avx512f,avx2,fma")))
+#define NNDEPLOY_X86_TARGET_F16C __attribute__((target("avx2,fma,f16c")))
+#define NNDEPLOY_X86_TARGET_AVX512_BF16 \
+  __attribute__((target("avx512bf16,avx512bw,avx512f,avx2,fma")))
+#define NNDEPLOY_X86_TARGET_AVX_VNNI \
+  __attribute__((target("avxvnni,avx2,fma")))
+#define NNDEPLOY_X86_TARGET_AVX512_VNNI \
+  __attribute__((target("avx512vnni,avx512bw,avx512f,avx2,fma")))
+#else
+#define NNDEPLOY_X86_TARGET_AVX2
+#define NNDEPLOY_X86_TARGET_AVX512
+#define NNDEPLOY_X86_TARGET_F16C
+#define NNDEPLOY_X86_TARGET_AVX512_BF16
+#define NNDEPLOY_X86_TARGET_AVX_VNNI
+#define NNDEPLOY_X86_TARGET_AVX512_VNNI
+#endif
+
+#endif /* _NNDEPLOY_OP_X86_OP_INCLUDE_H_ */
@@ -0,0 +1,35 @@
+#ifndef _NNDEPLOY_OP_X86_OP_UTIL_H_
+#define _NNDEPLOY_OP_X86_OP_UTIL_H_
+
+#include "nndeploy/base/common.h"
+#include "nndeploy/base/log.h"
+#include "nndeploy/base/macro.h"
+#include "nndeploy/base/status.h"
+#include "nndeploy/op/x86/op_include.h"
+
+namespace nndeploy {
+namespace op {
+
+/**
+ * @brief x86 cpu 支持的最高向量指令集
+ */
+enum X86IsaType : int {
+  kX86IsaTypeNone = 0x0000,
+  kX86IsaTypeAvx2,  // avx2 + fma
+  kX86IsaTypeAvx512,
+};
+
+/**
+ * @brief 运行时检测cpu特性，结果只计算一次
+ *
+ * @return X86IsaType
+ * @note 可通过环境变量 NNDEPLOY_X86_ISA=none/avx2/avx512 降级，便于对比测试
+ */
+NNDEPLOY_CC_API X86IsaType getX86IsaType();
+
+NNDEPLOY_CC_API std::string x86IsaTypeToString(X86IsaType isa);
+
+}  // namespace op
+}  // namespace nndeploy
+
+#endif /* _NNDEPLOY_OP_X86_OP_UTIL_H_ */
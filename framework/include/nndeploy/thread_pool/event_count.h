@@ -0,0 +1,87 @@
+
+#ifndef _NNDEPLOY_THREAD_POOL_EVENT_COUNT_H_
+#define _NNDEPLOY_THREAD_POOL_EVENT_COUNT_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace nndeploy {
+namespace thread_pool {
+
+/**
+ * @brief eventcount，用于空闲线程的休眠与唤醒
+ * @note
+ * # 等待方：key = prepareWait() -> 再检查一次条件 -> cancelWait()或commitWait(key)
+ * # 通知方：先让条件成立（如入队），再notify()
+ * # 在prepareWait之后发生的notify一定会让commitWait返回，不会丢失唤醒；
+ *   没有等待者时notify只有一次原子操作，不加锁
+ */
+class EventCount {
+ public:
+  typedef uint32_t Key;
+
+  EventCount() = default;
+  EventCount(const EventCount &) = delete;
+  EventCount &operator=(const EventCount &) = delete;
+
+  Key prepareWait() {
+    uint64_t prev = state_.fetch_add(kAddWaiter, std::memory_order_acq_rel);
+    return static_cast<Key>(prev >> kEpochShift);
+  }
+
+  void cancelWait() {
+    state_.fetch_sub(kAddWaiter, std::memory_order_seq_cst);
+  }
+
+  void commitWait(Key key) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      while (epoch() == key) {
+        cv_.wait(lock);
+      }
+    }
+    state_.fetch_sub(kAddWaiter, std::memory_order_seq_cst);
+  }
+
+  void notify() { doNotify(false); }
+
+  void notifyAll() { doNotify(true); }
+
+ private:
+  Key epoch() const {
+    return static_cast<Key>(state_.load(std::memory_order_acquire) >>
+                            kEpochShift);
+  }
+
+  void doNotify(bool all) {
+    uint64_t prev = state_.fetch_add(kAddEpoch, std::memory_order_acq_rel);
+    if ((prev & kWaiterMask) == 0) {
+      return;
+    }
+    // 加锁保证等待方要么还没检查epoch，要么已经在cv上等待
+    { std::lock_guard<std::mutex> lock(mutex_); }
+    if (all) {
+      cv_.notify_all();
+    } else {
+      cv_.notify_one();
+    }
+  }
+
+ private:
+  static const uint64_t kAddWaiter = 1;
+  static const uint64_t kWaiterMask = 0xffffffff;
+  static const int kEpochShift = 32;
+  static const uint64_t kAddEpoch = uint64_t(1) << kEpochShift;
+
+  // 高32位为epoch，低32位为等待者数量
+  std::atomic<uint64_t> state_{0};
+  std::mutex mutex_;
+  std::condition_variable cv_;
+};
+
+}  // namespace thread_pool
+}  // namespace nndeploy
+
+#endif  //_NNDEPLOY_THREAD_POOL_EVENT_COUNT_H_
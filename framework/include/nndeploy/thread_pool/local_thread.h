@@ -2,27 +2,48 @@
 #ifndef _NNDEPLOY_THREAD_POOL_LOCAL_THREAD_H_
 #define _NNDEPLOY_THREAD_POOL_LOCAL_THREAD_H_
 
+#include <atomic>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <thread>
 
 #include "nndeploy/base/status.h"
+#include "nndeploy/thread_pool/event_count.h"
+#include "nndeploy/thread_pool/parallel.h"
 #include "nndeploy/thread_pool/runnable_task.h"
-#include "nndeploy/thread_pool/safe_ws_queue.h"
+#include "nndeploy/thread_pool/work_stealing_queue.h"
 
 namespace nndeploy {
 namespace thread_pool {
 
+/**
+ * @brief 线程池中的工作线程
+ * @note
+ * # primary_queue_为无锁工作窃取队列，只有本线程push/pop，其他线程steal
+ * # 外部线程提交的任务先放入inbox_，由本线程搬到primary_queue_，或被空闲线程直接窃取
+ * # 没有任务时先短暂自旋，再通过线程池共享的EventCount休眠，入队后立即唤醒
+ * # cpu_id_不小于0时，线程启动后绑定到该cpu上
+ */
 class LocalThread {
  public:
   explicit LocalThread() {
     done_ = true;
     pool_threads_ = nullptr;
+    event_count_ = nullptr;
     index_ = -1;
+    cpu_id_ = -1;
     total_thread_size_ = 0;
   }
 
   ~LocalThread() { destroy(); }
 
+  /**
+   * 通知线程退出，线程会先执行完已入队的任务
+   * @return
+   */
+  void stop() { done_ = false; }
+
   /**
    * 所有线程类的 destroy 函数应该是一样的
    * 但是init函数不一样，因为线程构造函数不同
@@ -30,6 +51,9 @@ class LocalThread {
    */
   void destroy() {
     done_ = false;
+    if (event_count_ != nullptr) {
+      event_count_->notifyAll();
+    }
     if (thread_.joinable()) {
       thread_.join();  // 等待线程结束
     }
@@ -46,12 +70,44 @@ class LocalThread {
     thread_ = std::move(std::thread(&LocalThread::run, this));
   }
 
-  void setThreadPoolInfo(int index, std::vector<LocalThread *> *pool_threads) {
+  void setThreadPoolInfo(int index, std::vector<LocalThread *> *pool_threads,
+                         EventCount *event_count) {
     index_ = index;
     pool_threads_ = pool_threads;
+    event_count_ = event_count;
     total_thread_size_ = (int)pool_threads->size();
   }
 
+  void setCpuId(int cpu_id) { cpu_id_ = cpu_id; }
+
+  /**
+   * 当前负载：队列中的任务数，加上正在执行的任务
+   * @return
+   */
+  int getLoad() const {
+    return (int)primary_queue_.size() +
+           inbox_size_.load(std::memory_order_relaxed) +
+           (busy_.load(std::memory_order_relaxed) ? 1 : 0);
+  }
+
+  /**
+   * 当前线程所在的工作线程，不在线程池中时为nullptr
+   * @return
+   */
+  static LocalThread *&current() {
+    static thread_local LocalThread *local_thread = nullptr;
+    return local_thread;
+  }
+
+  /**
+   * 是否属于给定的线程池
+   * @param pool_threads
+   * @return
+   */
+  bool isInPool(const std::vector<LocalThread *> *pool_threads) const {
+    return pool_threads_ == pool_threads;
+  }
+
   /**
    * 线程执行函数
    * @return
@@ -61,29 +117,57 @@ class LocalThread {
                     [](LocalThread *thd) { return nullptr == thd; })) {
       return base::Status(base::kStatusCodeErrorThreadPool);
     }
+    current() = this;
+    if (cpu_id_ >= 0 && !bindCurrentThreadToCpu(cpu_id_)) {
+      NNDEPLOY_LOGI("thread[%d] bind to cpu[%d] failed.\n", index_, cpu_id_);
+    }
 
-    while (done_) {
+    while (true) {
       RTask task;
-      if (popTask(task) || stealTask(task)) {
-        task();
-      } else {
-        std::unique_lock<std::mutex> lk(mutex_);
-        cv_.wait_for(lk, std::chrono::milliseconds(100));
+      if (getTask(task)) {
+        runTask(task);
+        continue;
+      }
+      // 短暂自旋，连续的小任务不必进入休眠
+      bool found = false;
+      for (int i = 0; i < kSpinCount && !found; ++i) {
+        std::this_thread::yield();
+        found = getTask(task);
       }
+      if (found) {
+        runTask(task);
+        continue;
+      }
+      EventCount::Key key = event_count_->prepareWait();
+      if (getTask(task)) {
+        event_count_->cancelWait();
+        runTask(task);
+        continue;
+      }
+      if (!done_) {
+        event_count_->cancelWait();
+        break;
+      }
+      event_count_->commitWait(key);
     }
+    current() = nullptr;
     return base::Status();
   }
 
   /**
-   * 依次push到任一队列里。如果都失败，则yield，然后重新push
+   * 提交任务。本线程提交时直接进入无锁队列，其他线程提交时放入inbox_
    * @param task
    * @return
    */
   void pushTask(RTask &&task) {
-    while (!(primary_queue_.tryPush(std::forward<RTask>(task)))) {
-      std::this_thread::yield();
+    if (current() == this) {
+      primary_queue_.push(std::move(task));
+    } else {
+      std::lock_guard<std::mutex> lock(inbox_mutex_);
+      inbox_.emplace_back(std::move(task));
+      inbox_size_.fetch_add(1, std::memory_order_release);
     }
-    cv_.notify_one();
+    event_count_->notify();
   }
 
   /**
@@ -91,7 +175,12 @@ class LocalThread {
    * @param task
    * @return
    */
-  bool popTask(RTask &task) { return primary_queue_.tryPop(task); }
+  bool popTask(RTask &task) {
+    if (primary_queue_.pop(task)) {
+      return true;
+    }
+    return drainInbox(task);
+  }
 
   /**
    * 从其他线程窃取一个任务
@@ -99,13 +188,13 @@ class LocalThread {
    * @return
    */
   bool stealTask(RTask &task) {
-    if (pool_threads_->size() < total_thread_size_) {
+    if ((int)pool_threads_->size() < total_thread_size_) {
       return false;
     }
 
     for (auto &target : steal_targets_) {
-      if (((*pool_threads_)[target]) ||
-          ((*pool_threads_)[target])->primary_queue_.trySteal(task)) {
+      LocalThread *thread = (*pool_threads_)[target];
+      if (thread != nullptr && thread->trySteal(task)) {
         return true;
       }
     }
@@ -113,16 +202,84 @@ class LocalThread {
     return false;
   }
 
+  /**
+   * 其他线程从本线程窃取一个任务
+   * @param task
+   * @return
+   */
+  bool trySteal(RTask &task) {
+    return primary_queue_.steal(task) || stealInbox(task);
+  }
+
+  bool getTask(RTask &task) { return popTask(task) || stealTask(task); }
+
+ protected:
+  void runTask(RTask &task) {
+    busy_.store(true, std::memory_order_relaxed);
+    task();
+    busy_.store(false, std::memory_order_relaxed);
+  }
+
+  /**
+   * 把inbox_中的任务搬到无锁队列，返回其中最早提交的一个
+   * @param task
+   * @return
+   */
+  bool drainInbox(RTask &task) {
+    if (inbox_size_.load(std::memory_order_acquire) == 0) {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(inbox_mutex_);
+    if (inbox_.empty()) {
+      return false;
+    }
+    task = std::move(inbox_.front());
+    inbox_.pop_front();
+    // 逆序压入，使本线程按提交顺序从bottom端弹出
+    while (!inbox_.empty()) {
+      primary_queue_.push(std::move(inbox_.back()));
+      inbox_.pop_back();
+    }
+    inbox_size_.store(0, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * 其他线程直接从inbox_窃取。这里必须加锁而不是try_lock：
+   * 被唤醒的线程可能是唯一醒着的线程，放弃会导致任务滞留
+   * @param task
+   * @return
+   */
+  bool stealInbox(RTask &task) {
+    if (inbox_size_.load(std::memory_order_acquire) == 0) {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(inbox_mutex_);
+    if (inbox_.empty()) {
+      return false;
+    }
+    task = std::move(inbox_.front());
+    inbox_.pop_front();
+    inbox_size_.fetch_sub(1, std::memory_order_release);
+    return true;
+  }
+
  protected:
-  bool done_;
+  static const int kSpinCount = 64;
+
+  std::atomic<bool> done_;
   std::thread thread_;
   int index_;
+  int cpu_id_;
   int total_thread_size_;
-  SafeWSQueue<RTask> primary_queue_;
+  std::atomic<bool> busy_{false};
+  WorkStealingQueue<RTask> primary_queue_;
+  std::deque<RTask> inbox_;
+  std::mutex inbox_mutex_;
+  std::atomic<int> inbox_size_{0};
   std::vector<LocalThread *> *pool_threads_;
+  EventCount *event_count_;
   std::vector<int> steal_targets_;
-  std::mutex mutex_;
-  std::condition_variable cv_;
 };
 
 }  // namespace thread_pool
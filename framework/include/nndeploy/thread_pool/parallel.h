@@ -25,14 +25,23 @@ class NNDEPLOY_CC_API ParallelLoopBody {
   virtual void operator()(const base::Range &range) const = 0;
 };
 
+/**
+ * @brief 默认线程数，为硬件线程数，可通过环境变量NNDEPLOY_THREAD_NUM修改
+ */
 extern NNDEPLOY_CC_API int defaultNumberOfThreads();
 
+/**
+ * @brief 把调用线程绑定到指定cpu上，不支持的平台返回false
+ */
+extern NNDEPLOY_CC_API bool bindCurrentThreadToCpu(int cpu_id);
+
 extern NNDEPLOY_CC_API void setThreadNum(int num);
 
 extern NNDEPLOY_CC_API int getThreadNum();
 
 /**
  * @brief Parallel data processor
+ * @note 在共享线程池上执行，调用线程也参与计算；可在线程池任务或body中嵌套调用
  */
 extern NNDEPLOY_CC_API void parallelFor(const base::Range &range,
                                         const ParallelLoopBody &body,
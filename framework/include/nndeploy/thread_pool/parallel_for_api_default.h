@@ -8,47 +8,16 @@
 namespace nndeploy {
 namespace thread_pool {
 
-class ParallelJob;
-class WorkerThread;
-
-class ParallelPool {
- public:
-  static ParallelPool &getInstance() {
-    static ParallelPool *instance = new ParallelPool;
-    return *instance;
-  }
-
-  ParallelPool();
-
-  ~ParallelPool();
-
-  void setThreadNum(int num);
-
-  int getThreadNum() const;
-
-  void parallelFor(const base::Range &range, const ParallelLoopBody &body,
-                   double nstripes);
-
-  void stop() { setWorkThreads(0); }
-
- private:
-  bool setWorkThreads(int num);
-
- public:
-  std::mutex mutex_notify_;
-  std::condition_variable job_complete_;
-
- private:
-  std::mutex pool_mutex_;
-  int thread_num_;
-  std::vector<std::shared_ptr<WorkerThread>> work_threads_;
-  std::shared_ptr<ParallelJob> job_ = nullptr;
-  const int active_wait_;
-};
-
+/**
+ * @brief 基于共享线程池getGlobalThreadPool()的parallelFor
+ * @note
+ * # range按块切分，调用线程与线程池中的辅助任务通过原子计数领取块
+ * # 调用线程只等待已被领取的块，尚未开始的辅助任务领不到块直接返回，
+ *   因此在线程池任务中嵌套调用也不会死锁
+ */
 class ParallelForApiDefault : public ParallelForApi {
  public:
-  ParallelForApiDefault() = default;
+  ParallelForApiDefault();
 
   virtual ~ParallelForApiDefault() = default;
 
@@ -58,9 +27,13 @@ class ParallelForApiDefault : public ParallelForApi {
 
   virtual int parallelFor(const base::Range &range,
                           const ParallelLoopBody &body, double nstripes = -1.0);
+
+ private:
+  // 参与一次parallelFor的最大线程数，包括调用线程
+  std::atomic<int> thread_num_;
 };
 
 }  // namespace thread_pool
 }  // namespace nndeploy
 
-#endif /* _NNDEPLOY_THREAD_POOL_PARALLEL_FOR_API_H_ */
+#endif /* _NNDEPLOY_THREAD_POOL_PARALLEL_FOR_API_DEFAULT_H_ */
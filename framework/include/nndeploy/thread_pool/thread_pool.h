@@ -7,23 +7,44 @@
 #include <thread>
 
 #include "nndeploy/base/status.h"
+#include "nndeploy/thread_pool/event_count.h"
 #include "nndeploy/thread_pool/local_thread.h"
 #include "nndeploy/thread_pool/runnable_task.h"
-#include "nndeploy/thread_pool/safe_ws_queue.h"
 
 namespace nndeploy {
 namespace thread_pool {
+
+/**
+ * @brief 工作窃取线程池
+ * @note
+ * # 外部提交的任务放到当前负载最小的线程上，线程池内部提交的任务留在本线程
+ * # 可选地把工作线程绑定到指定cpu上，需在init之前调用setCpuAffinity
+ * # 进程内共享的线程池通过getGlobalThreadPool获取
+ */
 class NNDEPLOY_CC_API ThreadPool {
  public:
-  explicit ThreadPool(int size = 4) { max_thread_size_ = size; }
+  explicit ThreadPool(int size = 4) { max_thread_size_ = std::max(size, 1); }
+
+  /**
+   * 工作线程i绑定到cpu_ids[i % cpu_ids.size()]，为空则不绑定
+   * @param cpu_ids
+   */
+  void setCpuAffinity(const std::vector<int> &cpu_ids) { cpu_ids_ = cpu_ids; }
+
+  int getThreadNum() const { return max_thread_size_; }
 
   base::Status init() {
     for (int i = 0; i < max_thread_size_; i++) {
       auto ptr = new LocalThread();  // 创建核心线程数
-      ptr->setThreadPoolInfo(i, &threads_);
-      // ptr->init();
       threads_.emplace_back(ptr);
     }
+    // 所有线程创建完成后再设置，保证每个线程都能从其余所有线程窃取
+    for (int i = 0; i < max_thread_size_; i++) {
+      threads_[i]->setThreadPoolInfo(i, &threads_, &event_count_);
+      if (!cpu_ids_.empty()) {
+        threads_[i]->setCpuId(cpu_ids_[i % cpu_ids_.size()]);
+      }
+    }
     for (int i = 0; i < max_thread_size_; i++) {
       threads_[i]->init();
     }
@@ -32,10 +53,18 @@ class NNDEPLOY_CC_API ThreadPool {
   }
 
   base::Status destroy() {
+    // 先通知所有线程退出再统一唤醒；全部join后再释放，其他线程可能仍在窃取
+    for (auto &pt : threads_) {
+      pt->stop();
+    }
+    event_count_.notifyAll();
     for (auto &pt : threads_) {
       pt->destroy();
+    }
+    for (auto &pt : threads_) {
       delete pt;
     }
+    threads_.clear();
 
     return base::Status();
   }
@@ -47,20 +76,90 @@ class NNDEPLOY_CC_API ThreadPool {
     std::packaged_task<ResultType()> task(func);
     std::future<ResultType> result(task.get_future());
 
-    cur_index_++;
-    if (cur_index_ >= max_thread_size_ || cur_index_ < 0) {
-      cur_index_ = 0;
+    // 线程池内部提交的任务留在本线程的无锁队列中，由空闲线程窃取
+    LocalThread *current = LocalThread::current();
+    if (current != nullptr && current->isInPool(&threads_)) {
+      current->pushTask(std::move(task));
+      return result;
     }
-    threads_[cur_index_]->pushTask(std::move(task));
+    threads_[selectThread()]->pushTask(std::move(task));
     return result;
   }
 
+  /**
+   * 当前线程是否为本线程池的工作线程
+   * @return
+   */
+  bool isWorkerThread() const {
+    LocalThread *current = LocalThread::current();
+    return current != nullptr && current->isInPool(&threads_);
+  }
+
+  /**
+   * 取一个待执行的任务在当前线程执行，没有任务时返回false
+   * 在工作线程中等待其他任务完成时调用，避免所有工作线程都阻塞在等待上
+   * @return
+   */
+  bool runPendingTask() {
+    RTask task;
+    LocalThread *current = LocalThread::current();
+    if (current != nullptr && current->isInPool(&threads_)) {
+      if (!current->getTask(task)) {
+        return false;
+      }
+    } else {
+      bool found = false;
+      for (auto &pt : threads_) {
+        if (pt->trySteal(task)) {
+          found = true;
+          break;
+        }
+      }
+      if (!found) {
+        return false;
+      }
+    }
+    task();
+    return true;
+  }
+
+ private:
+  /**
+   * 从轮询起点开始找负载最小的线程，起点轮转使负载相同时任务均匀分布
+   * @return
+   */
+  int selectThread() {
+    int start = cur_index_.fetch_add(1, std::memory_order_relaxed) + 1;
+    start = (int)((unsigned)start % (unsigned)max_thread_size_);
+    int best = start;
+    int best_load = threads_[start]->getLoad();
+    for (int i = 1; i < max_thread_size_ && best_load > 0; i++) {
+      int index = (start + i) % max_thread_size_;
+      int load = threads_[index]->getLoad();
+      if (load < best_load) {
+        best = index;
+        best_load = load;
+      }
+    }
+    return best;
+  }
+
  private:
   std::atomic<int> cur_index_{0};
   int max_thread_size_ = 0;
+  std::vector<int> cpu_ids_;
   std::vector<LocalThread *> threads_;
+  EventCount event_count_;
 };
 
+/**
+ * @brief 进程内共享的线程池，线程数为defaultNumberOfThreads()
+ * @note
+ * # 所有dag执行器与parallelFor共用，避免每个图各自创建线程导致超订
+ * # 环境变量NNDEPLOY_THREAD_AFFINITY=1时，工作线程依次绑定到各个cpu上
+ */
+extern NNDEPLOY_CC_API ThreadPool *getGlobalThreadPool();
+
 }  // namespace thread_pool
 }  // namespace nndeploy
 
@@ -0,0 +1,168 @@
+
+#ifndef _NNDEPLOY_THREAD_POOL_WORK_STEALING_QUEUE_H_
+#define _NNDEPLOY_THREAD_POOL_WORK_STEALING_QUEUE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace nndeploy {
+namespace thread_pool {
+
+/**
+ * @brief Chase-Lev 无锁工作窃取队列
+ * @note
+ * # push/pop只能由队列所属线程调用，从bottom端进出（LIFO，缓存友好）
+ * # steal可由任意线程调用，从top端取（FIFO）
+ * # 容量不足时所属线程扩容为两倍，旧数组保留到队列析构，避免窃取线程访问已释放内存
+ * # 实现参考 Lê et al. "Correct and Efficient Work-Stealing for Weak Memory
+ *   Models"
+ */
+template <typename T>
+class WorkStealingQueue {
+ public:
+  explicit WorkStealingQueue(int64_t capacity = 64) {
+    int64_t size = 1;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    Array *array = new Array(size);
+    garbage_.emplace_back(array);
+    array_.store(array, std::memory_order_relaxed);
+  }
+
+  ~WorkStealingQueue() {
+    T *item = nullptr;
+    while ((item = popItem()) != nullptr) {
+      delete item;
+    }
+  }
+
+  WorkStealingQueue(const WorkStealingQueue &) = delete;
+  WorkStealingQueue &operator=(const WorkStealingQueue &) = delete;
+
+  /**
+   * @brief 所属线程压入任务
+   */
+  void push(T &&task) {
+    T *item = new T(std::move(task));
+    int64_t b = bottom_.load(std::memory_order_relaxed);
+    int64_t t = top_.load(std::memory_order_acquire);
+    Array *array = array_.load(std::memory_order_relaxed);
+    if (b - t > array->size_ - 1) {
+      array = grow(array, b, t);
+    }
+    array->put(b, item);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief 所属线程弹出最近压入的任务
+   */
+  bool pop(T &task) {
+    T *item = popItem();
+    if (item == nullptr) {
+      return false;
+    }
+    task = std::move(*item);
+    delete item;
+    return true;
+  }
+
+  /**
+   * @brief 其他线程窃取最早压入的任务，与其他窃取者竞争失败时返回false
+   */
+  bool steal(T &task) {
+    int64_t t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom_.load(std::memory_order_acquire);
+    if (t >= b) {
+      return false;
+    }
+    Array *array = array_.load(std::memory_order_acquire);
+    T *item = array->get(t);
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return false;
+    }
+    task = std::move(*item);
+    delete item;
+    return true;
+  }
+
+  bool empty() const {
+    int64_t b = bottom_.load(std::memory_order_relaxed);
+    int64_t t = top_.load(std::memory_order_relaxed);
+    return b <= t;
+  }
+
+  int64_t size() const {
+    int64_t b = bottom_.load(std::memory_order_relaxed);
+    int64_t t = top_.load(std::memory_order_relaxed);
+    return b > t ? b - t : 0;
+  }
+
+ private:
+  struct Array {
+    explicit Array(int64_t size)
+        : size_(size), mask_(size - 1), items_(new std::atomic<T *>[size]) {}
+
+    T *get(int64_t index) const {
+      return items_[index & mask_].load(std::memory_order_relaxed);
+    }
+    void put(int64_t index, T *item) {
+      items_[index & mask_].store(item, std::memory_order_relaxed);
+    }
+
+    int64_t size_;
+    int64_t mask_;
+    std::unique_ptr<std::atomic<T *>[]> items_;
+  };
+
+  T *popItem() {
+    int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    Array *array = array_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top_.load(std::memory_order_relaxed);
+    if (t > b) {
+      // 队列为空
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    T *item = array->get(b);
+    if (t == b) {
+      // 只剩最后一个元素，与窃取者竞争
+      if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                        std::memory_order_relaxed)) {
+        item = nullptr;
+      }
+      bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return item;
+  }
+
+  Array *grow(Array *array, int64_t b, int64_t t) {
+    Array *bigger = new Array(array->size_ * 2);
+    for (int64_t i = t; i < b; ++i) {
+      bigger->put(i, array->get(i));
+    }
+    garbage_.emplace_back(bigger);
+    array_.store(bigger, std::memory_order_release);
+    return bigger;
+  }
+
+ private:
+  // top_与bottom_分别被窃取者与所属线程频繁修改，放在不同缓存行
+  alignas(64) std::atomic<int64_t> top_{0};
+  alignas(64) std::atomic<int64_t> bottom_{0};
+  alignas(64) std::atomic<Array *> array_{nullptr};
+  std::vector<std::unique_ptr<Array>> garbage_;
+};
+
+}  // namespace thread_pool
+}  // namespace nndeploy
+
+#endif  //_NNDEPLOY_THREAD_POOL_WORK_STEALING_QUEUE_H_
@@ -0,0 +1,192 @@
+#include "nndeploy/base/mapped_file.h"
+
+#include "nndeploy/base/log.h"
+
+#if NNDEPLOY_OS_WINDOWS
+#undef NOMINMAX
+#define NOMINMAX
+#include <windows.h>
+#elif NNDEPLOY_OS_UNIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+namespace nndeploy {
+namespace base {
+
+size_t getPageSize() {
+#if NNDEPLOY_OS_WINDOWS
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return (size_t)info.dwPageSize;
+#elif NNDEPLOY_OS_UNIX
+  long page_size = sysconf(_SC_PAGESIZE);
+  return page_size > 0 ? (size_t)page_size : 4096;
+#else
+  return 4096;
+#endif
+}
+
+MappedFile::MappedFile() {}
+
+MappedFile::~MappedFile() { close(); }
+
+base::Status MappedFile::open(const std::string &path) {
+  close();
+#if NNDEPLOY_OS_WINDOWS
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    NNDEPLOY_LOGE("open file[%s] failed.\n", path.c_str());
+    return base::kStatusCodeErrorIO;
+  }
+  LARGE_INTEGER file_size;
+  if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+    NNDEPLOY_LOGE("file[%s] is empty.\n", path.c_str());
+    CloseHandle(file);
+    return base::kStatusCodeErrorIO;
+  }
+  HANDLE mapping =
+      CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mapping == nullptr) {
+    NNDEPLOY_LOGE("map file[%s] failed.\n", path.c_str());
+    CloseHandle(file);
+    return base::kStatusCodeErrorIO;
+  }
+  void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (data == nullptr) {
+    NNDEPLOY_LOGE("map file[%s] failed.\n", path.c_str());
+    CloseHandle(mapping);
+    CloseHandle(file);
+    return base::kStatusCodeErrorIO;
+  }
+  file_handle_ = file;
+  mapping_handle_ = mapping;
+  data_ = (uint8_t *)data;
+  size_ = (size_t)file_size.QuadPart;
+#elif NNDEPLOY_OS_UNIX
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    NNDEPLOY_LOGE("open file[%s] failed.\n", path.c_str());
+    return base::kStatusCodeErrorIO;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    NNDEPLOY_LOGE("file[%s] is empty.\n", path.c_str());
+    ::close(fd);
+    return base::kStatusCodeErrorIO;
+  }
+  // 只读共享映射，多个进程映射同一文件时共用page cache
+  void *data = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  // 映射建立后即可关闭文件描述符
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    NNDEPLOY_LOGE("mmap file[%s] failed.\n", path.c_str());
+    return base::kStatusCodeErrorIO;
+  }
+  data_ = (uint8_t *)data;
+  size_ = (size_t)st.st_size;
+#else
+  NNDEPLOY_LOGE("MappedFile is not supported on this platform.\n");
+  return base::kStatusCodeErrorNotSupport;
+#endif
+  path_ = path;
+  return base::kStatusCodeOk;
+}
+
+void MappedFile::close() {
+  if (data_ != nullptr) {
+#if NNDEPLOY_OS_WINDOWS
+    UnmapViewOfFile(data_);
+    CloseHandle((HANDLE)mapping_handle_);
+    CloseHandle((HANDLE)file_handle_);
+    mapping_handle_ = nullptr;
+    file_handle_ = nullptr;
+#elif NNDEPLOY_OS_UNIX
+    munmap(data_, size_);
+#endif
+  }
+  data_ = nullptr;
+  size_ = 0;
+  path_.clear();
+}
+
+bool MappedFile::isOpen() const { return data_ != nullptr; }
+const std::string &MappedFile::getPath() const { return path_; }
+const uint8_t *MappedFile::getData() const { return data_; }
+size_t MappedFile::getSize() const { return size_; }
+
+base::Status MappedFile::advise(size_t offset, size_t size,
+                                MappedFileAdvice advice) {
+  if (data_ == nullptr || offset >= size_) {
+    return base::kStatusCodeErrorInvalidParam;
+  }
+  size = std::min(size, size_ - offset);
+#if NNDEPLOY_OS_UNIX
+  // madvise要求起始地址按页对齐
+  size_t page_size = getPageSize();
+  size_t begin = offset / page_size * page_size;
+  size_t end = offset + size;
+  int flag = MADV_NORMAL;
+  switch (advice) {
+    case kMappedFileAdviceSequential:
+      flag = MADV_SEQUENTIAL;
+      break;
+    case kMappedFileAdviceRandom:
+      flag = MADV_RANDOM;
+      break;
+    case kMappedFileAdviceWillNeed:
+      flag = MADV_WILLNEED;
+      break;
+    case kMappedFileAdviceDontNeed:
+      flag = MADV_DONTNEED;
+      break;
+    default:
+      break;
+  }
+  if (madvise(data_ + begin, end - begin, flag) != 0) {
+    NNDEPLOY_LOGI("madvise file[%s] failed.\n", path_.c_str());
+    return base::kStatusCodeErrorIO;
+  }
+#endif
+  return base::kStatusCodeOk;
+}
+
+size_t MappedFile::getResidentSize(size_t offset, size_t size) const {
+  if (data_ == nullptr || offset >= size_) {
+    return 0;
+  }
+  size = std::min(size, size_ - offset);
+#if NNDEPLOY_OS_UNIX
+  size_t page_size = getPageSize();
+  size_t begin = offset / page_size * page_size;
+  size_t end = offset + size;
+  size_t page_num = (end - begin + page_size - 1) / page_size;
+#if NNDEPLOY_OS_DARWIN || NNDEPLOY_OS_IOS
+  std::vector<char> vec(page_num);
+#else
+  std::vector<unsigned char> vec(page_num);
+#endif
+  if (mincore(data_ + begin, end - begin, vec.data()) != 0) {
+    return 0;
+  }
+  size_t resident = 0;
+  for (size_t i = 0; i < page_num; ++i) {
+    if (vec[i] & 1) {
+      resident += page_size;
+    }
+  }
+  return std::min(resident, size_ - begin);
+#else
+  return size;
+#endif
+}
+
+size_t MappedFile::getResidentSize() const { return getResidentSize(0, size_); }
+
+}  // namespace base
+}  // namespace nndeploy
@@ -0,0 +1,387 @@
+#include "nndeploy/base/trace.h"
+
+#include "nndeploy/base/log.h"
+
+namespace nndeploy {
+namespace base {
+
+struct TraceEvent {
+  uint64_t start_ns_;
+  uint64_t end_ns_;
+  uint32_t name_id_;
+  uint16_t category_;
+  uint16_t depth_;
+};
+
+/**
+ * @brief 只由所属线程追加，size_用release写入，读者acquire读取后可以读[0, size_)
+ */
+struct TraceChunk {
+  static const size_t kCapacity = 4096;
+  TraceEvent events_[kCapacity];
+  std::atomic<size_t> size_{0};
+  std::atomic<TraceChunk *> next_{nullptr};
+};
+
+struct TraceOpen {
+  uint32_t name_id_;
+  uint16_t category_;
+  uint64_t start_ns_;
+};
+
+struct TraceBuffer {
+  explicit TraceBuffer(int tid)
+      : tid_(tid), thread_id_(std::this_thread::get_id()) {
+    head_ = new TraceChunk();
+    tail_ = head_;
+  }
+  ~TraceBuffer() {
+    TraceChunk *chunk = head_;
+    while (chunk != nullptr) {
+      TraceChunk *next = chunk->next_.load(std::memory_order_relaxed);
+      delete chunk;
+      chunk = next;
+    }
+  }
+
+  void push(const TraceEvent &event) {
+    size_t size = tail_->size_.load(std::memory_order_relaxed);
+    if (size == TraceChunk::kCapacity) {
+      TraceChunk *chunk = new TraceChunk();
+      tail_->next_.store(chunk, std::memory_order_release);
+      tail_ = chunk;
+      size = 0;
+    }
+    tail_->events_[size] = event;
+    tail_->size_.store(size + 1, std::memory_order_release);
+  }
+
+  int tid_;
+  std::thread::id thread_id_;
+  TraceChunk *head_;
+  TraceChunk *tail_;               // 只由所属线程访问
+  std::vector<TraceOpen> stack_;   // 只由所属线程访问
+};
+
+namespace {
+
+std::atomic<uint64_t> g_tracer_serial(0);
+
+struct ThreadBufferCache {
+  uint64_t serial_ = 0;
+  TraceBuffer *buffer_ = nullptr;
+};
+
+thread_local ThreadBufferCache t_buffer_cache;
+
+void escapeJson(std::ostream &stream, const std::string &str) {
+  for (char c : str) {
+    switch (c) {
+      case '"':
+        stream << "\\\"";
+        break;
+      case '\\':
+        stream << "\\\\";
+        break;
+      case '\n':
+        stream << "\\n";
+        break;
+      case '\t':
+        stream << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char buf[8];
+          snprintf(buf, sizeof(buf), "\\u%04x", c);
+          stream << buf;
+        } else {
+          stream << c;
+        }
+        break;
+    }
+  }
+}
+
+}  // namespace
+
+std::string traceCategoryToString(TraceCategory category) {
+  switch (category) {
+    case kTraceCategoryNode:
+      return "node";
+    case kTraceCategoryOp:
+      return "op";
+    case kTraceCategoryEdgeWait:
+      return "edge_wait";
+    case kTraceCategoryRuntime:
+      return "runtime";
+    case kTraceCategoryUser:
+      return "user";
+    default:
+      return "unknown";
+  }
+}
+
+Tracer::Tracer()
+    : enabled_(false),
+      reset_ns_(0),
+      epoch_(std::chrono::steady_clock::now()),
+      serial_(++g_tracer_serial) {
+  names_.emplace_back("");
+}
+
+Tracer::~Tracer() {}
+
+void Tracer::setEnabled(bool enabled) {
+  enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+uint32_t Tracer::intern(const std::string &name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = name_ids_.find(name);
+  if (iter != name_ids_.end()) {
+    return iter->second;
+  }
+  uint32_t name_id = static_cast<uint32_t>(names_.size());
+  names_.emplace_back(name);
+  name_ids_[name] = name_id;
+  return name_id;
+}
+
+std::string Tracer::getName(uint32_t name_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return name_id < names_.size() ? names_[name_id] : std::string();
+}
+
+void Tracer::begin(std::atomic<uint32_t> &name_id, const std::string &name,
+                   TraceCategory category) {
+  uint32_t id = name_id.load(std::memory_order_relaxed);
+  if (id == 0) {
+    id = intern(name);
+    name_id.store(id, std::memory_order_relaxed);
+  }
+  begin(id, category);
+}
+
+void Tracer::begin(uint32_t name_id, TraceCategory category) {
+  TraceBuffer *buffer = getThreadBuffer();
+  buffer->stack_.push_back(
+      {name_id, static_cast<uint16_t>(category), now()});
+}
+
+void Tracer::end() {
+  ThreadBufferCache &cache = t_buffer_cache;
+  if (cache.serial_ != serial_ || cache.buffer_ == nullptr) {
+    // 当前线程没有begin过
+    return;
+  }
+  TraceBuffer *buffer = cache.buffer_;
+  if (buffer->stack_.empty()) {
+    return;
+  }
+  uint64_t end_ns = now();
+  const TraceOpen &open = buffer->stack_.back();
+  TraceEvent event;
+  event.start_ns_ = open.start_ns_;
+  event.end_ns_ = end_ns;
+  event.name_id_ = open.name_id_;
+  event.category_ = open.category_;
+  event.depth_ = static_cast<uint16_t>(buffer->stack_.size() - 1);
+  buffer->stack_.pop_back();
+  buffer->push(event);
+}
+
+void Tracer::reset() { reset_ns_.store(now(), std::memory_order_relaxed); }
+
+std::vector<TraceStatistics> Tracer::getStatistics() {
+  std::map<std::pair<uint32_t, uint16_t>, std::vector<uint64_t>> durations;
+  forEachEvent([&durations](int tid, const TraceEvent &event) {
+    durations[{event.name_id_, event.category_}].push_back(event.end_ns_ -
+                                                           event.start_ns_);
+  });
+
+  std::vector<TraceStatistics> statistics;
+  for (auto &iter : durations) {
+    std::vector<uint64_t> &values = iter.second;
+    TraceStatistics stat;
+    stat.name_ = getName(iter.first.first);
+    stat.category_ = static_cast<TraceCategory>(iter.first.second);
+    stat.count_ = values.size();
+    uint64_t total = std::accumulate(values.begin(), values.end(), (uint64_t)0);
+    stat.total_us_ = total / 1000.0;
+    stat.avg_us_ = stat.total_us_ / values.size();
+    // 最近秩法
+    auto percentile = [&values](double p) {
+      size_t rank = static_cast<size_t>(std::ceil(p * values.size()));
+      size_t index = rank == 0 ? 0 : rank - 1;
+      std::nth_element(values.begin(), values.begin() + index, values.end());
+      return values[index] / 1000.0;
+    };
+    stat.p50_us_ = percentile(0.5);
+    stat.p99_us_ = percentile(0.99);
+    stat.max_us_ = *std::max_element(values.begin(), values.end()) / 1000.0;
+    statistics.emplace_back(stat);
+  }
+  std::sort(statistics.begin(), statistics.end(),
+            [](const TraceStatistics &a, const TraceStatistics &b) {
+              return a.total_us_ > b.total_us_;
+            });
+  return statistics;
+}
+
+void Tracer::printStatistics(const std::string &title) {
+  std::vector<TraceStatistics> statistics = getStatistics();
+  int name_size = 4;
+  for (auto &stat : statistics) {
+    name_size = std::max(name_size, static_cast<int>(stat.name_.size()));
+  }
+  printf("Tracer: %s\n", title.c_str());
+  std::string line(name_size + 2 + 10 + 2 + 8 + 5 * 14, '-');
+  printf("%s\n", line.c_str());
+  printf("%-*s  %-10s  %8s%14s%14s%14s%14s%14s\n", name_size, "name",
+         "category", "count", "total(ms)", "avg(ms)", "p50(ms)", "p99(ms)",
+         "max(ms)");
+  printf("%s\n", line.c_str());
+  for (auto &stat : statistics) {
+    printf("%-*s  %-10s  %8zu%14.3f%14.3f%14.3f%14.3f%14.3f\n", name_size,
+           stat.name_.c_str(), traceCategoryToString(stat.category_).c_str(),
+           stat.count_, stat.total_us_ / 1000.0, stat.avg_us_ / 1000.0,
+           stat.p50_us_ / 1000.0, stat.p99_us_ / 1000.0,
+           stat.max_us_ / 1000.0);
+  }
+  printf("%s\n", line.c_str());
+}
+
+base::Status Tracer::exportChromeTrace(const std::string &path) {
+  std::ofstream stream(path, std::ios::trunc);
+  if (!stream.is_open()) {
+    NNDEPLOY_LOGE("can't open file: %s.\n", path.c_str());
+    return base::kStatusCodeErrorIO;
+  }
+  std::vector<std::string> names;
+  std::vector<int> tids;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    names = names_;
+    for (auto &buffer : buffers_) {
+      tids.push_back(buffer->tid_);
+    }
+  }
+
+  stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool first = true;
+  for (int tid : tids) {
+    stream << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\","
+           << "\"pid\":0,\"tid\":" << tid << ",\"args\":{\"name\":\"thread "
+           << tid << "\"}}";
+    first = false;
+  }
+  char ts[64];
+  forEachEvent([&](int tid, const TraceEvent &event) {
+    stream << (first ? "" : ",") << "\n{\"name\":\"";
+    escapeJson(stream, event.name_id_ < names.size() ? names[event.name_id_]
+                                                     : std::string());
+    stream << "\",\"cat\":\""
+           << traceCategoryToString(
+                  static_cast<TraceCategory>(event.category_))
+           << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << tid;
+    // trace_event的时间单位为us
+    snprintf(ts, sizeof(ts), ",\"ts\":%.3f,\"dur\":%.3f",
+             event.start_ns_ / 1000.0,
+             (event.end_ns_ - event.start_ns_) / 1000.0);
+    stream << ts << ",\"args\":{\"depth\":" << event.depth_ << "}}";
+    first = false;
+  });
+  stream << "\n]}\n";
+  stream.close();
+  if (stream.fail()) {
+    NNDEPLOY_LOGE("write file failed: %s.\n", path.c_str());
+    return base::kStatusCodeErrorIO;
+  }
+  return base::kStatusCodeOk;
+}
+
+TraceBuffer *Tracer::getThreadBuffer() {
+  ThreadBufferCache &cache = t_buffer_cache;
+  if (cache.serial_ == serial_ && cache.buffer_ != nullptr) {
+    return cache.buffer_;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  // 缓冲在线程结束后保留，导出时仍然可以读取
+  TraceBuffer *buffer = nullptr;
+  std::thread::id thread_id = std::this_thread::get_id();
+  for (auto &iter : buffers_) {
+    if (iter->thread_id_ == thread_id) {
+      buffer = iter.get();
+      break;
+    }
+  }
+  if (buffer == nullptr) {
+    buffers_.emplace_back(new TraceBuffer(static_cast<int>(buffers_.size())));
+    buffer = buffers_.back().get();
+  }
+  cache.serial_ = serial_;
+  cache.buffer_ = buffer;
+  return buffer;
+}
+
+uint64_t Tracer::now() const {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - epoch_)
+      .count();
+}
+
+template <typename Func>
+void Tracer::forEachEvent(Func func) {
+  std::vector<TraceBuffer *> buffers;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &buffer : buffers_) {
+      buffers.push_back(buffer.get());
+    }
+  }
+  uint64_t reset_ns = reset_ns_.load(std::memory_order_relaxed);
+  for (TraceBuffer *buffer : buffers) {
+    TraceChunk *chunk = buffer->head_;
+    while (chunk != nullptr) {
+      size_t size = chunk->size_.load(std::memory_order_acquire);
+      for (size_t i = 0; i < size; ++i) {
+        const TraceEvent &event = chunk->events_[i];
+        if (event.start_ns_ >= reset_ns) {
+          func(buffer->tid_, event);
+        }
+      }
+      chunk = chunk->next_.load(std::memory_order_acquire);
+    }
+  }
+}
+
+Tracer *getGlobalTracer() {
+  static Tracer tracer;
+  return &tracer;
+}
+
+TraceScope::TraceScope(std::atomic<uint32_t> &name_id, const std::string &name,
+                       TraceCategory category) {
+  Tracer *tracer = getGlobalTracer();
+  active_ = tracer->isEnabled();
+  if (active_) {
+    tracer->begin(name_id, name, category);
+  }
+}
+
+TraceScope::TraceScope(uint32_t name_id, TraceCategory category) {
+  Tracer *tracer = getGlobalTracer();
+  active_ = tracer->isEnabled();
+  if (active_) {
+    tracer->begin(name_id, category);
+  }
+}
+
+TraceScope::~TraceScope() {
+  if (active_) {
+    getGlobalTracer()->end();
+  }
+}
+
+}  // namespace base
+}  // namespace nndeploy
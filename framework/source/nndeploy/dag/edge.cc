@@ -152,6 +152,9 @@ int Edge::getGraphOutputPosition() {
 base::EdgeUpdateFlag Edge::update(const Node *node) {
   return abstact_edge_->update(node);
 }
+bool Edge::waitNext(const Node *node, int timeout_ms) {
+  return abstact_edge_->waitNext(node, timeout_ms);
+}
 
 bool Edge::markGraphOutput() { return abstact_edge_->markGraphOutput(); }
 
@@ -175,6 +178,17 @@ base::ParallelType Edge::getParallelType() {
   return abstact_edge_->getParallelType();
 }
 
+void Edge::setQueueMaxSize(int queue_max_size) {
+  abstact_edge_->setQueueMaxSize(queue_max_size);
+}
+int Edge::getQueueMaxSize() { return abstact_edge_->getQueueMaxSize(); }
+void Edge::setQueueOverflowPolicy(base::QueueOverflowPolicy policy) {
+  abstact_edge_->setQueueOverflowPolicy(policy);
+}
+base::QueueOverflowPolicy Edge::getQueueOverflowPolicy() {
+  return abstact_edge_->getQueueOverflowPolicy();
+}
+
 base::Status Edge::increaseProducers(std::vector<Node *> &producers) {
   return abstact_edge_->increaseProducers(producers);
 }
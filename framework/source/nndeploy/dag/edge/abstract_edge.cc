@@ -34,6 +34,21 @@ base::Status AbstractEdge::increaseConsumers(std::vector<Node *> &consumers) {
   return base::kStatusCodeOk;
 }
 
+void AbstractEdge::setQueueMaxSize(int queue_max_size) {
+  queue_max_size_ = queue_max_size > 0 ? queue_max_size : 0;
+}
+int AbstractEdge::getQueueMaxSize() { return queue_max_size_; }
+void AbstractEdge::setQueueOverflowPolicy(base::QueueOverflowPolicy policy) {
+  queue_overflow_policy_ = policy;
+}
+base::QueueOverflowPolicy AbstractEdge::getQueueOverflowPolicy() {
+  return queue_overflow_policy_;
+}
+
+bool AbstractEdge::waitNext(const Node *node, int timeout_ms) {
+  return true;
+}
+
 bool AbstractEdge::markGraphOutput() {
   Node *node = nullptr;
   insertUnique(consumers_, node);
@@ -109,6 +124,9 @@ AbstractEdge *recreateEdge(AbstractEdge *abstact_edge,
     new_abstact_edge->increaseProducers(producers);
     std::vector<Node *> consumers = abstact_edge->getConsumers();
     new_abstact_edge->increaseConsumers(consumers);
+    new_abstact_edge->setQueueMaxSize(abstact_edge->getQueueMaxSize());
+    new_abstact_edge->setQueueOverflowPolicy(
+        abstact_edge->getQueueOverflowPolicy());
     delete abstact_edge;
   } else {
     new_abstact_edge = abstact_edge;
@@ -27,19 +27,16 @@ device::Buffer *DataPacket::create(device::Device *device,
   base::Status status = base::kStatusCodeOk;
   device::Buffer *buffer = nullptr;
   if (anything_ == nullptr) {
-    void *data = device->allocate(desc);
-    buffer = new device::Buffer(device, desc, data);
+    buffer = new device::Buffer(device, desc);
   } else {
     if (flag_ != EdgeTypeFlag::kBuffer) {
       destory();
-      void *data = device->allocate(desc);
-      buffer = new device::Buffer(device, desc, data);
+      buffer = new device::Buffer(device, desc);
     } else {
       buffer = (device::Buffer *)(anything_);
       if (buffer->getDesc() != desc) {
         destory();
-        void *data = device->allocate(desc);
-        buffer = new device::Buffer(device, desc, data);
+        buffer = new device::Buffer(device, desc);
       }
     }
   }
@@ -399,5 +396,14 @@ void PipelineDataPacket::increaseConsumersCount() {
 int PipelineDataPacket::getConsumersSize() { return consumers_size_; }
 int PipelineDataPacket::getConsumersCount() { return consumers_count_; }
 
+void PipelineDataPacket::recycle() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (is_external_) {
+    destory();
+  }
+  written_ = false;
+  consumers_count_ = 0;
+}
+
 }  // namespace dag
 }  // namespace nndeploy
\ No newline at end of file
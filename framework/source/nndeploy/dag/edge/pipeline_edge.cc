@@ -1,5 +1,6 @@
 #include "nndeploy/dag/edge/pipeline_edge.h"
 
+#include "nndeploy/base/trace.h"
 #include "nndeploy/dag/edge/data_packet.h"
 
 namespace nndeploy {
@@ -14,20 +15,27 @@ PipelineEdge::PipelineEdge(base::ParallelType paralle_type)
 PipelineEdge::~PipelineEdge() {
   consumers_size_ = 0;
 
-  for (auto iter : data_packets_) {
-    delete iter;
+  for (auto iter : ring_) {
+    if (iter != nullptr) {
+      delete iter;
+    }
+  }
+  ring_.clear();
+  if (drop_dp_ != nullptr) {
+    delete drop_dp_;
+    drop_dp_ = nullptr;
   }
-  data_packets_.clear();
 
   consuming_dp_.clear();
   to_consume_index_.clear();
 }
 
 base::Status PipelineEdge::construct() {
+  std::lock_guard<std::mutex> lock(mutex_);
   consumers_size_ = consumers_.size();
   for (auto iter : consumers_) {
     if (to_consume_index_.find(iter) == to_consume_index_.end()) {
-      to_consume_index_.insert({iter, 0});
+      to_consume_index_.insert({iter, head_seq_});
     }
     if (consuming_dp_.find(iter) == consuming_dp_.end()) {
       consuming_dp_.insert({iter, nullptr});
@@ -38,13 +46,9 @@ base::Status PipelineEdge::construct() {
 
 base::Status PipelineEdge::set(device::Buffer *buffer, int index,
                                bool is_external) {
-  // 上锁
-  std::lock_guard<std::mutex> lock(mutex_);
-  PipelineDataPacket *dp = new PipelineDataPacket(consumers_size_);
+  PipelineDataPacket *dp = acquirePacket();
   NNDEPLOY_CHECK_PARAM_NULL_RET_STATUS(dp, "PipelineDataPacket is null.\n");
 
-  data_packets_.push_back(dp);
-  cv_.notify_all();
   // set
   base::Status status = dp->set(buffer, index, is_external);
   NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
@@ -55,13 +59,9 @@ base::Status PipelineEdge::set(device::Buffer *buffer, int index,
 device::Buffer *PipelineEdge::create(device::Device *device,
                                      const device::BufferDesc &desc,
                                      int index) {
-  // 上锁
-  std::lock_guard<std::mutex> lock(mutex_);
-  PipelineDataPacket *dp = new PipelineDataPacket(consumers_size_);
+  PipelineDataPacket *dp = acquirePacket();
   NNDEPLOY_CHECK_PARAM_NULL_RET_NULL(dp, "PipelineDataPacket is null.\n");
 
-  data_packets_.push_back(dp);
-  cv_.notify_all();
   device::Buffer *ret_value = dp->create(device, desc, index);
   NNDEPLOY_CHECK_PARAM_NULL_RET_NULL(ret_value,
                                      "PipelineDataPacket create error.\n");
@@ -70,14 +70,8 @@ device::Buffer *PipelineEdge::create(device::Device *device,
 }
 bool PipelineEdge::notifyWritten(device::Buffer *buffer) {
   std::lock_guard<std::mutex> lock(mutex_);
-  bool is_notify = false;
-  for (auto iter = data_packets_.rbegin(); iter != data_packets_.rend();
-       ++iter) {
-    if ((*iter)->notifyWritten(buffer)) {
-      is_notify = true;
-      break;
-    }
-  }
+  bool is_notify = findWritingPacket(
+      [buffer](PipelineDataPacket *dp) { return dp->notifyWritten(buffer); });
   if (!is_notify) {
     NNDEPLOY_LOGE("This buffer[%p] is error.\n", buffer);
   }
@@ -108,13 +102,9 @@ device::Buffer *PipelineEdge::getGraphOutputBuffer() {
 
 #ifdef ENABLE_NNDEPLOY_OPENCV
 base::Status PipelineEdge::set(cv::Mat *cv_mat, int index, bool is_external) {
-  // 上锁
-  std::lock_guard<std::mutex> lock(mutex_);
-  PipelineDataPacket *dp = new PipelineDataPacket(consumers_size_);
+  PipelineDataPacket *dp = acquirePacket();
   NNDEPLOY_CHECK_PARAM_NULL_RET_STATUS(dp, "PipelineDataPacket is null.\n");
 
-  data_packets_.push_back(dp);
-  cv_.notify_all();
   // set
   base::Status status = dp->set(cv_mat, index, is_external);
   NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
@@ -123,13 +113,9 @@ base::Status PipelineEdge::set(cv::Mat *cv_mat, int index, bool is_external) {
 }
 cv::Mat *PipelineEdge::create(int rows, int cols, int type, const cv::Vec3b& value,
                               int index) {
-  // 上锁
-  std::lock_guard<std::mutex> lock(mutex_);
-  PipelineDataPacket *dp = new PipelineDataPacket(consumers_size_);
+  PipelineDataPacket *dp = acquirePacket();
   NNDEPLOY_CHECK_PARAM_NULL_RET_NULL(dp, "PipelineDataPacket is null.\n");
 
-  data_packets_.push_back(dp);
-  cv_.notify_all();
   cv::Mat *ret_value = dp->create(rows, cols, type, value, index);
   NNDEPLOY_CHECK_PARAM_NULL_RET_NULL(ret_value,
                                      "PipelineDataPacket create error.\n");
@@ -138,14 +124,8 @@ cv::Mat *PipelineEdge::create(int rows, int cols, int type, const cv::Vec3b& val
 }
 bool PipelineEdge::notifyWritten(cv::Mat *cv_mat) {
   std::lock_guard<std::mutex> lock(mutex_);
-  bool is_notify = false;
-  for (auto iter = data_packets_.rbegin(); iter != data_packets_.rend();
-       ++iter) {
-    if ((*iter)->notifyWritten(cv_mat)) {
-      is_notify = true;
-      break;
-    }
-  }
+  bool is_notify = findWritingPacket(
+      [cv_mat](PipelineDataPacket *dp) { return dp->notifyWritten(cv_mat); });
   if (!is_notify) {
     NNDEPLOY_LOGE("This cv_mat[%p] is error.\n", cv_mat);
   }
@@ -177,13 +157,9 @@ cv::Mat *PipelineEdge::getGraphOutputCvMat() {
 
 base::Status PipelineEdge::set(device::Tensor *tensor, int index,
                                bool is_external) {
-  // 上锁
-  std::lock_guard<std::mutex> lock(mutex_);
-  PipelineDataPacket *dp = new PipelineDataPacket(consumers_size_);
+  PipelineDataPacket *dp = acquirePacket();
   NNDEPLOY_CHECK_PARAM_NULL_RET_STATUS(dp, "PipelineDataPacket is null.\n");
 
-  data_packets_.push_back(dp);
-  cv_.notify_all();
   // set
   base::Status status = dp->set(tensor, index, is_external);
   NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
@@ -193,13 +169,9 @@ base::Status PipelineEdge::set(device::Tensor *tensor, int index,
 device::Tensor *PipelineEdge::create(device::Device *device,
                                      const device::TensorDesc &desc, int index,
                                      const std::string &name) {
-  // 上锁
-  std::lock_guard<std::mutex> lock(mutex_);
-  PipelineDataPacket *dp = new PipelineDataPacket(consumers_size_);
+  PipelineDataPacket *dp = acquirePacket();
   NNDEPLOY_CHECK_PARAM_NULL_RET_NULL(dp, "PipelineDataPacket is null.\n");
 
-  data_packets_.push_back(dp);
-  cv_.notify_all();
   device::Tensor *ret_value = dp->create(device, desc, index, name);
   NNDEPLOY_CHECK_PARAM_NULL_RET_NULL(ret_value,
                                      "PipelineDataPacket create error.\n");
@@ -207,14 +179,8 @@ device::Tensor *PipelineEdge::create(device::Device *device,
 }
 bool PipelineEdge::notifyWritten(device::Tensor *tensor) {
   std::lock_guard<std::mutex> lock(mutex_);
-  bool is_notify = false;
-  for (auto iter = data_packets_.rbegin(); iter != data_packets_.rend();
-       ++iter) {
-    if ((*iter)->notifyWritten(tensor)) {
-      is_notify = true;
-      break;
-    }
-  }
+  bool is_notify = findWritingPacket(
+      [tensor](PipelineDataPacket *dp) { return dp->notifyWritten(tensor); });
   if (!is_notify) {
     NNDEPLOY_LOGE("This tensor[%p] is error.\n", tensor);
   }
@@ -244,13 +210,9 @@ device::Tensor *PipelineEdge::getGraphOutputTensor() {
 }
 
 base::Status PipelineEdge::takeDataPacket(DataPacket *data_packet) {
-  // 上锁
-  std::lock_guard<std::mutex> lock(mutex_);
-  PipelineDataPacket *dp = new PipelineDataPacket(consumers_size_);
+  PipelineDataPacket *dp = acquirePacket();
   NNDEPLOY_CHECK_PARAM_NULL_RET_STATUS(dp, "PipelineDataPacket is null.\n");
 
-  data_packets_.push_back(dp);
-  cv_.notify_all();
   // set
   base::Status status = dp->takeDataPacket(data_packet);
   NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
@@ -259,14 +221,9 @@ base::Status PipelineEdge::takeDataPacket(DataPacket *data_packet) {
 }
 bool PipelineEdge::notifyAnyWritten(void *anything) {
   std::lock_guard<std::mutex> lock(mutex_);
-  bool is_notify = false;
-  for (auto iter = data_packets_.rbegin(); iter != data_packets_.rend();
-       ++iter) {
-    if ((*iter)->notifyAnyWritten(anything)) {
-      is_notify = true;
-      break;
-    }
-  }
+  bool is_notify = findWritingPacket([anything](PipelineDataPacket *dp) {
+    return dp->notifyAnyWritten(anything);
+  });
   if (!is_notify) {
     NNDEPLOY_LOGE("This anything[%p] is error.\n", anything);
   }
@@ -297,13 +254,9 @@ DataPacket *PipelineEdge::getGraphOutputDataPacket() {
 
 base::Status PipelineEdge::set(base::Param *param, int index,
                                bool is_external) {
-  // 上锁
-  std::lock_guard<std::mutex> lock(mutex_);
-  PipelineDataPacket *dp = new PipelineDataPacket(consumers_size_);
+  PipelineDataPacket *dp = acquirePacket();
   NNDEPLOY_CHECK_PARAM_NULL_RET_STATUS(dp, "PipelineDataPacket is null.\n");
 
-  data_packets_.push_back(dp);
-  cv_.notify_all();
   // set
   base::Status status = dp->set(param, index, is_external);
   NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
@@ -312,14 +265,8 @@ base::Status PipelineEdge::set(base::Param *param, int index,
 }
 bool PipelineEdge::notifyWritten(base::Param *param) {
   std::lock_guard<std::mutex> lock(mutex_);
-  bool is_notify = false;
-  for (auto iter = data_packets_.rbegin(); iter != data_packets_.rend();
-       ++iter) {
-    if ((*iter)->notifyWritten(param)) {
-      is_notify = true;
-      break;
-    }
-  }
+  bool is_notify = findWritingPacket(
+      [param](PipelineDataPacket *dp) { return dp->notifyWritten(param); });
   if (!is_notify) {
     NNDEPLOY_LOGE("This param[%p] is error.\n", param);
   }
@@ -373,14 +320,9 @@ int PipelineEdge::getPosition(const Node *node) {
     NNDEPLOY_LOGE("PipelineDataPacket getPipelineDataPacket error.\n");
     return -1;
   }
-  int position = 0;
-  for (auto iter : data_packets_) {
-    if (dp == iter) {
-      break;
-    } else {
-      position++;
-    }
-  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  Node *tmp_node = const_cast<Node *>(node);
+  int position = (int)(to_consume_index_[tmp_node] - 1 - head_seq_);
   return position;
 }
 int PipelineEdge::getGraphOutputPosition() { return getPosition(nullptr); }
@@ -406,60 +348,57 @@ base::EdgeUpdateFlag PipelineEdge::update(const Node *node) {
     return base::kEdgeUpdateFlagError;
   }
   std::unique_lock<std::mutex> lock(mutex_);
-  cv_.wait(lock, [this, tmp_node] {
-    return to_consume_index_[tmp_node] < data_packets_.size() ||
+  auto is_ready = [this, tmp_node] {
+    return to_consume_index_[tmp_node] < tail_seq_ ||
            terminate_flag_;  // 消费者需求的数据已存在，否则等待最新数据  ||
                              // 数据被消耗结束
-  });
+  };
+  if (!is_ready()) {
+    // 只记录实际阻塞的等待，以消费者命名，图的输出(node为nullptr)使用固定名字
+    std::atomic<uint32_t> &trace_id = wait_trace_id_[tmp_node];
+    NNDEPLOY_TRACE_BEGIN(trace_id,
+                         trace_id != 0 ? std::string()
+                         : tmp_node != nullptr
+                             ? tmp_node->getName() + " wait input"
+                             : std::string("graph output wait input"),
+                         base::kTraceCategoryEdgeWait);
+    cv_.wait(lock, is_ready);
+    NNDEPLOY_TRACE_END();
+  }
   if (terminate_flag_) {
     return base::kEdgeUpdateFlagTerminate;
   }
 
   // find
-  PipelineDataPacket *dp = nullptr;
-  int index = to_consume_index_[tmp_node];
-  int count = 0;
-  auto iter = data_packets_.begin();
-  for (int i = 0; i < index; i++) {
-    if ((*iter)->getConsumersCount() == consumers_size_) {
-      count++;
-    }
-    iter++;
-  }
-  dp = (*iter);
+  int64_t seq = std::max(to_consume_index_[tmp_node], head_seq_);
+  PipelineDataPacket *dp = ring_[seq % ring_.size()];
   dp->increaseConsumersCount();
   consuming_dp_[tmp_node] = dp;
-
-  // update
-  int real_count = 0;
-  iter = data_packets_.begin();
-  for (int i = 0; i < count; i++) {
-    bool delete_flag = true;
-    for (auto consuming_dp : consuming_dp_) {
-      if (consuming_dp.second == *iter) {
-        delete_flag = false;
-        break;
-      }
-    }
-    if (delete_flag) {
-      delete (*iter);
-      iter++;
-      real_count++;
-    } else {
-      break;
-    }
-  }
-  // 销毁不会被使用到的数据
-  data_packets_.erase(data_packets_.begin(), iter);
-  for (auto &iter : to_consume_index_) {
-    iter.second -= real_count;
-  }
   // 让下一次数据没有的时候线程一直在等待
-  to_consume_index_[tmp_node]++;
+  to_consume_index_[tmp_node] = seq + 1;
+
+  // 回收不会被使用到的数据包，唤醒等待空位的生产者
+  releasePackets();
+  cv_.notify_all();
 
   return base::kEdgeUpdateFlagComplete;
 }
 
+bool PipelineEdge::waitNext(const Node *node, int timeout_ms) {
+  Node *tmp_node = const_cast<Node *>(node);
+  if (!checkNode(tmp_node)) {
+    NNDEPLOY_LOGE("This node is error.\n");
+    return false;
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  bool ready = cv_.wait_for(
+      lock, std::chrono::milliseconds(std::max(timeout_ms, 0)),
+      [this, tmp_node] {
+        return to_consume_index_[tmp_node] < tail_seq_ || terminate_flag_;
+      });
+  return ready && !terminate_flag_;
+}
+
 PipelineDataPacket *PipelineEdge::getPipelineDataPacket(const Node *node) {
   Node *tmp_node = const_cast<Node *>(node);
   auto iter = consuming_dp_.find(tmp_node);
@@ -475,5 +414,90 @@ PipelineDataPacket *PipelineEdge::getPipelineDataPacket(const Node *node) {
   return iter->second;
 }
 
+PipelineDataPacket *PipelineEdge::acquirePacket() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (ring_.empty()) {
+    // 有界时多一个位置，存放最慢的消费者正在使用的数据包
+    int ring_size = queue_max_size_ > 0 ? queue_max_size_ + 1 : 8;
+    ring_.resize(ring_size, nullptr);
+  }
+  releasePackets();
+
+  if (queue_max_size_ > 0) {
+    auto is_full = [this]() {
+      for (auto &iter : to_consume_index_) {
+        if (tail_seq_ - iter.second >= queue_max_size_) {
+          return true;
+        }
+      }
+      return false;
+    };
+    if (is_full()) {
+      if (queue_overflow_policy_ == base::kQueueOverflowPolicyDropNewest) {
+        if (drop_dp_ == nullptr) {
+          drop_dp_ = new PipelineDataPacket(consumers_size_);
+        }
+        drop_dp_->recycle();
+        return drop_dp_;
+      }
+      {
+        // 队列满时生产者的等待，嵌套在生产者节点的span中
+        NNDEPLOY_TRACE_SCOPE("pipeline edge full",
+                             base::kTraceCategoryEdgeWait);
+        cv_.wait(lock,
+                 [this, &is_full] { return !is_full() || terminate_flag_; });
+      }
+      if (terminate_flag_) {
+        NNDEPLOY_LOGI("User voluntarily terminates.\n");
+        return nullptr;
+      }
+      releasePackets();
+    }
+  } else if (tail_seq_ - head_seq_ >= (int64_t)ring_.size()) {
+    growRing();
+  }
+
+  PipelineDataPacket *&slot = ring_[tail_seq_ % ring_.size()];
+  if (slot == nullptr) {
+    slot = new PipelineDataPacket(consumers_size_);
+  } else {
+    slot->recycle();
+  }
+  PipelineDataPacket *dp = slot;
+  tail_seq_++;
+  cv_.notify_all();
+  return dp;
+}
+
+void PipelineEdge::releasePackets() {
+  // 消费者正在使用序号为to_consume_index_-1的数据包，更早的都可以复用
+  int64_t head_seq = tail_seq_;
+  for (auto &iter : to_consume_index_) {
+    head_seq = std::min(head_seq, iter.second - 1);
+  }
+  head_seq_ = std::max(head_seq_, head_seq);
+}
+
+void PipelineEdge::growRing() {
+  size_t old_size = ring_.size();
+  std::vector<PipelineDataPacket *> ring(old_size * 2, nullptr);
+  for (int64_t seq = head_seq_; seq < tail_seq_; ++seq) {
+    ring[seq % ring.size()] = ring_[seq % old_size];
+    ring_[seq % old_size] = nullptr;
+  }
+  // 已释放的数据包放到空位上继续复用
+  size_t slot = 0;
+  for (auto iter : ring_) {
+    if (iter == nullptr) {
+      continue;
+    }
+    while (ring[slot] != nullptr) {
+      slot++;
+    }
+    ring[slot] = iter;
+  }
+  ring_.swap(ring);
+}
+
 }  // namespace dag
 }  // namespace nndeploy
\ No newline at end of file
@@ -14,6 +14,8 @@ base::Status ParallelPipelineExecutor::init(
   base::Status status = topoSortDFS(node_repository, topo_sort_node_);
   for (auto iter : topo_sort_node_) {
     iter->color_ = base::kNodeColorWhite;
+    // 每个节点常驻线程池中的一个线程
+    iter->node_->setDedicatedThreadFlag(true);
     if (iter->node_->getInitialized()) {
       continue;
     }
@@ -53,6 +55,7 @@ base::Status ParallelPipelineExecutor::deinit() {
     NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
                            "failed iter->node_->deinit()");
     iter->node_->setInitializedFlag(false);
+    iter->node_->setDedicatedThreadFlag(false);
   }
   return status;
 }
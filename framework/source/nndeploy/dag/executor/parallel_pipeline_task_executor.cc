@@ -0,0 +1,217 @@
+#include "nndeploy/dag/executor/parallel_pipeline_task_executor.h"
+
+namespace nndeploy {
+namespace dag {
+
+ParallelPipelineTaskExecutor::ParallelPipelineTaskExecutor() : Executor(){};
+
+ParallelPipelineTaskExecutor::~ParallelPipelineTaskExecutor(){};
+
+void ParallelPipelineTaskExecutor::setMaxInflight(int max_inflight) {
+  max_inflight_ = std::max(max_inflight, 1);
+}
+int ParallelPipelineTaskExecutor::getMaxInflight() { return max_inflight_; }
+
+base::Status ParallelPipelineTaskExecutor::init(
+    std::vector<EdgeWrapper*>& edge_repository,
+    std::vector<NodeWrapper*>& node_repository) {
+  thread_pool_ = thread_pool::getGlobalThreadPool();
+  topo_sort_node_.clear();
+  base::Status status = topoSortDFS(node_repository, topo_sort_node_);
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "topoSortDFS failed!");
+  for (auto iter : topo_sort_node_) {
+    iter->color_ = base::kNodeColorWhite;
+    if (iter->node_->getInitialized()) {
+      continue;
+    }
+    status = iter->node_->init();
+    NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                           "failed iter->node_->init()");
+    iter->node_->setInitializedFlag(true);
+  }
+
+  all_task_count_ = topo_sort_node_.size();
+  std::map<NodeWrapper*, int> node_index;
+  for (int i = 0; i < all_task_count_; ++i) {
+    node_index[topo_sort_node_[i]] = i;
+  }
+  predecessors_.assign(all_task_count_, std::vector<int>());
+  successors_.assign(all_task_count_, std::vector<int>());
+  for (int i = 0; i < all_task_count_; ++i) {
+    for (auto successor : topo_sort_node_[i]->successors_) {
+      auto iter = node_index.find(successor);
+      if (iter == node_index.end()) {
+        continue;
+      }
+      successors_[i].push_back(iter->second);
+      predecessors_[iter->second].push_back(i);
+    }
+  }
+  done_frames_.assign(all_task_count_, 0);
+  running_.assign(all_task_count_, false);
+  running_count_ = 0;
+  submitted_frames_ = 0;
+  frames_.clear();
+  failed_ = false;
+
+  edge_repository_ = edge_repository;
+  return status;
+}
+
+base::Status ParallelPipelineTaskExecutor::deinit() {
+  base::Status status = base::kStatusCodeOk;
+  {
+    // 等待已提交的帧执行完成
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return frames_.empty() || failed_; });
+  }
+  for (auto iter : edge_repository_) {
+    bool flag = iter->edge_->requestTerminate();
+    if (!flag) {
+      NNDEPLOY_LOGE("failed iter->edge_->requestTerminate()!\n");
+      return base::kStatusCodeErrorDag;
+    }
+  }
+  {
+    // 失败时可能仍有节点阻塞在updateInput上，终止边之后等待其返回
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return running_count_ == 0; });
+  }
+  thread_pool_ = nullptr;
+
+  for (auto iter : topo_sort_node_) {
+    status = iter->node_->deinit();
+    NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                           "failed iter->node_->deinit()");
+    iter->node_->setInitializedFlag(false);
+  }
+  return status;
+}
+
+base::Status ParallelPipelineTaskExecutor::run() {
+  std::future<base::Status> future = runAsync();
+  // 提交时已失败则直接返回错误，否则不等待该帧完成
+  if (future.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+    return future.get();
+  }
+  return base::kStatusCodeOk;
+}
+
+std::future<base::Status> ParallelPipelineTaskExecutor::runAsync() {
+  std::vector<std::pair<int, int64_t>> ready;
+  std::future<base::Status> future;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock,
+             [this] { return failed_ || (int)frames_.size() < max_inflight_; });
+    if (failed_) {
+      std::promise<base::Status> promise;
+      promise.set_value(base::kStatusCodeErrorDag);
+      return promise.get_future();
+    }
+    int64_t frame = submitted_frames_++;
+    Frame& state = frames_[frame];
+    state.remaining_ = all_task_count_;
+    future = state.promise_.get_future();
+    if (all_task_count_ == 0) {
+      state.promise_.set_value(base::kStatusCodeOk);
+      frames_.erase(frame);
+      return future;
+    }
+    for (int i = 0; i < all_task_count_; ++i) {
+      if (predecessors_[i].empty()) {
+        tryStart(i, ready);
+      }
+    }
+  }
+  submit(ready);
+  return future;
+}
+
+void ParallelPipelineTaskExecutor::tryStart(
+    int index, std::vector<std::pair<int, int64_t>>& ready) {
+  int64_t frame = done_frames_[index];
+  if (failed_ || running_[index] || frame >= submitted_frames_) {
+    return;
+  }
+  for (int predecessor : predecessors_[index]) {
+    if (done_frames_[predecessor] <= frame) {
+      return;
+    }
+  }
+  running_[index] = true;
+  running_count_++;
+  ready.emplace_back(index, frame);
+}
+
+void ParallelPipelineTaskExecutor::submit(
+    const std::vector<std::pair<int, int64_t>>& ready) {
+  for (const auto& task : ready) {
+    int index = task.first;
+    int64_t frame = task.second;
+    thread_pool_->commit([this, index, frame] { runNode(index, frame); });
+  }
+}
+
+void ParallelPipelineTaskExecutor::runNode(int index, int64_t frame) {
+  NodeWrapper* node_wrapper = topo_sort_node_[index];
+  base::Status status = base::kStatusCodeOk;
+  // 前驱已完成该帧，输入数据都已写入，updateInput不会阻塞
+  base::EdgeUpdateFlag edge_update_flag = node_wrapper->node_->updateInput();
+  if (edge_update_flag == base::kEdgeUpdateFlagComplete) {
+    node_wrapper->node_->setRunningFlag(true);
+    status = node_wrapper->node_->run();
+    if (status != base::kStatusCodeOk) {
+      NNDEPLOY_LOGE("node[%s] execute failed!.\n",
+                    node_wrapper->node_->getName().c_str());
+    }
+    node_wrapper->node_->setRunningFlag(false);
+  } else if (edge_update_flag == base::kEdgeUpdateFlagTerminate) {
+    status = base::kStatusCodeErrorDag;
+  } else {
+    NNDEPLOY_LOGE("Failed to node[%s] updateInput();\n",
+                  node_wrapper->node_->getName().c_str());
+    status = base::kStatusCodeErrorDag;
+  }
+  afterNodeRun(index, frame, status);
+}
+
+void ParallelPipelineTaskExecutor::afterNodeRun(int index, int64_t frame,
+                                                base::Status status) {
+  std::vector<std::pair<int, int64_t>> ready;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_[index] = false;
+    running_count_--;
+    if (status != base::kStatusCodeOk) {
+      // 后继节点拿不到该帧的数据，不再调度
+      failed_ = true;
+      failAllFrames(status);
+      cv_.notify_all();
+      return;
+    }
+    done_frames_[index]++;
+    auto iter = frames_.find(frame);
+    if (iter != frames_.end() && --iter->second.remaining_ == 0) {
+      // 每个节点按帧的顺序执行，帧也按提交的顺序完成
+      iter->second.promise_.set_value(iter->second.status_);
+      frames_.erase(iter);
+    }
+    tryStart(index, ready);
+    for (int successor : successors_[index]) {
+      tryStart(successor, ready);
+    }
+    cv_.notify_all();
+  }
+  submit(ready);
+}
+
+void ParallelPipelineTaskExecutor::failAllFrames(base::Status status) {
+  for (auto& iter : frames_) {
+    iter.second.promise_.set_value(status);
+  }
+  frames_.clear();
+}
+
+}  // namespace dag
+}  // namespace nndeploy
@@ -6,20 +6,27 @@ ParallelTaskExecutor::ParallelTaskExecutor() : Executor(){};
 
 ParallelTaskExecutor::~ParallelTaskExecutor(){};
 
+namespace {
+
+// 耗时滑动平均中新测量值的权重
+const double kCostSmoothing = 0.2;
+
+}  // namespace
+
 base::Status ParallelTaskExecutor::init(
     std::vector<EdgeWrapper*>& edge_repository,
     std::vector<NodeWrapper*>& node_repository) {
-  // TODO:
-  // 计算图的最大并行度，决定线程的数量
-  thread_pool_ = new thread_pool::ThreadPool();
-  thread_pool_->init();
+  // 所有图共用进程内的线程池，线程数由硬件决定，避免多个图同时运行时超订
+  thread_pool_ = thread_pool::getGlobalThreadPool();
   start_nodes_ = findStartNodes(node_repository);
+  topo_sort_node_.clear();
   base::Status status = topoSortBFS(node_repository, topo_sort_node_);
   all_task_count_ = topo_sort_node_.size();
   if (start_nodes_.empty()) {
     NNDEPLOY_LOGE("No start node found in graph");
     return base::kStatusCodeErrorInvalidValue;
   }
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "topoSortBFS failed!");
 
   for (auto iter : topo_sort_node_) {
     iter->color_ = base::kNodeColorWhite;
@@ -31,6 +38,35 @@ base::Status ParallelTaskExecutor::init(
     iter->node_->setInitializedFlag(true);
   }
 
+  // 建立以下标表示的邻接关系
+  int n = all_task_count_;
+  node_index_.clear();
+  for (int i = 0; i < n; ++i) {
+    node_index_[topo_sort_node_[i]] = i;
+  }
+  successors_.assign(n, std::vector<int>());
+  predecessor_count_.assign(n, 0);
+  for (int i = 0; i < n; ++i) {
+    for (auto successor : topo_sort_node_[i]->successors_) {
+      auto iter = node_index_.find(successor);
+      if (iter == node_index_.end()) {
+        continue;
+      }
+      successors_[i].push_back(iter->second);
+      predecessor_count_[iter->second]++;
+    }
+  }
+  pending_count_.reset(new std::atomic<int>[n]);
+  for (int i = 0; i < n; ++i) {
+    pending_count_[i] = predecessor_count_[i];
+  }
+
+  cost_.assign(n, 0.0);
+  priority_.assign(n, 0.0);
+  ready_.clear();
+  ready_.reserve(n);
+  updatePriority();
+
   edge_repository_ = edge_repository;
   return status;
 }
@@ -44,8 +80,7 @@ base::Status ParallelTaskExecutor::deinit() {
       return base::kStatusCodeErrorDag;
     }
   }
-  thread_pool_->destroy();
-  delete thread_pool_;
+  thread_pool_ = nullptr;
   for (auto iter : topo_sort_node_) {
     status = iter->node_->deinit();
     NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "node deinit failure");
@@ -55,9 +90,15 @@ base::Status ParallelTaskExecutor::deinit() {
 }
 
 base::Status ParallelTaskExecutor::run() {
+  std::vector<int> ready;
   for (auto iter : start_nodes_) {
-    process(iter);
+    auto index = node_index_.find(iter);
+    if (index != node_index_.end()) {
+      iter->color_ = base::kNodeColorGray;
+      ready.push_back(index->second);
+    }
   }
+  submit(ready);
   wait();
 
   for (auto iter : topo_sort_node_) {
@@ -75,76 +116,116 @@ base::Status ParallelTaskExecutor::run() {
 }
 
 void ParallelTaskExecutor::process(NodeWrapper* node_wrapper) {
+  auto iter = node_index_.find(node_wrapper);
+  if (iter == node_index_.end()) {
+    NNDEPLOY_LOGE("node[%s] is not in this graph!\n",
+                  node_wrapper->name_.c_str());
+    return;
+  }
   node_wrapper->color_ = base::kNodeColorGray;
-  const auto& func = [this, node_wrapper] {
-    base::EdgeUpdateFlag edge_update_flag = node_wrapper->node_->updateInput();
-    if (edge_update_flag == base::kEdgeUpdateFlagComplete) {
-      node_wrapper->node_->setRunningFlag(true);
-      // NNDEPLOY_LOGE("node[%s] execute start.\n",
-      //                 node_wrapper->node_->getName().c_str());
-      base::Status status = node_wrapper->node_->run();
-      if (status != base::kStatusCodeOk) {
-        NNDEPLOY_LOGE("node[%s] execute failed!.\n",
-                      node_wrapper->node_->getName().c_str());
-        return;
-      }
-      node_wrapper->node_->setRunningFlag(false);
-      afterNodeRun(node_wrapper);
-      // NNDEPLOY_LOGE("node[%s] execute end.\n",
-      //               node_wrapper->node_->getName().c_str());
-    } else if (edge_update_flag == base::kEdgeUpdateFlagTerminate) {
+  submit({iter->second});
+}
+
+void ParallelTaskExecutor::submit(const std::vector<int>& ready) {
+  if (ready.empty()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(ready_lock_);
+    for (int index : ready) {
+      ready_.push_back(index);
+      std::push_heap(ready_.begin(), ready_.end(),
+                     [this](int a, int b) { return isLowerPriority(a, b); });
+    }
+  }
+  // 任务与节点不绑定，任务开始执行时才从堆中取出当前优先级最高的节点
+  for (size_t i = 0; i < ready.size(); ++i) {
+    thread_pool_->commit([this] { runReadyNode(); });
+  }
+}
+
+void ParallelTaskExecutor::runReadyNode() {
+  int index = -1;
+  {
+    std::lock_guard<std::mutex> lock(ready_lock_);
+    if (ready_.empty()) {
       return;
-    } else {
-      NNDEPLOY_LOGE("Failed to node[%s] updateInput();\n",
+    }
+    std::pop_heap(ready_.begin(), ready_.end(),
+                  [this](int a, int b) { return isLowerPriority(a, b); });
+    index = ready_.back();
+    ready_.pop_back();
+  }
+  NodeWrapper* node_wrapper = topo_sort_node_[index];
+  base::EdgeUpdateFlag edge_update_flag = node_wrapper->node_->updateInput();
+  if (edge_update_flag == base::kEdgeUpdateFlagComplete) {
+    node_wrapper->node_->setRunningFlag(true);
+    // NNDEPLOY_LOGE("node[%s] execute start.\n",
+    //                 node_wrapper->node_->getName().c_str());
+    auto start = std::chrono::steady_clock::now();
+    base::Status status = node_wrapper->node_->run();
+    if (status != base::kStatusCodeOk) {
+      NNDEPLOY_LOGE("node[%s] execute failed!.\n",
                     node_wrapper->node_->getName().c_str());
       return;
     }
-  };
-  thread_pool_->commit(func);
+    double cost = std::chrono::duration<double, std::milli>(
+                      std::chrono::steady_clock::now() - start)
+                      .count();
+    // 同一节点在一次执行中只会运行一次，无需加锁
+    cost_[index] = cost_[index] <= 0.0
+                       ? cost
+                       : cost_[index] + kCostSmoothing * (cost - cost_[index]);
+    node_wrapper->node_->setRunningFlag(false);
+    afterNodeRun(node_wrapper);
+    // NNDEPLOY_LOGE("node[%s] execute end.\n",
+    //               node_wrapper->node_->getName().c_str());
+  } else if (edge_update_flag == base::kEdgeUpdateFlagTerminate) {
+    return;
+  } else {
+    NNDEPLOY_LOGE("Failed to node[%s] updateInput();\n",
+                  node_wrapper->node_->getName().c_str());
+    return;
+  }
 }
 
 void ParallelTaskExecutor::afterNodeRun(NodeWrapper* node_wrapper) {
-  {
-    std::lock_guard<std::mutex> lock(main_lock_);
-    completed_task_count_++;
+  auto iter = node_index_.find(node_wrapper);
+  if (iter == node_index_.end()) {
+    return;
   }
   node_wrapper->color_ = base::kNodeColorBlack;
-  for (auto successor : node_wrapper->successors_) {
-    bool all_pre_done = true;
-    for (auto iter : successor->predecessors_) {
-      all_pre_done &= (iter->color_ == base::kNodeColorBlack);
-    }
-    if (all_pre_done && successor->color_ == base::kNodeColorWhite) {
-      if (successor->predecessors_.size() <= 1) {
-        process(successor);
-      } else {
-        submitTaskSynchronized(successor);
-      }
+  std::vector<int> ready;
+  for (int successor : successors_[iter->second]) {
+    // 最后一个完成的前驱负责提交后继，只会提交一次
+    if (pending_count_[successor].fetch_sub(1, std::memory_order_acq_rel) ==
+        1) {
+      topo_sort_node_[successor]->color_ = base::kNodeColorGray;
+      ready.push_back(successor);
     }
   }
+  submit(ready);
 
-  // 如果不是尾部节点，则不用通知主线程进行检查
-  if (!node_wrapper->successors_.empty()) {
+  // 最后一个节点完成时通知主线程
+  if (completed_task_count_.fetch_add(1) + 1 < all_task_count_) {
     return;
   }
-
   {
     std::lock_guard<std::mutex> lock(main_lock_);
-
-    if (completed_task_count_ >= all_task_count_) {
-      cv_.notify_one();
-    }
-  }
-}
-
-void ParallelTaskExecutor::submitTaskSynchronized(NodeWrapper* node_wrapper) {
-  std::lock_guard<std::mutex> lock(commit_lock_);
-  if (node_wrapper->color_ == base::kNodeColorWhite) {
-    process(node_wrapper);
+    cv_.notify_one();
   }
 }
 
 void ParallelTaskExecutor::wait() {
+  // 子图在线程池的线程中运行时，阻塞等待可能占满所有线程，改为边等边执行任务
+  if (thread_pool_->isWorkerThread()) {
+    while (completed_task_count_ < all_task_count_) {
+      if (!thread_pool_->runPendingTask()) {
+        std::this_thread::yield();
+      }
+    }
+    return;
+  }
   std::unique_lock<std::mutex> lock(main_lock_);
   cv_.wait(lock, [this] { return completed_task_count_ >= all_task_count_; });
 }
@@ -154,6 +235,46 @@ void ParallelTaskExecutor::afterGraphRun() {
   for (auto iter : topo_sort_node_) {
     iter->color_ = base::kNodeColorWhite;
   }
+  for (int i = 0; i < all_task_count_; ++i) {
+    pending_count_[i] = predecessor_count_[i];
+  }
+  updatePriority();
+}
+
+double ParallelTaskExecutor::getPriority(NodeWrapper* node_wrapper) {
+  auto iter = node_index_.find(node_wrapper);
+  if (iter == node_index_.end()) {
+    return -1.0;
+  }
+  return priority_[iter->second];
+}
+
+bool ParallelTaskExecutor::isLowerPriority(int a, int b) const {
+  if (priority_[a] != priority_[b]) {
+    return priority_[a] < priority_[b];
+  }
+  return a > b;
+}
+
+void ParallelTaskExecutor::updatePriority() {
+  // 未测量的节点按已测节点的平均耗时估计
+  double sum = 0.0;
+  int measured = 0;
+  for (double cost : cost_) {
+    if (cost > 0.0) {
+      sum += cost;
+      measured++;
+    }
+  }
+  double estimate = measured > 0 ? sum / measured : 1.0;
+  // 下标即拓扑序，逆序遍历时后继的优先级都已计算
+  for (int i = all_task_count_ - 1; i >= 0; --i) {
+    double longest = 0.0;
+    for (int successor : successors_[i]) {
+      longest = std::max(longest, priority_[successor]);
+    }
+    priority_[i] = (cost_[i] > 0.0 ? cost_[i] : estimate) + longest;
+  }
 }
 
 }  // namespace dag
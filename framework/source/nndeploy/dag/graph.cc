@@ -12,6 +12,7 @@
 #include "nndeploy/base/time_profiler.h"
 #include "nndeploy/dag/edge.h"
 #include "nndeploy/dag/executor/parallel_pipeline_executor.h"
+#include "nndeploy/dag/executor/parallel_pipeline_task_executor.h"
 #include "nndeploy/dag/executor/parallel_task_executor.h"
 #include "nndeploy/dag/executor/sequential_executor.h"
 #include "nndeploy/dag/node.h"
@@ -326,6 +327,10 @@ void Graph::setGraphNodeShareStream(bool flag) {
 
 bool Graph::getGraphNodeShareStream() { return is_graph_node_share_stream_; }
 
+void Graph::setPipelineInflight(int num) { pipeline_inflight_ = num; }
+
+int Graph::getPipelineInflight() { return pipeline_inflight_; }
+
 base::Status Graph::updateNodeIO(Node *node, std::vector<Edge *> inputs,
                                  std::vector<Edge *> outputs) {
   base::Status status = base::kStatusCodeOk;
@@ -455,6 +460,16 @@ base::Status Graph::run() {
   return status;
 }
 
+std::future<base::Status> Graph::runAsync() {
+  if (executor_ == nullptr) {
+    NNDEPLOY_LOGE("graph is not initialized!\n");
+    std::promise<base::Status> promise;
+    promise.set_value(base::kStatusCodeErrorDag);
+    return promise.get_future();
+  }
+  return executor_->runAsync();
+}
+
 base::Status Graph::dump(std::ostream &oss) {
   base::Status status = dumpDag(edge_repository_, node_repository_, inputs_,
                                 outputs_, name_, oss);
@@ -616,7 +631,13 @@ base::Status Graph::executor() {
   } else if (parallel_type_ == base::kParallelTypeTask) {
     executor_ = std::make_shared<ParallelTaskExecutor>();
   } else if (parallel_type_ == base::kParallelTypePipeline) {
-    executor_ = std::make_shared<ParallelPipelineExecutor>();
+    if (pipeline_inflight_ > 0) {
+      auto executor = std::make_shared<ParallelPipelineTaskExecutor>();
+      executor->setMaxInflight(pipeline_inflight_);
+      executor_ = executor;
+    } else {
+      executor_ = std::make_shared<ParallelPipelineExecutor>();
+    }
   } else {
     NNDEPLOY_LOGE("parallel_type_ is invalid!\n");
     return base::kStatusCodeErrorInvalidValue;
@@ -348,6 +348,11 @@ NodeType Node::getNodeType() { return node_type_; }
 
 void Node::setRunningFlag(bool flag) {
   is_running_ = flag;
+  if (is_running_) {
+    NNDEPLOY_TRACE_BEGIN(trace_name_id_, name_, base::kTraceCategoryNode);
+  } else {
+    NNDEPLOY_TRACE_END();
+  }
   if (is_time_profile_) {
     if (is_running_) {
       NNDEPLOY_TIME_POINT_START(name_ + " run()");
@@ -365,6 +370,9 @@ void Node::setRunningFlag(bool flag) {
 }
 bool Node::isRunning() { return is_running_; }
 
+void Node::setDedicatedThreadFlag(bool flag) { is_dedicated_thread_ = flag; }
+bool Node::getDedicatedThreadFlag() { return is_dedicated_thread_; }
+
 void Node::setStream(device::Stream *stream) {
   if (stream_ != nullptr) {
     device::destroyStream(stream_);
@@ -248,6 +248,11 @@ base::Status topoSortBFS(std::vector<NodeWrapper *> &node_repository,
     NNDEPLOY_LOGE("No start node found in graph");
     return base::kStatusCodeErrorInvalidValue;
   }
+  // 所有前驱都出队后才加入队列，保证前驱总在后继之前
+  std::map<NodeWrapper *, int> in_degree;
+  for (auto node_wrapper : node_repository) {
+    in_degree[node_wrapper] = node_wrapper->predecessors_.size();
+  }
   std::deque<NodeWrapper *> node_deque;
   for (auto node_wrapper : start_nodes) {
     node_wrapper->color_ = base::kNodeColorGray;
@@ -256,20 +261,28 @@ base::Status topoSortBFS(std::vector<NodeWrapper *> &node_repository,
   while (!node_deque.empty()) {
     NodeWrapper *node_wrapper = node_deque.front();
     for (auto successor : node_wrapper->successors_) {
-      if (successor->color_ == base::kNodeColorWhite) {
-        successor->color_ = base::kNodeColorGray;
-        node_deque.emplace_back(successor);
-      } else if (successor->color_ == base::kNodeColorGray) {
-        continue;
-      } else {
+      if (successor->color_ != base::kNodeColorWhite) {
         NNDEPLOY_LOGE("Cycle detected in graph");
         return base::kStatusCodeErrorInvalidValue;
       }
+      if (--in_degree[successor] == 0) {
+        successor->color_ = base::kNodeColorGray;
+        node_deque.emplace_back(successor);
+      }
     }
     node_deque.pop_front();
     node_wrapper->color_ = base::kNodeColorBlack;
     topo_sort_node.emplace_back(node_wrapper);
   }
+  // 环上的节点入度不会减到0
+  for (auto node_wrapper : node_repository) {
+    if (node_wrapper->color_ == base::kNodeColorWhite &&
+        in_degree[node_wrapper] <
+            (int)node_wrapper->predecessors_.size()) {
+      NNDEPLOY_LOGE("Cycle detected in graph");
+      return base::kStatusCodeErrorInvalidValue;
+    }
+  }
 
   checkUnuseNode(node_repository);
 
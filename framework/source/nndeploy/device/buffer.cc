@@ -6,21 +6,30 @@
 namespace nndeploy {
 namespace device {
 
+// 设备开启了内存池时从内存池分配
 Buffer::Buffer(Device *device, size_t size) {
   device_ = device;
-  memory_pool_ = nullptr;
+  memory_pool_ = device->getMemoryPool();
   desc_ = size;
   memory_type_ = base::kMemoryTypeAllocate;
   ref_count_ = new int(1);
-  data_ = device->allocate(desc_);
+  if (memory_pool_ != nullptr) {
+    data_ = memory_pool_->allocate(desc_);
+  } else {
+    data_ = device->allocate(desc_);
+  }
 }
 Buffer::Buffer(Device *device, const BufferDesc &desc) {
   device_ = device;
-  memory_pool_ = nullptr;
+  memory_pool_ = device->getMemoryPool();
   desc_ = desc;
   memory_type_ = base::kMemoryTypeAllocate;
   ref_count_ = new int(1);
-  data_ = device->allocate(desc_);
+  if (memory_pool_ != nullptr) {
+    data_ = memory_pool_->allocate(desc_);
+  } else {
+    data_ = device->allocate(desc_);
+  }
 }
 
 Buffer::Buffer(Device *device, size_t size, void *ptr) {
@@ -0,0 +1,369 @@
+#include "nndeploy/device/caching_memory_pool.h"
+
+#include "nndeploy/device/buffer.h"
+
+namespace nndeploy {
+namespace device {
+
+namespace {
+
+// 线程本地缓存中每个size class最多缓存的块数
+const size_t kThreadCacheBlockNum = 4;
+// 线程本地缓存的总大小上限
+const size_t kThreadCacheMaxSize = size_t(64) << 20;
+// 块按地址分片登记，减少释放时的锁竞争；缓存中的块保留登记，复用时不再插入
+const int kShardNum = 16;
+// size class个数：kMinBlockSize一档，之后每个2的幂区间4档
+const int kSizeClassNum = 1 + (30 - 8) * 4;
+
+std::atomic<uint64_t> g_memory_pool_id{0};
+
+void updatePeak(std::atomic<size_t> &peak, size_t value) {
+  size_t prev = peak.load(std::memory_order_relaxed);
+  while (prev < value &&
+         !peak.compare_exchange_weak(prev, value, std::memory_order_relaxed)) {
+  }
+}
+
+}  // namespace
+
+struct CachingMemoryPool::ThreadCache {
+  std::mutex mutex_;
+  std::vector<std::vector<Block>> free_blocks_ =
+      std::vector<std::vector<Block>>(kSizeClassNum);
+  size_t cached_size_ = 0;
+};
+
+struct CachingMemoryPool::Arena {
+  struct Shard {
+    std::mutex mutex_;
+    std::unordered_map<void *, Block> blocks_;
+  };
+
+  Shard &getShard(void *ptr) {
+    size_t key = reinterpret_cast<size_t>(ptr) / kAlignment;
+    return shards_[key % kShardNum];
+  }
+
+  uint64_t key_ = 0;
+  bool pinned_ = false;
+
+  // 全局缓存与线程本地缓存的登记
+  std::mutex mutex_;
+  std::vector<std::vector<Block>> free_blocks_ =
+      std::vector<std::vector<Block>>(kSizeClassNum);
+  size_t cached_size_ = 0;
+  // 线程本地只持有weak_ptr，内存池析构后线程本地的条目随之失效
+  std::vector<std::shared_ptr<ThreadCache>> thread_caches_;
+
+  Shard shards_[kShardNum];
+
+  std::atomic<size_t> reserved_size_{0};
+  std::atomic<size_t> allocated_size_{0};
+  std::atomic<size_t> peak_allocated_size_{0};
+  std::atomic<size_t> thread_cached_size_{0};
+  std::atomic<size_t> allocate_count_{0};
+  std::atomic<size_t> cache_hit_count_{0};
+};
+
+CachingMemoryPool::CachingMemoryPool(Device *device)
+    : MemoryPool(device, base::kMemoryPoolTypeCaching) {
+  id_ = g_memory_pool_id.fetch_add(1);
+  max_cached_size_ = 0;
+  arena_ = new Arena();
+  arena_->key_ = id_ * 2;
+  arena_->pinned_ = false;
+  pinned_arena_ = new Arena();
+  pinned_arena_->key_ = id_ * 2 + 1;
+  pinned_arena_->pinned_ = true;
+}
+
+CachingMemoryPool::~CachingMemoryPool() {
+  this->deinit();
+  delete arena_;
+  delete pinned_arena_;
+}
+
+base::Status CachingMemoryPool::init() { return base::kStatusCodeOk; }
+base::Status CachingMemoryPool::init(size_t size) {
+  max_cached_size_ = size;
+  return base::kStatusCodeOk;
+}
+
+base::Status CachingMemoryPool::deinit() {
+  trimArena(*arena_);
+  trimArena(*pinned_arena_);
+  size_t allocated_size = arena_->allocated_size_.load() +
+                          pinned_arena_->allocated_size_.load();
+  if (allocated_size > 0) {
+    NNDEPLOY_LOGE("%zu bytes are still in use when memory pool deinit!\n",
+                  allocated_size);
+  }
+  return base::kStatusCodeOk;
+}
+
+void *CachingMemoryPool::allocate(size_t size) {
+  return allocateFrom(*arena_, size);
+}
+void *CachingMemoryPool::allocate(const BufferDesc &desc) {
+  return allocateFrom(*arena_, desc.getRealSize());
+}
+
+void CachingMemoryPool::deallocate(void *ptr) { deallocateTo(*arena_, ptr); }
+
+void *CachingMemoryPool::allocatePinned(size_t size) {
+  return allocateFrom(*pinned_arena_, size);
+}
+void *CachingMemoryPool::allocatePinned(const BufferDesc &desc) {
+  return allocateFrom(*pinned_arena_, desc.getRealSize());
+}
+
+void CachingMemoryPool::deallocatePinned(void *ptr) {
+  deallocateTo(*pinned_arena_, ptr);
+}
+
+base::Status CachingMemoryPool::trim() {
+  trimArena(*arena_);
+  trimArena(*pinned_arena_);
+  return base::kStatusCodeOk;
+}
+
+MemoryPoolStats CachingMemoryPool::getStats() {
+  MemoryPoolStats stats;
+  for (Arena *arena : {arena_, pinned_arena_}) {
+    stats.reserved_size_ += arena->reserved_size_.load();
+    stats.allocated_size_ += arena->allocated_size_.load();
+    stats.peak_allocated_size_ += arena->peak_allocated_size_.load();
+    stats.allocate_count_ += arena->allocate_count_.load();
+    stats.cache_hit_count_ += arena->cache_hit_count_.load();
+    stats.cached_size_ += arena->thread_cached_size_.load();
+    std::lock_guard<std::mutex> lock(arena->mutex_);
+    stats.cached_size_ += arena->cached_size_;
+  }
+  return stats;
+}
+
+int CachingMemoryPool::getSizeClass(size_t size, size_t &block_size) {
+  if (size <= kMinBlockSize) {
+    block_size = kMinBlockSize;
+    return 0;
+  }
+  if (size > kMaxCachedBlockSize) {
+    block_size = (size + kAlignment - 1) / kAlignment * kAlignment;
+    return -1;
+  }
+  // size在(2^shift, 2^(shift+1)]之间，按2^(shift-2)向上取整
+  int shift = 0;
+  for (size_t value = size - 1; value > 1; value >>= 1) {
+    shift++;
+  }
+  size_t step = size_t(1) << (shift - 2);
+  block_size = (size + step - 1) & ~(step - 1);
+  return 1 + (shift - 8) * 4 + (int)(block_size >> (shift - 2)) - 5;
+}
+
+void *CachingMemoryPool::allocateFrom(Arena &arena, size_t size) {
+  size_t block_size = 0;
+  int size_class = getSizeClass(size, block_size);
+  arena.allocate_count_.fetch_add(1, std::memory_order_relaxed);
+
+  Block block;
+  bool hit = false;
+  if (size_class >= 0) {
+    ThreadCache *cache = getThreadCache(arena);
+    {
+      std::lock_guard<std::mutex> lock(cache->mutex_);
+      auto &free_blocks = cache->free_blocks_[size_class];
+      if (!free_blocks.empty()) {
+        block = free_blocks.back();
+        free_blocks.pop_back();
+        cache->cached_size_ -= block.size_;
+        arena.thread_cached_size_.fetch_sub(block.size_);
+        hit = true;
+      }
+    }
+    if (!hit) {
+      std::lock_guard<std::mutex> lock(arena.mutex_);
+      auto &free_blocks = arena.free_blocks_[size_class];
+      if (!free_blocks.empty()) {
+        block = free_blocks.back();
+        free_blocks.pop_back();
+        arena.cached_size_ -= block.size_;
+        hit = true;
+      }
+    }
+  }
+
+  if (hit) {
+    arena.cache_hit_count_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    Device *device = getDevice();
+    size_t real_size = block_size + kAlignment;
+    void *base = arena.pinned_ ? device->allocatePinned(real_size)
+                               : device->allocate(real_size);
+    if (base == nullptr) {
+      // 设备内存不足时，归还所有缓存后重试一次
+      trimArena(arena);
+      base = arena.pinned_ ? device->allocatePinned(real_size)
+                           : device->allocate(real_size);
+      if (base == nullptr) {
+        NNDEPLOY_LOGE("memory pool allocate %zu bytes failed!\n", size);
+        return nullptr;
+      }
+    }
+    size_t address = reinterpret_cast<size_t>(base);
+    address = (address + kAlignment - 1) / kAlignment * kAlignment;
+    block.base_ = base;
+    block.ptr_ = reinterpret_cast<void *>(address);
+    block.size_ = block_size;
+    block.size_class_ = size_class;
+    arena.reserved_size_.fetch_add(real_size);
+  }
+
+  {
+    Arena::Shard &shard = arena.getShard(block.ptr_);
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    block.in_use_ = true;
+    shard.blocks_[block.ptr_] = block;
+  }
+  size_t allocated_size = arena.allocated_size_.fetch_add(block.size_) +
+                          block.size_;
+  updatePeak(arena.peak_allocated_size_, allocated_size);
+  return block.ptr_;
+}
+
+void CachingMemoryPool::deallocateTo(Arena &arena, void *ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  Block block;
+  {
+    Arena::Shard &shard = arena.getShard(ptr);
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    auto iter = shard.blocks_.find(ptr);
+    if (iter == shard.blocks_.end() || !iter->second.in_use_) {
+      NNDEPLOY_LOGE("ptr[%p] is not allocated by this memory pool!\n", ptr);
+      return;
+    }
+    iter->second.in_use_ = false;
+    block = iter->second;
+  }
+  arena.allocated_size_.fetch_sub(block.size_);
+
+  if (block.size_class_ < 0) {
+    releaseBlock(arena, block);
+    return;
+  }
+
+  ThreadCache *cache = getThreadCache(arena);
+  {
+    std::lock_guard<std::mutex> lock(cache->mutex_);
+    auto &free_blocks = cache->free_blocks_[block.size_class_];
+    if (free_blocks.size() < kThreadCacheBlockNum &&
+        cache->cached_size_ + block.size_ <= kThreadCacheMaxSize) {
+      free_blocks.push_back(block);
+      cache->cached_size_ += block.size_;
+      arena.thread_cached_size_.fetch_add(block.size_);
+      return;
+    }
+  }
+  std::lock_guard<std::mutex> lock(arena.mutex_);
+  arena.free_blocks_[block.size_class_].push_back(block);
+  arena.cached_size_ += block.size_;
+  shrinkCentral(arena);
+}
+
+CachingMemoryPool::ThreadCache *CachingMemoryPool::getThreadCache(
+    Arena &arena) {
+  // 内存池析构后其key不会再被使用，last_cache不会被误用
+  static thread_local uint64_t last_key = UINT64_MAX;
+  static thread_local ThreadCache *last_cache = nullptr;
+  static thread_local std::unordered_map<uint64_t, std::weak_ptr<ThreadCache>>
+      caches;
+  if (last_key == arena.key_) {
+    return last_cache;
+  }
+  ThreadCache *cache = nullptr;
+  auto iter = caches.find(arena.key_);
+  if (iter != caches.end()) {
+    cache = iter->second.lock().get();
+  } else {
+    // 新建条目前清理已析构的内存池留下的条目，条目数不超过存活的内存池数
+    for (auto it = caches.begin(); it != caches.end();) {
+      if (it->second.expired()) {
+        it = caches.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    std::shared_ptr<ThreadCache> shared_cache = std::make_shared<ThreadCache>();
+    {
+      std::lock_guard<std::mutex> lock(arena.mutex_);
+      arena.thread_caches_.emplace_back(shared_cache);
+    }
+    caches[arena.key_] = shared_cache;
+    cache = shared_cache.get();
+  }
+  last_key = arena.key_;
+  last_cache = cache;
+  return cache;
+}
+
+void CachingMemoryPool::releaseBlock(Arena &arena, const Block &block) {
+  {
+    Arena::Shard &shard = arena.getShard(block.ptr_);
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    shard.blocks_.erase(block.ptr_);
+  }
+  Device *device = getDevice();
+  if (arena.pinned_) {
+    device->deallocatePinned(block.base_);
+  } else {
+    device->deallocate(block.base_);
+  }
+  arena.reserved_size_.fetch_sub(block.size_ + kAlignment);
+}
+
+void CachingMemoryPool::shrinkCentral(Arena &arena) {
+  if (max_cached_size_ == 0) {
+    return;
+  }
+  // 优先归还大块
+  for (int i = kSizeClassNum - 1;
+       i >= 0 && arena.cached_size_ > max_cached_size_; --i) {
+    auto &free_blocks = arena.free_blocks_[i];
+    while (!free_blocks.empty() && arena.cached_size_ > max_cached_size_) {
+      Block block = free_blocks.back();
+      free_blocks.pop_back();
+      arena.cached_size_ -= block.size_;
+      releaseBlock(arena, block);
+    }
+  }
+}
+
+void CachingMemoryPool::trimArena(Arena &arena) {
+  std::vector<Block> blocks;
+  {
+    std::lock_guard<std::mutex> lock(arena.mutex_);
+    for (auto &cache : arena.thread_caches_) {
+      std::lock_guard<std::mutex> cache_lock(cache->mutex_);
+      for (auto &free_blocks : cache->free_blocks_) {
+        blocks.insert(blocks.end(), free_blocks.begin(), free_blocks.end());
+        free_blocks.clear();
+      }
+      arena.thread_cached_size_.fetch_sub(cache->cached_size_);
+      cache->cached_size_ = 0;
+    }
+    for (auto &free_blocks : arena.free_blocks_) {
+      blocks.insert(blocks.end(), free_blocks.begin(), free_blocks.end());
+      free_blocks.clear();
+    }
+    arena.cached_size_ = 0;
+  }
+  for (auto &block : blocks) {
+    releaseBlock(arena, block);
+  }
+}
+
+}  // namespace device
+}  // namespace nndeploy
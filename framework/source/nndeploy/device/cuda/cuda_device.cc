@@ -126,6 +126,27 @@ void CudaDevice::deallocate(void *ptr) {
   NNDEPLOY_CUDA_CHECK(cudaFree(ptr));
 }
 
+void *CudaDevice::allocatePinned(size_t size) {
+  BufferDesc desc(size);
+  return this->allocatePinned(desc);
+}
+void *CudaDevice::allocatePinned(const BufferDesc &desc) {
+  void *data = nullptr;
+  cudaError_t status = cudaMallocHost(&data, desc.getRealSize());
+  if (cudaSuccess != status) {
+    NNDEPLOY_LOGE("cuda alloc host failed with size %lu for %p, status:%d\n",
+                  desc.getRealSize(), data, status);
+    return nullptr;
+  }
+  return data;
+}
+void CudaDevice::deallocatePinned(void *ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  NNDEPLOY_CUDA_CHECK(cudaFreeHost(ptr));
+}
+
 base::Status CudaDevice::copy(void *src, void *dst, size_t size,
                               Stream *stream) {
   if (stream == nullptr) {
@@ -1,5 +1,7 @@
 #include "nndeploy/device/device.h"
 
+#include "nndeploy/device/memory_pool.h"
+
 namespace nndeploy {
 namespace device {
 
@@ -89,6 +91,59 @@ base::Status Device::destroyEvents(Event **events, size_t count) {
 
 base::DeviceType Device::getDeviceType() const { return device_type_; }
 
+base::Status Device::enableMemoryPool(base::MemoryPoolType memory_pool_type) {
+  if (memory_pool_ != nullptr) {
+    if (memory_pool_->getMemoryPoolType() == memory_pool_type) {
+      return base::kStatusCodeOk;
+    }
+    base::Status status = disableMemoryPool();
+    NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                           "disableMemoryPool failed!\n");
+  }
+  MemoryPool *memory_pool = createMemoryPool(this, memory_pool_type);
+  NNDEPLOY_CHECK_PARAM_NULL_RET_STATUS(memory_pool,
+                                       "createMemoryPool failed!\n");
+  base::Status status = memory_pool->init();
+  if (status != base::kStatusCodeOk) {
+    NNDEPLOY_LOGE("memory pool init failed!\n");
+    delete memory_pool;
+    return status;
+  }
+  memory_pool_ = memory_pool;
+  return base::kStatusCodeOk;
+}
+base::Status Device::disableMemoryPool() {
+  if (memory_pool_ == nullptr) {
+    return base::kStatusCodeOk;
+  }
+  if (memory_pool_->getStats().allocated_size_ > 0) {
+    NNDEPLOY_LOGE("memory pool is still in use, can not disable!\n");
+    return base::kStatusCodeErrorInvalidValue;
+  }
+  memory_pool_->deinit();
+  delete memory_pool_;
+  memory_pool_ = nullptr;
+  return base::kStatusCodeOk;
+}
+MemoryPool *Device::getMemoryPool() { return memory_pool_; }
+
+Device::~Device() {
+  // 仍有Buffer持有内存池中的内存时不释放内存池，避免Buffer析构时访问已释放的内存池
+  if (memory_pool_ != nullptr) {
+    size_t allocated_size = memory_pool_->getStats().allocated_size_;
+    if (allocated_size == 0) {
+      memory_pool_->deinit();
+      delete memory_pool_;
+    } else {
+      NNDEPLOY_LOGE(
+          "%zu bytes are still in use when device destroyed, memory pool is "
+          "leaked!\n",
+          allocated_size);
+    }
+  }
+  memory_pool_ = nullptr;
+}
+
 // Stream
 Stream::Stream(Device *device) : device_(device) {}
 
@@ -215,6 +270,18 @@ Device *getDevice(base::DeviceType device_type) {
   return architecture->getDevice(device_type.device_id_);
 }
 
+base::Status enableMemoryPool(base::DeviceType device_type,
+                              base::MemoryPoolType memory_pool_type) {
+  Device *device = getDevice(device_type);
+  NNDEPLOY_CHECK_PARAM_NULL_RET_STATUS(device, "getDevice failed!\n");
+  return device->enableMemoryPool(memory_pool_type);
+}
+base::Status disableMemoryPool(base::DeviceType device_type) {
+  Device *device = getDevice(device_type);
+  NNDEPLOY_CHECK_PARAM_NULL_RET_STATUS(device, "getDevice failed!\n");
+  return device->disableMemoryPool();
+}
+
 Stream *createStream(base::DeviceType device_type) {
   Device *device = getDevice(device_type);
   if (device == nullptr) {
@@ -2,6 +2,7 @@
 #include "nndeploy/device/memory_pool.h"
 
 #include "nndeploy/device/buffer.h"
+#include "nndeploy/device/caching_memory_pool.h"
 
 namespace nndeploy {
 namespace device {
@@ -27,10 +28,28 @@ base::Status MemoryPool::init(Buffer *buffer) {
   return base::kStatusCodeOk;
 }
 
+base::Status MemoryPool::trim() { return base::kStatusCodeOk; }
+MemoryPoolStats MemoryPool::getStats() { return MemoryPoolStats(); }
+
 Device *MemoryPool::getDevice() { return device_; }
 base::MemoryPoolType MemoryPool::getMemoryPoolType() {
   return memory_pool_type_;
 }
 
+MemoryPool *createMemoryPool(Device *device,
+                             base::MemoryPoolType memory_pool_type) {
+  MemoryPool *memory_pool = nullptr;
+  switch (memory_pool_type) {
+    case base::kMemoryPoolTypeCaching:
+      memory_pool = new CachingMemoryPool(device);
+      break;
+    default:
+      NNDEPLOY_LOGE("memory_pool_type[%d] is not implemented!\n",
+                    memory_pool_type);
+      break;
+  }
+  return memory_pool;
+}
+
 }  // namespace device
 }  // namespace nndeploy
@@ -23,8 +23,7 @@ Tensor::Tensor(Device *device, const TensorDesc &desc, const std::string &name,
                const base::IntVector &config)
     : name_(name), desc_(desc), is_external_(false) {
   BufferDesc buffer_desc = device->toBufferDesc(desc, config);
-  void *ptr = device->allocate(buffer_desc);
-  buffer_ = new Buffer(device, buffer_desc, ptr, base::kMemoryTypeAllocate);
+  buffer_ = new Buffer(device, buffer_desc);
   ref_count_ = new int(1);
 }
 Tensor::Tensor(Device *device, const TensorDesc &desc, void *data_ptr,
@@ -148,8 +147,7 @@ void Tensor::create(Device *device, const TensorDesc &desc,
   desc_ = desc;
   is_external_ = false;
   BufferDesc buffer_desc = device->toBufferDesc(desc, config);
-  void *ptr = device->allocate(buffer_desc);
-  buffer_ = new Buffer(device, buffer_desc, ptr, base::kMemoryTypeAllocate);
+  buffer_ = new Buffer(device, buffer_desc);
   ref_count_ = new int(1);
 }
 void Tensor::create(Device *device, const TensorDesc &desc, void *data_ptr,
@@ -222,8 +220,7 @@ void Tensor::allocate(Device *device, const base::IntVector &config) {
   }
   deallocate();
   is_external_ = false;
-  void *ptr = device->allocate(dst_buffer_desc);
-  buffer_ = new Buffer(device, dst_buffer_desc, ptr, base::kMemoryTypeAllocate);
+  buffer_ = new Buffer(device, dst_buffer_desc);
   ref_count_ = new int(1);
 }
 void Tensor::allocate(MemoryPool *memory_pool, const base::IntVector &config) {
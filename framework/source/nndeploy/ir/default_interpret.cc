@@ -33,26 +33,16 @@ base::Status DefaultInterpret::interpret(
 
   // 读模型权重文件
   if (model_value.size() > 1 && !model_value[1].empty()) {
-    std::string warn, err;
-
-    std::shared_ptr<safetensors::safetensors_t> mmap_st_ptr(
-        new safetensors::safetensors_t());
-    // 冒险的需要用愿指针
-    bool ret = safetensors::mmap_from_file(model_value[1], &(*mmap_st_ptr),
-                                           &warn, &err);
-    if (!ret) {
-      NNDEPLOY_LOGE(
-          "Failed to load: %s\n"
-          "  ERR: %s\n",
-          model_value[1].c_str(), err.c_str());
-      return base::kStatusCodeErrorIO;
-    }
-
-    // if (st_ptr_ != nullptr) {
-    //   st_ptr_.reset();
-    // }
-    st_ptr_.emplace_back(mmap_st_ptr);
-    status = model_desc_->deserializeWeightsFromSafetensors(mmap_st_ptr);
+    // 权重文件只读映射，权重tensor直接指向映射区域
+    std::shared_ptr<WeightStore> weight_store(new WeightStore());
+    status = weight_store->load(model_value[1]);
+    NNDEPLOY_RETURN_VALUE_ON_NEQ(status, base::kStatusCodeOk, status,
+                                 "weight_store->load failed!");
+
+    // 由model_desc_持有，与权重的生命周期一致
+    model_desc_->weight_stores_.emplace_back(weight_store);
+    status = model_desc_->deserializeWeightsFromSafetensors(
+        weight_store->getSafetensors());
     NNDEPLOY_RETURN_VALUE_ON_NEQ(
         status, base::kStatusCodeOk, status,
         "model_desc_->deserializeWeightsFromSafetensors failed!");
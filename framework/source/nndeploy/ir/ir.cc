@@ -678,5 +678,14 @@ base::Status ModelDesc::deserializeWeightsFromSafetensors(
   return status;
 }
 
+WeightStore *ModelDesc::getWeightStore(const std::string &weight_name) {
+  for (auto &weight_store : weight_stores_) {
+    if (weight_store->hasWeight(weight_name)) {
+      return weight_store.get();
+    }
+  }
+  return nullptr;
+}
+
 }  // namespace ir
 }  // namespace nndeploy
@@ -0,0 +1,111 @@
+#include "nndeploy/ir/weight_store.h"
+
+#include "nndeploy/base/log.h"
+
+namespace nndeploy {
+namespace ir {
+
+WeightStore::WeightStore() {}
+
+WeightStore::~WeightStore() {
+  // safetensors_t中的地址指向映射区域，先于映射释放
+  st_ptr_.reset();
+  file_.reset();
+}
+
+base::Status WeightStore::load(const std::string &path, bool prefetch) {
+  base::Status status = base::kStatusCodeOk;
+
+  std::shared_ptr<base::MappedFile> file(new base::MappedFile());
+  status = file->open(path);
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "MappedFile open failed!");
+
+  std::shared_ptr<safetensors::safetensors_t> st_ptr(
+      new safetensors::safetensors_t());
+  std::string warn, err;
+  bool ret = safetensors::load_from_mmap(file->getData(), file->getSize(),
+                                         path, &(*st_ptr), &warn, &err);
+  if (!ret) {
+    NNDEPLOY_LOGE(
+        "Failed to load: %s\n"
+        "  ERR: %s\n",
+        path.c_str(), err.c_str());
+    return base::kStatusCodeErrorIO;
+  }
+  if (!warn.empty()) {
+    NNDEPLOY_LOGI("load %s: %s\n", path.c_str(), warn.c_str());
+  }
+
+  st_ptr_ = st_ptr;
+  file_ = file;
+  if (prefetch) {
+    // 预读失败不影响使用
+    this->prefetch();
+  }
+  return status;
+}
+
+std::shared_ptr<safetensors::safetensors_t> &WeightStore::getSafetensors() {
+  return st_ptr_;
+}
+
+bool WeightStore::hasWeight(const std::string &name) {
+  return st_ptr_ != nullptr && st_ptr_->tensors.count(name);
+}
+
+base::Status WeightStore::prefetch() {
+  if (file_ == nullptr || st_ptr_ == nullptr) {
+    return base::kStatusCodeErrorInvalidParam;
+  }
+  size_t offset = st_ptr_->databuffer_addr - file_->getData();
+  return file_->advise(offset, st_ptr_->databuffer_size,
+                       base::kMappedFileAdviceWillNeed);
+}
+
+base::Status WeightStore::prefetch(const std::string &name) {
+  size_t offset = 0, size = 0;
+  if (!getWeightRange(name, offset, size)) {
+    return base::kStatusCodeErrorInvalidParam;
+  }
+  return file_->advise(offset, size, base::kMappedFileAdviceWillNeed);
+}
+
+base::Status WeightStore::release(const std::string &name) {
+  size_t offset = 0, size = 0;
+  if (!getWeightRange(name, offset, size)) {
+    return base::kStatusCodeErrorInvalidParam;
+  }
+  // 首尾不完整的页可能与相邻权重共享，只释放完整的页
+  size_t page_size = base::getPageSize();
+  size_t begin = (offset + page_size - 1) / page_size * page_size;
+  size_t end = (offset + size) / page_size * page_size;
+  if (end <= begin) {
+    return base::kStatusCodeOk;
+  }
+  return file_->advise(begin, end - begin, base::kMappedFileAdviceDontNeed);
+}
+
+size_t WeightStore::getMappedSize() {
+  return file_ != nullptr ? file_->getSize() : 0;
+}
+
+size_t WeightStore::getResidentSize() {
+  return file_ != nullptr ? file_->getResidentSize() : 0;
+}
+
+bool WeightStore::getWeightRange(const std::string &name, size_t &offset,
+                                 size_t &size) {
+  if (file_ == nullptr || st_ptr_ == nullptr) {
+    return false;
+  }
+  safetensors::tensor_t t_t;
+  if (!st_ptr_->tensors.at(name, &t_t)) {
+    return false;
+  }
+  offset = (st_ptr_->databuffer_addr - file_->getData()) + t_t.data_offsets[0];
+  size = t_t.data_offsets[1] - t_t.data_offsets[0];
+  return size > 0;
+}
+
+}  // namespace ir
+}  // namespace nndeploy
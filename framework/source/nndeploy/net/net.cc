@@ -95,6 +95,39 @@ device::Tensor *Net::getWeight(const std::string &weight) {
   }
   return weight_tensor;
 }
+device::Tensor *Net::getWeight(const std::string &weight,
+                               base::DeviceType device_type) {
+  device::Tensor *weight_tensor = getWeight(weight);
+  if (weight_tensor == nullptr) {
+    return nullptr;
+  }
+  ir::WeightStore *weight_store = model_desc_->getWeightStore(weight);
+  if (device::isHostDeviceType(device_type) ||
+      weight_tensor->getDeviceType() == device_type) {
+    // host上直接使用映射区域，提前异步预读，init时不必逐页缺页
+    if (weight_store != nullptr) {
+      weight_store->prefetch(weight);
+    }
+    return weight_tensor;
+  }
+
+  device::Device *device = device::getDevice(device_type);
+  NNDEPLOY_CHECK_PARAM_NULL_RET_NULL(device, "device is null!");
+  device::Tensor *device_tensor =
+      new device::Tensor(device, weight_tensor->getDesc(), weight);
+  base::Status status = weight_tensor->copyTo(device_tensor);
+  delete weight_tensor;
+  if (status != base::kStatusCodeOk) {
+    NNDEPLOY_LOGE("upload weight[%s] failed!\n", weight.c_str());
+    delete device_tensor;
+    return nullptr;
+  }
+  // 已上传到设备，释放本进程中该权重的常驻页
+  if (weight_store != nullptr) {
+    weight_store->release(weight);
+  }
+  return device_tensor;
+}
 
 op::Op *Net::createOp(base::DeviceType device_type, const std::string &name,
                       ir::OpType op_type,
@@ -115,7 +148,11 @@ op::Op *Net::createOp(base::DeviceType device_type, const std::string &name,
     TensorWrapper *input_wrapper = findTensorWrapper(tensor_repository_, input);
     if (input_wrapper == nullptr) {
       if (isWeight(input)) {
-        device::Tensor *weight = getWeight(input);
+        device::Tensor *weight = getWeight(input, device_type);
+        if (weight == nullptr) {
+          NNDEPLOY_LOGE("get weight[%s] failed!\n", input.c_str());
+          return nullptr;
+        }
         // input_wrapper = new TensorWrapper();
         // input_wrapper->is_external_ = false;
         // input_wrapper->is_weight_ = true;
@@ -170,7 +207,11 @@ op::Op *Net::createOp(base::DeviceType device_type, const std::string &name,
     TensorWrapper *input_wrapper = findTensorWrapper(tensor_repository_, input);
     if (input_wrapper == nullptr) {
       if (isWeight(input)) {
-        device::Tensor *weight = getWeight(input);
+        device::Tensor *weight = getWeight(input, device_type);
+        if (weight == nullptr) {
+          NNDEPLOY_LOGE("get weight[%s] failed!\n", input.c_str());
+          return nullptr;
+        }
         // input_wrapper = new TensorWrapper();
         // input_wrapper->is_external_ = false;
         // input_wrapper->is_weight_ = true;
@@ -305,10 +346,13 @@ base::Status Net::deinit() {
   // NNDEPLOY_LOGI("#######################\n");
   // NNDEPLOY_LOGI("Op DeInitialize Phase!\n");
   // NNDEPLOY_LOGI("#######################\n");
-  status = runtime_->deinit();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "runtime deinit failed!");
-  delete runtime_;
-  runtime_ = nullptr;
+  if (runtime_ != nullptr) {
+    status = runtime_->deinit();
+    NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                           "runtime deinit failed!");
+    delete runtime_;
+    runtime_ = nullptr;
+  }
 
   for (auto op_wrapper : op_repository_) {
     if (!op_wrapper->is_external_) {
@@ -20,6 +20,17 @@ base::Status PipelineRuntime::setWorkers(
   return status;
 }
 
+void PipelineRuntime::setOpCosts(const std::map<std::string, float> &op_costs) {
+  op_costs_ = op_costs;
+}
+
+void PipelineRuntime::setCostModel(double flops_per_ms, double bytes_per_ms) {
+  flops_per_ms_ = flops_per_ms;
+  bytes_per_ms_ = bytes_per_ms;
+}
+
+float PipelineRuntime::getExpectedThroughput() { return expected_throughput_; }
+
 base::Status PipelineRuntime::init(
     std::vector<TensorWrapper *> &tensor_repository,
     std::vector<OpWrapper *> &op_repository,
@@ -44,22 +55,16 @@ base::Status PipelineRuntime::init(
     }
   }
 
-  // 平均切分op_repository
-  int ops_per_stage = op_repository.size() / worker_num_;
-  if (ops_per_stage == 0) {
-    ops_per_stage = 1;
-  }
+  // 按op的耗时切分op_repository
+  std::vector<int> stage_begin;
+  status = this->partition(tensor_repository, op_repository, stage_begin);
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "partition failed");
 
   // 为每个阶段创建SequentialRuntime
-  for (int i = 0; i < worker_num_; ++i) {
+  for (int i = 0; i + 1 < stage_begin.size(); ++i) {
     // 计算当前阶段的op范围
-    int start_idx = i * ops_per_stage;
-    int end_idx =
-        (i == worker_num_ - 1) ? op_repository.size() : (i + 1) * ops_per_stage;
-
-    if (start_idx >= op_repository.size()) {
-      break;  // 如果没有足够的op，提前结束
-    }
+    int start_idx = stage_begin[i];
+    int end_idx = stage_begin[i + 1];
 
     // 为当前阶段创建op和tensor子集
     std::shared_ptr<PipelineRuntimeStage> stage =
@@ -334,6 +339,151 @@ base::Status PipelineRuntime::postRun() {
   return status;
 }
 
+base::Status PipelineRuntime::partition(
+    std::vector<TensorWrapper *> &tensor_repository,
+    std::vector<OpWrapper *> &op_repository, std::vector<int> &stage_begin) {
+  int op_num = op_repository.size();
+  int stage_num = std::min(worker_num_, op_num);
+  stage_begin.clear();
+  if (op_num == 0) {
+    stage_begin.push_back(0);
+    return base::kStatusCodeOk;
+  }
+  if (flops_per_ms_ <= 0.0 || bytes_per_ms_ <= 0.0) {
+    NNDEPLOY_LOGE("flops_per_ms_ and bytes_per_ms_ must be positive\n");
+    return base::kStatusCodeErrorInvalidParam;
+  }
+
+  std::map<OpWrapper *, int> op_index;
+  for (int i = 0; i < op_num; ++i) {
+    op_index[op_repository[i]] = i;
+  }
+
+  // 优先使用外部给定的耗时，其次按flops估算
+  bool use_op_costs = !op_costs_.empty();
+  for (auto op : op_repository) {
+    if (op_costs_.find(op->name_) == op_costs_.end()) {
+      use_op_costs = false;
+      break;
+    }
+  }
+  if (!op_costs_.empty() && !use_op_costs) {
+    NNDEPLOY_LOGW("op costs do not cover all ops, use flops instead\n");
+  }
+  std::vector<double> op_cost(op_num, 0.0);
+  for (int i = 0; i < op_num; ++i) {
+    OpWrapper *op = op_repository[i];
+    if (use_op_costs) {
+      op_cost[i] = op_costs_[op->name_];
+    } else {
+      op_cost[i] = (double)op->op_->getFlops() / flops_per_ms_;
+    }
+  }
+
+  // 激活值tensor的生产者与传输耗时，op_inputs记录每个op读取的tensor
+  std::vector<int> tensor_producer;
+  std::vector<double> tensor_cost;
+  std::vector<std::vector<int>> op_inputs(op_num);
+  for (auto tensor : tensor_repository) {
+    if (tensor->is_weight_) {
+      continue;
+    }
+    int id = tensor_producer.size();
+    int producer = -1;
+    for (auto op : tensor->producers_) {
+      auto iter = op_index.find(op);
+      if (iter != op_index.end()) {
+        producer = std::max(producer, iter->second);
+      }
+    }
+    double bytes = (double)tensor->tensor_->getDataType().size();
+    for (auto dim : tensor->tensor_->getShape()) {
+      bytes *= std::max(dim, 1);
+    }
+    tensor_producer.push_back(producer);
+    tensor_cost.push_back(bytes / bytes_per_ms_);
+    for (auto op : tensor->consumers_) {
+      auto iter = op_index.find(op);
+      if (iter != op_index.end()) {
+        insertUnique(op_inputs[iter->second], id);
+      }
+    }
+  }
+
+  // dp[k][j]: 前j个op切成k个阶段时耗时最长阶段的最小值，from[k][j]为最后一个阶段的起点
+  const double inf = std::numeric_limits<double>::max();
+  std::vector<std::vector<double>> dp(stage_num + 1,
+                                      std::vector<double>(op_num + 1, inf));
+  std::vector<std::vector<int>> from(stage_num + 1,
+                                     std::vector<int>(op_num + 1, -1));
+  std::vector<int> counted(tensor_producer.size(), -1);
+  dp[0][0] = 0.0;
+  for (int k = 1; k <= stage_num; ++k) {
+    for (int i = k - 1; i < op_num; ++i) {
+      if (dp[k - 1][i] == inf) {
+        continue;
+      }
+      // 阶段[i, j)的耗时随j递增地累加
+      double cost = 0.0;
+      int stamp = k * (op_num + 1) + i;
+      for (int j = i + 1; j <= op_num; ++j) {
+        cost += op_cost[j - 1];
+        for (int id : op_inputs[j - 1]) {
+          if (tensor_producer[id] < i && counted[id] != stamp) {
+            counted[id] = stamp;
+            cost += tensor_cost[id];
+          }
+        }
+        double value = std::max(dp[k - 1][i], cost);
+        if (value < dp[k][j]) {
+          dp[k][j] = value;
+          from[k][j] = i;
+        }
+      }
+    }
+  }
+
+  // 耗时相同时选择更少的阶段，延迟更低
+  int best_k = 1;
+  for (int k = 2; k <= stage_num; ++k) {
+    if (dp[k][op_num] < dp[best_k][op_num] * (1.0 - 1e-6)) {
+      best_k = k;
+    }
+  }
+  stage_begin.resize(best_k + 1);
+  stage_begin[best_k] = op_num;
+  for (int k = best_k, j = op_num; k > 0; --k) {
+    j = from[k][j];
+    stage_begin[k - 1] = j;
+  }
+
+  double max_cost = dp[best_k][op_num];
+  expected_throughput_ = max_cost > 0.0 ? (float)(1000.0 / max_cost) : 0.0f;
+  for (int k = 0; k < best_k; ++k) {
+    int begin = stage_begin[k];
+    int end = stage_begin[k + 1];
+    double compute = 0.0;
+    double transfer = 0.0;
+    std::set<int> inputs;
+    for (int j = begin; j < end; ++j) {
+      compute += op_cost[j];
+      for (int id : op_inputs[j]) {
+        if (tensor_producer[id] < begin && inputs.insert(id).second) {
+          transfer += tensor_cost[id];
+        }
+      }
+    }
+    NNDEPLOY_LOGI("stage %d: op [%d, %d), compute %.3f ms, transfer %.3f ms\n",
+                  k, begin, end, compute, transfer);
+  }
+  NNDEPLOY_LOGI(
+      "pipeline stages: %d, max stage cost: %.3f ms, expected throughput: %.2f "
+      "fps (%s)\n",
+      best_k, max_cost, expected_throughput_,
+      use_op_costs ? "op costs" : "flops");
+  return base::kStatusCodeOk;
+}
+
 void PipelineRuntime::commitThreadPool() {
   for (int i = 0; i < sequential_runtimes_.size(); ++i) {
     SequentialRuntime *runtime = sequential_runtimes_[i];
@@ -3,6 +3,7 @@
 #include "nndeploy/net/runtime/sequential_runtime.h"
 
 #include "nndeploy/base/time_profiler.h"
+#include "nndeploy/base/trace.h"
 
 namespace nndeploy {
 namespace net {
@@ -96,6 +97,7 @@ base::Status SequentialRuntime::deinit() {
     }
   }
   delete tensor_pool_;
+  op_trace_ids_.clear();
   return status;
 }
 
@@ -214,8 +216,16 @@ base::Status SequentialRuntime::run() {
   }
   // 运行
   NNDEPLOY_TIME_POINT_START("net->run()");
-  for (auto iter : op_repository_) {
+  if (op_trace_ids_.size() != op_repository_.size()) {
+    op_trace_ids_ = std::vector<std::atomic<uint32_t>>(op_repository_.size());
+  }
+  NNDEPLOY_TRACE_SCOPE("net->run()", base::kTraceCategoryRuntime);
+  for (size_t i = 0; i < op_repository_.size(); ++i) {
+    OpWrapper *iter = op_repository_[i];
+    NNDEPLOY_TRACE_BEGIN(op_trace_ids_[i], iter->op_->getName(),
+                         base::kTraceCategoryOp);
     status = iter->op_->run();
+    NNDEPLOY_TRACE_END();
     // NNDEPLOY_LOGE("Node %s run\n", iter->op_->getName().c_str());
     if (status != base::kStatusCodeOk) {
       NNDEPLOY_LOGE("Node %s run failed\n", iter->op_->getName().c_str());
@@ -0,0 +1,330 @@
+#include "nndeploy/net/tensor_pool/tensor_pool_1d_offset_calculate_inplace.h"
+
+#include "nndeploy/net/tensor_pool.h"
+
+namespace nndeploy {
+namespace net {
+
+// tensorpool OffsetCalculateInplace 实现
+
+TypeTensorPoolRegister<TypeTensorPoolCreator<TensorPool1DOffsetCalculateInplace>>
+    g_tensor_pool_1d_offset_calculate_inplace_register(
+        kTensorPool1DOffsetCalculateTypeInplace);
+
+namespace {
+
+// 每个组的起始地址按该字节数对齐
+const size_t kOffsetAlignment = 64;
+
+bool isIntersect(const std::vector<std::array<int, 2>> &a,
+                 const std::vector<std::array<int, 2>> &b) {
+  for (const auto &x : a) {
+    for (const auto &y : b) {
+      if (x[0] <= y[1] && y[0] <= x[1]) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void mergeIntervals(std::vector<std::array<int, 2>> &intervals) {
+  std::sort(intervals.begin(), intervals.end());
+  std::vector<std::array<int, 2>> merged;
+  for (const auto &interval : intervals) {
+    if (!merged.empty() && interval[0] <= merged.back()[1] + 1) {
+      merged.back()[1] = std::max(merged.back()[1], interval[1]);
+    } else {
+      merged.push_back(interval);
+    }
+  }
+  intervals.swap(merged);
+}
+
+}  // namespace
+
+TensorPool1DOffsetCalculateInplace::TensorPool1DOffsetCalculateInplace(
+    device::Device *device, std::vector<TensorWrapper *> &tensor_repository,
+    std::vector<OpWrapper *> &op_repository)
+    : TensorPool1D(device, tensor_repository, op_repository) {}
+
+TensorPool1DOffsetCalculateInplace::~TensorPool1DOffsetCalculateInplace() {}
+
+bool TensorPool1DOffsetCalculateInplace::isInplaceOp(ir::OpType op_type) {
+  switch (op_type) {
+    case ir::kOpTypeRelu:
+    case ir::kOpTypeSigmoid:
+    case ir::kOpTypeAdd:
+    case ir::kOpTypeMul:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool TensorPool1DOffsetCalculateInplace::isViewOp(ir::OpType op_type) {
+  switch (op_type) {
+    case ir::kOpTypeReshape:
+    case ir::kOpTypeFlatten:
+      return true;
+    default:
+      return false;
+  }
+}
+
+base::Status TensorPool1DOffsetCalculateInplace::allocate() {
+  base::Status status = base::kStatusCodeOk;
+
+  total_consumption_ = this->getMemorySize();
+  if (total_consumption_ < 0) {
+    NNDEPLOY_LOGE("getMemorySize failed\n");
+    return base::kStatusCodeErrorOutOfMemory;
+  }
+  // 分配内存
+  if (is_external_ == false) {
+    mem_block_ = new device::Buffer(device_, total_consumption_);
+  }
+  uint8_t *data_ptr = (uint8_t *)mem_block_->getData();
+  for (auto &group : alias_groups_) {
+    for (auto &t : group->tensor_usage_records_) {
+      device::Buffer *buffer =
+          new device::Buffer(device_, t->size_, data_ptr + group->offset_);
+      t->tensor_wrapper_->tensor_->justModify(buffer, false);
+    }
+  }
+
+  tensorUsageRecordPrint(tensor_usage_records_);
+  NNDEPLOY_LOGI("Total memory size: %zu (OffSetInplace)\n",
+                (size_t)total_consumption_);
+
+  return status;
+}
+
+base::Status TensorPool1DOffsetCalculateInplace::deallocate() {
+  base::Status status = base::kStatusCodeOk;
+
+  for (auto tensor_wrapper : tensor_repository_) {
+    auto tensor = tensor_wrapper->tensor_;
+    tensor->deallocate();
+  }
+
+  if (mem_block_ != nullptr && is_external_ == false) {
+    delete mem_block_;
+    mem_block_ = nullptr;
+  }
+
+  status = deinitAliasGroup();
+  if (status != base::kStatusCodeOk) {
+    NNDEPLOY_LOGE("deinitAliasGroup failed\n");
+    return status;
+  }
+
+  status = deinitTensorUsageRecord();
+  if (status != base::kStatusCodeOk) {
+    NNDEPLOY_LOGE("deinitTensorUsageRecord failed\n");
+    return status;
+  }
+
+  return status;
+}
+
+int64_t TensorPool1DOffsetCalculateInplace::getMemorySize() {
+  base::Status status = base::kStatusCodeOk;
+
+  // 可能被多次调用，先清理上一次的结果
+  deinitAliasGroup();
+  deinitTensorUsageRecord();
+
+  // 初始化TensorUsageRecord, 对tensor大小进行排序
+  status = initTensorUsageRecord();
+  if (status != base::kStatusCodeOk) {
+    NNDEPLOY_LOGE("initTensorUsageRecord failed\n");
+    return -1;
+  }
+
+  // 不做inplace时的内存大小，仅用于统计
+  status = initAliasGroup(false);
+  if (status != base::kStatusCodeOk) {
+    NNDEPLOY_LOGE("initAliasGroup failed\n");
+    return -1;
+  }
+  size_t size_without_inplace =
+      TensorPool1DOffsetCalculateInplace::calculateOffset();
+  size_t group_num_without_inplace = alias_groups_.size();
+  deinitAliasGroup();
+
+  status = initAliasGroup(true);
+  if (status != base::kStatusCodeOk) {
+    NNDEPLOY_LOGE("initAliasGroup failed\n");
+    return -1;
+  }
+  total_consumption_ = calculateOffset();
+  for (auto &group : alias_groups_) {
+    for (auto &t : group->tensor_usage_records_) {
+      t->is_allocated_ = true;
+      t->offset_ = (int)group->offset_;
+    }
+  }
+
+  NNDEPLOY_LOGI(
+      "inplace tensor: %zu, memory size: %zu -> %zu (OffSetInplace)\n",
+      group_num_without_inplace - alias_groups_.size(), size_without_inplace,
+      (size_t)total_consumption_);
+  return total_consumption_;
+}
+
+base::Status TensorPool1DOffsetCalculateInplace::setMemory(
+    device::Buffer *buffer) {
+  if (mem_block_ != nullptr && is_external_ == false) {
+    delete mem_block_;
+    mem_block_ = nullptr;
+  }
+  if (buffer == nullptr) {
+    NNDEPLOY_LOGE("buffer is nullptr\n");
+    return base::kStatusCodeErrorInvalidValue;
+  }
+  if (buffer->getRealSize() < total_consumption_) {
+    NNDEPLOY_LOGE("buffer size is too small\n");
+    return base::kStatusCodeErrorInvalidValue;
+  }
+  is_external_ = true;
+  mem_block_ = buffer;
+  return base::kStatusCodeOk;
+}
+
+base::Status TensorPool1DOffsetCalculateInplace::initAliasGroup(
+    bool enable_inplace) {
+  base::Status status = base::kStatusCodeOk;
+
+  std::map<device::Tensor *, std::shared_ptr<TensorUsageRecord>> record_map;
+  std::map<TensorUsageRecord *, std::shared_ptr<TensorAliasGroup>> group_map;
+  for (auto &t : tensor_usage_records_) {
+    auto group = std::make_shared<TensorAliasGroup>();
+    group->tensor_usage_records_.push_back(t);
+    group->intervals_.push_back(t->interval_);
+    group->size_ = t->size_;
+    group->end_ = t->interval_[1];
+    group->is_io_ = t->tensor_wrapper_->input_output_type_ != kNone;
+    record_map[t->tensor_wrapper_->tensor_] = t;
+    group_map[t.get()] = group;
+  }
+
+  // 按执行顺序合并inplace算子的输入输出
+  for (int i = 0; enable_inplace && i < (int)op_repository_.size(); i++) {
+    op::Op *op = op_repository_[i]->op_;
+    ir::OpType op_type = op->getOpType();
+    bool is_view = isViewOp(op_type);
+    if (!is_view && !isInplaceOp(op_type)) {
+      continue;
+    }
+    std::vector<device::Tensor *> outputs = op->getAllOutput();
+    if (outputs.size() != 1 || record_map.count(outputs[0]) == 0) {
+      continue;
+    }
+    auto &output = record_map[outputs[0]];
+    if (output->tensor_wrapper_->producers_.size() != 1) {
+      continue;
+    }
+    auto output_group = group_map[output.get()];
+    std::vector<device::Tensor *> inputs = op->getAllInput();
+    if (is_view) {
+      inputs.resize(std::min(inputs.size(), (size_t)1));
+    }
+    for (auto input_tensor : inputs) {
+      if (record_map.count(input_tensor) == 0) {
+        continue;
+      }
+      auto &input = record_map[input_tensor];
+      auto input_group = group_map[input.get()];
+      if (input_group == output_group || input->size_ != output->size_) {
+        continue;
+      }
+      // 改写输入的内存时，组内所有tensor在该op之后都不能再被使用
+      if (!is_view && (input_group->is_io_ || input_group->end_ != i)) {
+        continue;
+      }
+      for (auto &t : output_group->tensor_usage_records_) {
+        input_group->tensor_usage_records_.push_back(t);
+        group_map[t.get()] = input_group;
+      }
+      input_group->intervals_.insert(input_group->intervals_.end(),
+                                     output_group->intervals_.begin(),
+                                     output_group->intervals_.end());
+      input_group->size_ = std::max(input_group->size_, output_group->size_);
+      input_group->end_ = std::max(input_group->end_, output_group->end_);
+      input_group->is_io_ = input_group->is_io_ || output_group->is_io_;
+      break;
+    }
+  }
+
+  std::set<TensorAliasGroup *> visited;
+  for (auto &t : tensor_usage_records_) {
+    auto group = group_map[t.get()];
+    if (visited.count(group.get()) != 0) {
+      continue;
+    }
+    visited.insert(group.get());
+    mergeIntervals(group->intervals_);
+    group->size_ = (group->size_ + kOffsetAlignment - 1) / kOffsetAlignment *
+                   kOffsetAlignment;
+    alias_groups_.push_back(group);
+  }
+  std::stable_sort(alias_groups_.begin(), alias_groups_.end(),
+                   [](const std::shared_ptr<TensorAliasGroup> &a,
+                      const std::shared_ptr<TensorAliasGroup> &b) {
+                     return a->size_ > b->size_;
+                   });
+
+  return status;
+}
+
+base::Status TensorPool1DOffsetCalculateInplace::deinitAliasGroup() {
+  base::Status status = base::kStatusCodeOk;
+
+  alias_groups_.clear();
+
+  return status;
+}
+
+size_t TensorPool1DOffsetCalculateInplace::calculateOffset() {
+  size_t total_size = 0;
+  std::vector<TensorAliasGroup *> assigned;
+  for (auto &group : alias_groups_) {
+    // 生命周期相交的已分配组按偏移量排序
+    std::vector<TensorAliasGroup *> conflicts;
+    for (auto other : assigned) {
+      if (isIntersect(group->intervals_, other->intervals_)) {
+        conflicts.push_back(other);
+      }
+    }
+    std::sort(conflicts.begin(), conflicts.end(),
+              [](TensorAliasGroup *a, TensorAliasGroup *b) {
+                return a->offset_ < b->offset_;
+              });
+
+    // 在相交组之间寻找能放下的最小空隙，没有则放在末尾
+    size_t best_offset = SIZE_MAX;
+    size_t smallest_gap = SIZE_MAX;
+    size_t prev_end = 0;
+    for (auto other : conflicts) {
+      if (other->offset_ > prev_end) {
+        size_t gap = other->offset_ - prev_end;
+        if (gap >= group->size_ && gap < smallest_gap) {
+          smallest_gap = gap;
+          best_offset = prev_end;
+        }
+      }
+      prev_end = std::max(prev_end, other->offset_ + other->size_);
+    }
+    if (best_offset == SIZE_MAX) {
+      best_offset = prev_end;
+    }
+    group->offset_ = best_offset;
+    total_size = std::max(total_size, best_offset + group->size_);
+    assigned.push_back(group.get());
+  }
+  return total_size;
+}
+
+}  // namespace net
+}  // namespace nndeploy
@@ -0,0 +1,219 @@
+#include "nndeploy/net/tensor_pool/tensor_pool_1d_offset_calculate_optimal.h"
+
+#include "nndeploy/net/tensor_pool.h"
+
+namespace nndeploy {
+namespace net {
+
+// tensorpool OffsetCalculateOptimal 实现
+
+TypeTensorPoolRegister<TypeTensorPoolCreator<TensorPool1DOffsetCalculateOptimal>>
+    g_tensor_pool_1d_offset_calculate_optimal_register(
+        kTensorPool1DOffsetCalculateTypeOptimal);
+
+struct TensorPool1DOffsetCalculateOptimal::Search {
+  std::vector<size_t> size_;
+  std::vector<std::vector<int>> conflicts_;
+  std::vector<std::vector<int>> live_ops_;
+  // 每个时刻尚未放置的组的大小之和
+  std::vector<size_t> remain_;
+  std::vector<size_t> offset_;
+  std::vector<bool> placed_;
+  int placed_num_ = 0;
+
+  size_t best_ = SIZE_MAX;
+  std::vector<size_t> best_offset_;
+  size_t lower_bound_ = 0;
+
+  std::chrono::steady_clock::time_point deadline_;
+  size_t node_num_ = 0;
+  bool timeout_ = false;
+
+  // 不低于from、且与已放置的相交组都不重叠的最低偏移量
+  size_t lowestFit(int i, size_t from) {
+    std::vector<std::pair<size_t, size_t>> ranges;
+    for (int j : conflicts_[i]) {
+      if (placed_[j]) {
+        ranges.emplace_back(offset_[j], offset_[j] + size_[j]);
+      }
+    }
+    std::sort(ranges.begin(), ranges.end());
+    size_t pos = from;
+    for (auto &range : ranges) {
+      if (range.second <= pos) {
+        continue;
+      }
+      if (range.first >= pos + size_[i]) {
+        break;
+      }
+      pos = range.second;
+    }
+    return pos;
+  }
+
+  size_t maxRemain() {
+    size_t max = 0;
+    for (size_t value : remain_) {
+      max = std::max(max, value);
+    }
+    return max;
+  }
+
+  void place(int i, size_t offset) {
+    offset_[i] = offset;
+    placed_[i] = true;
+    placed_num_++;
+    for (int t : live_ops_[i]) {
+      remain_[t] -= size_[i];
+    }
+  }
+
+  void unplace(int i) {
+    placed_[i] = false;
+    placed_num_--;
+    for (int t : live_ops_[i]) {
+      remain_[t] += size_[i];
+    }
+  }
+};
+
+TensorPool1DOffsetCalculateOptimal::TensorPool1DOffsetCalculateOptimal(
+    device::Device *device, std::vector<TensorWrapper *> &tensor_repository,
+    std::vector<OpWrapper *> &op_repository)
+    : TensorPool1DOffsetCalculateInplace(device, tensor_repository,
+                                         op_repository) {}
+
+TensorPool1DOffsetCalculateOptimal::~TensorPool1DOffsetCalculateOptimal() {}
+
+void TensorPool1DOffsetCalculateOptimal::setTimeLimit(int time_limit_ms) {
+  time_limit_ms_ = time_limit_ms;
+}
+int TensorPool1DOffsetCalculateOptimal::getTimeLimit() {
+  return time_limit_ms_;
+}
+
+size_t TensorPool1DOffsetCalculateOptimal::calculateOffset() {
+  // 贪心的结果作为初始解
+  size_t greedy = TensorPool1DOffsetCalculateInplace::calculateOffset();
+  int n = alias_groups_.size();
+  int op_num = op_repository_.size();
+
+  Search s;
+  s.size_.resize(n);
+  s.conflicts_.resize(n);
+  s.live_ops_.resize(n);
+  s.remain_.resize(op_num, 0);
+  s.offset_.resize(n, 0);
+  s.placed_.resize(n, false);
+  s.best_ = greedy;
+  for (int i = 0; i < n; i++) {
+    s.size_[i] = alias_groups_[i]->size_;
+    s.best_offset_.push_back(alias_groups_[i]->offset_);
+    for (const auto &interval : alias_groups_[i]->intervals_) {
+      for (int t = std::max(interval[0], 0);
+           t <= std::min(interval[1], op_num - 1); t++) {
+        s.live_ops_[i].push_back(t);
+        s.remain_[t] += s.size_[i];
+      }
+    }
+  }
+  s.lower_bound_ = s.maxRemain();
+  if (s.best_ > s.lower_bound_) {
+    std::vector<std::vector<bool>> live(n, std::vector<bool>(op_num, false));
+    for (int i = 0; i < n; i++) {
+      for (int t : s.live_ops_[i]) {
+        live[i][t] = true;
+      }
+    }
+    for (int i = 0; i < n; i++) {
+      for (int j = i + 1; j < n; j++) {
+        for (int t : s.live_ops_[i]) {
+          if (live[j][t]) {
+            s.conflicts_[i].push_back(j);
+            s.conflicts_[j].push_back(i);
+            break;
+          }
+        }
+      }
+    }
+    s.deadline_ = std::chrono::steady_clock::now() +
+                  std::chrono::milliseconds(time_limit_ms_);
+    search(s, -1, 0, 0);
+  }
+
+  for (int i = 0; i < n; i++) {
+    alias_groups_[i]->offset_ = s.best_offset_[i];
+  }
+  bool is_optimal = !s.timeout_ || s.best_ == s.lower_bound_;
+  NNDEPLOY_LOGI(
+      "greedy: %zu, optimal: %zu, lower bound: %zu, node: %zu, %s "
+      "(OffSetOptimal)\n",
+      greedy, s.best_, s.lower_bound_, s.node_num_,
+      is_optimal ? "proved" : "time limit reached");
+  return s.best_;
+}
+
+void TensorPool1DOffsetCalculateOptimal::search(Search &s, int last,
+                                                size_t last_offset,
+                                                size_t peak) {
+  int n = s.size_.size();
+  if (s.placed_num_ == n) {
+    if (peak < s.best_) {
+      s.best_ = peak;
+      s.best_offset_ = s.offset_;
+    }
+    return;
+  }
+  if (s.timeout_ || s.best_ == s.lower_bound_) {
+    return;
+  }
+  if ((++s.node_num_ & 255) == 0 &&
+      std::chrono::steady_clock::now() > s.deadline_) {
+    s.timeout_ = true;
+    return;
+  }
+
+  // 候选按偏移量从低到高、大小从大到小展开
+  std::vector<std::pair<size_t, int>> candidates;
+  for (int i = 0; i < n; i++) {
+    if (s.placed_[i]) {
+      continue;
+    }
+    size_t offset = s.lowestFit(i, last_offset);
+    // 同一偏移量上互不相交的组，不同的放置顺序得到相同的布局，只保留一种
+    if (offset == last_offset && i < last) {
+      continue;
+    }
+    candidates.emplace_back(offset, i);
+  }
+  std::sort(candidates.begin(), candidates.end(),
+            [&s](const std::pair<size_t, int> &a,
+                 const std::pair<size_t, int> &b) {
+              if (a.first != b.first) {
+                return a.first < b.first;
+              }
+              return s.size_[a.second] > s.size_[b.second];
+            });
+
+  for (auto &candidate : candidates) {
+    size_t offset = candidate.first;
+    int i = candidate.second;
+    size_t new_peak = std::max(peak, offset + s.size_[i]);
+    if (new_peak >= s.best_) {
+      continue;
+    }
+    s.place(i, offset);
+    // 剩余的组都不低于offset，每个时刻至少再叠加剩余存活组的大小
+    size_t bound = std::max(new_peak, offset + s.maxRemain());
+    if (bound < s.best_) {
+      search(s, i, offset, new_peak);
+    }
+    s.unplace(i);
+    if (s.timeout_ || s.best_ == s.lower_bound_) {
+      return;
+    }
+  }
+}
+
+}  // namespace net
+}  // namespace nndeploy
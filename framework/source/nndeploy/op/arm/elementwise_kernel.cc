@@ -0,0 +1,196 @@
+
+#include "nndeploy/op/elementwise_kernel.h"
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace nndeploy {
+namespace op {
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+
+struct ElementwiseAddNeon {
+  static inline float32x4_t apply(float32x4_t a, float32x4_t b) {
+    return vaddq_f32(a, b);
+  }
+  static inline float apply(float a, float b) { return a + b; }
+};
+
+struct ElementwiseSubNeon {
+  static inline float32x4_t apply(float32x4_t a, float32x4_t b) {
+    return vsubq_f32(a, b);
+  }
+  static inline float apply(float a, float b) { return a - b; }
+};
+
+struct ElementwiseMulNeon {
+  static inline float32x4_t apply(float32x4_t a, float32x4_t b) {
+    return vmulq_f32(a, b);
+  }
+  static inline float apply(float a, float b) { return a * b; }
+};
+
+struct ElementwiseDivNeon {
+  static inline float32x4_t apply(float32x4_t a, float32x4_t b) {
+    return vdivq_f32(a, b);
+  }
+  static inline float apply(float a, float b) { return a / b; }
+};
+
+template <typename Op>
+static void elementwiseBinaryLoopNeon(const float *a, int a_step,
+                                      const float *b, int b_step, float *c,
+                                      int n) {
+  int i = 0;
+  if (a_step == 1 && b_step == 1) {
+    for (; i + 4 <= n; i += 4) {
+      vst1q_f32(c + i, Op::apply(vld1q_f32(a + i), vld1q_f32(b + i)));
+    }
+    for (; i < n; ++i) {
+      c[i] = Op::apply(a[i], b[i]);
+    }
+  } else if (a_step == 1) {
+    const float sb = b[0];
+    const float32x4_t vb = vdupq_n_f32(sb);
+    for (; i + 4 <= n; i += 4) {
+      vst1q_f32(c + i, Op::apply(vld1q_f32(a + i), vb));
+    }
+    for (; i < n; ++i) {
+      c[i] = Op::apply(a[i], sb);
+    }
+  } else if (b_step == 1) {
+    const float sa = a[0];
+    const float32x4_t va = vdupq_n_f32(sa);
+    for (; i + 4 <= n; i += 4) {
+      vst1q_f32(c + i, Op::apply(va, vld1q_f32(b + i)));
+    }
+    for (; i < n; ++i) {
+      c[i] = Op::apply(sa, b[i]);
+    }
+  } else {
+    std::fill(c, c + n, Op::apply(a[0], b[0]));
+  }
+}
+
+static void elementwiseBinaryNeon(ElementwiseBinaryType type, const float *a,
+                                  int a_step, const float *b, int b_step,
+                                  float *c, int n) {
+  switch (type) {
+    case kElementwiseBinaryTypeAdd:
+      elementwiseBinaryLoopNeon<ElementwiseAddNeon>(a, a_step, b, b_step, c,
+                                                    n);
+      break;
+    case kElementwiseBinaryTypeSub:
+      elementwiseBinaryLoopNeon<ElementwiseSubNeon>(a, a_step, b, b_step, c,
+                                                    n);
+      break;
+    case kElementwiseBinaryTypeMul:
+      elementwiseBinaryLoopNeon<ElementwiseMulNeon>(a, a_step, b, b_step, c,
+                                                    n);
+      break;
+    default:
+      elementwiseBinaryLoopNeon<ElementwiseDivNeon>(a, a_step, b, b_step, c,
+                                                    n);
+      break;
+  }
+}
+
+/**
+ * @brief 只向量化不需要超越函数的一元运算，其余走标量实现
+ * @note vmaxnmq/vminnmq在一个操作数为NaN时返回另一个，与标量实现一致
+ */
+static void elementwiseUnaryNeon(const ElementwiseUnary &unary, const float *x,
+                                 float *y, int n) {
+  const float32x4_t alpha = vdupq_n_f32(unary.alpha_);
+  const float32x4_t beta = vdupq_n_f32(unary.beta_);
+  int i = 0;
+  switch (unary.type_) {
+    case kElementwiseUnaryTypeRelu:
+      for (; i + 4 <= n; i += 4) {
+        vst1q_f32(y + i, vmaxnmq_f32(vld1q_f32(x + i), vdupq_n_f32(0.0f)));
+      }
+      break;
+    case kElementwiseUnaryTypeSqrt:
+      for (; i + 4 <= n; i += 4) {
+        vst1q_f32(y + i, vsqrtq_f32(vld1q_f32(x + i)));
+      }
+      break;
+    case kElementwiseUnaryTypeAbs:
+      for (; i + 4 <= n; i += 4) {
+        vst1q_f32(y + i, vabsq_f32(vld1q_f32(x + i)));
+      }
+      break;
+    case kElementwiseUnaryTypeNeg:
+      for (; i + 4 <= n; i += 4) {
+        vst1q_f32(y + i, vnegq_f32(vld1q_f32(x + i)));
+      }
+      break;
+    case kElementwiseUnaryTypeLinear:
+      for (; i + 4 <= n; i += 4) {
+        vst1q_f32(y + i, vfmaq_f32(beta, alpha, vld1q_f32(x + i)));
+      }
+      break;
+    case kElementwiseUnaryTypeClip:
+      for (; i + 4 <= n; i += 4) {
+        float32x4_t v = vmaxnmq_f32(vld1q_f32(x + i), alpha);
+        vst1q_f32(y + i, vminnmq_f32(v, beta));
+      }
+      break;
+    default:
+      break;
+  }
+  for (; i < n; ++i) {
+    y[i] = elementwiseUnaryScalar(unary, x[i]);
+  }
+}
+
+static void loadFp16Neon(const void *src, float *dst, int n) {
+  const uint16_t *s = static_cast<const uint16_t *>(src);
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    float16x4_t h = vreinterpret_f16_u16(vld1_u16(s + i));
+    vst1q_f32(dst + i, vcvt_f32_f16(h));
+  }
+  if (i < n) {
+    uint16_t tail[4] = {0};
+    memcpy(tail, s + i, (n - i) * sizeof(uint16_t));
+    float out[4];
+    vst1q_f32(out, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(tail))));
+    memcpy(dst + i, out, (n - i) * sizeof(float));
+  }
+}
+
+static void storeFp16Neon(const float *src, void *dst, int n) {
+  uint16_t *d = static_cast<uint16_t *>(dst);
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    float16x4_t h = vcvt_f16_f32(vld1q_f32(src + i));
+    vst1_u16(d + i, vreinterpret_u16_f16(h));
+  }
+  if (i < n) {
+    float tail[4] = {0.0f};
+    memcpy(tail, src + i, (n - i) * sizeof(float));
+    uint16_t out[4];
+    vst1_u16(out, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(tail))));
+    memcpy(d + i, out, (n - i) * sizeof(uint16_t));
+  }
+}
+
+static bool registerArmElementwiseKernels() {
+  ElementwiseKernel kernel("neon", 10);
+  kernel.binary_ = elementwiseBinaryNeon;
+  kernel.unary_ = elementwiseUnaryNeon;
+  kernel.load_fp16_ = loadFp16Neon;
+  kernel.store_fp16_ = storeFp16Neon;
+  registerElementwiseKernel(kernel);
+  return true;
+}
+
+static bool g_arm_elementwise_kernel_register =
+    registerArmElementwiseKernels();
+
+#endif
+
+}  // namespace op
+}  // namespace nndeploy
@@ -0,0 +1,82 @@
+
+#include "nndeploy/op/gemm_kernel.h"
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace nndeploy {
+namespace op {
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+
+/**
+ * @brief armv8 neon 8x8 微核，16个累加寄存器 + 2个A + 2个B寄存器
+ */
+static void sgemmMicroKernel8x8Neon(int kc, const float *a, const float *b,
+                                    float *c, int ldc, bool accumulate) {
+  float32x4_t c00 = vdupq_n_f32(0.0f), c01 = vdupq_n_f32(0.0f);
+  float32x4_t c10 = vdupq_n_f32(0.0f), c11 = vdupq_n_f32(0.0f);
+  float32x4_t c20 = vdupq_n_f32(0.0f), c21 = vdupq_n_f32(0.0f);
+  float32x4_t c30 = vdupq_n_f32(0.0f), c31 = vdupq_n_f32(0.0f);
+  float32x4_t c40 = vdupq_n_f32(0.0f), c41 = vdupq_n_f32(0.0f);
+  float32x4_t c50 = vdupq_n_f32(0.0f), c51 = vdupq_n_f32(0.0f);
+  float32x4_t c60 = vdupq_n_f32(0.0f), c61 = vdupq_n_f32(0.0f);
+  float32x4_t c70 = vdupq_n_f32(0.0f), c71 = vdupq_n_f32(0.0f);
+  for (int k = 0; k < kc; ++k) {
+    float32x4_t b0 = vld1q_f32(b);
+    float32x4_t b1 = vld1q_f32(b + 4);
+    float32x4_t a0 = vld1q_f32(a);
+    float32x4_t a1 = vld1q_f32(a + 4);
+    c00 = vfmaq_laneq_f32(c00, b0, a0, 0);
+    c01 = vfmaq_laneq_f32(c01, b1, a0, 0);
+    c10 = vfmaq_laneq_f32(c10, b0, a0, 1);
+    c11 = vfmaq_laneq_f32(c11, b1, a0, 1);
+    c20 = vfmaq_laneq_f32(c20, b0, a0, 2);
+    c21 = vfmaq_laneq_f32(c21, b1, a0, 2);
+    c30 = vfmaq_laneq_f32(c30, b0, a0, 3);
+    c31 = vfmaq_laneq_f32(c31, b1, a0, 3);
+    c40 = vfmaq_laneq_f32(c40, b0, a1, 0);
+    c41 = vfmaq_laneq_f32(c41, b1, a1, 0);
+    c50 = vfmaq_laneq_f32(c50, b0, a1, 1);
+    c51 = vfmaq_laneq_f32(c51, b1, a1, 1);
+    c60 = vfmaq_laneq_f32(c60, b0, a1, 2);
+    c61 = vfmaq_laneq_f32(c61, b1, a1, 2);
+    c70 = vfmaq_laneq_f32(c70, b0, a1, 3);
+    c71 = vfmaq_laneq_f32(c71, b1, a1, 3);
+    a += 8;
+    b += 8;
+  }
+#define NNDEPLOY_ARM_STORE_ROW_NEON(row, r0, r1)       \
+  do {                                                 \
+    float *c_row = c + (row) * ldc;                    \
+    if (accumulate) {                                  \
+      r0 = vaddq_f32(r0, vld1q_f32(c_row));            \
+      r1 = vaddq_f32(r1, vld1q_f32(c_row + 4));        \
+    }                                                  \
+    vst1q_f32(c_row, r0);                              \
+    vst1q_f32(c_row + 4, r1);                          \
+  } while (0)
+  NNDEPLOY_ARM_STORE_ROW_NEON(0, c00, c01);
+  NNDEPLOY_ARM_STORE_ROW_NEON(1, c10, c11);
+  NNDEPLOY_ARM_STORE_ROW_NEON(2, c20, c21);
+  NNDEPLOY_ARM_STORE_ROW_NEON(3, c30, c31);
+  NNDEPLOY_ARM_STORE_ROW_NEON(4, c40, c41);
+  NNDEPLOY_ARM_STORE_ROW_NEON(5, c50, c51);
+  NNDEPLOY_ARM_STORE_ROW_NEON(6, c60, c61);
+  NNDEPLOY_ARM_STORE_ROW_NEON(7, c70, c71);
+#undef NNDEPLOY_ARM_STORE_ROW_NEON
+}
+
+static bool registerArmSgemmMicroKernels() {
+  registerSgemmMicroKernel(
+      SgemmMicroKernel("neon_8x8", 8, 8, sgemmMicroKernel8x8Neon, 10));
+  return true;
+}
+
+static bool g_arm_sgemm_micro_kernel_register = registerArmSgemmMicroKernels();
+
+#endif
+
+}  // namespace op
+}  // namespace nndeploy
@@ -0,0 +1,654 @@
+
+#include "nndeploy/op/elementwise_kernel.h"
+
+#include "nndeploy/base/half.h"
+#include "nndeploy/thread_pool/parallel.h"
+
+namespace nndeploy {
+namespace op {
+
+// fp32块的长度，输入输出的块同时留在L1中
+static const int kElementwiseBlock = 1024;
+// 每个任务至少处理的元素数
+static const int64_t kElementwiseGrain = 16384;
+
+template <typename Func>
+static void elementwiseBinaryLoopRef(Func func, const float *a, int a_step,
+                                     const float *b, int b_step, float *c,
+                                     int n) {
+  // 按步长分开写循环，便于编译器向量化
+  if (a_step == 1 && b_step == 1) {
+    for (int i = 0; i < n; ++i) {
+      c[i] = func(a[i], b[i]);
+    }
+  } else if (a_step == 1) {
+    const float sb = b[0];
+    for (int i = 0; i < n; ++i) {
+      c[i] = func(a[i], sb);
+    }
+  } else if (b_step == 1) {
+    const float sa = a[0];
+    for (int i = 0; i < n; ++i) {
+      c[i] = func(sa, b[i]);
+    }
+  } else {
+    std::fill(c, c + n, func(a[0], b[0]));
+  }
+}
+
+static void elementwiseBinaryRef(ElementwiseBinaryType type, const float *a,
+                                 int a_step, const float *b, int b_step,
+                                 float *c, int n) {
+  switch (type) {
+    case kElementwiseBinaryTypeAdd:
+      elementwiseBinaryLoopRef([](float x, float y) { return x + y; }, a,
+                               a_step, b, b_step, c, n);
+      break;
+    case kElementwiseBinaryTypeSub:
+      elementwiseBinaryLoopRef([](float x, float y) { return x - y; }, a,
+                               a_step, b, b_step, c, n);
+      break;
+    case kElementwiseBinaryTypeMul:
+      elementwiseBinaryLoopRef([](float x, float y) { return x * y; }, a,
+                               a_step, b, b_step, c, n);
+      break;
+    default:
+      elementwiseBinaryLoopRef([](float x, float y) { return x / y; }, a,
+                               a_step, b, b_step, c, n);
+      break;
+  }
+}
+
+template <ElementwiseUnaryType type>
+static void elementwiseUnaryLoopRef(const ElementwiseUnary &unary,
+                                    const float *x, float *y, int n) {
+  ElementwiseUnary u(type, unary.alpha_, unary.beta_);
+  for (int i = 0; i < n; ++i) {
+    y[i] = elementwiseUnaryScalar(u, x[i]);
+  }
+}
+
+static void elementwiseUnaryRef(const ElementwiseUnary &unary, const float *x,
+                                float *y, int n) {
+#define NNDEPLOY_ELEMENTWISE_UNARY_CASE(type)      \
+  case type:                                       \
+    elementwiseUnaryLoopRef<type>(unary, x, y, n); \
+    break;
+  switch (unary.type_) {
+    NNDEPLOY_ELEMENTWISE_UNARY_CASE(kElementwiseUnaryTypeRelu)
+    NNDEPLOY_ELEMENTWISE_UNARY_CASE(kElementwiseUnaryTypeSigmoid)
+    NNDEPLOY_ELEMENTWISE_UNARY_CASE(kElementwiseUnaryTypeSilu)
+    NNDEPLOY_ELEMENTWISE_UNARY_CASE(kElementwiseUnaryTypeTanh)
+    NNDEPLOY_ELEMENTWISE_UNARY_CASE(kElementwiseUnaryTypeExp)
+    NNDEPLOY_ELEMENTWISE_UNARY_CASE(kElementwiseUnaryTypeSqrt)
+    NNDEPLOY_ELEMENTWISE_UNARY_CASE(kElementwiseUnaryTypeAbs)
+    NNDEPLOY_ELEMENTWISE_UNARY_CASE(kElementwiseUnaryTypeNeg)
+    NNDEPLOY_ELEMENTWISE_UNARY_CASE(kElementwiseUnaryTypeLinear)
+    NNDEPLOY_ELEMENTWISE_UNARY_CASE(kElementwiseUnaryTypeClip)
+    default:
+      if (x != y) {
+        memcpy(y, x, n * sizeof(float));
+      }
+      break;
+  }
+#undef NNDEPLOY_ELEMENTWISE_UNARY_CASE
+}
+
+static void loadFp16Ref(const void *src, float *dst, int n) {
+  base::convertFromFp16ToFloat(const_cast<void *>(src), dst, n);
+}
+
+// 四舍五入(ties to even)，溢出为±inf，NaN保持为quiet NaN，与F16C逐位一致；
+// base::convertFromFloatToFp16溢出时饱和并逐个元素打印日志，
+// half_float::half_cast默认ties away from zero，都不在这里使用
+static inline uint16_t floatToFp16Rne(float x) {
+  uint32_t u;
+  memcpy(&u, &x, sizeof(u));
+  const uint16_t sign = static_cast<uint16_t>((u >> 16) & 0x8000);
+  const uint32_t abs = u & 0x7fffffff;
+  if (abs > 0x7f800000) {
+    return sign | 0x7e00 | static_cast<uint16_t>((abs >> 13) & 0x3ff);
+  }
+  if (abs >= 0x477ff000) {  // 不小于65520，舍入后溢出
+    return sign | 0x7c00;
+  }
+  if (abs >= 0x38800000) {  // fp16的normal，指数偏置由127改为15
+    uint32_t m = abs - 0x38000000;
+    m += 0xfff + ((m >> 13) & 1);
+    return sign | static_cast<uint16_t>(m >> 13);
+  }
+  // fp16的subnormal：加0.5f后尾数的最低位恰为2^-24，由fpu完成舍入
+  float f;
+  memcpy(&f, &abs, sizeof(f));
+  f += 0.5f;
+  memcpy(&u, &f, sizeof(u));
+  return sign | static_cast<uint16_t>(u - 0x3f000000);
+}
+
+static void storeFp16Ref(const float *src, void *dst, int n) {
+  uint16_t *d = static_cast<uint16_t *>(dst);
+  for (int i = 0; i < n; ++i) {
+    d[i] = floatToFp16Rne(src[i]);
+  }
+}
+
+static void loadBfp16Ref(const void *src, float *dst, int n) {
+  const uint16_t *s = static_cast<const uint16_t *>(src);
+  for (int i = 0; i < n; ++i) {
+    uint32_t u = static_cast<uint32_t>(s[i]) << 16;
+    memcpy(dst + i, &u, sizeof(u));
+  }
+}
+
+// 四舍五入(ties to even)，base::bfp16_t为截断
+static void storeBfp16Ref(const float *src, void *dst, int n) {
+  uint16_t *d = static_cast<uint16_t *>(dst);
+  for (int i = 0; i < n; ++i) {
+    uint32_t u;
+    memcpy(&u, src + i, sizeof(u));
+    if ((u & 0x7fffffff) > 0x7f800000) {
+      d[i] = static_cast<uint16_t>((u >> 16) | 0x40);  // 保持为NaN
+    } else {
+      d[i] = static_cast<uint16_t>((u + 0x7fff + ((u >> 16) & 1)) >> 16);
+    }
+  }
+}
+
+static void loadInt8Ref(const void *src, float *dst, int n) {
+  const int8_t *s = static_cast<const int8_t *>(src);
+  for (int i = 0; i < n; ++i) {
+    dst[i] = static_cast<float>(s[i]);
+  }
+}
+
+static void storeInt8Ref(const float *src, void *dst, int n) {
+  int8_t *d = static_cast<int8_t *>(dst);
+  for (int i = 0; i < n; ++i) {
+    float x = src[i] > -128.0f ? src[i] : -128.0f;
+    x = x < 127.0f ? x : 127.0f;
+    d[i] = static_cast<int8_t>(std::nearbyint(x));
+  }
+}
+
+static std::vector<ElementwiseKernel> &getElementwiseKernelList() {
+  static std::vector<ElementwiseKernel> kernels = []() {
+    ElementwiseKernel kernel("ref", 0);
+    kernel.binary_ = elementwiseBinaryRef;
+    kernel.unary_ = elementwiseUnaryRef;
+    kernel.load_fp16_ = loadFp16Ref;
+    kernel.store_fp16_ = storeFp16Ref;
+    kernel.load_bfp16_ = loadBfp16Ref;
+    kernel.store_bfp16_ = storeBfp16Ref;
+    kernel.load_int8_ = loadInt8Ref;
+    kernel.store_int8_ = storeInt8Ref;
+    return std::vector<ElementwiseKernel>{kernel};
+  }();
+  return kernels;
+}
+
+static ElementwiseKernel mergeElementwiseKernels(
+    std::vector<ElementwiseKernel> kernels) {
+  std::stable_sort(kernels.begin(), kernels.end(),
+                   [](const ElementwiseKernel &a, const ElementwiseKernel &b) {
+                     return a.priority_ < b.priority_;
+                   });
+  ElementwiseKernel kernel = kernels[0];
+  for (auto &iter : kernels) {
+#define NNDEPLOY_ELEMENTWISE_MERGE(member) \
+  if (iter.member != nullptr) {            \
+    kernel.member = iter.member;           \
+  }
+    NNDEPLOY_ELEMENTWISE_MERGE(binary_);
+    NNDEPLOY_ELEMENTWISE_MERGE(unary_);
+    NNDEPLOY_ELEMENTWISE_MERGE(load_fp16_);
+    NNDEPLOY_ELEMENTWISE_MERGE(store_fp16_);
+    NNDEPLOY_ELEMENTWISE_MERGE(load_bfp16_);
+    NNDEPLOY_ELEMENTWISE_MERGE(store_bfp16_);
+    NNDEPLOY_ELEMENTWISE_MERGE(load_int8_);
+    NNDEPLOY_ELEMENTWISE_MERGE(store_int8_);
+#undef NNDEPLOY_ELEMENTWISE_MERGE
+    kernel.name_ = iter.name_;
+    kernel.priority_ = iter.priority_;
+  }
+  return kernel;
+}
+
+// 合并后的实现，每次注册时重新合并，不在第一次查询时固定
+static ElementwiseKernel &getBestElementwiseKernel() {
+  static ElementwiseKernel best =
+      mergeElementwiseKernels(getElementwiseKernelList());
+  return best;
+}
+
+void registerElementwiseKernel(const ElementwiseKernel &kernel) {
+  getElementwiseKernelList().push_back(kernel);
+  getBestElementwiseKernel() =
+      mergeElementwiseKernels(getElementwiseKernelList());
+}
+
+const ElementwiseKernel &getElementwiseKernel() {
+  return getBestElementwiseKernel();
+}
+
+ElementwiseOperand::ElementwiseOperand(device::Tensor *tensor)
+    : data_(tensor->getData()),
+      data_type_(tensor->getDataType()),
+      shape_(tensor->getShape()) {}
+
+namespace {
+
+enum ElementwiseDataType : int {
+  kElementwiseDataTypeFp32 = 0x0000,
+  kElementwiseDataTypeFp16,
+  kElementwiseDataTypeBfp16,
+  kElementwiseDataTypeInt8,
+
+  kElementwiseDataTypeNotSupport,
+};
+
+ElementwiseDataType getElementwiseDataType(const base::DataType &data_type) {
+  if (data_type.lanes_ != 1) {
+    return kElementwiseDataTypeNotSupport;
+  }
+  if (data_type.code_ == base::kDataTypeCodeFp && data_type.bits_ == 32) {
+    return kElementwiseDataTypeFp32;
+  } else if (data_type.code_ == base::kDataTypeCodeFp &&
+             data_type.bits_ == 16) {
+    return kElementwiseDataTypeFp16;
+  } else if (data_type.code_ == base::kDataTypeCodeBFp &&
+             data_type.bits_ == 16) {
+    return kElementwiseDataTypeBfp16;
+  } else if (data_type.code_ == base::kDataTypeCodeInt &&
+             data_type.bits_ == 8) {
+    return kElementwiseDataTypeInt8;
+  }
+  return kElementwiseDataTypeNotSupport;
+}
+
+/**
+ * @brief 合并维度后的访问方式，strides_[0]为输出，之后为各输入，单位为元素
+ */
+struct ElementwiseLayout {
+  std::vector<int64_t> shape_;
+  std::vector<std::vector<int64_t>> strides_;
+};
+
+base::Status collapseLayout(const base::IntVector &output_shape,
+                            const std::vector<base::IntVector> &input_shapes,
+                            ElementwiseLayout &layout) {
+  const int ndim = static_cast<int>(output_shape.size());
+  const int num = static_cast<int>(input_shapes.size()) + 1;
+  std::vector<std::vector<int64_t>> strides(num,
+                                            std::vector<int64_t>(ndim, 0));
+  for (int k = 0; k < num; ++k) {
+    const base::IntVector &shape =
+        k == 0 ? output_shape : input_shapes[k - 1];
+    const int diff = ndim - static_cast<int>(shape.size());
+    if (diff < 0) {
+      NNDEPLOY_LOGE("input has more dims than output.\n");
+      return base::kStatusCodeErrorInvalidParam;
+    }
+    int64_t stride = 1;
+    for (int i = ndim - 1; i >= diff; --i) {
+      int dim = shape[i - diff];
+      if (dim == output_shape[i]) {
+        strides[k][i] = dim == 1 ? 0 : stride;
+      } else if (dim == 1) {
+        strides[k][i] = 0;
+      } else {
+        NNDEPLOY_LOGE("can't broadcast dim %d to %d at axis %d.\n", dim,
+                      output_shape[i], i);
+        return base::kStatusCodeErrorInvalidParam;
+      }
+      stride *= dim;
+    }
+  }
+
+  // 从内向外，跳过长度为1的维度，合并所有操作数都连续的相邻维度
+  layout.shape_.clear();
+  layout.strides_.assign(num, std::vector<int64_t>());
+  for (int i = ndim - 1; i >= 0; --i) {
+    if (output_shape[i] < 0) {
+      NNDEPLOY_LOGE("invalid output shape.\n");
+      return base::kStatusCodeErrorInvalidParam;
+    }
+    if (output_shape[i] == 1) {
+      continue;
+    }
+    bool merge = !layout.shape_.empty();
+    for (int k = 0; merge && k < num; ++k) {
+      merge = strides[k][i] ==
+              layout.strides_[k].back() * layout.shape_.back();
+    }
+    if (merge) {
+      layout.shape_.back() *= output_shape[i];
+    } else {
+      layout.shape_.push_back(output_shape[i]);
+      for (int k = 0; k < num; ++k) {
+        layout.strides_[k].push_back(strides[k][i]);
+      }
+    }
+  }
+  if (layout.shape_.empty()) {
+    layout.shape_.push_back(1);
+    for (int k = 0; k < num; ++k) {
+      layout.strides_[k].push_back(1);
+    }
+  }
+  std::reverse(layout.shape_.begin(), layout.shape_.end());
+  for (int k = 0; k < num; ++k) {
+    std::reverse(layout.strides_[k].begin(), layout.strides_[k].end());
+  }
+  return base::kStatusCodeOk;
+}
+
+struct ElementwiseArg {
+  char *data_;
+  ElementwiseDataType data_type_;
+  int elem_size_;
+  ElementwiseLoadFunc load_;
+  ElementwiseStoreFunc store_;
+};
+
+base::Status makeElementwiseArg(const ElementwiseKernel &kernel,
+                                const ElementwiseOperand &operand,
+                                ElementwiseArg &arg) {
+  arg.data_ = static_cast<char *>(operand.data_);
+  arg.data_type_ = getElementwiseDataType(operand.data_type_);
+  arg.load_ = nullptr;
+  arg.store_ = nullptr;
+  switch (arg.data_type_) {
+    case kElementwiseDataTypeFp32:
+      arg.elem_size_ = 4;
+      break;
+    case kElementwiseDataTypeFp16:
+      arg.elem_size_ = 2;
+      arg.load_ = kernel.load_fp16_;
+      arg.store_ = kernel.store_fp16_;
+      break;
+    case kElementwiseDataTypeBfp16:
+      arg.elem_size_ = 2;
+      arg.load_ = kernel.load_bfp16_;
+      arg.store_ = kernel.store_bfp16_;
+      break;
+    case kElementwiseDataTypeInt8:
+      arg.elem_size_ = 1;
+      arg.load_ = kernel.load_int8_;
+      arg.store_ = kernel.store_int8_;
+      break;
+    default:
+      NNDEPLOY_LOGE("data type %s is not supported.\n",
+                    base::dataTypeToString(operand.data_type_).c_str());
+      return base::kStatusCodeErrorNotSupport;
+  }
+  if (arg.data_ == nullptr) {
+    NNDEPLOY_LOGE("operand data is nullptr.\n");
+    return base::kStatusCodeErrorNullParam;
+  }
+  return base::kStatusCodeOk;
+}
+
+/**
+ * @brief 一次逐元素运算，num_inputs_为1时为一元运算链，为2时为二元运算加epilogue
+ */
+struct ElementwiseProblem {
+  const ElementwiseKernel *kernel_;
+  ElementwiseBinaryType type_;
+  const std::vector<ElementwiseUnary> *unary_;
+  int num_inputs_;
+  ElementwiseArg args_[3];  // 输出，输入0，输入1
+  ElementwiseLayout layout_;
+  int64_t rows_;
+  int64_t inner_;
+  // 任务划分：inner_较长时每行分为segs_per_row_段，否则每个任务处理rows_per_task_行
+  int64_t segs_per_row_;
+  int64_t seg_len_;
+  int64_t rows_per_task_;
+};
+
+/**
+ * @brief 计算一行中[begin, end)的元素，offsets为各操作数在这一行的起始元素偏移
+ */
+void runSegment(const ElementwiseProblem &p, const int64_t *offsets,
+                int64_t begin, int64_t end) {
+  const ElementwiseKernel &kernel = *p.kernel_;
+  const int num = p.num_inputs_ + 1;
+  float buffers[3][kElementwiseBlock];
+  int steps[3];
+  for (int k = 0; k < num; ++k) {
+    steps[k] = static_cast<int>(p.layout_.strides_[k].back());
+  }
+  for (int64_t i = begin; i < end; i += kElementwiseBlock) {
+    const int n =
+        static_cast<int>(std::min<int64_t>(kElementwiseBlock, end - i));
+    const float *inputs[2] = {nullptr, nullptr};
+    for (int k = 1; k < num; ++k) {
+      const ElementwiseArg &arg = p.args_[k];
+      char *src = arg.data_ + (offsets[k] + i * steps[k]) * arg.elem_size_;
+      if (arg.data_type_ == kElementwiseDataTypeFp32) {
+        inputs[k - 1] = reinterpret_cast<const float *>(src);
+      } else {
+        // 广播的标量只转换一个元素
+        arg.load_(src, buffers[k], steps[k] == 0 ? 1 : n);
+        inputs[k - 1] = buffers[k];
+      }
+    }
+    const ElementwiseArg &out = p.args_[0];
+    char *dst = out.data_ + (offsets[0] + i) * out.elem_size_;
+    float *result = out.data_type_ == kElementwiseDataTypeFp32
+                        ? reinterpret_cast<float *>(dst)
+                        : buffers[0];
+
+    const float *x = inputs[0];
+    if (p.num_inputs_ == 2) {
+      kernel.binary_(p.type_, inputs[0], steps[1], inputs[1], steps[2], result,
+                     n);
+      x = result;
+    } else if (steps[1] == 0) {
+      std::fill(result, result + n, inputs[0][0]);
+      x = result;
+    }
+    for (auto &unary : *p.unary_) {
+      kernel.unary_(unary, x, result, n);
+      x = result;
+    }
+    if (x != result) {
+      memcpy(result, x, n * sizeof(float));
+    }
+    if (out.data_type_ != kElementwiseDataTypeFp32) {
+      out.store_(result, dst, n);
+    }
+  }
+}
+
+void runRows(const ElementwiseProblem &p, int64_t row_begin, int64_t row_end,
+             int64_t begin, int64_t end) {
+  const int num = p.num_inputs_ + 1;
+  const int outer = static_cast<int>(p.layout_.shape_.size()) - 1;
+  // 行号展开为外层维度的坐标，之后逐行进位
+  std::vector<int64_t> coords(outer, 0);
+  int64_t offsets[3] = {0, 0, 0};
+  int64_t row = row_begin;
+  for (int d = outer - 1; d >= 0; --d) {
+    coords[d] = row % p.layout_.shape_[d];
+    row /= p.layout_.shape_[d];
+    for (int k = 0; k < num; ++k) {
+      offsets[k] += coords[d] * p.layout_.strides_[k][d];
+    }
+  }
+  for (row = row_begin; row < row_end; ++row) {
+    runSegment(p, offsets, begin, end);
+    for (int d = outer - 1; d >= 0; --d) {
+      ++coords[d];
+      for (int k = 0; k < num; ++k) {
+        offsets[k] += p.layout_.strides_[k][d];
+      }
+      if (coords[d] < p.layout_.shape_[d]) {
+        break;
+      }
+      for (int k = 0; k < num; ++k) {
+        offsets[k] -= coords[d] * p.layout_.strides_[k][d];
+      }
+      coords[d] = 0;
+    }
+  }
+}
+
+class ElementwiseParallelBody : public thread_pool::ParallelLoopBody {
+ public:
+  explicit ElementwiseParallelBody(const ElementwiseProblem &problem)
+      : problem_(problem) {}
+
+  virtual void operator()(const base::Range &range) const {
+    const ElementwiseProblem &p = problem_;
+    for (int task = range.start_; task < range.end_; ++task) {
+      if (p.segs_per_row_ > 1) {
+        int64_t row = task / p.segs_per_row_;
+        int64_t begin = (task % p.segs_per_row_) * p.seg_len_;
+        int64_t end = std::min(begin + p.seg_len_, p.inner_);
+        runRows(p, row, row + 1, begin, end);
+      } else {
+        int64_t row_begin = task * p.rows_per_task_;
+        int64_t row_end = std::min(row_begin + p.rows_per_task_, p.rows_);
+        runRows(p, row_begin, row_end, 0, p.inner_);
+      }
+    }
+  }
+
+ private:
+  const ElementwiseProblem &problem_;
+};
+
+base::Status runElementwise(ElementwiseProblem &p,
+                            const std::vector<ElementwiseOperand> &operands) {
+  for (auto &unary : *p.unary_) {
+    if (unary.type_ < kElementwiseUnaryTypeRelu ||
+        unary.type_ >= kElementwiseUnaryTypeNotSupport) {
+      NNDEPLOY_LOGE("unary type %d is not supported.\n", unary.type_);
+      return base::kStatusCodeErrorNotSupport;
+    }
+  }
+  std::vector<base::IntVector> input_shapes;
+  for (int k = 1; k < (int)operands.size(); ++k) {
+    input_shapes.push_back(operands[k].shape_);
+  }
+  base::Status status =
+      collapseLayout(operands[0].shape_, input_shapes, p.layout_);
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                         "collapseLayout failed");
+  int64_t total = 1;
+  for (auto dim : operands[0].shape_) {
+    total *= dim;
+  }
+  if (total == 0) {
+    return base::kStatusCodeOk;
+  }
+  for (int k = 0; k < (int)operands.size(); ++k) {
+    status = makeElementwiseArg(*p.kernel_, operands[k], p.args_[k]);
+    NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                           "makeElementwiseArg failed");
+  }
+
+  p.inner_ = p.layout_.shape_.back();
+  p.rows_ = total / p.inner_;
+  if (p.inner_ >= 2 * kElementwiseGrain) {
+    p.seg_len_ = kElementwiseGrain;
+    p.segs_per_row_ = (p.inner_ + p.seg_len_ - 1) / p.seg_len_;
+    p.rows_per_task_ = 1;
+  } else {
+    p.seg_len_ = p.inner_;
+    p.segs_per_row_ = 1;
+    p.rows_per_task_ = std::max<int64_t>(kElementwiseGrain / p.inner_, 1);
+  }
+  int64_t num_tasks =
+      p.segs_per_row_ > 1
+          ? p.rows_ * p.segs_per_row_
+          : (p.rows_ + p.rows_per_task_ - 1) / p.rows_per_task_;
+  if (num_tasks > INT_MAX) {
+    NNDEPLOY_LOGE("tensor is too large.\n");
+    return base::kStatusCodeErrorInvalidParam;
+  }
+  ElementwiseParallelBody body(p);
+  if (num_tasks == 1) {
+    body(base::Range(0, 1));
+  } else {
+    thread_pool::parallelFor(base::Range(0, static_cast<int>(num_tasks)),
+                             body);
+  }
+  return base::kStatusCodeOk;
+}
+
+}  // namespace
+
+base::Status elementwiseBinary(ElementwiseBinaryType type,
+                               const ElementwiseOperand &input0,
+                               const ElementwiseOperand &input1,
+                               const ElementwiseOperand &output,
+                               const std::vector<ElementwiseUnary> &epilogue) {
+  if (type < kElementwiseBinaryTypeAdd ||
+      type >= kElementwiseBinaryTypeNotSupport) {
+    NNDEPLOY_LOGE("binary type %d is not supported.\n", type);
+    return base::kStatusCodeErrorNotSupport;
+  }
+  ElementwiseProblem p;
+  p.kernel_ = &getElementwiseKernel();
+  p.type_ = type;
+  p.unary_ = &epilogue;
+  p.num_inputs_ = 2;
+  return runElementwise(p, {output, input0, input1});
+}
+
+base::Status elementwiseUnary(const std::vector<ElementwiseUnary> &ops,
+                              const ElementwiseOperand &input,
+                              const ElementwiseOperand &output) {
+  ElementwiseProblem p;
+  p.kernel_ = &getElementwiseKernel();
+  p.type_ = kElementwiseBinaryTypeNotSupport;
+  p.unary_ = &ops;
+  p.num_inputs_ = 1;
+  return runElementwise(p, {output, input});
+}
+
+static void loadFp32(const void *src, float *dst, int n) {
+  memcpy(dst, src, n * sizeof(float));
+}
+
+static void storeFp32(const float *src, void *dst, int n) {
+  memcpy(dst, src, n * sizeof(float));
+}
+
+ElementwiseLoadFunc getElementwiseLoadFunc(const base::DataType &data_type) {
+  const ElementwiseKernel &kernel = getElementwiseKernel();
+  switch (getElementwiseDataType(data_type)) {
+    case kElementwiseDataTypeFp32:
+      return loadFp32;
+    case kElementwiseDataTypeFp16:
+      return kernel.load_fp16_;
+    case kElementwiseDataTypeBfp16:
+      return kernel.load_bfp16_;
+    case kElementwiseDataTypeInt8:
+      return kernel.load_int8_;
+    default:
+      return nullptr;
+  }
+}
+
+ElementwiseStoreFunc getElementwiseStoreFunc(
+    const base::DataType &data_type) {
+  const ElementwiseKernel &kernel = getElementwiseKernel();
+  switch (getElementwiseDataType(data_type)) {
+    case kElementwiseDataTypeFp32:
+      return storeFp32;
+    case kElementwiseDataTypeFp16:
+      return kernel.store_fp16_;
+    case kElementwiseDataTypeBfp16:
+      return kernel.store_bfp16_;
+    case kElementwiseDataTypeInt8:
+      return kernel.store_int8_;
+    default:
+      return nullptr;
+  }
+}
+
+}  // namespace op
+}  // namespace nndeploy
@@ -0,0 +1,490 @@
+
+#include "nndeploy/op/gemm_kernel.h"
+
+#include "nndeploy/base/common.h"
+#include "nndeploy/base/glic_stl_include.h"
+#include "nndeploy/base/log.h"
+#include "nndeploy/base/macro.h"
+#include "nndeploy/base/status.h"
+#include "nndeploy/op/elementwise_kernel.h"
+#include "nndeploy/thread_pool/parallel.h"
+
+namespace nndeploy {
+namespace op {
+
+// 分块大小：A的[mc x kc]块常驻L2，B的[kc x nr]微面板常驻L1
+static const int kSgemmBlockM = 120;
+static const int kSgemmBlockN = 384;
+static const int kSgemmBlockK = 256;
+// gemv按列切分时每个任务的最小列数
+static const int kSgemvBlockN = 256;
+
+static void sgemmMicroKernel4x8(int kc, const float *a, const float *b,
+                                float *c, int ldc, bool accumulate) {
+  float acc[4][8] = {{0.0f}};
+  for (int k = 0; k < kc; ++k) {
+    for (int i = 0; i < 4; ++i) {
+      float av = a[i];
+      for (int j = 0; j < 8; ++j) {
+        acc[i][j] += av * b[j];
+      }
+    }
+    a += 4;
+    b += 8;
+  }
+  for (int i = 0; i < 4; ++i) {
+    float *c_row = c + i * ldc;
+    for (int j = 0; j < 8; ++j) {
+      c_row[j] = accumulate ? c_row[j] + acc[i][j] : acc[i][j];
+    }
+  }
+}
+
+// 已注册的最优微核，每次注册时更新，不在第一次查询时固定：
+// 其他编译单元的注册先于或晚于第一次查询都能生效
+static SgemmMicroKernel &getBestSgemmMicroKernel() {
+  static SgemmMicroKernel best("scalar_4x8", 4, 8, sgemmMicroKernel4x8, 0);
+  return best;
+}
+
+void registerSgemmMicroKernel(const SgemmMicroKernel &kernel) {
+  SgemmMicroKernel &best = getBestSgemmMicroKernel();
+  if (kernel.priority_ > best.priority_) {
+    best = kernel;
+  }
+}
+
+const SgemmMicroKernel &getSgemmMicroKernel() {
+  return getBestSgemmMicroKernel();
+}
+
+/**
+ * @brief 读取存储上连续的n个元素，load为nullptr(fp32)时直接返回源地址，
+ *        否则转换到buffer中
+ */
+static inline const float *loadSgemmRun(const void *data,
+                                        ElementwiseLoadFunc load,
+                                        size_t elem_size, size_t offset,
+                                        int n, float *buffer) {
+  if (load == nullptr) {
+    return static_cast<const float *>(data) + offset;
+  }
+  load(static_cast<const char *>(data) + offset * elem_size, buffer, n);
+  return buffer;
+}
+
+/**
+ * @brief 打包A块：[mc x kc] -> mr行一组的微面板，不足mr的补零，同时乘上alpha
+ * @note 非fp32的A在打包时转为fp32，buffer至少能放下max(mc, kc)个元素
+ */
+static void packSgemmA(bool trans_a, const void *a, ElementwiseLoadFunc load,
+                       size_t elem_size, int lda, int m0, int mc, int k0,
+                       int kc, float alpha, int mr, float *buffer,
+                       float *dst) {
+  if (!trans_a) {
+    for (int i0 = 0; i0 < mc; i0 += mr) {
+      const int rows = std::min(mr, mc - i0);
+      float *panel = dst + (size_t)(i0 / mr) * kc * mr;
+      for (int i = 0; i < rows; ++i) {
+        const float *src = loadSgemmRun(
+            a, load, elem_size, (size_t)(m0 + i0 + i) * lda + k0, kc, buffer);
+        for (int kk = 0; kk < kc; ++kk) {
+          panel[kk * mr + i] = alpha * src[kk];
+        }
+      }
+    }
+  } else {
+    for (int kk = 0; kk < kc; ++kk) {
+      const float *src = loadSgemmRun(a, load, elem_size,
+                                      (size_t)(k0 + kk) * lda + m0, mc, buffer);
+      for (int i0 = 0; i0 < mc; i0 += mr) {
+        const int rows = std::min(mr, mc - i0);
+        float *d = dst + (size_t)(i0 / mr) * kc * mr + (size_t)kk * mr;
+        for (int i = 0; i < rows; ++i) {
+          d[i] = alpha * src[i0 + i];
+        }
+      }
+    }
+  }
+  const int rows = mc % mr;
+  if (rows != 0) {
+    float *panel = dst + (size_t)(mc / mr) * kc * mr;
+    for (int kk = 0; kk < kc; ++kk) {
+      for (int i = rows; i < mr; ++i) {
+        panel[kk * mr + i] = 0.0f;
+      }
+    }
+  }
+}
+
+/**
+ * @brief 打包B块：[kc x nc] -> nr列一组的微面板，不足nr的补零
+ * @note 非fp32的B在打包时转为fp32，buffer至少能放下max(nc, kc)个元素
+ */
+static void packSgemmB(bool trans_b, const void *b, ElementwiseLoadFunc load,
+                       size_t elem_size, int ldb, int k0, int kc, int n0,
+                       int nc, int nr, float *buffer, float *dst) {
+  if (!trans_b) {
+    for (int kk = 0; kk < kc; ++kk) {
+      const float *src = loadSgemmRun(b, load, elem_size,
+                                      (size_t)(k0 + kk) * ldb + n0, nc, buffer);
+      for (int j0 = 0; j0 < nc; j0 += nr) {
+        const int cols = std::min(nr, nc - j0);
+        float *d = dst + (size_t)(j0 / nr) * kc * nr + (size_t)kk * nr;
+        memcpy(d, src + j0, cols * sizeof(float));
+      }
+    }
+  } else {
+    for (int j0 = 0; j0 < nc; j0 += nr) {
+      const int cols = std::min(nr, nc - j0);
+      float *panel = dst + (size_t)(j0 / nr) * kc * nr;
+      for (int j = 0; j < cols; ++j) {
+        const float *src = loadSgemmRun(
+            b, load, elem_size, (size_t)(n0 + j0 + j) * ldb + k0, kc, buffer);
+        for (int kk = 0; kk < kc; ++kk) {
+          panel[kk * nr + j] = src[kk];
+        }
+      }
+    }
+  }
+  const int cols = nc % nr;
+  if (cols != 0) {
+    float *panel = dst + (size_t)(nc / nr) * kc * nr;
+    for (int kk = 0; kk < kc; ++kk) {
+      for (int j = cols; j < nr; ++j) {
+        panel[kk * nr + j] = 0.0f;
+      }
+    }
+  }
+}
+
+struct SgemmProblem {
+  bool trans_a_;
+  bool trans_b_;
+  int m_;
+  int n_;
+  int k_;
+  float alpha_;
+  float beta_;
+  // A/B为fp32时load为nullptr，否则为转为fp32的函数
+  const void *const *a_;
+  ElementwiseLoadFunc load_a_;
+  size_t a_elem_size_;
+  int lda_;
+  const void *const *b_;
+  ElementwiseLoadFunc load_b_;
+  size_t b_elem_size_;
+  int ldb_;
+  float *const *c_;
+  int ldc_;
+  int block_m_;
+  int block_n_;
+  int tiles_m_;
+  int tiles_n_;
+};
+
+/**
+ * @brief C块预处理：beta为0时清零（不读取C），否则乘上beta
+ */
+static void scaleSgemmTile(float *c, int ldc, int rows, int cols, float beta) {
+  for (int i = 0; i < rows; ++i) {
+    float *c_row = c + (size_t)i * ldc;
+    if (beta == 0.0f) {
+      memset(c_row, 0, cols * sizeof(float));
+    } else if (beta != 1.0f) {
+      for (int j = 0; j < cols; ++j) {
+        c_row[j] *= beta;
+      }
+    }
+  }
+}
+
+/**
+ * @brief 计算一个[mc x nc]的输出块，沿k分块打包后调用微核
+ */
+static void sgemmTile(const SgemmMicroKernel &kernel, const SgemmProblem &p,
+                      int batch_index, int m0, int mc, int n0, int nc) {
+  // 每个线程复用自己的打包缓冲区
+  thread_local std::vector<float> pack_buffer;
+  const int mr = kernel.mr_;
+  const int nr = kernel.nr_;
+  const int kc_max = std::min(kSgemmBlockK, p.k_);
+  const size_t a_size = (size_t)((mc + mr - 1) / mr) * mr * kc_max;
+  const size_t b_size = (size_t)((nc + nr - 1) / nr) * nr * kc_max;
+  const size_t load_size = std::max(kc_max, std::max(mc, nc));
+  const size_t buffer_size = a_size + b_size + (size_t)mr * nr + load_size;
+  if (pack_buffer.size() < buffer_size) {
+    pack_buffer.resize(buffer_size);
+  }
+  float *pack_a = pack_buffer.data();
+  float *pack_b = pack_a + a_size;
+  float *tile = pack_b + b_size;
+  float *load_buffer = tile + (size_t)mr * nr;
+
+  const void *a = p.a_[batch_index];
+  const void *b = p.b_[batch_index];
+  float *c = p.c_[batch_index] + (size_t)m0 * p.ldc_ + n0;
+  bool accumulate = p.beta_ != 0.0f;
+  if (p.beta_ != 1.0f && (p.beta_ != 0.0f || p.k_ == 0)) {
+    scaleSgemmTile(c, p.ldc_, mc, nc, p.beta_);
+  }
+
+  for (int k0 = 0; k0 < p.k_; k0 += kSgemmBlockK) {
+    const int kc = std::min(kSgemmBlockK, p.k_ - k0);
+    packSgemmA(p.trans_a_, a, p.load_a_, p.a_elem_size_, p.lda_, m0, mc, k0,
+               kc, p.alpha_, mr, load_buffer, pack_a);
+    packSgemmB(p.trans_b_, b, p.load_b_, p.b_elem_size_, p.ldb_, k0, kc, n0,
+               nc, nr, load_buffer, pack_b);
+    for (int j0 = 0; j0 < nc; j0 += nr) {
+      const int cols = std::min(nr, nc - j0);
+      const float *b_panel = pack_b + (size_t)(j0 / nr) * kc * nr;
+      for (int i0 = 0; i0 < mc; i0 += mr) {
+        const int rows = std::min(mr, mc - i0);
+        const float *a_panel = pack_a + (size_t)(i0 / mr) * kc * mr;
+        float *c_tile = c + (size_t)i0 * p.ldc_ + j0;
+        if (rows == mr && cols == nr) {
+          kernel.func_(kc, a_panel, b_panel, c_tile, p.ldc_, accumulate);
+        } else {
+          kernel.func_(kc, a_panel, b_panel, tile, nr, false);
+          for (int i = 0; i < rows; ++i) {
+            float *c_row = c_tile + (size_t)i * p.ldc_;
+            const float *t_row = tile + i * nr;
+            for (int j = 0; j < cols; ++j) {
+              c_row[j] = accumulate ? c_row[j] + t_row[j] : t_row[j];
+            }
+          }
+        }
+      }
+    }
+    accumulate = true;
+  }
+}
+
+class SgemmParallelBody : public thread_pool::ParallelLoopBody {
+ public:
+  SgemmParallelBody(const SgemmMicroKernel &kernel, const SgemmProblem &problem)
+      : kernel_(kernel), problem_(problem) {}
+
+  virtual void operator()(const base::Range &range) const {
+    const SgemmProblem &p = problem_;
+    const int tiles_per_batch = p.tiles_m_ * p.tiles_n_;
+    for (int t = range.start_; t < range.end_; ++t) {
+      const int batch_index = t / tiles_per_batch;
+      const int tm = (t % tiles_per_batch) / p.tiles_n_;
+      const int tn = (t % tiles_per_batch) % p.tiles_n_;
+      const int m0 = tm * p.block_m_;
+      const int n0 = tn * p.block_n_;
+      sgemmTile(kernel_, p, batch_index, m0, std::min(p.block_m_, p.m_ - m0),
+                n0, std::min(p.block_n_, p.n_ - n0));
+    }
+  }
+
+ private:
+  const SgemmMicroKernel &kernel_;
+  const SgemmProblem &problem_;
+};
+
+/**
+ * @brief m == 1 时退化为gemv，打包没有收益，直接按列块计算
+ * @note
+ * # trans_b时每列是一次点积，用8路独立累加打断依赖链
+ * # 非fp32的A整体转为fp32，B按行转换
+ */
+class SgemvParallelBody : public thread_pool::ParallelLoopBody {
+ public:
+  SgemvParallelBody(const SgemmProblem &problem, int tiles_n)
+      : problem_(problem), tiles_n_(tiles_n) {}
+
+  virtual void operator()(const base::Range &range) const {
+    const SgemmProblem &p = problem_;
+    thread_local std::vector<float> gemv_buffer;
+    for (int t = range.start_; t < range.end_; ++t) {
+      const int batch_index = t / tiles_n_;
+      const int n0 = (t % tiles_n_) * kSgemvBlockN;
+      const int nc = std::min(kSgemvBlockN, p.n_ - n0);
+      const void *b = p.b_[batch_index];
+      float *c = p.c_[batch_index] + n0;
+      // op(A)为[1 x k]，trans_a时按列存储
+      const int a_stride = p.trans_a_ ? p.lda_ : 1;
+      const size_t buffer_size = (size_t)p.k_ + std::max(p.k_, nc);
+      if (gemv_buffer.size() < buffer_size) {
+        gemv_buffer.resize(buffer_size);
+      }
+      float *b_buffer = gemv_buffer.data() + p.k_;
+      const void *a_data = p.a_[batch_index];
+      const float *a = nullptr;
+      if (a_stride == 1) {
+        a = loadSgemmRun(a_data, p.load_a_, p.a_elem_size_, 0, p.k_,
+                         gemv_buffer.data());
+      } else {
+        // trans_a时A的元素不连续，逐个读取
+        float *a_row = gemv_buffer.data();
+        for (int kk = 0; kk < p.k_; ++kk) {
+          a_row[kk] = *loadSgemmRun(a_data, p.load_a_, p.a_elem_size_,
+                                    (size_t)kk * a_stride, 1, a_row + kk);
+        }
+        a = a_row;
+      }
+      scaleSgemmTile(c, 0, 1, nc, p.beta_);
+      if (!p.trans_b_) {
+        for (int kk = 0; kk < p.k_; ++kk) {
+          const float av = p.alpha_ * a[kk];
+          const float *b_row =
+              loadSgemmRun(b, p.load_b_, p.b_elem_size_,
+                           (size_t)kk * p.ldb_ + n0, nc, b_buffer);
+          for (int j = 0; j < nc; ++j) {
+            c[j] += av * b_row[j];
+          }
+        }
+      } else {
+        for (int j = 0; j < nc; ++j) {
+          const float *b_row =
+              loadSgemmRun(b, p.load_b_, p.b_elem_size_,
+                           (size_t)(n0 + j) * p.ldb_, p.k_, b_buffer);
+          float sum[8] = {0.0f};
+          int kk = 0;
+          for (; kk + 8 <= p.k_; kk += 8) {
+            for (int u = 0; u < 8; ++u) {
+              sum[u] += a[kk + u] * b_row[kk + u];
+            }
+          }
+          for (; kk < p.k_; ++kk) {
+            sum[0] += a[kk] * b_row[kk];
+          }
+          float total = ((sum[0] + sum[1]) + (sum[2] + sum[3])) +
+                        ((sum[4] + sum[5]) + (sum[6] + sum[7]));
+          c[j] += p.alpha_ * total;
+        }
+      }
+    }
+  }
+
+ private:
+  const SgemmProblem &problem_;
+  const int tiles_n_;
+};
+
+/**
+ * @brief 按输出块划分任务并执行，p中只需要填好问题本身的描述
+ */
+static void runSgemmBatch(SgemmProblem &p, int batch) {
+  const int m = p.m_;
+  const int n = p.n_;
+  if (m <= 0 || n <= 0 || batch <= 0) {
+    return;
+  }
+  const SgemmMicroKernel &kernel = getSgemmMicroKernel();
+  const int num_threads = std::max(thread_pool::getThreadNum(), 1);
+
+  if (m == 1) {
+    const int tiles_n = (n + kSgemvBlockN - 1) / kSgemvBlockN;
+    SgemvParallelBody body(p, tiles_n);
+    thread_pool::parallelFor(base::Range(0, batch * tiles_n), body);
+    return;
+  }
+
+  // 输出块数不足以喂满所有线程时，先缩小列块再缩小行块
+  p.block_m_ = std::max(kernel.mr_, kSgemmBlockM / kernel.mr_ * kernel.mr_);
+  p.block_n_ = std::max(kernel.nr_, kSgemmBlockN / kernel.nr_ * kernel.nr_);
+  auto num_tiles = [&]() {
+    return (int64_t)batch * ((m + p.block_m_ - 1) / p.block_m_) *
+           ((n + p.block_n_ - 1) / p.block_n_);
+  };
+  while (num_tiles() < num_threads * 2 && p.block_n_ > kernel.nr_ * 2) {
+    p.block_n_ = std::max(kernel.nr_, p.block_n_ / 2 / kernel.nr_ * kernel.nr_);
+  }
+  while (num_tiles() < num_threads * 2 && p.block_m_ > kernel.mr_) {
+    p.block_m_ = std::max(kernel.mr_, p.block_m_ / 2 / kernel.mr_ * kernel.mr_);
+  }
+  p.tiles_m_ = (m + p.block_m_ - 1) / p.block_m_;
+  p.tiles_n_ = (n + p.block_n_ - 1) / p.block_n_;
+
+  SgemmParallelBody body(kernel, p);
+  thread_pool::parallelFor(base::Range(0, batch * p.tiles_m_ * p.tiles_n_),
+                           body);
+}
+
+static SgemmProblem makeSgemmProblem(bool trans_a, bool trans_b, int m,
+                                     int n, int k, float alpha,
+                                     const void *const *a, int lda,
+                                     const void *const *b, int ldb,
+                                     float beta, float *const *c, int ldc) {
+  SgemmProblem p;
+  p.trans_a_ = trans_a;
+  p.trans_b_ = trans_b;
+  p.m_ = m;
+  p.n_ = n;
+  p.k_ = k;
+  p.alpha_ = alpha;
+  p.beta_ = beta;
+  p.a_ = a;
+  p.load_a_ = nullptr;
+  p.a_elem_size_ = sizeof(float);
+  p.lda_ = lda;
+  p.b_ = b;
+  p.load_b_ = nullptr;
+  p.b_elem_size_ = sizeof(float);
+  p.ldb_ = ldb;
+  p.c_ = c;
+  p.ldc_ = ldc;
+  return p;
+}
+
+void sgemmBatch(bool trans_a, bool trans_b, int m, int n, int k, float alpha,
+                const float *const *a, int lda, const float *const *b, int ldb,
+                float beta, float *const *c, int ldc, int batch) {
+  SgemmProblem p = makeSgemmProblem(
+      trans_a, trans_b, m, n, k, alpha,
+      reinterpret_cast<const void *const *>(a), lda,
+      reinterpret_cast<const void *const *>(b), ldb, beta, c, ldc);
+  runSgemmBatch(p, batch);
+}
+
+void sgemm(bool trans_a, bool trans_b, int m, int n, int k, float alpha,
+           const float *a, int lda, const float *b, int ldb, float beta,
+           float *c, int ldc) {
+  sgemmBatch(trans_a, trans_b, m, n, k, alpha, &a, lda, &b, ldb, beta, &c, ldc,
+             1);
+}
+
+base::Status sgemmBatchMixed(bool trans_a, bool trans_b, int m, int n, int k,
+                             float alpha, const void *const *a,
+                             const base::DataType &a_data_type, int lda,
+                             const void *const *b,
+                             const base::DataType &b_data_type, int ldb,
+                             float beta, float *const *c, int ldc,
+                             int batch) {
+  ElementwiseLoadFunc load_a = getElementwiseLoadFunc(a_data_type);
+  ElementwiseLoadFunc load_b = getElementwiseLoadFunc(b_data_type);
+  if (load_a == nullptr || load_b == nullptr) {
+    NNDEPLOY_LOGE("data type %s x %s is not supported.\n",
+                  base::dataTypeToString(a_data_type).c_str(),
+                  base::dataTypeToString(b_data_type).c_str());
+    return base::kStatusCodeErrorNotSupport;
+  }
+  SgemmProblem p = makeSgemmProblem(trans_a, trans_b, m, n, k, alpha, a, lda,
+                                    b, ldb, beta, c, ldc);
+  base::DataType fp32 = base::dataTypeOf<float>();
+  if (a_data_type != fp32) {
+    p.load_a_ = load_a;
+    p.a_elem_size_ = a_data_type.size();
+  }
+  if (b_data_type != fp32) {
+    p.load_b_ = load_b;
+    p.b_elem_size_ = b_data_type.size();
+  }
+  runSgemmBatch(p, batch);
+  return base::kStatusCodeOk;
+}
+
+base::Status sgemmMixed(bool trans_a, bool trans_b, int m, int n, int k,
+                        float alpha, const void *a,
+                        const base::DataType &a_data_type, int lda,
+                        const void *b, const base::DataType &b_data_type,
+                        int ldb, float beta, float *c, int ldc) {
+  return sgemmBatchMixed(trans_a, trans_b, m, n, k, alpha, &a, a_data_type,
+                         lda, &b, b_data_type, ldb, beta, &c, ldc, 1);
+}
+
+}  // namespace op
+}  // namespace nndeploy
@@ -318,6 +318,9 @@ void Op::setRunningFlag(bool flag) {
 }
 bool Op::isRunning() { return is_running_; }
 
+void Op::setConstWeightFlag(bool flag) { is_const_weight_ = flag; }
+bool Op::getConstWeightFlag() { return is_const_weight_; }
+
 base::Status Op::init() {
   if (!is_external_stream_ && stream_ == nullptr) {
     stream_ = device::createStream(device_type_);
@@ -340,10 +343,42 @@ void Op::setWorkspace(void *workspace) {
   workspace_ = workspace;
 }
 uint64_t Op::getFlops() {
-  if (flops_ == 0) {
-    NNDEPLOY_LOGE("Op %s flops is not set.\n", op_desc_.name_.c_str());
+  if (flops_ != 0) {
+    return flops_;
+  }
+  // 未知的维度(动态shape)按1计算
+  auto elements = [](device::Tensor *tensor, int begin) -> uint64_t {
+    uint64_t size = 1;
+    if (tensor == nullptr) {
+      return size;
+    }
+    base::IntVector shape = tensor->getShape();
+    for (int i = begin; i < (int)shape.size(); ++i) {
+      size *= (uint64_t)std::max(shape[i], 1);
+    }
+    return size;
+  };
+  uint64_t flops = 0;
+  for (auto output : outputs_) {
+    flops += elements(output, 0);
+  }
+  ir::OpType op_type = op_desc_.op_type_;
+  if (inputs_.size() >= 2 && !outputs_.empty()) {
+    if (op_type == ir::kOpTypeConv) {
+      // weight: [oc, ic/group, kh, kw]
+      flops = 2 * elements(outputs_[0], 0) * elements(inputs_[1], 1);
+    } else if (op_type == ir::kOpTypeMatMul && inputs_[0] != nullptr &&
+               !inputs_[0]->getShape().empty()) {
+      uint64_t k = std::max(inputs_[0]->getShape().back(), 1);
+      flops = 2 * elements(outputs_[0], 0) * k;
+    } else if (op_type == ir::kOpTypeGemm && outputs_[0] != nullptr &&
+               !outputs_[0]->getShape().empty()) {
+      // 无论是否转置，B的元素个数/N即为累加长度
+      uint64_t n = std::max(outputs_[0]->getShape().back(), 1);
+      flops = 2 * elements(outputs_[0], 0) * (elements(inputs_[1], 0) / n);
+    }
   }
-  return flops_;
+  return flops;
 }
 
 base::Status Op::inferDataType() {
@@ -16,6 +16,8 @@
 #include "nndeploy/device/tensor.h"
 #include "nndeploy/ir/ir.h"
 #include "nndeploy/op/op.h"
+#include "nndeploy/op/op_cache.h"
+#include "nndeploy/op/type_dispatch.h"
 
 namespace nndeploy {
 
@@ -28,13 +30,16 @@ base::Status OpBatchNorm::inferShape() {
 }
 
 base::Status OpBatchNorm::run() {
+  return dispatchFloatDataType(inputs_[0]->getDataType(), [this](auto tag) {
+    return this->runImpl<typename decltype(tag)::type>();
+  });
+}
+
+template <typename T>
+base::Status OpBatchNorm::runImpl() {
   base::Status status = base::kStatusCodeOk;
   // 获取输入、尺度、偏移、均值和方差张量
   device::Tensor *input_tensor = inputs_[0];
-  device::Tensor *scale_tensor = inputs_[1];
-  device::Tensor *bias_tensor = inputs_[2];
-  device::Tensor *mean_tensor = inputs_[3];
-  device::Tensor *var_tensor = inputs_[4];
   device::Tensor *output_tensor = outputs_[0];
 
   // 获取输入的维度信息
@@ -44,31 +49,50 @@ base::Status OpBatchNorm::run() {
   auto param =
       dynamic_cast<ir::BatchNormalizationParam *>(op_desc_.op_param_.get());
   float epsilon = param->epsilon_;
-  float *input_data = static_cast<float *>(input_tensor->getData());
-  float *scale_data = static_cast<float *>(scale_tensor->getData());
-  float *bias_data = static_cast<float *>(bias_tensor->getData());
-  float *mean_data = static_cast<float *>(mean_tensor->getData());
-  float *var_data = static_cast<float *>(var_tensor->getData());
-  float *output_data = static_cast<float *>(output_tensor->getData());
+  const T *input_data = static_cast<const T *>(input_tensor->getData());
+  T *output_data = static_cast<T *>(output_tensor->getData());
 
-  // 执行批量归一化操作
+  // 尺度、偏移、均值和方差可以是与输入不同的类型，统一读为fp32
   int channel_size = input_shape[1];
+  std::vector<float> params((size_t)channel_size * 4);
+  for (int i = 0; i < 4; ++i) {
+    device::Tensor *tensor = inputs_[i + 1];
+    ElementwiseLoadFunc load = getElementwiseLoadFunc(tensor->getDataType());
+    if (load == nullptr) {
+      NNDEPLOY_LOGE("data type of input %d is not supported.\n", i + 1);
+      return base::kStatusCodeErrorNotSupport;
+    }
+    load(tensor->getData(), params.data() + (size_t)i * channel_size,
+         channel_size);
+  }
+  const float *scale_data = params.data();
+  const float *bias_data = scale_data + channel_size;
+  const float *mean_data = bias_data + channel_size;
+  const float *var_data = mean_data + channel_size;
+
+  // 执行批量归一化操作，每次处理一个通道的平面，非fp32时转为fp32计算后写回
+  const int plane_size = input_shape[2] * input_shape[3];
+  if (!std::is_same<T, float>::value) {
+    buffer_.resize((size_t)plane_size * 2);
+  }
   for (int n = 0; n < input_shape[0]; ++n) {  // 遍历批次
     for (int c = 0; c < channel_size; ++c) {  // 遍历通道
       float mean = mean_data[c];
       float var = var_data[c];
       float scale = scale_data[c];
       float bias = bias_data[c];
-      for (int h = 0; h < input_shape[2]; ++h) {    // 遍历高度
-        for (int w = 0; w < input_shape[3]; ++w) {  // 遍历宽度
-          int index = n * channel_size * input_shape[2] * input_shape[3] +
-                      c * input_shape[2] * input_shape[3] + h * input_shape[3] +
-                      w;
-          float normalized_value =
-              (input_data[index] - mean) / sqrt(var + epsilon);
-          output_data[index] = scale * normalized_value + bias;
-        }
+      float inv_std = 1.0f / std::sqrt(var + epsilon);
+      size_t offset = ((size_t)n * channel_size + c) * plane_size;
+      const float *input =
+          loadAsFloat(input_data + offset, buffer_.data(), plane_size);
+      float *output = std::is_same<T, float>::value
+                          ? reinterpret_cast<float *>(output_data + offset)
+                          : buffer_.data() + plane_size;
+      for (int i = 0; i < plane_size; ++i) {
+        float normalized_value = (input[i] - mean) * inv_std;
+        output[i] = scale * normalized_value + bias;
       }
+      storeFromFloat(output, output_data + offset, plane_size);
     }
   }
 
@@ -80,44 +104,9 @@ base::Status batchNorm(device::Tensor *input, device::Tensor *scale,
                        device::Tensor *var,
                        std::shared_ptr<ir::BatchNormalizationParam> param,
                        device::Tensor *output) {
-  base::Status status = base::kStatusCodeOk;
-
-  Op *op = createOp(input->getDeviceType(), "", ir::kOpTypeBatchNormalization);
-  if (op == nullptr) {
-    NNDEPLOY_LOGE("createOp failed");
-    return base::kStatusCodeErrorNotImplement;
-  }
-  status = op->setParam(param);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setParam failed");
-  status = op->setInput(input, 0);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  status = op->setInput(scale, 1);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  status = op->setInput(bias, 2);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  status = op->setInput(mean, 3);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  status = op->setInput(var, 4);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  status = op->setOutput(output, 0);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setOutput failed");
-  status = op->init();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "init failed");
-  status = op->checkOrAllocOutput();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
-                         "checkOrAllocOutput failed");
-  status = op->preRun();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "preRun failed");
-  status = op->run();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "run failed");
-  status = op->postRun();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "postRun failed");
-  status = op->deinit();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "deinit failed");
-
-  delete op;
-
-  return status;
+  return getGlobalOpCache()->run(input->getDeviceType(),
+                                 ir::kOpTypeBatchNormalization, param,
+                                 {input, scale, bias, mean, var}, {output});
 }
 
 REGISTER_OP_IMPLEMENTION(kDeviceTypeCodeCpu, ir::kOpTypeBatchNormalization,
@@ -0,0 +1,390 @@
+
+#include "nndeploy/op/op_cache.h"
+
+namespace nndeploy {
+namespace op {
+
+static inline void hashCombine(uint64_t &seed, uint64_t value) {
+  seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
+/**
+ * @brief host设备(x86/arm)上没有专门实现的算子使用cpu上的实现
+ */
+static base::DeviceType getOpDeviceType(base::DeviceType device_type,
+                                        ir::OpType op_type) {
+  if (device_type.code_ == base::kDeviceTypeCodeCpu ||
+      !device::isHostDeviceType(device_type)) {
+    return device_type;
+  }
+  auto &creator_map = getGlobalOpCreatorMap();
+  auto iter = creator_map.find(device_type.code_);
+  if (iter != creator_map.end() && iter->second.count(op_type) > 0) {
+    return device_type;
+  }
+  return base::DeviceType(base::kDeviceTypeCodeCpu, device_type.device_id_);
+}
+
+struct OpCache::Entry {
+  uint64_t hash_ = 0;
+  base::DeviceType device_type_;
+  ir::OpType op_type_;
+  std::string param_;  // 参数的序列化结果
+  std::vector<base::DataType> data_types_;
+  std::vector<base::IntVector> shapes_;
+
+  bool cached_ = false;
+  Op *op_ = nullptr;
+  std::vector<device::Tensor *> tensors_;  // 上一次绑定的输入与输出
+  uint64_t last_use_ = 0;
+
+  void computeHash() {
+    hash_ = 0;
+    hashCombine(hash_, (uint64_t)device_type_.code_);
+    hashCombine(hash_, (uint64_t)device_type_.device_id_);
+    hashCombine(hash_, (uint64_t)op_type_);
+    hashCombine(hash_, std::hash<std::string>()(param_));
+    for (size_t i = 0; i < shapes_.size(); ++i) {
+      const base::DataType &data_type = data_types_[i];
+      hashCombine(hash_, ((uint64_t)data_type.code_ << 16) |
+                             ((uint64_t)data_type.bits_ << 8) |
+                             (uint64_t)data_type.lanes_);
+      hashCombine(hash_, (uint64_t)shapes_[i].size());
+      for (int dim : shapes_[i]) {
+        hashCombine(hash_, (uint64_t)(int64_t)dim);
+      }
+    }
+  }
+
+  bool match(const Entry &key) const {
+    return hash_ == key.hash_ && device_type_ == key.device_type_ &&
+           op_type_ == key.op_type_ && param_ == key.param_ &&
+           data_types_ == key.data_types_ && shapes_ == key.shapes_;
+  }
+};
+
+OpCache::OpCache() {}
+
+OpCache::~OpCache() { clear(); }
+
+base::Status OpCache::run(base::DeviceType device_type, ir::OpType op_type,
+                          std::shared_ptr<base::Param> param,
+                          std::initializer_list<device::Tensor *> inputs,
+                          std::initializer_list<device::Tensor *> outputs) {
+  return run(device_type, op_type, param, inputs.begin(), inputs.size(),
+             outputs.begin(), outputs.size());
+}
+
+base::Status OpCache::run(base::DeviceType device_type, ir::OpType op_type,
+                          std::shared_ptr<base::Param> param,
+                          const std::vector<device::Tensor *> &inputs,
+                          const std::vector<device::Tensor *> &outputs) {
+  return run(device_type, op_type, param, inputs.data(), inputs.size(),
+             outputs.data(), outputs.size());
+}
+
+static base::Status executeOp(Op *op, base::DeviceType device_type,
+                              std::vector<device::Tensor *> &bound,
+                              std::vector<device::Tensor *> &tensors,
+                              size_t input_size) {
+  base::Status status = base::kStatusCodeOk;
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    if (i < input_size) {
+      status = op->setInput(tensors[i], (int)i);
+      NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
+    } else {
+      status = op->setOutput(tensors[i], (int)(i - input_size));
+      NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setOutput failed");
+    }
+  }
+  if (!op->getInitialized()) {
+    status = op->init();
+    NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "init failed");
+  } else if (bound != tensors && !device::isHostDeviceType(device_type)) {
+    status = op->deinit();
+    NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "deinit failed");
+    status = op->init();
+    NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "init failed");
+  }
+  bound.swap(tensors);
+  // 同时标记需要重新推导输出
+  op->setInitializedFlag(true);
+
+  status = op->checkOrAllocOutput();
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                         "checkOrAllocOutput failed");
+  status = op->preRun();
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "preRun failed");
+  status = op->run();
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "run failed");
+  status = op->postRun();
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "postRun failed");
+  return status;
+}
+
+base::Status OpCache::run(base::DeviceType device_type, ir::OpType op_type,
+                          std::shared_ptr<base::Param> param,
+                          device::Tensor *const *inputs, size_t input_size,
+                          device::Tensor *const *outputs,
+                          size_t output_size) {
+  Entry key;
+  key.device_type_ = device_type;
+  key.op_type_ = op_type;
+  bool cacheable = true;
+  if (param != nullptr &&
+      param->serialize(key.param_, false) != base::kStatusCodeOk) {
+    cacheable = false;
+  }
+  std::vector<device::Tensor *> tensors;
+  tensors.reserve(input_size + output_size);
+  for (size_t i = 0; i < input_size; ++i) {
+    if (inputs[i] != nullptr) {
+      if (tensors.size() != i) {
+        NNDEPLOY_LOGE("optional inputs of op %s must be trailing.\n",
+                      ir::opTypeToString(op_type).c_str());
+        return base::kStatusCodeErrorInvalidParam;
+      }
+      tensors.emplace_back(inputs[i]);
+      key.data_types_.emplace_back(inputs[i]->getDataType());
+      key.shapes_.emplace_back(inputs[i]->getShape());
+    }
+  }
+  const size_t bound_input_size = tensors.size();
+  for (size_t i = 0; i < output_size; ++i) {
+    if (outputs[i] != nullptr) {
+      tensors.emplace_back(outputs[i]);
+    }
+  }
+  if (bound_input_size == 0 || tensors.size() == bound_input_size) {
+    NNDEPLOY_LOGE("op %s needs at least one input and one output.\n",
+                  ir::opTypeToString(op_type).c_str());
+    return base::kStatusCodeErrorInvalidParam;
+  }
+  key.computeHash();
+
+  Entry *entry = nullptr;
+  base::Status status = acquire(key, cacheable, param, entry);
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "acquire op failed");
+  status = executeOp(entry->op_, device_type, entry->tensors_, tensors,
+                     bound_input_size);
+  // 执行失败的实例状态未知，不再复用
+  release(entry, status == base::kStatusCodeOk);
+  return status;
+}
+
+base::Status OpCache::acquire(Entry &key, bool cacheable,
+                              std::shared_ptr<base::Param> param,
+                              Entry *&entry) {
+  Entry *evicted = nullptr;
+  bool cached = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (cacheable && capacity_ > 0) {
+      auto iter = idle_.find(key.hash_);
+      if (iter != idle_.end()) {
+        std::vector<Entry *> &bucket = iter->second;
+        for (size_t i = bucket.size(); i > 0; --i) {
+          if (bucket[i - 1]->match(key)) {
+            entry = bucket[i - 1];
+            bucket.erase(bucket.begin() + (i - 1));
+            ++hit_count_;
+            return base::kStatusCodeOk;
+          }
+        }
+      }
+      ++miss_count_;
+      if (size_ >= capacity_) {
+        // 每个桶内按放回的先后排列，桶首为桶内最久未使用的实例
+        auto lru = idle_.end();
+        for (auto it = idle_.begin(); it != idle_.end(); ++it) {
+          if (!it->second.empty() &&
+              (lru == idle_.end() ||
+               it->second.front()->last_use_ <
+                   lru->second.front()->last_use_)) {
+            lru = it;
+          }
+        }
+        if (lru != idle_.end()) {
+          evicted = lru->second.front();
+          lru->second.erase(lru->second.begin());
+          if (lru->second.empty()) {
+            idle_.erase(lru);
+          }
+          --size_;
+        }
+      }
+      ++size_;
+      cached = true;
+    }
+  }
+  if (evicted != nullptr) {
+    destroy(evicted);
+  }
+
+  Op *op = createOp(getOpDeviceType(key.device_type_, key.op_type_), "",
+                    key.op_type_);
+  base::Status status = base::kStatusCodeOk;
+  if (op == nullptr) {
+    NNDEPLOY_LOGE("createOp failed\n");
+    status = base::kStatusCodeErrorNotImplement;
+  } else if (param != nullptr) {
+    status = op->setParam(param);
+    if (status != base::kStatusCodeOk) {
+      NNDEPLOY_LOGE("setParam failed\n");
+      delete op;
+    }
+  }
+  if (status != base::kStatusCodeOk) {
+    if (cached) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --size_;
+    }
+    return status;
+  }
+  // 复用的实例每次调用都可能换绑或原地修改权重，不缓存打包后的权重
+  op->setConstWeightFlag(false);
+  entry = new Entry(std::move(key));
+  entry->cached_ = cached;
+  entry->op_ = op;
+  return status;
+}
+
+void OpCache::release(Entry *entry, bool keep) {
+  if (entry->cached_) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (keep && size_ <= capacity_) {
+      entry->last_use_ = ++tick_;
+      idle_[entry->hash_].emplace_back(entry);
+      return;
+    }
+    --size_;
+  }
+  destroy(entry);
+}
+
+void OpCache::destroy(Entry *entry) {
+  if (entry->op_ != nullptr) {
+    if (entry->op_->getInitialized()) {
+      entry->op_->deinit();
+    }
+    delete entry->op_;
+  }
+  delete entry;
+}
+
+void OpCache::setCapacity(size_t capacity) {
+  std::vector<Entry *> evicted;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = capacity;
+    while (size_ > capacity_) {
+      auto lru = idle_.end();
+      for (auto it = idle_.begin(); it != idle_.end(); ++it) {
+        if (!it->second.empty() &&
+            (lru == idle_.end() || it->second.front()->last_use_ <
+                                       lru->second.front()->last_use_)) {
+          lru = it;
+        }
+      }
+      // 其余为正在执行的实例，放回时销毁
+      if (lru == idle_.end()) {
+        break;
+      }
+      evicted.emplace_back(lru->second.front());
+      lru->second.erase(lru->second.begin());
+      if (lru->second.empty()) {
+        idle_.erase(lru);
+      }
+      --size_;
+    }
+  }
+  for (Entry *entry : evicted) {
+    destroy(entry);
+  }
+}
+
+size_t OpCache::getCapacity() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return capacity_;
+}
+
+size_t OpCache::getSize() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return size_;
+}
+
+uint64_t OpCache::getHitCount() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return hit_count_;
+}
+
+uint64_t OpCache::getMissCount() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return miss_count_;
+}
+
+void OpCache::clear() {
+  std::vector<Entry *> entries;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &iter : idle_) {
+      entries.insert(entries.end(), iter.second.begin(), iter.second.end());
+    }
+    size_ -= entries.size();
+    idle_.clear();
+  }
+  for (Entry *entry : entries) {
+    destroy(entry);
+  }
+}
+
+OpCache *getGlobalOpCache() {
+  // 不在进程退出时析构，避免在device析构之后销毁算子
+  static OpCache *cache = new OpCache();
+  return cache;
+}
+
+TensorArena::TensorArena() {}
+
+TensorArena::~TensorArena() { clear(); }
+
+device::Tensor *TensorArena::allocate(device::Device *device,
+                                      const device::TensorDesc &desc) {
+  if (cursor_ < tensors_.size()) {
+    device::Tensor *tensor = tensors_[cursor_];
+    if (tensor->getDevice() == device &&
+        (tensor->getDesc() == desc || tensor->justModify(desc))) {
+      ++cursor_;
+      return tensor;
+    }
+    delete tensor;
+    tensors_[cursor_] = new device::Tensor(device, desc);
+  } else {
+    tensors_.emplace_back(new device::Tensor(device, desc));
+  }
+  return tensors_[cursor_++];
+}
+
+device::Tensor *TensorArena::scalar(float value) {
+  // kDataFormatAuto，不改变与之运算的张量的格式
+  static const device::TensorDesc desc(base::dataTypeOf<float>(),
+                                       base::kDataFormatAuto, {1});
+  device::Tensor *tensor = allocate(device::getDefaultHostDevice(), desc);
+  tensor->set(value);
+  return tensor;
+}
+
+void TensorArena::reset() { cursor_ = 0; }
+
+void TensorArena::clear() {
+  for (device::Tensor *tensor : tensors_) {
+    delete tensor;
+  }
+  tensors_.clear();
+  cursor_ = 0;
+}
+
+size_t TensorArena::getSize() { return tensors_.size(); }
+
+}  // namespace op
+}  // namespace nndeploy
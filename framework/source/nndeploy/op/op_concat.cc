@@ -17,6 +17,7 @@
 #include "nndeploy/device/tensor.h"
 #include "nndeploy/ir/ir.h"
 #include "nndeploy/op/op.h"
+#include "nndeploy/op/op_cache.h"
 
 namespace nndeploy {
 namespace op {
@@ -76,37 +77,9 @@ base::Status OpConcat::run() {
 base::Status concat(std::vector<device::Tensor *> input,
                     std::shared_ptr<ir::ConcatParam> param,
                     device::Tensor *output) {
-  base::Status status = base::kStatusCodeOk;
-
-  Op *op = createOp(input[0]->getDeviceType(), "", ir::kOpTypeConcat);
-  if (op == nullptr) {
-    NNDEPLOY_LOGE("createOp failed");
-    return base::kStatusCodeErrorNotImplement;
-  }
-  status = op->setParam(param);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setParam failed");
-  for (size_t i = 0; i < input.size(); i++) {
-    status = op->setInput(input[i], i);
-    NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  }
-  status = op->setOutput(output, 0);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setOutput failed");
-  status = op->init();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "init failed");
-  status = op->checkOrAllocOutput();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
-                         "checkOrAllocOutput failed");
-  status = op->preRun();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "preRun failed");
-  status = op->run();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "run failed");
-  status = op->postRun();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "postRun failed");
-  status = op->deinit();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "deinit failed");
-  delete op;
-
-  return status;
+  return getGlobalOpCache()->run(input[0]->getDeviceType(), ir::kOpTypeConcat,
+                                 param, input,
+                                 std::vector<device::Tensor *>{output});
 }
 
 REGISTER_OP_IMPLEMENTION(kDeviceTypeCodeCpu, ir::kOpTypeConcat, OpConcat)
@@ -17,6 +17,7 @@
 #include "nndeploy/device/tensor.h"
 #include "nndeploy/ir/ir.h"
 #include "nndeploy/op/op.h"
+#include "nndeploy/op/op_cache.h"
 
 namespace nndeploy {
 namespace op {
@@ -133,6 +134,14 @@ base::Status OpConv::run() {
   device::Tensor *bias_tensor = inputs_.size() > 2 ? inputs_[2] : nullptr;
   device::Tensor *output_tensor = outputs_[0];
 
+  // 参考实现只支持fp32，fp16/bf16由各设备上的实现处理
+  base::DataType fp32 = base::dataTypeOf<float>();
+  if (input_tensor->getDataType() != fp32 ||
+      weight_tensor->getDataType() != fp32) {
+    NNDEPLOY_LOGE("OpConv only support fp32.\n");
+    return base::kStatusCodeErrorNotSupport;
+  }
+
   // 获取输入和权重的维度信息
   auto input_shape = input_tensor->getShape();
   auto weight_shape = weight_tensor->getShape();
@@ -223,41 +232,8 @@ base::Status OpConv::run() {
 base::Status conv(device::Tensor *input, device::Tensor *weight,
                   device::Tensor *bias, std::shared_ptr<ir::ConvParam> param,
                   device::Tensor *output) {
-  base::Status status = base::kStatusCodeOk;
-
-  Op *op = createOp(input->getDeviceType(), "", ir::kOpTypeConv);
-  if (op == nullptr) {
-    NNDEPLOY_LOGE("createOp failed");
-    return base::kStatusCodeErrorNotImplement;
-  }
-  status = op->setParam(param);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setParam failed");
-  status = op->setInput(input, 0);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  status = op->setInput(weight, 1);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  if (bias != nullptr) {
-    status = op->setInput(bias, 2);
-    NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  }
-  status = op->setOutput(output, 0);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setOutput failed");
-  status = op->init();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "init failed");
-  status = op->checkOrAllocOutput();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
-                         "checkOrAllocOutput failed");
-  status = op->preRun();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "preRun failed");
-  status = op->run();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "run failed");
-  status = op->postRun();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "postRun failed");
-  status = op->deinit();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "deinit failed");
-  delete op;
-
-  return status;
+  return getGlobalOpCache()->run(input->getDeviceType(), ir::kOpTypeConv, param,
+                                 {input, weight, bias}, {output});
 }
 
 REGISTER_OP_IMPLEMENTION(kDeviceTypeCodeCpu, ir::kOpTypeConv, OpConv)
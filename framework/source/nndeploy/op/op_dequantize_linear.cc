@@ -16,6 +16,7 @@
 #include "nndeploy/device/tensor.h"
 #include "nndeploy/ir/ir.h"
 #include "nndeploy/op/op.h"
+#include "nndeploy/op/op_cache.h"
 #include "nndeploy/op/util.h"
 
 namespace nndeploy {
@@ -165,40 +166,9 @@ base::Status dequantizeLinear(device::Tensor* input, device::Tensor* scale,
                                device::Tensor* zero_point,
                                std::shared_ptr<ir::DequantizeLinearParam> param,
                                device::Tensor* output) {
-  base::Status status = base::kStatusCodeOk;
-
-  Op* op = createOp(input->getDeviceType(), "", ir::kOpTypeDequantizeLinear);
-  if (op == nullptr) {
-    NNDEPLOY_LOGE("createOp failed");
-    return base::kStatusCodeErrorNotImplement;
-  }
-  status = op->setParam(param);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setParam failed");
-  status = op->setInput(input, 0);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  status = op->setInput(scale, 1);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  if (zero_point != nullptr) {
-    status = op->setInput(zero_point, 2);
-    NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  }
-  status = op->setOutput(output, 0);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setOutput failed");
-  status = op->init();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "init failed");
-  status = op->checkOrAllocOutput();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
-                         "checkOrAllocOutput failed");
-  status = op->preRun();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "preRun failed");
-  status = op->run();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "run failed");
-  status = op->postRun();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "postRun failed");
-  status = op->deinit();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "deinit failed");
-  delete op;
-  return status;
+  return getGlobalOpCache()->run(input->getDeviceType(),
+                                 ir::kOpTypeDequantizeLinear, param,
+                                 {input, scale, zero_point}, {output});
 }
 
 REGISTER_OP_IMPLEMENTION(kDeviceTypeCodeCpu, ir::kOpTypeDequantizeLinear,
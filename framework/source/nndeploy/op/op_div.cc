@@ -16,48 +16,25 @@
 #include "nndeploy/device/memory_pool.h"
 #include "nndeploy/device/tensor.h"
 #include "nndeploy/ir/ir.h"
+#include "nndeploy/op/elementwise_kernel.h"
 #include "nndeploy/op/op.h"
+#include "nndeploy/op/op_cache.h"
 
 namespace nndeploy {
 namespace op {
 
 base::Status OpDiv::run() {
-  // TODO: 实现除法运算
-  NNDEPLOY_LOGI("not implemented.\n");
-  return base::kStatusCodeOk;
+  // 按NumPy规则广播
+  return elementwiseBinary(kElementwiseBinaryTypeDiv,
+                           ElementwiseOperand(inputs_[0]),
+                           ElementwiseOperand(inputs_[1]),
+                           ElementwiseOperand(outputs_[0]));
 }
 
 base::Status div(device::Tensor *input1, device::Tensor *input2,
                  device::Tensor *output) {
-  base::Status status = base::kStatusCodeOk;
-
-  Op *op = createOp(input1->getDeviceType(), "", ir::kOpTypeDiv);
-  if (op == nullptr) {
-    NNDEPLOY_LOGE("createOp failed");
-    return base::kStatusCodeErrorNotImplement;
-  }
-  status = op->setInput(input1, 0);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  status = op->setInput(input2, 1);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  status = op->setOutput(output, 0);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setOutput failed");
-  status = op->init();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "init failed");
-  status = op->checkOrAllocOutput();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
-                         "checkOrAllocOutput failed");
-  status = op->preRun();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "preRun failed");
-  status = op->run();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "run failed");
-  status = op->postRun();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "postRun failed");
-  status = op->deinit();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "deinit failed");
-  delete op;
-
-  return status;
+  return getGlobalOpCache()->run(input1->getDeviceType(), ir::kOpTypeDiv,
+                                 nullptr, {input1, input2}, {output});
 }
 
 REGISTER_OP_IMPLEMENTION(kDeviceTypeCodeCpu, ir::kOpTypeDiv, OpDiv)
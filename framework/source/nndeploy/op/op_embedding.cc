@@ -16,7 +16,9 @@
 #include "nndeploy/device/memory_pool.h"
 #include "nndeploy/device/tensor.h"
 #include "nndeploy/ir/ir.h"
+#include "nndeploy/op/elementwise_kernel.h"
 #include "nndeploy/op/op.h"
+#include "nndeploy/op/op_cache.h"
 #include "nndeploy/op/util.h"
 
 namespace nndeploy {
@@ -46,6 +48,12 @@ base::Status OpEmbedding::inferShape() {
   return status;
 }
 
+base::Status OpEmbedding::inferDataType() {
+  // 输出与词表的类型相同(inputs_[0]为索引)
+  outputs_[0]->setDataType(inputs_[1]->getDataType());
+  return base::kStatusCodeOk;
+}
+
 base::Status OpEmbedding::run() {
   base::Status status = base::kStatusCodeOk;
   // 获取输入和输出张量
@@ -54,8 +62,8 @@ base::Status OpEmbedding::run() {
   device::Tensor *output_tensor = outputs_[0];
 
   int32_t *indices = static_cast<int32_t *>(indices_tensor->getData());
-  float *data = static_cast<float *>(data_tensor->getData());
-  float *output = static_cast<float *>(output_tensor->getData());
+  const char *data = static_cast<const char *>(data_tensor->getData());
+  char *output = static_cast<char *>(output_tensor->getData());
 
   auto indices_shape = indices_tensor->getShape();
   auto data_shape = data_tensor->getShape();
@@ -64,6 +72,27 @@ base::Status OpEmbedding::run() {
   int vocab_size = data_shape[0];
   int hidden_size = data_shape[1];
 
+  // 词表保持原有精度(fp32/fp16/bf16/int8)，类型与输出相同时按行直接拷贝，
+  // 否则经fp32转换
+  base::DataType data_type = data_tensor->getDataType();
+  base::DataType output_type = output_tensor->getDataType();
+  const size_t data_row_size = (size_t)hidden_size * data_type.size();
+  const size_t output_row_size = (size_t)hidden_size * output_type.size();
+  ElementwiseLoadFunc load = nullptr;
+  ElementwiseStoreFunc store = nullptr;
+  std::vector<float> row;
+  if (data_type != output_type) {
+    load = getElementwiseLoadFunc(data_type);
+    store = getElementwiseStoreFunc(output_type);
+    if (load == nullptr || store == nullptr) {
+      NNDEPLOY_LOGE("data type %s -> %s is not supported.\n",
+                    base::dataTypeToString(data_type).c_str(),
+                    base::dataTypeToString(output_type).c_str());
+      return base::kStatusCodeErrorNotSupport;
+    }
+    row.resize(hidden_size);
+  }
+
   // batch也统一进去
   int total_indices = 1;
   for (auto dim : indices_shape) {
@@ -76,8 +105,14 @@ base::Status OpEmbedding::run() {
       NNDEPLOY_LOGE("Invalid index: %d\n", idx);
       return base::kStatusCodeErrorInvalidParam;
     }
-    memcpy(output + i * hidden_size, data + idx * hidden_size,
-           hidden_size * sizeof(float));
+    const char *src = data + idx * data_row_size;
+    char *dst = output + i * output_row_size;
+    if (load == nullptr) {
+      memcpy(dst, src, data_row_size);
+    } else {
+      load(src, row.data(), hidden_size);
+      store(row.data(), dst, hidden_size);
+    }
   }
 
   return status;
@@ -86,36 +121,8 @@ base::Status OpEmbedding::run() {
 base::Status embedding(device::Tensor *data, device::Tensor *indices,
                        std::shared_ptr<ir::EmbeddingParam> param,
                        device::Tensor *output) {
-  base::Status status = base::kStatusCodeOk;
-
-  Op *op = createOp(data->getDeviceType(), "", ir::kOpTypeEmbedding);
-  if (op == nullptr) {
-    NNDEPLOY_LOGE("createOp failed");
-    return base::kStatusCodeErrorNotImplement;
-  }
-  status = op->setParam(param);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setParam failed");
-  status = op->setInput(indices, 0);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput 0 failed");
-  status = op->setInput(data, 1);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput 1 failed");
-  status = op->setOutput(output, 0);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setOutput 1 failed");
-  status = op->init();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "init failed");
-  status = op->checkOrAllocOutput();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
-                         "checkOrAllocOutput failed");
-  status = op->preRun();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "preRun failed");
-  status = op->run();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "run failed");
-  status = op->postRun();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "postRun failed");
-  status = op->deinit();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "deinit failed");
-  delete op;
-  return status;
+  return getGlobalOpCache()->run(data->getDeviceType(), ir::kOpTypeEmbedding,
+                                 param, {indices, data}, {output});
 }
 
 REGISTER_OP_IMPLEMENTION(kDeviceTypeCodeCpu, ir::kOpTypeEmbedding, OpEmbedding)
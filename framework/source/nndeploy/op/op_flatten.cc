@@ -17,6 +17,7 @@
 #include "nndeploy/device/tensor.h"
 #include "nndeploy/ir/ir.h"
 #include "nndeploy/op/op.h"
+#include "nndeploy/op/op_cache.h"
 #include "nndeploy/op/util.h"
 
 namespace nndeploy {
@@ -86,9 +87,11 @@ base::Status OpFlatten::run() {
   size_t elem_cnt = std::accumulate(input_shape.begin(), input_shape.end(), 1,
                                     std::multiplies<size_t>());
 
-  // 直接拷贝数据
-  std::memcpy(output_data, input_data,
-              elem_cnt * (input_tensor->getDataType().bits_ / 8));
+  // 直接拷贝数据，inplace时输入输出为同一块内存
+  if (output_data != input_data) {
+    std::memcpy(output_data, input_data,
+                elem_cnt * (input_tensor->getDataType().bits_ / 8));
+  }
 
   return base::kStatusCodeOk;
 }
@@ -96,34 +99,8 @@ base::Status OpFlatten::run() {
 base::Status flatten(device::Tensor* input,
                      std::shared_ptr<ir::FlattenParam> param,
                      device::Tensor* output) {
-  base::Status status = base::kStatusCodeOk;
-
-  Op* op = createOp(input->getDeviceType(), "", ir::kOpTypeFlatten);
-  if (op == nullptr) {
-    NNDEPLOY_LOGE("createOp failed");
-    return base::kStatusCodeErrorNotImplement;
-  }
-  status = op->setParam(param);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setParam failed");
-  status = op->setInput(input, 0);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  status = op->setOutput(output, 0);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setOutput failed");
-  status = op->init();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "init failed");
-  status = op->checkOrAllocOutput();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
-                         "checkOrAllocOutput failed");
-  status = op->preRun();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "preRun failed");
-  status = op->run();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "run failed");
-  status = op->postRun();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "postRun failed");
-  status = op->deinit();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "deinit failed");
-  delete op;
-  return status;
+  return getGlobalOpCache()->run(input->getDeviceType(), ir::kOpTypeFlatten,
+                                 param, {input}, {output});
 }
 
 REGISTER_OP_IMPLEMENTION(kDeviceTypeCodeCpu, ir::kOpTypeFlatten, OpFlatten)
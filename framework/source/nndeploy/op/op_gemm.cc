@@ -16,7 +16,10 @@
 #include "nndeploy/device/memory_pool.h"
 #include "nndeploy/device/tensor.h"
 #include "nndeploy/ir/ir.h"
+#include "nndeploy/op/gemm_kernel.h"
 #include "nndeploy/op/op.h"
+#include "nndeploy/op/op_cache.h"
+#include "nndeploy/op/type_dispatch.h"
 #include "nndeploy/op/util.h"
 
 namespace nndeploy {
@@ -84,6 +87,13 @@ base::Status OpGemm::inferShape() {
 }
 
 base::Status OpGemm::run() {
+  return dispatchFloatDataType(outputs_[0]->getDataType(), [this](auto tag) {
+    return this->runImpl<typename decltype(tag)::type>();
+  });
+}
+
+template <typename T>
+base::Status OpGemm::runImpl() {
   // 获取输入和输出张量
   device::Tensor* input_a = inputs_[0];
   device::Tensor* input_b = inputs_[1];
@@ -102,54 +112,53 @@ base::Status OpGemm::run() {
     NNDEPLOY_LOGE("Failed to cast op param to GemmParam\n");
     return base::kStatusCodeErrorInvalidParam;
   }
+  bool trans_a = param->trans_a_ != 0;
+  bool trans_b = param->trans_b_ != 0;
 
   // 确定矩阵乘法的维度
-  size_t M = param->trans_a_ ? shape_a[1] : shape_a[0];
-  size_t N = param->trans_b_ ? shape_b[0] : shape_b[1];
-  size_t K = param->trans_a_ ? shape_a[0] : shape_a[1];
+  int M = trans_a ? shape_a[1] : shape_a[0];
+  int N = trans_b ? shape_b[0] : shape_b[1];
+  int K = trans_a ? shape_a[0] : shape_a[1];
 
   // 确保输入张量的形状与参数一致
-  if ((param->trans_b_ ? shape_b[1] : shape_b[0]) != K) {
+  if ((trans_b ? shape_b[1] : shape_b[0]) != K) {
     NNDEPLOY_LOGE(
         "Input shapes are not compatible for matrix multiplication.\n");
     return base::kStatusCodeErrorInvalidParam;
   }
 
-  // 获取输入和输出张量的数据指针
-  float* data_a = reinterpret_cast<float*>(input_a->getData());
-  float* data_b = reinterpret_cast<float*>(input_b->getData());
-  float* data_c =
-      input_c ? reinterpret_cast<float*>(input_c->getData()) : nullptr;
-  float* data_output = reinterpret_cast<float*>(output->getData());
-
-  // 执行矩阵乘法
-  for (size_t m = 0; m < M; ++m) {
-    for (size_t n = 0; n < N; ++n) {
-      float sum = 0.0f;
-      for (size_t k = 0; k < K; ++k) {
-        size_t a_index = param->trans_a_ ? (k * M + m) : (m * K + k);
-        size_t b_index = param->trans_b_ ? (n * K + k) : (k * N + n);
-        sum += data_a[a_index] * data_b[b_index];
-      }
-      // 应用 bias，如果存在，并且支持广播
-      if (data_c) {
-        // 根据 bias 的形状进行索引计算
-        if (shape_c.size() == 1) {
-          // 规则3: bias形状为[channel]
-          sum += param->beta_ * data_c[n];
-        } else if (shape_c.size() == 2) {
-          // 规则2: bias形状为[1, channel]
-          if (shape_c[0] == 1) {
-            sum += param->beta_ * data_c[n];
-          } else {
-            // 规则3： bias形状与output一致
-            sum += param->beta_ * data_c[m * N + n];
-          }
-        }
-      }
-      data_output[m * N + n] = param->alpha_ * sum;
+  // fp32输出直接作为累加结果，其余先在fp32缓冲区上计算再写回
+  T* data_output = reinterpret_cast<T*>(output->getData());
+  float* acc = reinterpret_cast<float*>(data_output);
+  if (!std::is_same<T, float>::value) {
+    accumulator_.resize((size_t)M * N);
+    acc = accumulator_.data();
+  }
+
+  // Y = alpha * A' * B' + beta * C，先把广播后的C写入acc，再由sgemm以beta累加
+  if (input_c != nullptr) {
+    ElementwiseLoadFunc load_c =
+        getElementwiseLoadFunc(input_c->getDataType());
+    if (load_c == nullptr) {
+      NNDEPLOY_LOGE("data type of C is not supported.\n");
+      return base::kStatusCodeErrorNotSupport;
+    }
+    const char* data_c = static_cast<const char*>(input_c->getData());
+    size_t row_size = (size_t)N * input_c->getDataType().size();
+    bool full = shape_c.size() == 2 && shape_c[0] != 1;
+    for (int m = 0; m < M; ++m) {
+      load_c(full ? data_c + m * row_size : data_c, acc + (size_t)m * N, N);
     }
   }
+  int lda = trans_a ? M : K;
+  int ldb = trans_b ? K : N;
+  float beta = input_c != nullptr ? param->beta_ : 0.0f;
+  base::Status status = sgemmMixed(
+      trans_a, trans_b, M, N, K, param->alpha_, input_a->getData(),
+      input_a->getDataType(), lda, input_b->getData(), input_b->getDataType(),
+      ldb, beta, acc, N);
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "sgemmMixed failed");
+  storeFromFloat(acc, data_output, M * N);
 
   return base::kStatusCodeOk;
 }
@@ -158,43 +167,14 @@ base::Status gemm(device::Tensor* inputs_a, device::Tensor* inputs_b,
                   device::Tensor* inputs_c,
                   std::shared_ptr<ir::GemmParam> param,
                   device::Tensor* output) {
-  base::Status status = base::kStatusCodeOk;
-
-  Op* op = createOp(inputs_a->getDeviceType(), "", ir::kOpTypeGemm);
-  if (op == nullptr) {
-    NNDEPLOY_LOGE("createOp failed");
-    return base::kStatusCodeErrorNotImplement;
-  }
-  status = op->setParam(param);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setParam failed");
-  status = op->setInput(inputs_a, 0);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  status = op->setInput(inputs_b, 1);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  if (inputs_c != nullptr) {
-    status = op->setInput(inputs_c, 2);
-    NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  }
-  status = op->setOutput(output, 0);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setOutput failed");
-  status = op->init();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "init failed");
-  status = op->checkOrAllocOutput();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
-                         "checkOrAllocOutput failed");
-  status = op->preRun();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "preRun failed");
-  status = op->run();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "run failed");
-  status = op->postRun();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "postRun failed");
-  status = op->deinit();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "deinit failed");
-  delete op;
-  return status;
+  return getGlobalOpCache()->run(inputs_a->getDeviceType(), ir::kOpTypeGemm,
+                                 param, {inputs_a, inputs_b, inputs_c},
+                                 {output});
 }
 
 REGISTER_OP_IMPLEMENTION(kDeviceTypeCodeCpu, ir::kOpTypeGemm, OpGemm)
+REGISTER_OP_IMPLEMENTION(kDeviceTypeCodeX86, ir::kOpTypeGemm, OpGemm)
+REGISTER_OP_IMPLEMENTION(kDeviceTypeCodeArm, ir::kOpTypeGemm, OpGemm)
 
 }  // namespace op
 }  // namespace nndeploy
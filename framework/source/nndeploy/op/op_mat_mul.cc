@@ -16,12 +16,93 @@
 #include "nndeploy/device/memory_pool.h"
 #include "nndeploy/device/tensor.h"
 #include "nndeploy/ir/ir.h"
+#include "nndeploy/op/gemm_kernel.h"
 #include "nndeploy/op/op.h"
+#include "nndeploy/op/op_cache.h"
+#include "nndeploy/op/type_dispatch.h"
 #include "nndeploy/op/util.h"
 
 namespace nndeploy {
 namespace op {
 
+/**
+ * @brief 按onnx MatMul语义（同numpy.matmul）计算batch维广播后的形状
+ * @note 一维输入会先补成矩阵：A补为[1, k]，B补为[k, 1]，计算完再去掉补的维度
+ */
+static base::Status matMulBroadcastShape(const base::IntVector &shape_a,
+                                         const base::IntVector &shape_b,
+                                         base::IntVector &batch_shape, int &m,
+                                         int &n, int &k,
+                                         base::IntVector &output_shape) {
+  if (shape_a.empty() || shape_b.empty()) {
+    NNDEPLOY_LOGE("MatMul input can not be scalar.\n");
+    return base::kStatusCodeErrorInvalidParam;
+  }
+  base::IntVector a = shape_a;
+  base::IntVector b = shape_b;
+  if (a.size() == 1) {
+    a.insert(a.begin(), 1);
+  }
+  if (b.size() == 1) {
+    b.push_back(1);
+  }
+  m = a[a.size() - 2];
+  k = a[a.size() - 1];
+  n = b[b.size() - 1];
+  if (b[b.size() - 2] != k) {
+    NNDEPLOY_LOGE("MatMul inner dimension mismatch: %d vs %d.\n", k,
+                  b[b.size() - 2]);
+    return base::kStatusCodeErrorInvalidParam;
+  }
+  size_t batch_rank = std::max(a.size(), b.size()) - 2;
+  batch_shape.assign(batch_rank, 1);
+  for (size_t i = 0; i < batch_rank; ++i) {
+    int offset_a = (int)i - (int)(batch_rank - (a.size() - 2));
+    int offset_b = (int)i - (int)(batch_rank - (b.size() - 2));
+    int dim_a = offset_a >= 0 ? a[offset_a] : 1;
+    int dim_b = offset_b >= 0 ? b[offset_b] : 1;
+    if (dim_a != dim_b && dim_a != 1 && dim_b != 1) {
+      NNDEPLOY_LOGE("MatMul batch dimension can not broadcast: %d vs %d.\n",
+                    dim_a, dim_b);
+      return base::kStatusCodeErrorInvalidParam;
+    }
+    batch_shape[i] = std::max(dim_a, dim_b);
+  }
+  output_shape = batch_shape;
+  if (shape_a.size() != 1) {
+    output_shape.push_back(m);
+  }
+  if (shape_b.size() != 1) {
+    output_shape.push_back(n);
+  }
+  return base::kStatusCodeOk;
+}
+
+/**
+ * @brief 广播后第batch_index个矩阵在原始输入中的偏移（以矩阵为单位）
+ */
+static size_t matMulBatchOffset(const base::IntVector &shape, size_t rank,
+                                const base::IntVector &batch_shape,
+                                size_t batch_index) {
+  // rank为输入补齐成矩阵后的维度，batch维为前rank - 2维，右对齐广播
+  size_t input_batch_rank = rank - 2;
+  size_t offset = 0;
+  size_t stride = 1;
+  for (size_t i = batch_shape.size(); i-- > 0;) {
+    size_t index = batch_index % batch_shape[i];
+    batch_index /= batch_shape[i];
+    int j = (int)i - (int)(batch_shape.size() - input_batch_rank);
+    if (j < 0) {
+      continue;
+    }
+    if (shape[j] != 1) {
+      offset += index * stride;
+    }
+    stride *= shape[j];
+  }
+  return offset;
+}
+
 base::Status OpMatMul::inferShape() {
   base::Status status = base::kStatusCodeOk;
   if (inputs_.size() < 2) {
@@ -31,10 +112,13 @@ base::Status OpMatMul::inferShape() {
 
   auto first_input_shape = inputs_[0]->getShape();
   auto second_input_shape = inputs_[1]->getShape();
-  int shape_size = second_input_shape.size();
-
-  base::IntVector output_shape = first_input_shape;
-  output_shape[shape_size - 1] = second_input_shape[shape_size - 1];
+  base::IntVector batch_shape;
+  base::IntVector output_shape;
+  int m = 0, n = 0, k = 0;
+  status = matMulBroadcastShape(first_input_shape, second_input_shape,
+                                batch_shape, m, n, k, output_shape);
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                         "matMulBroadcastShape failed");
 
   outputs_[0]->reshape(output_shape);
 
@@ -42,43 +126,75 @@ base::Status OpMatMul::inferShape() {
 }
 
 base::Status OpMatMul::run() {
-  NNDEPLOY_LOGI("not implemented.\n");
-  return base::kStatusCodeOk;
+  return dispatchFloatDataType(outputs_[0]->getDataType(), [this](auto tag) {
+    return this->runImpl<typename decltype(tag)::type>();
+  });
 }
 
-base::Status matmul(device::Tensor *inputs_a, device::Tensor *inputs_b,
-                    device::Tensor *output) {
-  base::Status status = base::kStatusCodeOk;
+template <typename T>
+base::Status OpMatMul::runImpl() {
+  device::Tensor *input_a = inputs_[0];
+  device::Tensor *input_b = inputs_[1];
+  device::Tensor *output = outputs_[0];
+
+  base::IntVector shape_a = input_a->getShape();
+  base::IntVector shape_b = input_b->getShape();
+  base::IntVector batch_shape;
+  base::IntVector output_shape;
+  int m = 0, n = 0, k = 0;
+  base::Status status = matMulBroadcastShape(shape_a, shape_b, batch_shape, m,
+                                             n, k, output_shape);
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                         "matMulBroadcastShape failed");
+
+  const char *data_a = static_cast<const char *>(input_a->getData());
+  const char *data_b = static_cast<const char *>(input_b->getData());
+  const size_t elem_size_a = input_a->getDataType().size();
+  const size_t elem_size_b = input_b->getDataType().size();
 
-  Op *op = createOp(inputs_a->getDeviceType(), "", ir::kOpTypeMaxPool);
-  if (op == nullptr) {
-    NNDEPLOY_LOGE("createOp failed");
-    return base::kStatusCodeErrorNotImplement;
+  // 每个batch的矩阵指针，广播的输入在多个batch间共享
+  size_t batch = 1;
+  for (auto dim : batch_shape) {
+    batch *= dim;
   }
-  status = op->setInput(inputs_a, 0);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  status = op->setInput(inputs_b, 0);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  status = op->setOutput(output, 0);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setOutput failed");
-  status = op->init();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "init failed");
-  status = op->checkOrAllocOutput();
+  // fp32输出直接作为累加结果，其余先在fp32缓冲区上计算再写回
+  T *data_output = reinterpret_cast<T *>(output->getData());
+  float *acc = reinterpret_cast<float *>(data_output);
+  if (!std::is_same<T, float>::value) {
+    accumulator_.resize(batch * m * n);
+    acc = accumulator_.data();
+  }
+  size_t rank_a = std::max<size_t>(shape_a.size(), 2);
+  size_t rank_b = std::max<size_t>(shape_b.size(), 2);
+  std::vector<const void *> a_ptrs(batch);
+  std::vector<const void *> b_ptrs(batch);
+  std::vector<float *> c_ptrs(batch);
+  for (size_t i = 0; i < batch; ++i) {
+    a_ptrs[i] = data_a + matMulBatchOffset(shape_a, rank_a, batch_shape, i) *
+                             m * k * elem_size_a;
+    b_ptrs[i] = data_b + matMulBatchOffset(shape_b, rank_b, batch_shape, i) *
+                             k * n * elem_size_b;
+    c_ptrs[i] = acc + i * m * n;
+  }
+  status = sgemmBatchMixed(false, false, m, n, k, 1.0f, a_ptrs.data(),
+                           input_a->getDataType(), k, b_ptrs.data(),
+                           input_b->getDataType(), n, 0.0f, c_ptrs.data(), n,
+                           (int)batch);
   NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
-                         "checkOrAllocOutput failed");
-  status = op->preRun();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "preRun failed");
-  status = op->run();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "run failed");
-  status = op->postRun();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "postRun failed");
-  status = op->deinit();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "deinit failed");
-  delete op;
-  return status;
+                         "sgemmBatchMixed failed");
+  storeFromFloat(acc, data_output, (int)(batch * m * n));
+  return base::kStatusCodeOk;
+}
+
+base::Status matmul(device::Tensor *inputs_a, device::Tensor *inputs_b,
+                    device::Tensor *output) {
+  return getGlobalOpCache()->run(inputs_a->getDeviceType(), ir::kOpTypeMatMul,
+                                 nullptr, {inputs_a, inputs_b}, {output});
 }
 
 REGISTER_OP_IMPLEMENTION(kDeviceTypeCodeCpu, ir::kOpTypeMatMul, OpMatMul)
+REGISTER_OP_IMPLEMENTION(kDeviceTypeCodeX86, ir::kOpTypeMatMul, OpMatMul)
+REGISTER_OP_IMPLEMENTION(kDeviceTypeCodeArm, ir::kOpTypeMatMul, OpMatMul)
 
 }  // namespace op
 }  // namespace nndeploy
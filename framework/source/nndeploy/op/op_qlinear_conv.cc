@@ -5,6 +5,7 @@
 #include "nndeploy/base/macro.h"
 #include "nndeploy/base/object.h"
 #include "nndeploy/base/param.h"
+#include "nndeploy/base/shape.h"
 #include "nndeploy/base/status.h"
 #include "nndeploy/base/string.h"
 #include "nndeploy/base/time_profiler.h"
@@ -13,9 +14,37 @@
 #include "nndeploy/device/memory_pool.h"
 #include "nndeploy/ir/ir.h"
 #include "nndeploy/op/op.h"
+#include "nndeploy/op/op_cache.h"
 
 namespace nndeploy {
 namespace op {
+
+static bool isQuantizedDataType(const base::DataType& data_type) {
+  return data_type == base::dataTypeOf<int8_t>() ||
+         data_type == base::dataTypeOf<uint8_t>();
+}
+
+/**
+ * @brief 读取int8/uint8张量的第index个元素
+ */
+static inline int32_t loadQuantizedValue(const device::Tensor* tensor,
+                                         size_t index) {
+  if (tensor->getDataType() == base::dataTypeOf<int8_t>()) {
+    return static_cast<const int8_t*>(tensor->getData())[index];
+  }
+  return static_cast<const uint8_t*>(tensor->getData())[index];
+}
+
+base::Status OpQLinearConv::inferDataType() {
+  if (inputs_.size() < 8) {
+    NNDEPLOY_LOGE("QLinearConv requires at least 8 inputs.\n");
+    return base::kStatusCodeErrorInvalidParam;
+  }
+  // y的类型由y_zero_point决定
+  outputs_[0]->setDataType(inputs_[7]->getDataType());
+  return base::kStatusCodeOk;
+}
+
 base::Status OpQLinearConv::inferShape() {
   base::Status status = base::kStatusCodeOk;
 
@@ -50,9 +79,8 @@ base::Status OpQLinearConv::inferShape() {
   }
   std::vector<int> kernel_shape = param->kernel_shape_;
   if (kernel_shape.size() == 0) {
-    auto second_input_shape = inputs_[1]->getShape();
-    for (int i = 2; i < second_input_shape.size(); ++i) {
-      kernel_shape.push_back(second_input_shape[i]);
+    for (int i = 2; i < w_shape.size(); ++i) {
+      kernel_shape.push_back(w_shape[i]);
     }
   }
   std::vector<int> strides = param->strides_;
@@ -104,7 +132,7 @@ base::Status OpQLinearConv::inferShape() {
   // add the first two dimensions from the input.
   base::IntVector output_shape = input_shape;
   output_shape[0] = input_shape[0];
-  output_shape[1] = inputs_[1]->getShape()[0];
+  output_shape[1] = w_shape[0];
   for (size_t i = 2; i < output_shape.size(); i++) {
     output_shape[i] = -1;
   }
@@ -128,195 +156,186 @@ base::Status OpQLinearConv::inferShape() {
     output_shape[new_i] = 1 + strided_kernel_positions;
   }
 
-
   outputs_[0]->reshape(output_shape);
   // outputs_[0]->print();
 
   return status;
 }
 
-template <typename T>
+base::Status OpQLinearConv::getQuantParam(
+    QLinearConvQuantParam& quant_param) {
+  if (inputs_.size() < 8 || outputs_.empty()) {
+    NNDEPLOY_LOGE("QLinearConv requires at least 8 inputs.\n");
+    return base::kStatusCodeErrorInvalidParam;
+  }
+  device::Tensor* x = inputs_[0];
+  device::Tensor* x_scale = inputs_[1];
+  device::Tensor* x_zero_point = inputs_[2];
+  device::Tensor* w = inputs_[3];
+  device::Tensor* w_scale = inputs_[4];
+  device::Tensor* w_zero_point = inputs_[5];
+  device::Tensor* y_scale = inputs_[6];
+  device::Tensor* y_zero_point = inputs_[7];
+  device::Tensor* B = inputs_.size() > 8 ? inputs_[8] : nullptr;
+  device::Tensor* y = outputs_[0];
+
+  if (!isQuantizedDataType(x->getDataType()) ||
+      !isQuantizedDataType(w->getDataType()) ||
+      !isQuantizedDataType(y->getDataType())) {
+    NNDEPLOY_LOGE("QLinearConv only supports int8/uint8 x, w and y.\n");
+    return base::kStatusCodeErrorNotSupport;
+  }
+  if (x_zero_point->getDataType() != x->getDataType() ||
+      w_zero_point->getDataType() != w->getDataType() ||
+      y_zero_point->getDataType() != y->getDataType()) {
+    NNDEPLOY_LOGE("data type of zero point mismatch.\n");
+    return base::kStatusCodeErrorInvalidParam;
+  }
+  if (x_scale->getDataType() != base::dataTypeOf<float>() ||
+      w_scale->getDataType() != base::dataTypeOf<float>() ||
+      y_scale->getDataType() != base::dataTypeOf<float>()) {
+    NNDEPLOY_LOGE("QLinearConv only supports fp32 scale.\n");
+    return base::kStatusCodeErrorNotSupport;
+  }
+  if (base::shapeCount(x_scale->getShape()) != 1 ||
+      base::shapeCount(x_zero_point->getShape()) != 1 ||
+      base::shapeCount(y_scale->getShape()) != 1 ||
+      base::shapeCount(y_zero_point->getShape()) != 1) {
+    NNDEPLOY_LOGE("scale and zero point of x and y must be scalar.\n");
+    return base::kStatusCodeErrorInvalidParam;
+  }
+  const int channel_out = w->getShape()[0];
+  const size_t w_scale_size = base::shapeCount(w_scale->getShape());
+  const size_t w_zero_point_size = base::shapeCount(w_zero_point->getShape());
+  if ((w_scale_size != 1 && w_scale_size != channel_out) ||
+      (w_zero_point_size != 1 && w_zero_point_size != channel_out)) {
+    NNDEPLOY_LOGE("scale and zero point of w must be scalar or per channel.\n");
+    return base::kStatusCodeErrorInvalidParam;
+  }
+  if (B != nullptr && (B->getDataType() != base::dataTypeOf<int32_t>() ||
+                       base::shapeCount(B->getShape()) != channel_out)) {
+    NNDEPLOY_LOGE("bias of QLinearConv must be int32 with shape [M].\n");
+    return base::kStatusCodeErrorInvalidParam;
+  }
+
+  quant_param.x_scale_ = static_cast<float*>(x_scale->getData())[0];
+  quant_param.x_zero_point_ = loadQuantizedValue(x_zero_point, 0);
+  quant_param.y_scale_ = static_cast<float*>(y_scale->getData())[0];
+  quant_param.y_zero_point_ = loadQuantizedValue(y_zero_point, 0);
+  const float* w_scale_ptr = static_cast<float*>(w_scale->getData());
+  quant_param.w_scale_.resize(channel_out);
+  quant_param.w_zero_point_.resize(channel_out);
+  for (int c = 0; c < channel_out; ++c) {
+    quant_param.w_scale_[c] = w_scale_ptr[w_scale_size == 1 ? 0 : c];
+    quant_param.w_zero_point_[c] =
+        loadQuantizedValue(w_zero_point, w_zero_point_size == 1 ? 0 : c);
+  }
+  return base::kStatusCodeOk;
+}
+
 base::Status OpQLinearConv::qLinearConvImpl(
-    device::Tensor* x, device::Tensor* x_scale, device::Tensor* x_zero_point,
-    device::Tensor* w, device::Tensor* w_scale, device::Tensor* w_zero_point,
-    device::Tensor* y_scale, device::Tensor* y_zero_point, device::Tensor* B,
-    void* output_data) {
-  const T* x_ptr = reinterpret_cast<T*>(x->getData());
-  const float* x_scale_ptr = reinterpret_cast<float*>(x_scale->getData());
-  const T* x_zp_ptr = reinterpret_cast<T*>(x_zero_point->getData());
-  const T* w_ptr = reinterpret_cast<T*>(w->getData());
-  const float* w_scale_ptr = reinterpret_cast<float*>(w_scale->getData());
-  const T* w_zp_ptr = reinterpret_cast<T*>(w_zero_point->getData());
-  const float* y_scale_ptr = reinterpret_cast<float*>(y_scale->getData());
-  const T* y_zp_ptr = reinterpret_cast<T*>(y_zero_point->getData());
-  const int32_t* B_ptr = B ? reinterpret_cast<int32_t*>(B->getData()) : nullptr;
-  T* output_ptr = reinterpret_cast<T*>(output_data);
+    const QLinearConvQuantParam& quant_param) {
+  device::Tensor* x = inputs_[0];
+  device::Tensor* w = inputs_[3];
+  device::Tensor* B = inputs_.size() > 8 ? inputs_[8] : nullptr;
+  device::Tensor* y = outputs_[0];
+  const int32_t* B_ptr =
+      B != nullptr ? static_cast<const int32_t*>(B->getData()) : nullptr;
 
   auto param = dynamic_cast<ir::QLinearConvParam*>(op_desc_.op_param_.get());
-  std::vector<int> kernel_shape = param->kernel_shape_;
-  std::vector<int> strides = param->strides_;
-  std::vector<int> dilations = param->dilations_;
-  std::vector<int> pads = param->pads_;
+  NNDEPLOY_CHECK_PARAM_NULL_RET_STATUS(param, "op_desc_.op_param_ is nullptr");
+  const std::vector<int>& strides = param->strides_;
+  const std::vector<int>& dilations = param->dilations_;
+  const std::vector<int>& pads = param->pads_;
 
   const auto& x_shape = x->getShape();
   const auto& w_shape = w->getShape();
-  const auto& output_shape = outputs_[0]->getShape();
-
-  long output_size = std::accumulate(output_shape.begin(), output_shape.end(),
-                                     1, std::multiplies<int>());
-
-  long x_size = std::accumulate(x_shape.begin(), x_shape.end(), 1,
-                                std::multiplies<int>());
-
-  long w_size = std::accumulate(w_shape.begin(), w_shape.end(), 1,
-                                std::multiplies<int>());
-
-  // 转换为int32计算 防止溢出
-  int32_t* x_dequantized = new int32_t[x_size];
-  int32_t* w_dequantized = new int32_t[w_size];
-
-  for (size_t i = 0; i < x_size; ++i) {
-    x_dequantized[i] =
-        static_cast<int32_t>(x_ptr[i]) - static_cast<int32_t>(x_zp_ptr[0]);
+  const auto& y_shape = y->getShape();
+  if (x_shape.size() != 4 || w_shape.size() != 4 || y_shape.size() != 4) {
+    NNDEPLOY_LOGE("QLinearConv only supports 2d convolution.\n");
+    return base::kStatusCodeErrorNotSupport;
   }
-
-  for (size_t i = 0; i < w_size; ++i) {
-    w_dequantized[i] =
-        static_cast<int32_t>(w_ptr[i]) - static_cast<int32_t>(w_zp_ptr[0]);
+  const int group = std::max(param->group_, 1);
+  const int batch = x_shape[0];
+  const int channel_in = x_shape[1] / group;
+  const int channel_out = w_shape[0] / group;
+  const int height_in = x_shape[2];
+  const int width_in = x_shape[3];
+  const int kernel_h = w_shape[2];
+  const int kernel_w = w_shape[3];
+  const int height_out = y_shape[2];
+  const int width_out = y_shape[3];
+  if (w_shape[1] != channel_in || w_shape[0] % group != 0) {
+    NNDEPLOY_LOGE("shape of w does not match group.\n");
+    return base::kStatusCodeErrorInvalidParam;
   }
 
-  // Convolution implementation
-  int32_t* conv_result = new int32_t[output_size];
-  int output_height = output_shape[2];
-  int output_width = output_shape[3];
-  for (int n = 0; n < x_shape[0]; ++n) {
-    for (int f = 0; f < w_shape[0]; ++f) {
-      for (int y = 0; y < output_height; ++y) {
-        for (int x = 0; x < output_width; ++x) {
-          int32_t value = 0;
-
-          for (int k = 0; k < x_shape[1]; ++k) {
-            for (int i = 0; i < kernel_shape[0]; ++i) {
-              for (int j = 0; j < kernel_shape[1]; ++j) {
-                int input_y = y * strides[0] + i * dilations[0] - pads[0];
-                int input_x = x * strides[1] + j * dilations[1] - pads[1];
-
-                if (input_y >= 0 && input_y < x_shape[2] && input_x >= 0 &&
-                    input_x < x_shape[3]) {
-                  int32_t x_val =
-                      x_dequantized[n * x_shape[1] * x_shape[2] * x_shape[3] +
-                                    k * x_shape[2] * x_shape[3] +
-                                    input_y * x_shape[3] + input_x];
-                  int32_t w_val =
-                      w_dequantized[f * x_shape[1] * kernel_shape[0] *
-                                        kernel_shape[1] +
-                                    k * kernel_shape[0] * kernel_shape[1] +
-                                    i * kernel_shape[1] + j];
-
+  const bool y_signed = y->getDataType() == base::dataTypeOf<int8_t>();
+  const float y_min = y_signed ? -128.0f : 0.0f;
+  const float y_max = y_signed ? 127.0f : 255.0f;
+  for (int n = 0; n < batch; ++n) {
+    for (int gi = 0; gi < group; ++gi) {
+      for (int f = gi * channel_out; f < (gi + 1) * channel_out; ++f) {
+        const int32_t w_zp = quant_param.w_zero_point_[f];
+        // 与x86实现使用同样的计算顺序，结果逐位一致
+        const float scale = quant_param.x_scale_ * quant_param.w_scale_[f] /
+                            quant_param.y_scale_;
+        for (int oh = 0; oh < height_out; ++oh) {
+          for (int ow = 0; ow < width_out; ++ow) {
+            int32_t value = 0;
+            for (int c = 0; c < channel_in; ++c) {
+              const size_t x_offset =
+                  ((size_t)n * x_shape[1] + gi * channel_in + c) * height_in *
+                  width_in;
+              const size_t w_offset =
+                  ((size_t)f * channel_in + c) * kernel_h * kernel_w;
+              for (int kh = 0; kh < kernel_h; ++kh) {
+                for (int kw = 0; kw < kernel_w; ++kw) {
+                  const int ih = oh * strides[0] + kh * dilations[0] - pads[0];
+                  const int iw = ow * strides[1] + kw * dilations[1] - pads[1];
+                  if (ih < 0 || ih >= height_in || iw < 0 || iw >= width_in) {
+                    continue;
+                  }
+                  const int32_t x_val =
+                      loadQuantizedValue(x, x_offset + ih * width_in + iw) -
+                      quant_param.x_zero_point_;
+                  const int32_t w_val =
+                      loadQuantizedValue(w, w_offset + kh * kernel_w + kw) -
+                      w_zp;
                   value += x_val * w_val;
-                 
                 }
               }
             }
+            if (B_ptr != nullptr) {
+              value += B_ptr[f];
+            }
+            float result = std::nearbyint(static_cast<float>(value) * scale) +
+                           static_cast<float>(quant_param.y_zero_point_);
+            result = std::max(y_min, std::min(y_max, result));
+            const size_t y_offset =
+                (((size_t)n * w_shape[0] + f) * height_out + oh) * width_out +
+                ow;
+            if (y_signed) {
+              static_cast<int8_t*>(y->getData())[y_offset] =
+                  static_cast<int8_t>(result);
+            } else {
+              static_cast<uint8_t*>(y->getData())[y_offset] =
+                  static_cast<uint8_t>(result);
+            }
           }
-
-          // Add bias
-          if (B_ptr) {
-            value += B_ptr[f];
-          }
-
-          conv_result[n * w_shape[0] * output_height * output_width +
-                      f * output_height * output_width + y * output_width + x] =
-              value;
         }
       }
     }
   }
-
-  // Requantize the result
-  float scale = x_scale_ptr[0] * w_scale_ptr[0] / y_scale_ptr[0];
-  for (size_t i = 0; i < output_size; ++i) {
-    float quantized_value = conv_result[i] * scale + y_zp_ptr[0];
-    if (std::is_integral<T>::value) {
-      // int8范围
-      if (std::is_signed<T>::value) {
-      
-        quantized_value = std::max(-128.0f, std::min(127.0f, quantized_value));
-      } else {
-        // uint8范围
-     
-        quantized_value = std::max(0.0f, std::min(255.0f, quantized_value));
-      }
-    }
-    output_ptr[i] = static_cast<T>(std::round(quantized_value));
-  }
-
-  // Cleanup
-  delete[] x_dequantized;
-  delete[] w_dequantized;
-  delete[] conv_result;
-
   return base::kStatusCodeOk;
 }
 
-// 显式模板实例化
-template base::Status OpQLinearConv::qLinearConvImpl<int8_t>(
-    device::Tensor* x, device::Tensor* x_scale, device::Tensor* x_zero_point,
-    device::Tensor* w, device::Tensor* w_scale, device::Tensor* w_zero_point,
-    device::Tensor* y_scale, device::Tensor* y_zero_point, device::Tensor* B,
-    void* output_data);
-
-template base::Status OpQLinearConv::qLinearConvImpl<uint8_t>(
-    device::Tensor* x, device::Tensor* x_scale, device::Tensor* x_zero_point,
-    device::Tensor* w, device::Tensor* w_scale, device::Tensor* w_zero_point,
-    device::Tensor* y_scale, device::Tensor* y_zero_point, device::Tensor* B,
-    void* output_data);
-
 base::Status OpQLinearConv::run() {
-  device::Tensor* x = inputs_[0];
-  device::Tensor* x_scale = inputs_[1];
-  device::Tensor* x_zero_point = inputs_[2];
-  device::Tensor* w = inputs_[3];
-  device::Tensor* w_scale = inputs_[4];
-  device::Tensor* w_zero_point = inputs_[5];
-  device::Tensor* y_scale = inputs_[6];
-  device::Tensor* y_zero_point = inputs_[7];
-  device::Tensor* B = inputs_.size() > 8 ? inputs_[8] : nullptr;
-  device::Tensor* output = outputs_[0];
-
-  base::DataType x_dtype = x->getDataType();
-
-  if (x_dtype != base::dataTypeOf<int8_t>() &&
-      x_dtype != base::dataTypeOf<uint8_t>()) {
-    NNDEPLOY_LOGE("Unsupported input dtype");
-    return base::kStatusCodeErrorInvalidParam;
-  }
-
-  void* output_data = output->getData();
-
-  auto param = dynamic_cast<ir::QLinearConvParam*>(op_desc_.op_param_.get());
-
-  switch (x_dtype.code_) {
-    case base::kDataTypeCodeInt:
-      if (x_dtype.bits_ == 8) {
-        return this->qLinearConvImpl<int8_t>(x, x_scale, x_zero_point, w,
-                                             w_scale, w_zero_point, y_scale,
-                                             y_zero_point, B, output_data);
-      }
-      break;
-    case base::kDataTypeCodeUint:
-      if (x_dtype.bits_ == 8) {
-        return this->qLinearConvImpl<uint8_t>(x, x_scale, x_zero_point, w,
-                                              w_scale, w_zero_point, y_scale,
-                                              y_zero_point, B, output_data);
-      }
-      break;
-    default:
-      break;
-  }
-
-  NNDEPLOY_LOGE("Unsupported qlinear conv input dtype");
-  return base::kStatusCodeErrorInvalidParam;
+  QLinearConvQuantParam quant_param;
+  base::Status status = this->getQuantParam(quant_param);
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                         "getQuantParam failed");
+  return this->qLinearConvImpl(quant_param);
 }
 
 base::Status qLinearConv(device::Tensor* x, device::Tensor* x_scale,
@@ -326,52 +345,11 @@ base::Status qLinearConv(device::Tensor* x, device::Tensor* x_scale,
                          device::Tensor* B,
                          std::shared_ptr<ir::QLinearConvParam> param,
                          device::Tensor* output) {
-  base::Status status = base::kStatusCodeOk;
-
-  Op* op = createOp(x->getDeviceType(), "", ir::kOpTypeQLinearConv);
-  if (op == nullptr) {
-    NNDEPLOY_LOGE("createOp failed");
-    return base::kStatusCodeErrorNotImplement;
-  }
-  status = op->setParam(param);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setParam failed");
-  status = op->setInput(x, 0);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  status = op->setInput(x_scale, 1);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  status = op->setInput(x_zero_point, 2);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  status = op->setInput(w, 3);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  status = op->setInput(w_scale, 4);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  status = op->setInput(w_zero_point, 5);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  status = op->setInput(y_scale, 6);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  status = op->setInput(y_zero_point, 7);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  if (B != nullptr) {
-    status = op->setInput(B, 8);
-    NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  }
-  status = op->setOutput(output, 0);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setOutput failed");
-  status = op->init();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "init failed");
-  status = op->checkOrAllocOutput();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
-                         "checkOrAllocOutput failed");
-  status = op->preRun();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "preRun failed");
-  status = op->run();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "run failed");
-  status = op->postRun();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "postRun failed");
-  status = op->deinit();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "deinit failed");
-  delete op;
-  return status;
+  return getGlobalOpCache()->run(
+      x->getDeviceType(), ir::kOpTypeQLinearConv, param,
+      {x, x_scale, x_zero_point, w, w_scale, w_zero_point, y_scale,
+       y_zero_point, B},
+      {output});
 }
 
 REGISTER_OP_IMPLEMENTION(kDeviceTypeCodeCpu, ir::kOpTypeQLinearConv,
@@ -16,63 +16,22 @@
 #include "nndeploy/device/memory_pool.h"
 #include "nndeploy/device/tensor.h"
 #include "nndeploy/ir/ir.h"
+#include "nndeploy/op/elementwise_kernel.h"
 #include "nndeploy/op/op.h"
+#include "nndeploy/op/op_cache.h"
 
 namespace nndeploy {
 namespace op {
 
 base::Status OpSigmoid::run() {
-  base::Status status = base::kStatusCodeOk;
-
-  // 获取输入和输出张量
-  device::Tensor* input_tensor = inputs_[0];
-  device::Tensor* output_tensor = outputs_[0];
-
-  // 获取输入张量的维度信息
-  auto input_shape = input_tensor->getShape();
-  long input_elements = std::accumulate(input_shape.begin(), input_shape.end(),
-                                        1, std::multiplies<int>());
-
-  // 获取输入和输出张量的数据指针
-  float* input_data = static_cast<float*>(input_tensor->getData());
-  float* output_data = static_cast<float*>(output_tensor->getData());
-
-  // 执行Sigmoid操作
-  for (long i = 0; i < input_elements; ++i) {
-    output_data[i] = 1.0f / (1.0f + expf(-input_data[i]));
-  }
-
-  return status;
+  return elementwiseUnary({ElementwiseUnary(kElementwiseUnaryTypeSigmoid)},
+                          ElementwiseOperand(inputs_[0]),
+                          ElementwiseOperand(outputs_[0]));
 }
 
 base::Status sigmoid(device::Tensor* input, device::Tensor* output) {
-  base::Status status = base::kStatusCodeOk;
-
-  Op* op = createOp(input->getDeviceType(), "", ir::kOpTypeSigmoid);
-  if (op == nullptr) {
-    NNDEPLOY_LOGE("createOp failed");
-    return base::kStatusCodeErrorNotImplement;
-  }
-  status = op->setInput(input, 0);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  status = op->setOutput(output, 0);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setOutput failed");
-  status = op->init();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "init failed");
-  status = op->checkOrAllocOutput();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
-                         "checkOrAllocOutput failed");
-  status = op->preRun();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "preRun failed");
-  status = op->run();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "run failed");
-  status = op->postRun();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "postRun failed");
-  status = op->deinit();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "deinit failed");
-  delete op;
-
-  return status;
+  return getGlobalOpCache()->run(input->getDeviceType(), ir::kOpTypeSigmoid,
+                                 nullptr, {input}, {output});
 }
 
 REGISTER_OP_IMPLEMENTION(kDeviceTypeCodeCpu, ir::kOpTypeSigmoid, OpSigmoid)
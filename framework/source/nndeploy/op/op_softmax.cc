@@ -17,6 +17,8 @@
 #include "nndeploy/device/tensor.h"
 #include "nndeploy/ir/ir.h"
 #include "nndeploy/op/op.h"
+#include "nndeploy/op/op_cache.h"
+#include "nndeploy/op/type_dispatch.h"
 
 namespace nndeploy {
 namespace op {
@@ -46,6 +48,13 @@ base::Status OpSoftmax::inferShape() {
 }
 
 base::Status OpSoftmax::run() {
+  return dispatchFloatDataType(inputs_[0]->getDataType(), [this](auto tag) {
+    return this->runImpl<typename decltype(tag)::type>();
+  });
+}
+
+template <typename T>
+base::Status OpSoftmax::runImpl() {
   base::Status status = base::kStatusCodeOk;
   // 获取输入和输出张量
   device::Tensor *input_tensor = inputs_[0];
@@ -60,8 +69,8 @@ base::Status OpSoftmax::run() {
   int axis = param->axis_;
 
   // 获取输入输出数据
-  float *input_data = static_cast<float *>(input_tensor->getData());
-  float *output_data = static_cast<float *>(output_tensor->getData());
+  const T *input_data = static_cast<const T *>(input_tensor->getData());
+  T *output_data = static_cast<T *>(output_tensor->getData());
 
   // 计算每个维度的大小
   int outer_size = 1;
@@ -74,30 +83,43 @@ base::Status OpSoftmax::run() {
     inner_size *= input_shape[i];
   }
 
+  // 每次处理一个[axis_size x inner_size]的切片，非fp32时转为fp32计算后写回
+  const int slice_size = axis_size * inner_size;
+  if (!std::is_same<T, float>::value) {
+    buffer_.resize((size_t)slice_size * 2);
+  }
+
   // 执行softmax操作
   for (int i = 0; i < outer_size; i++) {
+    T *output_slice = output_data + (size_t)i * slice_size;
+    const float *input = loadAsFloat(input_data + (size_t)i * slice_size,
+                                     buffer_.data(), slice_size);
+    float *output = std::is_same<T, float>::value
+                        ? reinterpret_cast<float *>(output_slice)
+                        : buffer_.data() + slice_size;
     for (int k = 0; k < inner_size; k++) {
       // 找到最大值
       float max_val = -std::numeric_limits<float>::infinity();
       for (int j = 0; j < axis_size; j++) {
-        int index = i * axis_size * inner_size + j * inner_size + k;
-        max_val = std::max(max_val, input_data[index]);
+        int index = j * inner_size + k;
+        max_val = std::max(max_val, input[index]);
       }
 
       // 计算exp和
       float sum = 0.0f;
       for (int j = 0; j < axis_size; j++) {
-        int index = i * axis_size * inner_size + j * inner_size + k;
-        output_data[index] = std::exp(input_data[index] - max_val);
-        sum += output_data[index];
+        int index = j * inner_size + k;
+        output[index] = std::exp(input[index] - max_val);
+        sum += output[index];
       }
 
       // 归一化
       for (int j = 0; j < axis_size; j++) {
-        int index = i * axis_size * inner_size + j * inner_size + k;
-        output_data[index] /= sum;
+        int index = j * inner_size + k;
+        output[index] /= sum;
       }
     }
+    storeFromFloat(output, output_slice, slice_size);
   }
 
   return status;
@@ -106,35 +128,8 @@ base::Status OpSoftmax::run() {
 base::Status softmax(device::Tensor *input,
                      std::shared_ptr<ir::SoftmaxParam> param,
                      device::Tensor *output) {
-  base::Status status = base::kStatusCodeOk;
-
-  Op *op = createOp(input->getDeviceType(), "", ir::kOpTypeSoftmax);
-  if (op == nullptr) {
-    NNDEPLOY_LOGE("createOp failed");
-    return base::kStatusCodeErrorNotImplement;
-  }
-  status = op->setParam(param);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setParam failed");
-  status = op->setInput(input, 0);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setInput failed");
-  status = op->setOutput(output, 0);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "setOutput failed");
-  status = op->init();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "init failed");
-  status = op->checkOrAllocOutput();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
-                         "checkOrAllocOutput failed");
-  status = op->preRun();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "preRun failed");
-  status = op->run();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "run failed");
-  status = op->postRun();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "postRun failed");
-  status = op->deinit();
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "deinit failed");
-  delete op;
-
-  return status;
+  return getGlobalOpCache()->run(input->getDeviceType(), ir::kOpTypeSoftmax,
+                                 param, {input}, {output});
 }
 
 REGISTER_OP_IMPLEMENTION(kDeviceTypeCodeCpu, ir::kOpTypeSoftmax, OpSoftmax)
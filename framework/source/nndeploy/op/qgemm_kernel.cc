@@ -0,0 +1,210 @@
+
+#include "nndeploy/op/qgemm_kernel.h"
+
+#include "nndeploy/base/common.h"
+#include "nndeploy/base/glic_stl_include.h"
+#include "nndeploy/base/log.h"
+#include "nndeploy/base/macro.h"
+#include "nndeploy/base/status.h"
+#include "nndeploy/thread_pool/parallel.h"
+
+namespace nndeploy {
+namespace op {
+
+// 打包后B块的字节数上限，B的[k x nc]块常驻L2，A的微面板从L2/L3流过
+static const int kQgemmBlockBytes = 256 * 1024;
+static const int kQgemmBlockNMax = 512;
+
+static void qgemmMicroKernel4x8(int k4, const int8_t *a, const uint8_t *b,
+                                int32_t *c, int ldc, bool accumulate) {
+  int32_t acc[4][8] = {{0}};
+  for (int g = 0; g < k4; ++g) {
+    for (int i = 0; i < 4; ++i) {
+      for (int j = 0; j < 8; ++j) {
+        int32_t sum = 0;
+        for (int r = 0; r < 4; ++r) {
+          sum += (int32_t)a[i * 4 + r] * (int32_t)b[j * 4 + r];
+        }
+        acc[i][j] += sum;
+      }
+    }
+    a += 4 * 4;
+    b += 8 * 4;
+  }
+  for (int i = 0; i < 4; ++i) {
+    int32_t *c_row = c + i * ldc;
+    for (int j = 0; j < 8; ++j) {
+      c_row[j] = accumulate ? c_row[j] + acc[i][j] : acc[i][j];
+    }
+  }
+}
+
+// 已注册的最优微核，每次注册时更新，不在第一次查询时固定：
+// 其他编译单元的注册先于或晚于第一次查询都能生效
+static QgemmMicroKernel &getBestQgemmMicroKernel() {
+  static QgemmMicroKernel best("scalar_4x8", 4, 8, qgemmMicroKernel4x8, 0);
+  return best;
+}
+
+void registerQgemmMicroKernel(const QgemmMicroKernel &kernel) {
+  QgemmMicroKernel &best = getBestQgemmMicroKernel();
+  if (kernel.priority_ > best.priority_) {
+    best = kernel;
+  }
+}
+
+const QgemmMicroKernel &getQgemmMicroKernel() {
+  return getBestQgemmMicroKernel();
+}
+
+void packQgemmA(const int8_t *a, int lda, int m, int k, int mr, int8_t *dst) {
+  const int k_padded = qgemmPaddedK(k);
+  for (int i0 = 0; i0 < m; i0 += mr) {
+    const int rows = std::min(mr, m - i0);
+    int8_t *panel = dst + (size_t)i0 * k_padded;
+    memset(panel, 0, (size_t)mr * k_padded);
+    for (int i = 0; i < rows; ++i) {
+      const int8_t *src = a + (size_t)(i0 + i) * lda;
+      for (int kk = 0; kk < k; ++kk) {
+        panel[(kk / 4) * mr * 4 + i * 4 + (kk % 4)] = src[kk];
+      }
+    }
+  }
+}
+
+void packQgemmB(const uint8_t *b, int ldb, int k, int n, int nr, uint8_t *dst,
+                int32_t *col_sum) {
+  const int k_padded = qgemmPaddedK(k);
+  const int panels = (n + nr - 1) / nr;
+  if (col_sum != nullptr) {
+    memset(col_sum, 0, n * sizeof(int32_t));
+  }
+  // 每次读4行，把同一列的4个字节拼成一个32位字写出，不足nr的列补零
+  static const uint8_t kZeroRow[64] = {0};  // 不小于所有微核的nr
+  for (int g = 0; g < k_padded / 4; ++g) {
+    const uint8_t *rows[4];
+    for (int r = 0; r < 4; ++r) {
+      const int kk = g * 4 + r;
+      rows[r] = kk < k ? b + (size_t)kk * ldb : nullptr;
+    }
+    for (int p = 0; p < panels; ++p) {
+      const int j0 = p * nr;
+      const int cols = std::min(nr, n - j0);
+      uint8_t *d = dst + (size_t)p * nr * k_padded + (size_t)g * nr * 4;
+      const uint8_t *r0 = rows[0] + j0;
+      const uint8_t *r1 = rows[1] != nullptr ? rows[1] + j0 : kZeroRow;
+      const uint8_t *r2 = rows[2] != nullptr ? rows[2] + j0 : kZeroRow;
+      const uint8_t *r3 = rows[3] != nullptr ? rows[3] + j0 : kZeroRow;
+      for (int j = 0; j < cols; ++j) {
+        const uint32_t word = (uint32_t)r0[j] | ((uint32_t)r1[j] << 8) |
+                              ((uint32_t)r2[j] << 16) |
+                              ((uint32_t)r3[j] << 24);
+        memcpy(d + j * 4, &word, sizeof(word));
+      }
+      memset(d + cols * 4, 0, (nr - cols) * 4);
+      if (col_sum != nullptr) {
+        int32_t *sum = col_sum + j0;
+        for (int j = 0; j < cols; ++j) {
+          sum[j] += (int32_t)r0[j] + r1[j] + r2[j] + r3[j];
+        }
+      }
+    }
+  }
+}
+
+struct QgemmProblem {
+  int m_;
+  int n_;
+  int k_;
+  const int8_t *packed_a_;
+  const uint8_t *b_;
+  int ldb_;
+  int32_t *c_;
+  int ldc_;
+  int block_n_;
+};
+
+class QgemmParallelBody : public thread_pool::ParallelLoopBody {
+ public:
+  QgemmParallelBody(const QgemmMicroKernel &kernel, const QgemmProblem &problem)
+      : kernel_(kernel), problem_(problem) {}
+
+  virtual void operator()(const base::Range &range) const {
+    thread_local std::vector<uint8_t> pack_buffer;
+    const QgemmProblem &p = problem_;
+    const int mr = kernel_.mr_;
+    const int nr = kernel_.nr_;
+    const int k_padded = qgemmPaddedK(p.k_);
+    const size_t b_size = (size_t)p.block_n_ * k_padded;
+    if (pack_buffer.size() < b_size) {
+      pack_buffer.resize(b_size);
+    }
+    int32_t tile[32 * 32];
+    for (int t = range.start_; t < range.end_; ++t) {
+      const int n0 = t * p.block_n_;
+      const int nc = std::min(p.block_n_, p.n_ - n0);
+      packQgemmB(p.b_ + n0, p.ldb_, p.k_, nc, nr, pack_buffer.data(),
+                 nullptr);
+      for (int j0 = 0; j0 < nc; j0 += nr) {
+        const int cols = std::min(nr, nc - j0);
+        const uint8_t *b_panel = pack_buffer.data() + (size_t)j0 * k_padded;
+        for (int i0 = 0; i0 < p.m_; i0 += mr) {
+          const int rows = std::min(mr, p.m_ - i0);
+          const int8_t *a_panel = p.packed_a_ + (size_t)i0 * k_padded;
+          int32_t *c = p.c_ + (size_t)i0 * p.ldc_ + n0 + j0;
+          if (rows == mr && cols == nr) {
+            kernel_.func_(k_padded / 4, a_panel, b_panel, c, p.ldc_, false);
+          } else {
+            kernel_.func_(k_padded / 4, a_panel, b_panel, tile, nr, false);
+            for (int i = 0; i < rows; ++i) {
+              memcpy(c + (size_t)i * p.ldc_, tile + i * nr,
+                     cols * sizeof(int32_t));
+            }
+          }
+        }
+      }
+    }
+  }
+
+ private:
+  const QgemmMicroKernel &kernel_;
+  const QgemmProblem &problem_;
+};
+
+void qgemm(int m, int n, int k, const int8_t *packed_a, const uint8_t *b,
+           int ldb, int32_t *c, int ldc) {
+  if (m <= 0 || n <= 0) {
+    return;
+  }
+  const QgemmMicroKernel &kernel = getQgemmMicroKernel();
+  if (k <= 0) {
+    for (int i = 0; i < m; ++i) {
+      memset(c + (size_t)i * ldc, 0, n * sizeof(int32_t));
+    }
+    return;
+  }
+  const int nr = kernel.nr_;
+  const int num_threads = std::max(thread_pool::getThreadNum(), 1);
+  QgemmProblem p;
+  p.m_ = m;
+  p.n_ = n;
+  p.k_ = k;
+  p.packed_a_ = packed_a;
+  p.b_ = b;
+  p.ldb_ = ldb;
+  p.c_ = c;
+  p.ldc_ = ldc;
+  // 列块在L2容量内尽量大，块数不足以喂满所有线程时再缩小
+  p.block_n_ = kQgemmBlockBytes / qgemmPaddedK(k) / nr * nr;
+  p.block_n_ = std::max(nr, std::min(kQgemmBlockNMax / nr * nr, p.block_n_));
+  while ((n + p.block_n_ - 1) / p.block_n_ < num_threads * 2 &&
+         p.block_n_ > nr) {
+    p.block_n_ = std::max(nr, p.block_n_ / 2 / nr * nr);
+  }
+  QgemmParallelBody body(kernel, p);
+  thread_pool::parallelFor(
+      base::Range(0, (n + p.block_n_ - 1) / p.block_n_), body);
+}
+
+}  // namespace op
+}  // namespace nndeploy
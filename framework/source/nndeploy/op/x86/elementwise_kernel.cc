@@ -0,0 +1,432 @@
+#include "nndeploy/op/elementwise_kernel.h"
+#include "nndeploy/op/x86/op_include.h"
+#include "nndeploy/op/x86/op_util.h"
+
+namespace nndeploy {
+namespace op {
+
+// 从kElementwiseTailMask + 8 - n处读取8个int32，得到前n个lane的掩码
+static const int32_t kElementwiseTailMask[16] = {-1, -1, -1, -1, -1, -1,
+                                                 -1, -1, 0,  0,  0,  0,
+                                                 0,  0,  0,  0};
+
+static NNDEPLOY_X86_TARGET_AVX2 inline __m256i tailMaskAvx2(int n) {
+  return _mm256_loadu_si256(
+      reinterpret_cast<const __m256i *>(kElementwiseTailMask + 8 - n));
+}
+
+struct ElementwiseAddAvx2 {
+  static NNDEPLOY_X86_TARGET_AVX2 inline __m256 apply(__m256 a, __m256 b) {
+    return _mm256_add_ps(a, b);
+  }
+  static inline float apply(float a, float b) { return a + b; }
+};
+
+struct ElementwiseSubAvx2 {
+  static NNDEPLOY_X86_TARGET_AVX2 inline __m256 apply(__m256 a, __m256 b) {
+    return _mm256_sub_ps(a, b);
+  }
+  static inline float apply(float a, float b) { return a - b; }
+};
+
+struct ElementwiseMulAvx2 {
+  static NNDEPLOY_X86_TARGET_AVX2 inline __m256 apply(__m256 a, __m256 b) {
+    return _mm256_mul_ps(a, b);
+  }
+  static inline float apply(float a, float b) { return a * b; }
+};
+
+struct ElementwiseDivAvx2 {
+  static NNDEPLOY_X86_TARGET_AVX2 inline __m256 apply(__m256 a, __m256 b) {
+    return _mm256_div_ps(a, b);
+  }
+  static inline float apply(float a, float b) { return a / b; }
+};
+
+template <typename Op>
+static NNDEPLOY_X86_TARGET_AVX2 void elementwiseBinaryLoopAvx2(
+    const float *a, int a_step, const float *b, int b_step, float *c, int n) {
+  int i = 0;
+  if (a_step == 1 && b_step == 1) {
+    for (; i + 16 <= n; i += 16) {
+      __m256 r0 = Op::apply(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+      __m256 r1 =
+          Op::apply(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8));
+      _mm256_storeu_ps(c + i, r0);
+      _mm256_storeu_ps(c + i + 8, r1);
+    }
+    for (; i + 8 <= n; i += 8) {
+      __m256 r = Op::apply(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+      _mm256_storeu_ps(c + i, r);
+    }
+    for (; i < n; ++i) {
+      c[i] = Op::apply(a[i], b[i]);
+    }
+  } else if (a_step == 1) {
+    const float sb = b[0];
+    const __m256 vb = _mm256_set1_ps(sb);
+    for (; i + 8 <= n; i += 8) {
+      _mm256_storeu_ps(c + i, Op::apply(_mm256_loadu_ps(a + i), vb));
+    }
+    for (; i < n; ++i) {
+      c[i] = Op::apply(a[i], sb);
+    }
+  } else if (b_step == 1) {
+    const float sa = a[0];
+    const __m256 va = _mm256_set1_ps(sa);
+    for (; i + 8 <= n; i += 8) {
+      _mm256_storeu_ps(c + i, Op::apply(va, _mm256_loadu_ps(b + i)));
+    }
+    for (; i < n; ++i) {
+      c[i] = Op::apply(sa, b[i]);
+    }
+  } else {
+    std::fill(c, c + n, Op::apply(a[0], b[0]));
+  }
+}
+
+static void elementwiseBinaryAvx2(ElementwiseBinaryType type, const float *a,
+                                  int a_step, const float *b, int b_step,
+                                  float *c, int n) {
+  switch (type) {
+    case kElementwiseBinaryTypeAdd:
+      elementwiseBinaryLoopAvx2<ElementwiseAddAvx2>(a, a_step, b, b_step, c,
+                                                    n);
+      break;
+    case kElementwiseBinaryTypeSub:
+      elementwiseBinaryLoopAvx2<ElementwiseSubAvx2>(a, a_step, b, b_step, c,
+                                                    n);
+      break;
+    case kElementwiseBinaryTypeMul:
+      elementwiseBinaryLoopAvx2<ElementwiseMulAvx2>(a, a_step, b, b_step, c,
+                                                    n);
+      break;
+    default:
+      elementwiseBinaryLoopAvx2<ElementwiseDivAvx2>(a, a_step, b, b_step, c,
+                                                    n);
+      break;
+  }
+}
+
+/**
+ * @brief Cephes的exp多项式近似，相对误差约1e-7
+ */
+static NNDEPLOY_X86_TARGET_AVX2 inline __m256 expAvx2(__m256 x) {
+  x = _mm256_min_ps(x, _mm256_set1_ps(88.3762626647949f));
+  x = _mm256_max_ps(x, _mm256_set1_ps(-88.3762626647949f));
+  // x = n * ln2 + r
+  __m256 fx = _mm256_fmadd_ps(x, _mm256_set1_ps(1.44269504088896341f),
+                              _mm256_set1_ps(0.5f));
+  fx = _mm256_floor_ps(fx);
+  x = _mm256_fnmadd_ps(fx, _mm256_set1_ps(0.693359375f), x);
+  x = _mm256_fnmadd_ps(fx, _mm256_set1_ps(-2.12194440e-4f), x);
+  __m256 y = _mm256_set1_ps(1.9875691500e-4f);
+  y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(1.3981999507e-3f));
+  y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(8.3334519073e-3f));
+  y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(4.1665795894e-2f));
+  y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(1.6666665459e-1f));
+  y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(5.0000001201e-1f));
+  y = _mm256_fmadd_ps(y, _mm256_mul_ps(x, x), x);
+  y = _mm256_add_ps(y, _mm256_set1_ps(1.0f));
+  // 2^n
+  __m256i n = _mm256_add_epi32(_mm256_cvttps_epi32(fx), _mm256_set1_epi32(127));
+  n = _mm256_slli_epi32(n, 23);
+  return _mm256_mul_ps(y, _mm256_castsi256_ps(n));
+}
+
+static NNDEPLOY_X86_TARGET_AVX2 inline __m256 sigmoidAvx2(__m256 x) {
+  const __m256 one = _mm256_set1_ps(1.0f);
+  __m256 e = expAvx2(_mm256_sub_ps(_mm256_setzero_ps(), x));
+  return _mm256_div_ps(one, _mm256_add_ps(one, e));
+}
+
+/**
+ * @brief |x|较小时用泰勒展开，避免(1 - e) / (1 + e)的相消误差
+ */
+static NNDEPLOY_X86_TARGET_AVX2 inline __m256 tanhAvx2(__m256 x) {
+  const __m256 one = _mm256_set1_ps(1.0f);
+  const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+  __m256 ax = _mm256_andnot_ps(sign_mask, x);
+  __m256 e = expAvx2(_mm256_mul_ps(ax, _mm256_set1_ps(-2.0f)));
+  __m256 t = _mm256_div_ps(_mm256_sub_ps(one, e), _mm256_add_ps(one, e));
+  __m256 x2 = _mm256_mul_ps(ax, ax);
+  __m256 p = _mm256_set1_ps(-17.0f / 315.0f);
+  p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(2.0f / 15.0f));
+  p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(-1.0f / 3.0f));
+  p = _mm256_fmadd_ps(p, _mm256_mul_ps(x2, ax), ax);
+  __m256 small = _mm256_cmp_ps(ax, _mm256_set1_ps(0.125f), _CMP_LT_OQ);
+  t = _mm256_blendv_ps(t, p, small);
+  return _mm256_or_ps(t, _mm256_and_ps(x, sign_mask));
+}
+
+template <ElementwiseUnaryType type>
+static NNDEPLOY_X86_TARGET_AVX2 inline __m256 unaryAvx2(__m256 x,
+                                                        __m256 alpha,
+                                                        __m256 beta) {
+  switch (type) {
+    case kElementwiseUnaryTypeRelu:
+      return _mm256_max_ps(x, _mm256_setzero_ps());
+    case kElementwiseUnaryTypeSigmoid:
+      return sigmoidAvx2(x);
+    case kElementwiseUnaryTypeSilu:
+      return _mm256_mul_ps(x, sigmoidAvx2(x));
+    case kElementwiseUnaryTypeTanh:
+      return tanhAvx2(x);
+    case kElementwiseUnaryTypeExp:
+      return expAvx2(x);
+    case kElementwiseUnaryTypeSqrt:
+      return _mm256_sqrt_ps(x);
+    case kElementwiseUnaryTypeAbs:
+      return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x);
+    case kElementwiseUnaryTypeNeg:
+      return _mm256_xor_ps(x, _mm256_set1_ps(-0.0f));
+    case kElementwiseUnaryTypeLinear:
+      return _mm256_fmadd_ps(alpha, x, beta);
+    case kElementwiseUnaryTypeClip:
+      // 与标量实现一致，NaN返回alpha
+      return _mm256_min_ps(_mm256_max_ps(x, alpha), beta);
+    default:
+      return x;
+  }
+}
+
+template <ElementwiseUnaryType type>
+static NNDEPLOY_X86_TARGET_AVX2 void elementwiseUnaryLoopAvx2(
+    const ElementwiseUnary &unary, const float *x, float *y, int n) {
+  const __m256 alpha = _mm256_set1_ps(unary.alpha_);
+  const __m256 beta = _mm256_set1_ps(unary.beta_);
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(y + i,
+                     unaryAvx2<type>(_mm256_loadu_ps(x + i), alpha, beta));
+  }
+  // 尾部用掩码读写，结果与向量部分一致
+  if (i < n) {
+    __m256i mask = tailMaskAvx2(n - i);
+    __m256 v = unaryAvx2<type>(_mm256_maskload_ps(x + i, mask), alpha, beta);
+    _mm256_maskstore_ps(y + i, mask, v);
+  }
+}
+
+static void elementwiseUnaryAvx2(const ElementwiseUnary &unary, const float *x,
+                                 float *y, int n) {
+#define NNDEPLOY_ELEMENTWISE_UNARY_CASE(type)       \
+  case type:                                        \
+    elementwiseUnaryLoopAvx2<type>(unary, x, y, n); \
+    break;
+  switch (unary.type_) {
+    NNDEPLOY_ELEMENTWISE_UNARY_CASE(kElementwiseUnaryTypeRelu)
+    NNDEPLOY_ELEMENTWISE_UNARY_CASE(kElementwiseUnaryTypeSigmoid)
+    NNDEPLOY_ELEMENTWISE_UNARY_CASE(kElementwiseUnaryTypeSilu)
+    NNDEPLOY_ELEMENTWISE_UNARY_CASE(kElementwiseUnaryTypeTanh)
+    NNDEPLOY_ELEMENTWISE_UNARY_CASE(kElementwiseUnaryTypeExp)
+    NNDEPLOY_ELEMENTWISE_UNARY_CASE(kElementwiseUnaryTypeSqrt)
+    NNDEPLOY_ELEMENTWISE_UNARY_CASE(kElementwiseUnaryTypeAbs)
+    NNDEPLOY_ELEMENTWISE_UNARY_CASE(kElementwiseUnaryTypeNeg)
+    NNDEPLOY_ELEMENTWISE_UNARY_CASE(kElementwiseUnaryTypeLinear)
+    NNDEPLOY_ELEMENTWISE_UNARY_CASE(kElementwiseUnaryTypeClip)
+    default:
+      if (x != y) {
+        memcpy(y, x, n * sizeof(float));
+      }
+      break;
+  }
+#undef NNDEPLOY_ELEMENTWISE_UNARY_CASE
+}
+
+static NNDEPLOY_X86_TARGET_F16C void loadFp16F16c(const void *src,
+                                                  float *dst, int n) {
+  const uint16_t *s = static_cast<const uint16_t *>(src);
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+    _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+  }
+  if (i < n) {
+    uint16_t tail[8] = {0};
+    memcpy(tail, s + i, (n - i) * sizeof(uint16_t));
+    float out[8];
+    _mm256_storeu_ps(
+        out, _mm256_cvtph_ps(_mm_loadu_si128(
+                 reinterpret_cast<const __m128i *>(tail))));
+    memcpy(dst + i, out, (n - i) * sizeof(float));
+  }
+}
+
+static NNDEPLOY_X86_TARGET_F16C void storeFp16F16c(const float *src,
+                                                   void *dst, int n) {
+  uint16_t *d = static_cast<uint16_t *>(dst);
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(src + i),
+                                _MM_FROUND_TO_NEAREST_INT);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(d + i), h);
+  }
+  if (i < n) {
+    float tail[8] = {0.0f};
+    memcpy(tail, src + i, (n - i) * sizeof(float));
+    uint16_t out[8];
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i *>(out),
+        _mm256_cvtps_ph(_mm256_loadu_ps(tail), _MM_FROUND_TO_NEAREST_INT));
+    memcpy(d + i, out, (n - i) * sizeof(uint16_t));
+  }
+}
+
+static NNDEPLOY_X86_TARGET_AVX2 void loadInt8Avx2(const void *src, float *dst,
+                                                  int n) {
+  const int8_t *s = static_cast<const int8_t *>(src);
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(s + i));
+    _mm256_storeu_ps(dst + i, _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(v)));
+  }
+  for (; i < n; ++i) {
+    dst[i] = static_cast<float>(s[i]);
+  }
+}
+
+static NNDEPLOY_X86_TARGET_AVX2 void storeInt8Avx2(const float *src,
+                                                   void *dst, int n) {
+  int8_t *d = static_cast<int8_t *>(dst);
+  const __m256 lo = _mm256_set1_ps(-128.0f);
+  const __m256 hi = _mm256_set1_ps(127.0f);
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    // max的第一个操作数为NaN时返回第二个操作数，与标量实现一致
+    __m256 v = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(src + i), lo), hi);
+    __m256i v32 = _mm256_cvtps_epi32(v);
+    __m128i v16 = _mm_packs_epi32(_mm256_castsi256_si128(v32),
+                                  _mm256_extracti128_si256(v32, 1));
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(d + i),
+                     _mm_packs_epi16(v16, v16));
+  }
+  for (; i < n; ++i) {
+    float x = src[i] > -128.0f ? src[i] : -128.0f;
+    x = x < 127.0f ? x : 127.0f;
+    d[i] = static_cast<int8_t>(std::nearbyint(x));
+  }
+}
+
+// 四舍五入(ties to even)，NaN保持为NaN，与标量实现一致
+static inline uint16_t storeBfp16Scalar(float x) {
+  uint32_t u;
+  memcpy(&u, &x, sizeof(u));
+  if ((u & 0x7fffffff) > 0x7f800000) {
+    return static_cast<uint16_t>((u >> 16) | 0x40);
+  }
+  return static_cast<uint16_t>((u + 0x7fff + ((u >> 16) & 1)) >> 16);
+}
+
+static NNDEPLOY_X86_TARGET_AVX2 void loadBfp16Avx2(const void *src,
+                                                   float *dst, int n) {
+  const uint16_t *s = static_cast<const uint16_t *>(src);
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+    __m256i u = _mm256_slli_epi32(_mm256_cvtepu16_epi32(h), 16);
+    _mm256_storeu_ps(dst + i, _mm256_castsi256_ps(u));
+  }
+  for (; i < n; ++i) {
+    uint32_t u = static_cast<uint32_t>(s[i]) << 16;
+    memcpy(dst + i, &u, sizeof(u));
+  }
+}
+
+static NNDEPLOY_X86_TARGET_AVX2 void storeBfp16Avx2(const float *src,
+                                                    void *dst, int n) {
+  uint16_t *d = static_cast<uint16_t *>(dst);
+  const __m256i rounding = _mm256_set1_epi32(0x7fff);
+  const __m256i one = _mm256_set1_epi32(1);
+  const __m256i abs_mask = _mm256_set1_epi32(0x7fffffff);
+  const __m256i inf = _mm256_set1_epi32(0x7f800000);
+  const __m256i quiet = _mm256_set1_epi32(0x00400000);
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i u = _mm256_castps_si256(_mm256_loadu_ps(src + i));
+    __m256i odd = _mm256_and_si256(_mm256_srli_epi32(u, 16), one);
+    __m256i r = _mm256_add_epi32(u, _mm256_add_epi32(rounding, odd));
+    // 去掉符号位后按有符号比较，大于inf的为NaN
+    __m256i nan = _mm256_cmpgt_epi32(_mm256_and_si256(u, abs_mask), inf);
+    r = _mm256_blendv_epi8(r, _mm256_or_si256(u, quiet), nan);
+    r = _mm256_srli_epi32(r, 16);
+    __m128i h = _mm_packus_epi32(_mm256_castsi256_si128(r),
+                                 _mm256_extracti128_si256(r, 1));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(d + i), h);
+  }
+  for (; i < n; ++i) {
+    d[i] = storeBfp16Scalar(src[i]);
+  }
+}
+
+static NNDEPLOY_X86_TARGET_AVX512 void loadBfp16Avx512(const void *src,
+                                                       float *dst, int n) {
+  const uint16_t *s = static_cast<const uint16_t *>(src);
+  int i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+    __m512i u = _mm512_slli_epi32(_mm512_cvtepu16_epi32(h), 16);
+    _mm512_storeu_ps(dst + i, _mm512_castsi512_ps(u));
+  }
+  for (; i < n; ++i) {
+    uint32_t u = static_cast<uint32_t>(s[i]) << 16;
+    memcpy(dst + i, &u, sizeof(u));
+  }
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+/**
+ * @brief vcvtneps2bf16，一条指令完成16个元素的四舍五入
+ * @note 输入的非规格化数按0处理(bf16的精度下可以忽略)，其余与标量实现一致
+ */
+static NNDEPLOY_X86_TARGET_AVX512_BF16 void storeBfp16Avx512Bf16(
+    const float *src, void *dst, int n) {
+  uint16_t *d = static_cast<uint16_t *>(dst);
+  int i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m256bh h = _mm512_cvtneps_pbh(_mm512_loadu_ps(src + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(d + i), (__m256i)h);
+  }
+  for (; i < n; ++i) {
+    d[i] = storeBfp16Scalar(src[i]);
+  }
+}
+#endif
+
+static bool registerX86ElementwiseKernels() {
+  X86IsaType isa = getX86IsaType();
+  if (isa >= kX86IsaTypeAvx2) {
+    ElementwiseKernel kernel("avx2", 10);
+    kernel.binary_ = elementwiseBinaryAvx2;
+    kernel.unary_ = elementwiseUnaryAvx2;
+    kernel.load_bfp16_ = loadBfp16Avx2;
+    kernel.store_bfp16_ = storeBfp16Avx2;
+    kernel.load_int8_ = loadInt8Avx2;
+    kernel.store_int8_ = storeInt8Avx2;
+#if defined(__GNUC__) || defined(__clang__)
+    bool f16c = __builtin_cpu_supports("f16c");
+#else
+    bool f16c = true;  // 支持avx2的x86 cpu均支持f16c
+#endif
+    if (f16c) {
+      kernel.load_fp16_ = loadFp16F16c;
+      kernel.store_fp16_ = storeFp16F16c;
+    }
+    registerElementwiseKernel(kernel);
+  }
+#if defined(__GNUC__) || defined(__clang__)
+  if (isa >= kX86IsaTypeAvx512 && __builtin_cpu_supports("avx512bf16")) {
+    ElementwiseKernel kernel("avx512_bf16", 20);
+    kernel.load_bfp16_ = loadBfp16Avx512;
+    kernel.store_bfp16_ = storeBfp16Avx512Bf16;
+    registerElementwiseKernel(kernel);
+  }
+#endif
+  return true;
+}
+
+static bool g_x86_elementwise_kernel_register =
+    registerX86ElementwiseKernels();
+
+}  // namespace op
+}  // namespace nndeploy
@@ -0,0 +1,129 @@
+
+#include "nndeploy/op/gemm_kernel.h"
+#include "nndeploy/op/x86/op_include.h"
+#include "nndeploy/op/x86/op_util.h"
+
+namespace nndeploy {
+namespace op {
+
+static NNDEPLOY_X86_TARGET_AVX2 void sgemmMicroKernel6x16Avx2(
+    int kc, const float *a, const float *b, float *c, int ldc,
+    bool accumulate) {
+  __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+  __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+  __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+  __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+  __m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+  __m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+  for (int k = 0; k < kc; ++k) {
+    __m256 b0 = _mm256_loadu_ps(b);
+    __m256 b1 = _mm256_loadu_ps(b + 8);
+    __m256 av = _mm256_broadcast_ss(a);
+    c00 = _mm256_fmadd_ps(av, b0, c00);
+    c01 = _mm256_fmadd_ps(av, b1, c01);
+    av = _mm256_broadcast_ss(a + 1);
+    c10 = _mm256_fmadd_ps(av, b0, c10);
+    c11 = _mm256_fmadd_ps(av, b1, c11);
+    av = _mm256_broadcast_ss(a + 2);
+    c20 = _mm256_fmadd_ps(av, b0, c20);
+    c21 = _mm256_fmadd_ps(av, b1, c21);
+    av = _mm256_broadcast_ss(a + 3);
+    c30 = _mm256_fmadd_ps(av, b0, c30);
+    c31 = _mm256_fmadd_ps(av, b1, c31);
+    av = _mm256_broadcast_ss(a + 4);
+    c40 = _mm256_fmadd_ps(av, b0, c40);
+    c41 = _mm256_fmadd_ps(av, b1, c41);
+    av = _mm256_broadcast_ss(a + 5);
+    c50 = _mm256_fmadd_ps(av, b0, c50);
+    c51 = _mm256_fmadd_ps(av, b1, c51);
+    a += 6;
+    b += 16;
+  }
+#define NNDEPLOY_X86_STORE_ROW_AVX2(row, r0, r1)                     \
+  do {                                                               \
+    float *c_row = c + (row) * ldc;                                  \
+    if (accumulate) {                                                \
+      r0 = _mm256_add_ps(r0, _mm256_loadu_ps(c_row));                \
+      r1 = _mm256_add_ps(r1, _mm256_loadu_ps(c_row + 8));            \
+    }                                                                \
+    _mm256_storeu_ps(c_row, r0);                                     \
+    _mm256_storeu_ps(c_row + 8, r1);                                 \
+  } while (0)
+  NNDEPLOY_X86_STORE_ROW_AVX2(0, c00, c01);
+  NNDEPLOY_X86_STORE_ROW_AVX2(1, c10, c11);
+  NNDEPLOY_X86_STORE_ROW_AVX2(2, c20, c21);
+  NNDEPLOY_X86_STORE_ROW_AVX2(3, c30, c31);
+  NNDEPLOY_X86_STORE_ROW_AVX2(4, c40, c41);
+  NNDEPLOY_X86_STORE_ROW_AVX2(5, c50, c51);
+#undef NNDEPLOY_X86_STORE_ROW_AVX2
+}
+
+static NNDEPLOY_X86_TARGET_AVX512 void sgemmMicroKernel6x32Avx512(
+    int kc, const float *a, const float *b, float *c, int ldc,
+    bool accumulate) {
+  __m512 c00 = _mm512_setzero_ps(), c01 = _mm512_setzero_ps();
+  __m512 c10 = _mm512_setzero_ps(), c11 = _mm512_setzero_ps();
+  __m512 c20 = _mm512_setzero_ps(), c21 = _mm512_setzero_ps();
+  __m512 c30 = _mm512_setzero_ps(), c31 = _mm512_setzero_ps();
+  __m512 c40 = _mm512_setzero_ps(), c41 = _mm512_setzero_ps();
+  __m512 c50 = _mm512_setzero_ps(), c51 = _mm512_setzero_ps();
+  for (int k = 0; k < kc; ++k) {
+    __m512 b0 = _mm512_loadu_ps(b);
+    __m512 b1 = _mm512_loadu_ps(b + 16);
+    __m512 av = _mm512_set1_ps(a[0]);
+    c00 = _mm512_fmadd_ps(av, b0, c00);
+    c01 = _mm512_fmadd_ps(av, b1, c01);
+    av = _mm512_set1_ps(a[1]);
+    c10 = _mm512_fmadd_ps(av, b0, c10);
+    c11 = _mm512_fmadd_ps(av, b1, c11);
+    av = _mm512_set1_ps(a[2]);
+    c20 = _mm512_fmadd_ps(av, b0, c20);
+    c21 = _mm512_fmadd_ps(av, b1, c21);
+    av = _mm512_set1_ps(a[3]);
+    c30 = _mm512_fmadd_ps(av, b0, c30);
+    c31 = _mm512_fmadd_ps(av, b1, c31);
+    av = _mm512_set1_ps(a[4]);
+    c40 = _mm512_fmadd_ps(av, b0, c40);
+    c41 = _mm512_fmadd_ps(av, b1, c41);
+    av = _mm512_set1_ps(a[5]);
+    c50 = _mm512_fmadd_ps(av, b0, c50);
+    c51 = _mm512_fmadd_ps(av, b1, c51);
+    a += 6;
+    b += 32;
+  }
+#define NNDEPLOY_X86_STORE_ROW_AVX512(row, r0, r1)                   \
+  do {                                                               \
+    float *c_row = c + (row) * ldc;                                  \
+    if (accumulate) {                                                \
+      r0 = _mm512_add_ps(r0, _mm512_loadu_ps(c_row));                \
+      r1 = _mm512_add_ps(r1, _mm512_loadu_ps(c_row + 16));           \
+    }                                                                \
+    _mm512_storeu_ps(c_row, r0);                                     \
+    _mm512_storeu_ps(c_row + 16, r1);                                \
+  } while (0)
+  NNDEPLOY_X86_STORE_ROW_AVX512(0, c00, c01);
+  NNDEPLOY_X86_STORE_ROW_AVX512(1, c10, c11);
+  NNDEPLOY_X86_STORE_ROW_AVX512(2, c20, c21);
+  NNDEPLOY_X86_STORE_ROW_AVX512(3, c30, c31);
+  NNDEPLOY_X86_STORE_ROW_AVX512(4, c40, c41);
+  NNDEPLOY_X86_STORE_ROW_AVX512(5, c50, c51);
+#undef NNDEPLOY_X86_STORE_ROW_AVX512
+}
+
+static bool registerX86SgemmMicroKernels() {
+  X86IsaType isa = getX86IsaType();
+  if (isa >= kX86IsaTypeAvx2) {
+    registerSgemmMicroKernel(SgemmMicroKernel(
+        "avx2_6x16", 6, 16, sgemmMicroKernel6x16Avx2, 10));
+  }
+  if (isa >= kX86IsaTypeAvx512) {
+    registerSgemmMicroKernel(SgemmMicroKernel(
+        "avx512_6x32", 6, 32, sgemmMicroKernel6x32Avx512, 20));
+  }
+  return true;
+}
+
+static bool g_x86_sgemm_micro_kernel_register = registerX86SgemmMicroKernels();
+
+}  // namespace op
+}  // namespace nndeploy
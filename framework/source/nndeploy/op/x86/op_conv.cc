@@ -0,0 +1,671 @@
+#include "nndeploy/op/op_conv.h"
+
+#include "nndeploy/base/common.h"
+#include "nndeploy/base/glic_stl_include.h"
+#include "nndeploy/base/log.h"
+#include "nndeploy/base/macro.h"
+#include "nndeploy/base/status.h"
+#include "nndeploy/device/device.h"
+#include "nndeploy/device/tensor.h"
+#include "nndeploy/ir/ir.h"
+#include "nndeploy/op/elementwise_kernel.h"
+#include "nndeploy/op/gemm_kernel.h"
+#include "nndeploy/op/op.h"
+#include "nndeploy/op/x86/op_include.h"
+#include "nndeploy/op/x86/op_util.h"
+#include "nndeploy/thread_pool/parallel.h"
+
+namespace nndeploy {
+namespace op {
+
+/**
+ * @brief 单个group内的卷积几何信息
+ */
+struct X86ConvGeometry {
+  int channel_in_ = 0;  // 每个group的输入通道数
+  int height_in_ = 0;
+  int width_in_ = 0;
+  int height_out_ = 0;
+  int width_out_ = 0;
+  int kernel_h_ = 0;
+  int kernel_w_ = 0;
+  int stride_h_ = 1;
+  int stride_w_ = 1;
+  int pad_h_ = 0;
+  int pad_w_ = 0;
+  int dilation_h_ = 1;
+  int dilation_w_ = 1;
+};
+
+// 卷积的gemm分块大小：B的[kc x nc]块常驻L2，A的[mr x kc]微面板常驻L1
+static const int kX86ConvBlockK = 256;
+static const int kX86ConvBlockN = 384;
+
+/**
+ * @brief 权重打包：[m x k] 行主序 -> 按 mr 行一组的微面板，不足 mr 的补零
+ */
+static void packConvWeight(const float *weight, int m, int k, int mr,
+                           float *dst) {
+  for (int m0 = 0; m0 < m; m0 += mr) {
+    int rows = std::min(mr, m - m0);
+    for (int kk = 0; kk < k; ++kk) {
+      for (int i = 0; i < rows; ++i) {
+        dst[i] = weight[(size_t)(m0 + i) * k + kk];
+      }
+      for (int i = rows; i < mr; ++i) {
+        dst[i] = 0.0f;
+      }
+      dst += mr;
+    }
+  }
+}
+
+/**
+ * @brief 输入打包：隐式im2col，直接把输入[k0, k0 + kc) x [n0, n0 + nc)
+ * 的区域写成 nr 列一组的微面板，不再需要完整的im2col缓冲区
+ * @note 1x1/stride1/pad0 的卷积输入本身就是 [k x n] 矩阵，直接按行拷贝
+ */
+static void packConvInput(const X86ConvGeometry &g, const float *input,
+                          bool is_pointwise, int k0, int kc, int n0, int nc,
+                          int nr, float *dst) {
+  const int kernel_size = g.kernel_h_ * g.kernel_w_;
+  const int plane_in = g.height_in_ * g.width_in_;
+  const int panels = (nc + nr - 1) / nr;
+  for (int kk = 0; kk < kc; ++kk) {
+    const int k = k0 + kk;
+    const int c = k / kernel_size;
+    const int kh = (k % kernel_size) / g.kernel_w_;
+    const int kw = (k % kernel_size) % g.kernel_w_;
+    const float *channel = input + (size_t)c * plane_in;
+    const int offset_h = kh * g.dilation_h_ - g.pad_h_;
+    const int offset_w = kw * g.dilation_w_ - g.pad_w_;
+    int oh = n0 / g.width_out_;
+    int ow = n0 % g.width_out_;
+    for (int p = 0; p < panels; ++p) {
+      float *d = dst + (size_t)p * kc * nr + (size_t)kk * nr;
+      const int cols = std::min(nr, nc - p * nr);
+      if (is_pointwise) {
+        memcpy(d, channel + n0 + p * nr, cols * sizeof(float));
+      } else {
+        int j = 0;
+        while (j < cols) {
+          // 同一输出行内的一段连续列
+          const int run = std::min(cols - j, g.width_out_ - ow);
+          const int ih = oh * g.stride_h_ + offset_h;
+          if (ih < 0 || ih >= g.height_in_) {
+            memset(d + j, 0, run * sizeof(float));
+          } else {
+            const float *row = channel + (size_t)ih * g.width_in_;
+            const int iw = ow * g.stride_w_ + offset_w;
+            if (g.stride_w_ == 1 && iw >= 0 && iw + run <= g.width_in_) {
+              memcpy(d + j, row + iw, run * sizeof(float));
+            } else {
+              for (int t = 0; t < run; ++t) {
+                const int x = iw + t * g.stride_w_;
+                d[j + t] = (x >= 0 && x < g.width_in_) ? row[x] : 0.0f;
+              }
+            }
+          }
+          j += run;
+          ow += run;
+          if (ow == g.width_out_) {
+            ow = 0;
+            ++oh;
+          }
+        }
+      }
+      for (int j = cols; j < nr; ++j) {
+        d[j] = 0.0f;
+      }
+    }
+  }
+}
+
+static inline float convActivate(float value, ir::OpType activate_op) {
+  switch (activate_op) {
+    case ir::kOpTypeRelu:
+      return value > 0.0f ? value : 0.0f;
+    case ir::kOpTypeSigmoid:
+      return 1.0f / (1.0f + std::exp(-value));
+    case ir::kOpTypeTanh:
+      return std::tanh(value);
+    default:
+      return value;
+  }
+}
+
+/**
+ * @brief 融合的后处理：bias + 激活，在刚写完、仍在L1里的输出块上完成
+ */
+static void convEpilogue(float *c, int ldc, int rows, int cols,
+                         const float *bias, ir::OpType activate_op) {
+  for (int i = 0; i < rows; ++i) {
+    float *c_row = c + (size_t)i * ldc;
+    const float b = bias != nullptr ? bias[i] : 0.0f;
+    if (activate_op == ir::kOpTypeNone) {
+      if (bias != nullptr) {
+        for (int j = 0; j < cols; ++j) {
+          c_row[j] += b;
+        }
+      }
+    } else if (activate_op == ir::kOpTypeRelu) {
+      // std::max 编译为无分支的 maxss，避免随机数据上的分支预测失败
+      for (int j = 0; j < cols; ++j) {
+        c_row[j] = std::max(c_row[j] + b, 0.0f);
+      }
+    } else {
+      for (int j = 0; j < cols; ++j) {
+        c_row[j] = convActivate(c_row[j] + b, activate_op);
+      }
+    }
+  }
+}
+
+/**
+ * @brief 深度可分离卷积补边后，覆盖全部输出所需的输入长度
+ */
+static inline int depthwisePaddedSize(int out, int kernel, int stride,
+                                      int dilation) {
+  return (out - 1) * stride + (kernel - 1) * dilation + 1;
+}
+
+/**
+ * @brief 深度可分离卷积的一行输出，输入已经补过边，所有tap都不越界
+ * @note 按tap逐行累加，相邻输出之间没有依赖，避免单个输出上的累加长依赖链
+ */
+static void depthwiseRow(const float *input, int width_in,
+                         const float *weight, const X86ConvGeometry &g, int oh,
+                         float bias, float *out_row) {
+  for (int ow = 0; ow < g.width_out_; ++ow) {
+    out_row[ow] = bias;
+  }
+  for (int kh = 0; kh < g.kernel_h_; ++kh) {
+    const float *row =
+        input + (size_t)(oh * g.stride_h_ + kh * g.dilation_h_) * width_in;
+    for (int kw = 0; kw < g.kernel_w_; ++kw) {
+      const float w = weight[kh * g.kernel_w_ + kw];
+      const float *src = row + kw * g.dilation_w_;
+      for (int ow = 0; ow < g.width_out_; ++ow) {
+        out_row[ow] += w * src[ow * g.stride_w_];
+      }
+    }
+  }
+}
+
+static NNDEPLOY_X86_TARGET_AVX2 void depthwiseRowAvx2(
+    const float *input, int width_in, const float *weight,
+    const X86ConvGeometry &g, int oh, float bias, float *out_row) {
+  const int kernel_size = g.kernel_h_ * g.kernel_w_;
+  const float *rows[64];
+  __m256 wv[64];
+  for (int kh = 0; kh < g.kernel_h_; ++kh) {
+    const float *row =
+        input + (size_t)(oh * g.stride_h_ + kh * g.dilation_h_) * width_in;
+    for (int kw = 0; kw < g.kernel_w_; ++kw) {
+      rows[kh * g.kernel_w_ + kw] = row + kw * g.dilation_w_;
+      wv[kh * g.kernel_w_ + kw] = _mm256_set1_ps(weight[kh * g.kernel_w_ + kw]);
+    }
+  }
+  const __m256 bv = _mm256_set1_ps(bias);
+  // 一次处理4个向量，4条独立的累加链
+  int ow = 0;
+  for (; ow + 32 <= g.width_out_; ow += 32) {
+    __m256 acc0 = bv, acc1 = bv, acc2 = bv, acc3 = bv;
+    for (int t = 0; t < kernel_size; ++t) {
+      const float *src = rows[t] + ow;
+      acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(src), wv[t], acc0);
+      acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(src + 8), wv[t], acc1);
+      acc2 = _mm256_fmadd_ps(_mm256_loadu_ps(src + 16), wv[t], acc2);
+      acc3 = _mm256_fmadd_ps(_mm256_loadu_ps(src + 24), wv[t], acc3);
+    }
+    _mm256_storeu_ps(out_row + ow, acc0);
+    _mm256_storeu_ps(out_row + ow + 8, acc1);
+    _mm256_storeu_ps(out_row + ow + 16, acc2);
+    _mm256_storeu_ps(out_row + ow + 24, acc3);
+  }
+  for (; ow < g.width_out_; ow += 8) {
+    const int remain = std::min(8, g.width_out_ - ow);
+    __m256i mask =
+        _mm256_cmpgt_epi32(_mm256_set1_epi32(remain),
+                           _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    __m256 acc = bv;
+    for (int t = 0; t < kernel_size; ++t) {
+      acc = _mm256_fmadd_ps(_mm256_maskload_ps(rows[t] + ow, mask), wv[t], acc);
+    }
+    _mm256_maskstore_ps(out_row + ow, mask, acc);
+  }
+}
+
+/**
+ * @brief 深度可分离卷积（group == channel_in == channel_out）单通道直接计算
+ * 这种卷积每个group的gemm只有一行，走im2col+gemm没有收益
+ * @note 先拷贝到补零后的缓冲区，行内计算不再需要边界判断
+ */
+static void depthwiseConvChannel(const float *input, const float *weight,
+                                 float bias, const X86ConvGeometry &g,
+                                 ir::OpType activate_op, bool use_avx2,
+                                 float *output) {
+  thread_local std::vector<float> padded;
+  const int kernel_size = g.kernel_h_ * g.kernel_w_;
+  const int height_pad = depthwisePaddedSize(g.height_out_, g.kernel_h_,
+                                             g.stride_h_, g.dilation_h_);
+  const int width_pad = depthwisePaddedSize(g.width_out_, g.kernel_w_,
+                                            g.stride_w_, g.dilation_w_);
+  const size_t padded_size = (size_t)height_pad * width_pad;
+  if (padded.size() < padded_size) {
+    padded.resize(padded_size);
+  }
+  memset(padded.data(), 0, padded_size * sizeof(float));
+  for (int h = 0; h < g.height_in_; ++h) {
+    const int ph = h + g.pad_h_;
+    if (ph >= height_pad) {
+      break;
+    }
+    const int cols = std::min(g.width_in_, width_pad - g.pad_w_);
+    if (cols > 0) {
+      memcpy(padded.data() + (size_t)ph * width_pad + g.pad_w_,
+             input + (size_t)h * g.width_in_, cols * sizeof(float));
+    }
+  }
+  // avx2路径要求stride为1，且tap数不超过depthwiseRowAvx2中的固定数组
+  const bool vectorize = use_avx2 && g.stride_w_ == 1 && kernel_size <= 64;
+  for (int oh = 0; oh < g.height_out_; ++oh) {
+    float *out_row = output + (size_t)oh * g.width_out_;
+    if (vectorize) {
+      depthwiseRowAvx2(padded.data(), width_pad, weight, g, oh, bias, out_row);
+    } else {
+      depthwiseRow(padded.data(), width_pad, weight, g, oh, bias, out_row);
+    }
+    if (activate_op != ir::kOpTypeNone) {
+      convEpilogue(out_row, g.width_out_, 1, g.width_out_, nullptr,
+                   activate_op);
+    }
+  }
+}
+
+/**
+ * @brief 卷积一次执行所需的全部信息，供多线程任务共享
+ */
+struct X86ConvProblem {
+  X86ConvGeometry g_;
+  const float *input_ = nullptr;
+  const float *weight_ = nullptr;  // 深度可分离卷积为原始权重，否则为打包后的
+  const float *bias_ = nullptr;
+  float *output_ = nullptr;
+  ir::OpType activate_op_ = ir::kOpTypeNone;
+  int group_ = 1;
+  int m_ = 0;  // 每个group的输出通道数
+  int k_ = 0;  // 每个group的累加长度
+  int m_padded_ = 0;
+  bool is_pointwise_ = false;
+  int tiles_n_ = 0;
+  SgemmMicroKernel kernel_;
+  bool use_avx2_ = false;
+};
+
+class X86DepthwiseConvParallelBody : public thread_pool::ParallelLoopBody {
+ public:
+  explicit X86DepthwiseConvParallelBody(const X86ConvProblem &problem)
+      : problem_(problem) {}
+
+  virtual void operator()(const base::Range &range) const {
+    const X86ConvProblem &p = problem_;
+    const X86ConvGeometry &g = p.g_;
+    const int kernel_size = g.kernel_h_ * g.kernel_w_;
+    const size_t plane_in = (size_t)g.height_in_ * g.width_in_;
+    const size_t plane_out = (size_t)g.height_out_ * g.width_out_;
+    // 任务按 batch * channel 展开
+    for (int t = range.start_; t < range.end_; ++t) {
+      const int c = t % p.group_;
+      depthwiseConvChannel(p.input_ + t * plane_in,
+                           p.weight_ + (size_t)c * kernel_size,
+                           p.bias_ ? p.bias_[c] : 0.0f, g, p.activate_op_,
+                           p.use_avx2_, p.output_ + t * plane_out);
+    }
+  }
+
+ private:
+  const X86ConvProblem &problem_;
+};
+
+/**
+ * @brief 单个batch、单个group、[n0, n0 + nc)列的卷积：
+ * output[m x n] = weight[m x k] * im2col(input)[k x n]，n = oh * ow
+ */
+static void gemmConvTile(const X86ConvProblem &p, const float *input,
+                         const float *packed_weight, const float *bias,
+                         float *output, int n0) {
+  thread_local std::vector<float> pack_buffer;
+  const X86ConvGeometry &g = p.g_;
+  const int mr = p.kernel_.mr_;
+  const int nr = p.kernel_.nr_;
+  const int n = g.height_out_ * g.width_out_;
+  const int nc = std::min(kX86ConvBlockN, n - n0);
+  const int panels = (nc + nr - 1) / nr;
+  const size_t buffer_size =
+      (size_t)kX86ConvBlockK * panels * nr + (size_t)mr * nr;
+  if (pack_buffer.size() < buffer_size) {
+    pack_buffer.resize(buffer_size);
+  }
+  float *pack_b = pack_buffer.data();
+  float *tile = pack_b + (size_t)kX86ConvBlockK * panels * nr;
+  for (int k0 = 0; k0 < p.k_; k0 += kX86ConvBlockK) {
+    const int kc = std::min(kX86ConvBlockK, p.k_ - k0);
+    const bool accumulate = k0 > 0;
+    const bool is_last = k0 + kc >= p.k_;
+    packConvInput(g, input, p.is_pointwise_, k0, kc, n0, nc, nr, pack_b);
+    for (int m0 = 0; m0 < p.m_; m0 += mr) {
+      const int rows = std::min(mr, p.m_ - m0);
+      const float *a = packed_weight + (size_t)m0 * p.k_ + (size_t)k0 * mr;
+      for (int j = 0; j < panels; ++j) {
+        const int cols = std::min(nr, nc - j * nr);
+        const float *b = pack_b + (size_t)j * kc * nr;
+        float *c = output + (size_t)m0 * n + n0 + j * nr;
+        if (rows == mr && cols == nr) {
+          p.kernel_.func_(kc, a, b, c, n, accumulate);
+        } else {
+          p.kernel_.func_(kc, a, b, tile, nr, false);
+          for (int i = 0; i < rows; ++i) {
+            float *c_row = c + (size_t)i * n;
+            const float *t_row = tile + i * nr;
+            for (int jj = 0; jj < cols; ++jj) {
+              c_row[jj] = accumulate ? c_row[jj] + t_row[jj] : t_row[jj];
+            }
+          }
+        }
+        if (is_last) {
+          convEpilogue(c, n, rows, cols, bias ? bias + m0 : nullptr,
+                       p.activate_op_);
+        }
+      }
+    }
+  }
+}
+
+class X86GemmConvParallelBody : public thread_pool::ParallelLoopBody {
+ public:
+  explicit X86GemmConvParallelBody(const X86ConvProblem &problem)
+      : problem_(problem) {}
+
+  virtual void operator()(const base::Range &range) const {
+    const X86ConvProblem &p = problem_;
+    const X86ConvGeometry &g = p.g_;
+    const size_t group_input_size =
+        (size_t)g.channel_in_ * g.height_in_ * g.width_in_;
+    const size_t group_output_size =
+        (size_t)p.m_ * g.height_out_ * g.width_out_;
+    // 任务按 batch * group * 列块 展开
+    for (int t = range.start_; t < range.end_; ++t) {
+      const int batch_group = t / p.tiles_n_;
+      const int gi = batch_group % p.group_;
+      const int n0 = (t % p.tiles_n_) * kX86ConvBlockN;
+      gemmConvTile(p, p.input_ + batch_group * group_input_size,
+                   p.weight_ + (size_t)gi * p.m_padded_ * p.k_,
+                   p.bias_ ? p.bias_ + gi * p.m_ : nullptr,
+                   p.output_ + batch_group * group_output_size, n0);
+    }
+  }
+
+ private:
+  const X86ConvProblem &problem_;
+};
+
+/**
+ * @brief x86 卷积实现
+ * @note
+ * # 普通卷积：隐式im2col + 打包gemm，权重在preRun中按微核的mr打包一次
+ * # 1x1/stride1/pad0：输入直接作为gemm的B矩阵，跳过im2col
+ * # 深度可分离卷积：直接卷积，avx2向量化
+ * # 微核来自gemm_kernel中按cpu特性注册的最优实现
+ * # bias与activate_op_在写回输出块时融合完成
+ * # 按batch/group/输出列块通过thread_pool::parallelFor多线程执行
+ * # 权重可以是fp32/fp16/bf16，原始权重保持原有精度，打包时转为fp32；
+ *   fp16/bf16的输入输出与bias经fp32缓冲区转换
+ * # 非4维或其他数据类型退回到参考实现OpConv::run
+ */
+class X86OpConv : public OpConv {
+ public:
+  X86OpConv() : OpConv() {}
+  virtual ~X86OpConv() {}
+
+  virtual base::Status preRun() {
+    base::Status status = OpConv::preRun();
+    NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "preRun failed");
+    if (!isSupported()) {
+      return base::kStatusCodeOk;
+    }
+    kernel_ = getSgemmMicroKernel();
+    use_avx2_ = getX86IsaType() >= kX86IsaTypeAvx2;
+
+    // 权重按group打包，权重不变(getConstWeightFlag)时只打包一次
+    device::Tensor *weight_tensor = inputs_[1];
+    const void *weight_data = weight_tensor->getData();
+    base::IntVector weight_shape = weight_tensor->getShape();
+    if (getConstWeightFlag() && weight_data == packed_weight_src_ &&
+        weight_shape == packed_shape_) {
+      return base::kStatusCodeOk;
+    }
+    // 非fp32的权重先转为fp32，只在打包时存在
+    std::vector<float> weight_fp32;
+    const float *weight = static_cast<const float *>(weight_data);
+    if (weight_tensor->getDataType() != base::dataTypeOf<float>()) {
+      weight_fp32.resize((size_t)weight_shape[0] * weight_shape[1] *
+                         weight_shape[2] * weight_shape[3]);
+      ElementwiseLoadFunc load =
+          getElementwiseLoadFunc(weight_tensor->getDataType());
+      load(weight_data, weight_fp32.data(), (int)weight_fp32.size());
+      weight = weight_fp32.data();
+    }
+    if (isDepthwise()) {
+      // 深度可分离卷积直接使用原始权重，非fp32时保存转换后的权重
+      packed_weight_.swap(weight_fp32);
+    } else {
+      auto param = dynamic_cast<ir::ConvParam *>(op_desc_.op_param_.get());
+      const int group = std::max(param->group_, 1);
+      const int mr = kernel_.mr_;
+      const int m = weight_shape[0] / group;
+      const int k = weight_shape[1] * weight_shape[2] * weight_shape[3];
+      const int m_padded = (m + mr - 1) / mr * mr;
+      packed_weight_.resize((size_t)group * m_padded * k);
+      for (int gi = 0; gi < group; ++gi) {
+        packConvWeight(weight + (size_t)gi * m * k, m, k, mr,
+                       packed_weight_.data() + (size_t)gi * m_padded * k);
+      }
+    }
+    packed_weight_src_ = weight_data;
+    packed_shape_ = weight_shape;
+    return base::kStatusCodeOk;
+  }
+
+  virtual base::Status run() {
+    if (!isSupported() || kernel_.func_ == nullptr) {
+      return OpConv::run();
+    }
+    device::Tensor *input_tensor = inputs_[0];
+    device::Tensor *weight_tensor = inputs_[1];
+    device::Tensor *bias_tensor = inputs_.size() > 2 ? inputs_[2] : nullptr;
+    device::Tensor *output_tensor = outputs_[0];
+    if (weight_tensor->getData() != packed_weight_src_) {
+      base::Status status = this->preRun();
+      NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "preRun failed");
+    }
+
+    auto param = dynamic_cast<ir::ConvParam *>(op_desc_.op_param_.get());
+    base::IntVector input_shape = input_tensor->getShape();
+    base::IntVector weight_shape = weight_tensor->getShape();
+    base::IntVector output_shape = output_tensor->getShape();
+    const int batch = input_shape[0];
+    const int group = std::max(param->group_, 1);
+
+    X86ConvProblem p;
+    X86ConvGeometry &g = p.g_;
+    g.channel_in_ = input_shape[1] / group;
+    g.height_in_ = input_shape[2];
+    g.width_in_ = input_shape[3];
+    g.height_out_ = output_shape[2];
+    g.width_out_ = output_shape[3];
+    g.kernel_h_ = weight_shape[2];
+    g.kernel_w_ = weight_shape[3];
+    if (param->strides_.size() >= 2) {
+      g.stride_h_ = param->strides_[0];
+      g.stride_w_ = param->strides_[1];
+    }
+    if (param->pads_.size() >= 2) {
+      g.pad_h_ = param->pads_[0];
+      g.pad_w_ = param->pads_[1];
+    }
+    if (param->dilations_.size() >= 2) {
+      g.dilation_h_ = param->dilations_[0];
+      g.dilation_w_ = param->dilations_[1];
+    }
+    // 非fp32的输入、bias与输出经fp32缓冲区转换
+    const base::DataType fp32 = base::dataTypeOf<float>();
+    const bool convert = input_tensor->getDataType() != fp32;
+    base::Status status = base::kStatusCodeOk;
+    if (convert) {
+      input_buffer_.resize((size_t)batch * input_shape[1] * g.height_in_ *
+                           g.width_in_);
+      output_buffer_.resize((size_t)batch * output_shape[1] * g.height_out_ *
+                            g.width_out_);
+      status = elementwiseUnary(
+          std::vector<ElementwiseUnary>(), ElementwiseOperand(input_tensor),
+          ElementwiseOperand(input_buffer_.data(), fp32, input_shape));
+      NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                             "convert input failed");
+      p.input_ = input_buffer_.data();
+      p.output_ = output_buffer_.data();
+    } else {
+      p.input_ = static_cast<const float *>(input_tensor->getData());
+      p.output_ = static_cast<float *>(output_tensor->getData());
+    }
+    p.bias_ = nullptr;
+    if (bias_tensor != nullptr && bias_tensor->getDataType() != fp32) {
+      bias_buffer_.resize(output_shape[1]);
+      ElementwiseLoadFunc load =
+          getElementwiseLoadFunc(bias_tensor->getDataType());
+      if (load == nullptr) {
+        NNDEPLOY_LOGE("data type of bias is not supported.\n");
+        return base::kStatusCodeErrorNotSupport;
+      }
+      load(bias_tensor->getData(), bias_buffer_.data(), output_shape[1]);
+      p.bias_ = bias_buffer_.data();
+    } else if (bias_tensor != nullptr) {
+      p.bias_ = static_cast<const float *>(bias_tensor->getData());
+    }
+    p.activate_op_ = param->activate_op_;
+    p.group_ = group;
+    p.kernel_ = kernel_;
+    p.use_avx2_ = use_avx2_;
+
+    if (isDepthwise()) {
+      p.weight_ = packed_weight_.empty()
+                      ? static_cast<const float *>(weight_tensor->getData())
+                      : packed_weight_.data();
+      X86DepthwiseConvParallelBody body(p);
+      thread_pool::parallelFor(base::Range(0, batch * group), body);
+      return storeOutput(convert);
+    }
+
+    p.weight_ = packed_weight_.data();
+    p.m_ = output_shape[1] / group;
+    p.k_ = g.channel_in_ * g.kernel_h_ * g.kernel_w_;
+    p.m_padded_ = (p.m_ + kernel_.mr_ - 1) / kernel_.mr_ * kernel_.mr_;
+    p.is_pointwise_ = g.kernel_h_ == 1 && g.kernel_w_ == 1 &&
+                      g.stride_h_ == 1 && g.stride_w_ == 1 && g.pad_h_ == 0 &&
+                      g.pad_w_ == 0 && g.height_in_ == g.height_out_ &&
+                      g.width_in_ == g.width_out_;
+    const int n = g.height_out_ * g.width_out_;
+    p.tiles_n_ = (n + kX86ConvBlockN - 1) / kX86ConvBlockN;
+    X86GemmConvParallelBody body(p);
+    thread_pool::parallelFor(base::Range(0, batch * group * p.tiles_n_), body);
+    return storeOutput(convert);
+  }
+
+  virtual base::Status deinit() {
+    packed_weight_.clear();
+    packed_weight_.shrink_to_fit();
+    packed_weight_src_ = nullptr;
+    packed_shape_.clear();
+    input_buffer_.clear();
+    input_buffer_.shrink_to_fit();
+    output_buffer_.clear();
+    output_buffer_.shrink_to_fit();
+    bias_buffer_.clear();
+    return OpConv::deinit();
+  }
+
+ private:
+  base::Status storeOutput(bool convert) {
+    if (!convert) {
+      return base::kStatusCodeOk;
+    }
+    device::Tensor *output_tensor = outputs_[0];
+    return elementwiseUnary(
+        std::vector<ElementwiseUnary>(),
+        ElementwiseOperand(output_buffer_.data(), base::dataTypeOf<float>(),
+                           output_tensor->getShape()),
+        ElementwiseOperand(output_tensor));
+  }
+
+  bool isSupported() {
+    if (inputs_.size() < 2 || outputs_.empty()) {
+      return false;
+    }
+    if (inputs_[0]->getShape().size() != 4 ||
+        inputs_[1]->getShape().size() != 4) {
+      return false;
+    }
+    if (!isFloatDataType(inputs_[0]->getDataType()) ||
+        !isFloatDataType(inputs_[1]->getDataType()) ||
+        outputs_[0]->getDataType() != inputs_[0]->getDataType()) {
+      return false;
+    }
+    auto param = dynamic_cast<ir::ConvParam *>(op_desc_.op_param_.get());
+    if (param == nullptr) {
+      return false;
+    }
+    switch (param->activate_op_) {
+      case ir::kOpTypeNone:
+      case ir::kOpTypeRelu:
+      case ir::kOpTypeSigmoid:
+      case ir::kOpTypeTanh:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  bool isFloatDataType(const base::DataType &data_type) {
+    return data_type == base::dataTypeOf<float>() ||
+           data_type == base::dataTypeOf<half_float::half>() ||
+           data_type == base::dataTypeOf<base::bfp16_t>();
+  }
+
+  bool isDepthwise() {
+    auto param = dynamic_cast<ir::ConvParam *>(op_desc_.op_param_.get());
+    int channel_in = inputs_[0]->getShape()[1];
+    int channel_out = inputs_[1]->getShape()[0];
+    return param->group_ > 1 && param->group_ == channel_in &&
+           param->group_ == channel_out;
+  }
+
+ private:
+  SgemmMicroKernel kernel_;
+  bool use_avx2_ = false;
+
+  // 打包后的权重(深度可分离卷积为转为fp32的权重，fp32时为空)，
+  // 以及对应的原始权重指针/形状，用于判断是否需要重新打包
+  std::vector<float> packed_weight_;
+  const void *packed_weight_src_ = nullptr;
+  base::IntVector packed_shape_;
+
+  // 非fp32的输入输出与bias的fp32缓冲区
+  std::vector<float> input_buffer_;
+  std::vector<float> output_buffer_;
+  std::vector<float> bias_buffer_;
+};
+
+REGISTER_OP_IMPLEMENTION(kDeviceTypeCodeX86, ir::kOpTypeConv, X86OpConv)
+
+}  // namespace op
+}  // namespace nndeploy
@@ -0,0 +1,531 @@
+#include "nndeploy/op/op_qlinear_conv.h"
+
+#include "nndeploy/base/common.h"
+#include "nndeploy/base/glic_stl_include.h"
+#include "nndeploy/base/log.h"
+#include "nndeploy/base/macro.h"
+#include "nndeploy/base/status.h"
+#include "nndeploy/device/device.h"
+#include "nndeploy/device/tensor.h"
+#include "nndeploy/ir/ir.h"
+#include "nndeploy/op/op.h"
+#include "nndeploy/op/qgemm_kernel.h"
+#include "nndeploy/op/x86/op_include.h"
+#include "nndeploy/op/x86/op_util.h"
+#include "nndeploy/thread_pool/parallel.h"
+
+namespace nndeploy {
+namespace op {
+
+// 打包后B块的字节数上限：B的[k x nc]块常驻L2，权重的微面板从L2/L3流过
+static const int kX86QConvBlockBytes = 256 * 1024;
+static const int kX86QConvBlockNMax = 512;
+
+/**
+ * @brief 单个group内的量化卷积几何信息
+ */
+struct X86QConvGeometry {
+  int channel_in_ = 0;  // 每个group的输入通道数
+  int height_in_ = 0;
+  int width_in_ = 0;
+  int height_out_ = 0;
+  int width_out_ = 0;
+  int kernel_h_ = 0;
+  int kernel_w_ = 0;
+  int stride_h_ = 1;
+  int stride_w_ = 1;
+  int pad_h_ = 0;
+  int pad_w_ = 0;
+  int dilation_h_ = 1;
+  int dilation_w_ = 1;
+};
+
+/**
+ * @brief 隐式im2col：把输入[0, k) x [n0, n0 + nc)的区域写成[k x nc]的u8矩阵
+ * @note
+ * # flip为0x80时把s8的x转为u8(x + 128)，与vpdpbusd的u8操作数一致
+ * # 越界的位置填pad_value，即转换后的x_zero_point，对应的实数值为0
+ */
+static void im2colQConvInput(const X86QConvGeometry &g, const uint8_t *input,
+                             uint8_t flip, uint8_t pad_value, int n0, int nc,
+                             uint8_t *dst) {
+  const int kernel_size = g.kernel_h_ * g.kernel_w_;
+  const int plane_in = g.height_in_ * g.width_in_;
+  const int k = g.channel_in_ * kernel_size;
+  for (int kk = 0; kk < k; ++kk) {
+    const int c = kk / kernel_size;
+    const int kh = (kk % kernel_size) / g.kernel_w_;
+    const int kw = (kk % kernel_size) % g.kernel_w_;
+    const uint8_t *channel = input + (size_t)c * plane_in;
+    const int offset_h = kh * g.dilation_h_ - g.pad_h_;
+    const int offset_w = kw * g.dilation_w_ - g.pad_w_;
+    uint8_t *d = dst + (size_t)kk * nc;
+    int oh = n0 / g.width_out_;
+    int ow = n0 % g.width_out_;
+    int j = 0;
+    while (j < nc) {
+      // 同一输出行内的一段连续列
+      const int run = std::min(nc - j, g.width_out_ - ow);
+      const int ih = oh * g.stride_h_ + offset_h;
+      if (ih < 0 || ih >= g.height_in_) {
+        memset(d + j, pad_value, run);
+      } else {
+        const uint8_t *row = channel + (size_t)ih * g.width_in_;
+        const int iw = ow * g.stride_w_ + offset_w;
+        if (g.stride_w_ == 1) {
+          // 左右越界的部分填pad_value，中间一段连续拷贝
+          const int begin = std::min(run, std::max(0, -iw));
+          const int end = std::max(begin, std::min(run, g.width_in_ - iw));
+          memset(d + j, pad_value, begin);
+          for (int t = begin; t < end; ++t) {
+            d[j + t] = row[iw + t] ^ flip;
+          }
+          memset(d + j + end, pad_value, run - end);
+        } else {
+          for (int t = 0; t < run; ++t) {
+            const int x = iw + t * g.stride_w_;
+            d[j + t] = (x >= 0 && x < g.width_in_) ? row[x] ^ flip : pad_value;
+          }
+        }
+      }
+      j += run;
+      ow += run;
+      if (ow == g.width_out_) {
+        ow = 0;
+        ++oh;
+      }
+    }
+  }
+}
+
+/**
+ * @brief 一个输出通道的重量化参数
+ * @note value = acc - w_zero_point * col_sum + correction，
+ *       y = saturate(round(value * scale) + y_zero_point)
+ */
+struct X86QConvRequant {
+  int32_t w_zero_point_ = 0;  // 转为s8后的权重零点
+  int32_t correction_ = 0;    // bias与零点修正中与列无关的部分
+  float scale_ = 1.0f;        // x_scale * w_scale / y_scale
+};
+
+static void requantizeRow(const int32_t *acc, const int32_t *col_sum,
+                          const X86QConvRequant &requant, int32_t y_zero_point,
+                          bool y_signed, int cols, void *dst) {
+  const float y_min = y_signed ? -128.0f : 0.0f;
+  const float y_max = y_signed ? 127.0f : 255.0f;
+  for (int j = 0; j < cols; ++j) {
+    int32_t value = acc[j] + requant.correction_;
+    if (col_sum != nullptr) {
+      value -= requant.w_zero_point_ * col_sum[j];
+    }
+    float result =
+        std::nearbyint(static_cast<float>(value) * requant.scale_) +
+        static_cast<float>(y_zero_point);
+    result = std::max(y_min, std::min(y_max, result));
+    if (y_signed) {
+      static_cast<int8_t *>(dst)[j] = static_cast<int8_t>(result);
+    } else {
+      static_cast<uint8_t *>(dst)[j] = static_cast<uint8_t>(result);
+    }
+  }
+}
+
+/**
+ * @brief requantizeRow的avx2实现
+ * @note vcvtps2dq按默认的舍入模式(ties to even)取整，与std::nearbyint一致；
+ *       饱和后每个int32只有低字节有效，用vpshufb取出后拼成连续的8个字节
+ */
+static NNDEPLOY_X86_TARGET_AVX2 void requantizeRowAvx2(
+    const int32_t *acc, const int32_t *col_sum,
+    const X86QConvRequant &requant, int32_t y_zero_point, bool y_signed,
+    int cols, void *dst) {
+  const __m256i correction = _mm256_set1_epi32(requant.correction_);
+  const __m256i w_zero_point = _mm256_set1_epi32(requant.w_zero_point_);
+  const __m256 scale = _mm256_set1_ps(requant.scale_);
+  const __m256i zero_point = _mm256_set1_epi32(y_zero_point);
+  const __m256i y_min = _mm256_set1_epi32(y_signed ? -128 : 0);
+  const __m256i y_max = _mm256_set1_epi32(y_signed ? 127 : 255);
+  const __m256i byte_shuffle = _mm256_setr_epi8(
+      0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 4, 8,
+      12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+  const __m256i lane_permute = _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0);
+  uint8_t *out = static_cast<uint8_t *>(dst);
+  int j = 0;
+  for (; j + 8 <= cols; j += 8) {
+    __m256i value = _mm256_add_epi32(
+        _mm256_loadu_si256((const __m256i *)(acc + j)), correction);
+    if (col_sum != nullptr) {
+      value = _mm256_sub_epi32(
+          value, _mm256_mullo_epi32(
+                     w_zero_point,
+                     _mm256_loadu_si256((const __m256i *)(col_sum + j))));
+    }
+    __m256i result = _mm256_cvtps_epi32(
+        _mm256_mul_ps(_mm256_cvtepi32_ps(value), scale));
+    result = _mm256_add_epi32(result, zero_point);
+    result = _mm256_min_epi32(_mm256_max_epi32(result, y_min), y_max);
+    result = _mm256_permutevar8x32_epi32(
+        _mm256_shuffle_epi8(result, byte_shuffle), lane_permute);
+    _mm_storel_epi64((__m128i *)(out + j), _mm256_castsi256_si128(result));
+  }
+  if (j < cols) {
+    requantizeRow(acc + j, col_sum != nullptr ? col_sum + j : nullptr,
+                  requant, y_zero_point, y_signed, cols - j, out + j);
+  }
+}
+
+/**
+ * @brief 量化卷积一次执行所需的全部信息，供多线程任务共享
+ */
+struct X86QConvProblem {
+  X86QConvGeometry g_;
+  const uint8_t *input_ = nullptr;
+  const int8_t *weight_ = nullptr;  // 打包后的权重
+  const X86QConvRequant *requant_ = nullptr;
+  void *output_ = nullptr;
+  uint8_t flip_ = 0;
+  uint8_t pad_value_ = 0;
+  bool need_col_sum_ = false;
+  bool y_signed_ = false;
+  int32_t y_zero_point_ = 0;
+  int group_ = 1;
+  int m_ = 0;  // 每个group的输出通道数
+  int k_ = 0;  // 每个group的累加长度
+  int m_padded_ = 0;
+  bool is_pointwise_ = false;
+  int block_n_ = 0;
+  int tiles_n_ = 0;
+  QgemmMicroKernel kernel_;
+  bool use_avx2_ = false;
+};
+
+/**
+ * @brief 单个batch、单个group、[n0, n0 + nc)列的量化卷积：
+ * acc[m x n] = weight[m x k] * im2col(input)[k x n]，n = oh * ow，
+ * 每个微核的输出块算完整个k后直接重量化写回
+ */
+static void qConvTile(const X86QConvProblem &p, const uint8_t *input,
+                      const int8_t *packed_weight,
+                      const X86QConvRequant *requant, uint8_t *output,
+                      int n0) {
+  thread_local std::vector<uint8_t> im2col_buffer;
+  thread_local std::vector<uint8_t> pack_buffer;
+  thread_local std::vector<int32_t> col_sum_buffer;
+  const X86QConvGeometry &g = p.g_;
+  const int mr = p.kernel_.mr_;
+  const int nr = p.kernel_.nr_;
+  const int n = g.height_out_ * g.width_out_;
+  const int nc = std::min(p.block_n_, n - n0);
+  const int k_padded = qgemmPaddedK(p.k_);
+  const size_t pack_size = (size_t)(nc + nr - 1) / nr * nr * k_padded;
+  if (pack_buffer.size() < pack_size) {
+    pack_buffer.resize(pack_size);
+  }
+  if (col_sum_buffer.size() < (size_t)nc) {
+    col_sum_buffer.resize(nc);
+  }
+  // 1x1/stride1/pad0 且x为u8时，输入本身就是[k x n]的u8矩阵
+  const uint8_t *b = input + n0;
+  int ldb = n;
+  if (!p.is_pointwise_ || p.flip_ != 0) {
+    if (im2col_buffer.size() < (size_t)p.k_ * nc) {
+      im2col_buffer.resize((size_t)p.k_ * nc);
+    }
+    im2colQConvInput(g, input, p.flip_, p.pad_value_, n0, nc,
+                     im2col_buffer.data());
+    b = im2col_buffer.data();
+    ldb = nc;
+  }
+  int32_t *col_sum = p.need_col_sum_ ? col_sum_buffer.data() : nullptr;
+  packQgemmB(b, ldb, p.k_, nc, nr, pack_buffer.data(), col_sum);
+
+  int32_t tile[32 * 32];
+  for (int j0 = 0; j0 < nc; j0 += nr) {
+    const int cols = std::min(nr, nc - j0);
+    const uint8_t *b_panel = pack_buffer.data() + (size_t)j0 * k_padded;
+    for (int i0 = 0; i0 < p.m_; i0 += mr) {
+      const int rows = std::min(mr, p.m_ - i0);
+      const int8_t *a_panel = packed_weight + (size_t)i0 * k_padded;
+      p.kernel_.func_(k_padded / 4, a_panel, b_panel, tile, nr, false);
+      for (int i = 0; i < rows; ++i) {
+        uint8_t *out = output + (size_t)(i0 + i) * n + n0 + j0;
+        const int32_t *sum = col_sum != nullptr ? col_sum + j0 : nullptr;
+        if (p.use_avx2_) {
+          requantizeRowAvx2(tile + i * nr, sum, requant[i0 + i],
+                            p.y_zero_point_, p.y_signed_, cols, out);
+        } else {
+          requantizeRow(tile + i * nr, sum, requant[i0 + i], p.y_zero_point_,
+                        p.y_signed_, cols, out);
+        }
+      }
+    }
+  }
+}
+
+class X86QConvParallelBody : public thread_pool::ParallelLoopBody {
+ public:
+  explicit X86QConvParallelBody(const X86QConvProblem &problem)
+      : problem_(problem) {}
+
+  virtual void operator()(const base::Range &range) const {
+    const X86QConvProblem &p = problem_;
+    const X86QConvGeometry &g = p.g_;
+    const size_t group_input_size =
+        (size_t)g.channel_in_ * g.height_in_ * g.width_in_;
+    const size_t group_output_size =
+        (size_t)p.m_ * g.height_out_ * g.width_out_;
+    const size_t k_padded = qgemmPaddedK(p.k_);
+    // 任务按 batch * group * 列块 展开
+    for (int t = range.start_; t < range.end_; ++t) {
+      const int batch_group = t / p.tiles_n_;
+      const int gi = batch_group % p.group_;
+      const int n0 = (t % p.tiles_n_) * p.block_n_;
+      qConvTile(p, p.input_ + batch_group * group_input_size,
+                p.weight_ + (size_t)gi * p.m_padded_ * k_padded,
+                p.requant_ + gi * p.m_,
+                static_cast<uint8_t *>(p.output_) +
+                    batch_group * group_output_size,
+                n0);
+    }
+  }
+
+ private:
+  const X86QConvProblem &problem_;
+};
+
+/**
+ * @brief x86 量化卷积实现
+ * @note
+ * # 权重在preRun中转为s8(u8的权重减128)并按微核的mr打包一次，同时记下每个
+ *   输出通道的权重和；s8的x异或0x80转为u8，微核为u8 x s8 -> int32
+ * # 隐式im2col + int8 gemm，微核来自qgemm_kernel中按cpu特性注册的最优实现
+ *   (avx512-vnni/avx-vnni/avx2)
+ * # 零点修正、bias与按输出通道的重量化在写回输出块时融合完成，
+ *   结果与参考实现OpQLinearConv::run逐位一致
+ * # 按batch/group/输出列块通过thread_pool::parallelFor多线程执行
+ * # 非4维的卷积退回到参考实现
+ */
+class X86OpQLinearConv : public OpQLinearConv {
+ public:
+  X86OpQLinearConv() : OpQLinearConv() {}
+  virtual ~X86OpQLinearConv() {}
+
+  virtual base::Status preRun() {
+    base::Status status = OpQLinearConv::preRun();
+    NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "preRun failed");
+    if (!isSupported()) {
+      return base::kStatusCodeOk;
+    }
+    kernel_ = getQgemmMicroKernel();
+    use_avx2_ = getX86IsaType() >= kX86IsaTypeAvx2;
+
+    // 权重按group打包，权重不变(getConstWeightFlag)时只打包一次
+    device::Tensor *weight_tensor = inputs_[3];
+    const void *weight_data = weight_tensor->getData();
+    base::IntVector weight_shape = weight_tensor->getShape();
+    if (getConstWeightFlag() && weight_data == packed_weight_src_ &&
+        weight_shape == packed_shape_) {
+      return base::kStatusCodeOk;
+    }
+    auto param = dynamic_cast<ir::QLinearConvParam *>(op_desc_.op_param_.get());
+    const int group = std::max(param->group_, 1);
+    const int mr = kernel_.mr_;
+    const int m = weight_shape[0] / group;
+    const int k = weight_shape[1] * weight_shape[2] * weight_shape[3];
+    const int m_padded = (m + mr - 1) / mr * mr;
+    const int k_padded = qgemmPaddedK(k);
+    // u8的权重减128转为s8，零点在run中做同样的平移
+    const bool weight_unsigned =
+        weight_tensor->getDataType() == base::dataTypeOf<uint8_t>();
+    std::vector<int8_t> weight((size_t)m * k);
+    packed_weight_.resize((size_t)group * m_padded * k_padded);
+    weight_row_sum_.resize(weight_shape[0]);
+    for (int gi = 0; gi < group; ++gi) {
+      const size_t offset = (size_t)gi * m * k;
+      for (int i = 0; i < m; ++i) {
+        int32_t sum = 0;
+        for (int kk = 0; kk < k; ++kk) {
+          const size_t index = offset + (size_t)i * k + kk;
+          const int32_t value =
+              weight_unsigned
+                  ? static_cast<const uint8_t *>(weight_data)[index] - 128
+                  : static_cast<const int8_t *>(weight_data)[index];
+          weight[(size_t)i * k + kk] = static_cast<int8_t>(value);
+          sum += value;
+        }
+        weight_row_sum_[gi * m + i] = sum;
+      }
+      packQgemmA(weight.data(), k, m, k, mr,
+                 packed_weight_.data() + (size_t)gi * m_padded * k_padded);
+    }
+    packed_weight_src_ = weight_data;
+    packed_shape_ = weight_shape;
+    return base::kStatusCodeOk;
+  }
+
+  virtual base::Status run() {
+    if (!isSupported() || kernel_.func_ == nullptr) {
+      return OpQLinearConv::run();
+    }
+    QLinearConvQuantParam quant_param;
+    base::Status status = this->getQuantParam(quant_param);
+    NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                           "getQuantParam failed");
+    device::Tensor *input_tensor = inputs_[0];
+    device::Tensor *weight_tensor = inputs_[3];
+    device::Tensor *bias_tensor = inputs_.size() > 8 ? inputs_[8] : nullptr;
+    device::Tensor *output_tensor = outputs_[0];
+    if (weight_tensor->getData() != packed_weight_src_) {
+      status = this->preRun();
+      NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "preRun failed");
+    }
+
+    auto param = dynamic_cast<ir::QLinearConvParam *>(op_desc_.op_param_.get());
+    base::IntVector input_shape = input_tensor->getShape();
+    base::IntVector weight_shape = weight_tensor->getShape();
+    base::IntVector output_shape = output_tensor->getShape();
+    const int batch = input_shape[0];
+    const int group = std::max(param->group_, 1);
+
+    X86QConvProblem p;
+    X86QConvGeometry &g = p.g_;
+    g.channel_in_ = input_shape[1] / group;
+    g.height_in_ = input_shape[2];
+    g.width_in_ = input_shape[3];
+    g.height_out_ = output_shape[2];
+    g.width_out_ = output_shape[3];
+    g.kernel_h_ = weight_shape[2];
+    g.kernel_w_ = weight_shape[3];
+    if (param->strides_.size() >= 2) {
+      g.stride_h_ = param->strides_[0];
+      g.stride_w_ = param->strides_[1];
+    }
+    if (param->pads_.size() >= 2) {
+      g.pad_h_ = param->pads_[0];
+      g.pad_w_ = param->pads_[1];
+    }
+    if (param->dilations_.size() >= 2) {
+      g.dilation_h_ = param->dilations_[0];
+      g.dilation_w_ = param->dilations_[1];
+    }
+    p.m_ = weight_shape[0] / group;
+    p.k_ = g.channel_in_ * g.kernel_h_ * g.kernel_w_;
+    p.m_padded_ = (p.m_ + kernel_.mr_ - 1) / kernel_.mr_ * kernel_.mr_;
+
+    // 微核计算的是 x' * w'，x' = x + x_offset，w' = w - w_offset：
+    // sum((x - zx)(w - zw)) = sum(x'w') - zw' * sum(x') - zx' * sum(w')
+    //                         + k * zx' * zw'，其中 zx' = zx + x_offset，
+    // zw' = zw - w_offset；补边位置填zx'，对结果没有贡献
+    const bool input_signed =
+        input_tensor->getDataType() == base::dataTypeOf<int8_t>();
+    const bool weight_unsigned =
+        weight_tensor->getDataType() == base::dataTypeOf<uint8_t>();
+    const int32_t x_zero_point =
+        quant_param.x_zero_point_ + (input_signed ? 128 : 0);
+    const int32_t w_offset = weight_unsigned ? 128 : 0;
+    const int32_t *bias =
+        bias_tensor != nullptr
+            ? static_cast<const int32_t *>(bias_tensor->getData())
+            : nullptr;
+    requant_.resize(weight_shape[0]);
+    p.need_col_sum_ = false;
+    for (int c = 0; c < weight_shape[0]; ++c) {
+      X86QConvRequant &requant = requant_[c];
+      requant.w_zero_point_ = quant_param.w_zero_point_[c] - w_offset;
+      requant.correction_ = (bias != nullptr ? bias[c] : 0) -
+                            x_zero_point * weight_row_sum_[c] +
+                            p.k_ * x_zero_point * requant.w_zero_point_;
+      requant.scale_ = quant_param.x_scale_ * quant_param.w_scale_[c] /
+                       quant_param.y_scale_;
+      p.need_col_sum_ = p.need_col_sum_ || requant.w_zero_point_ != 0;
+    }
+
+    p.input_ = static_cast<const uint8_t *>(input_tensor->getData());
+    p.weight_ = packed_weight_.data();
+    p.requant_ = requant_.data();
+    p.output_ = output_tensor->getData();
+    p.flip_ = input_signed ? 0x80 : 0;
+    p.pad_value_ = static_cast<uint8_t>(x_zero_point);
+    p.y_signed_ = output_tensor->getDataType() == base::dataTypeOf<int8_t>();
+    p.y_zero_point_ = quant_param.y_zero_point_;
+    p.group_ = group;
+    p.kernel_ = kernel_;
+    p.use_avx2_ = use_avx2_;
+    p.is_pointwise_ = g.kernel_h_ == 1 && g.kernel_w_ == 1 &&
+                      g.stride_h_ == 1 && g.stride_w_ == 1 && g.pad_h_ == 0 &&
+                      g.pad_w_ == 0 && g.height_in_ == g.height_out_ &&
+                      g.width_in_ == g.width_out_;
+
+    // 列块在L2容量内尽量大，任务数不足以喂满所有线程时再缩小
+    const int nr = kernel_.nr_;
+    const int n = g.height_out_ * g.width_out_;
+    const int num_threads = std::max(thread_pool::getThreadNum(), 1);
+    p.block_n_ = kX86QConvBlockBytes / qgemmPaddedK(p.k_) / nr * nr;
+    p.block_n_ = std::max(nr, std::min(kX86QConvBlockNMax / nr * nr,
+                                       p.block_n_));
+    auto num_tiles = [&]() {
+      return (int64_t)batch * group * ((n + p.block_n_ - 1) / p.block_n_);
+    };
+    while (num_tiles() < num_threads * 2 && p.block_n_ > nr) {
+      p.block_n_ = std::max(nr, p.block_n_ / 2 / nr * nr);
+    }
+    p.tiles_n_ = (n + p.block_n_ - 1) / p.block_n_;
+    X86QConvParallelBody body(p);
+    thread_pool::parallelFor(base::Range(0, batch * group * p.tiles_n_), body);
+    return base::kStatusCodeOk;
+  }
+
+  virtual base::Status deinit() {
+    packed_weight_.clear();
+    packed_weight_.shrink_to_fit();
+    packed_weight_src_ = nullptr;
+    packed_shape_.clear();
+    weight_row_sum_.clear();
+    requant_.clear();
+    return OpQLinearConv::deinit();
+  }
+
+ private:
+  bool isSupported() {
+    if (inputs_.size() < 8 || outputs_.empty()) {
+      return false;
+    }
+    if (inputs_[0]->getShape().size() != 4 ||
+        inputs_[3]->getShape().size() != 4 ||
+        outputs_[0]->getShape().size() != 4) {
+      return false;
+    }
+    if (!isQuantizedDataType(inputs_[0]->getDataType()) ||
+        !isQuantizedDataType(inputs_[3]->getDataType()) ||
+        !isQuantizedDataType(outputs_[0]->getDataType())) {
+      return false;
+    }
+    auto param = dynamic_cast<ir::QLinearConvParam *>(op_desc_.op_param_.get());
+    return param != nullptr;
+  }
+
+  bool isQuantizedDataType(const base::DataType &data_type) {
+    return data_type == base::dataTypeOf<int8_t>() ||
+           data_type == base::dataTypeOf<uint8_t>();
+  }
+
+ private:
+  QgemmMicroKernel kernel_;
+  bool use_avx2_ = false;
+
+  // 打包后的s8权重、每个输出通道的权重和，以及对应的原始权重指针/形状，
+  // 用于判断是否需要重新打包
+  std::vector<int8_t> packed_weight_;
+  std::vector<int32_t> weight_row_sum_;
+  const void *packed_weight_src_ = nullptr;
+  base::IntVector packed_shape_;
+
+  std::vector<X86QConvRequant> requant_;
+};
+
+REGISTER_OP_IMPLEMENTION(kDeviceTypeCodeX86, ir::kOpTypeQLinearConv,
+                         X86OpQLinearConv)
+
+}  // namespace op
+}  // namespace nndeploy
@@ -0,0 +1,89 @@
+
+#include "nndeploy/op/x86/op_util.h"
+
+#include "nndeploy/base/common.h"
+#include "nndeploy/base/log.h"
+#include "nndeploy/base/macro.h"
+#include "nndeploy/base/status.h"
+#include "nndeploy/op/x86/op_include.h"
+
+namespace nndeploy {
+namespace op {
+
+static X86IsaType detectX86IsaType() {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return kX86IsaTypeAvx512;
+  }
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return kX86IsaTypeAvx2;
+  }
+  return kX86IsaTypeNone;
+#elif defined(_MSC_VER)
+  int info[4] = {0};
+  __cpuid(info, 0);
+  int max_leaf = info[0];
+  if (max_leaf < 7) {
+    return kX86IsaTypeNone;
+  }
+  __cpuid(info, 1);
+  bool osxsave = (info[2] & (1 << 27)) != 0;
+  bool fma = (info[2] & (1 << 12)) != 0;
+  if (!osxsave) {
+    return kX86IsaTypeNone;
+  }
+  unsigned long long xcr0 = _xgetbv(0);
+  bool ymm_state = (xcr0 & 0x6) == 0x6;
+  bool zmm_state = (xcr0 & 0xe6) == 0xe6;
+  __cpuidex(info, 7, 0);
+  bool avx2 = (info[1] & (1 << 5)) != 0;
+  bool avx512f = (info[1] & (1 << 16)) != 0;
+  if (avx512f && zmm_state) {
+    return kX86IsaTypeAvx512;
+  }
+  if (avx2 && fma && ymm_state) {
+    return kX86IsaTypeAvx2;
+  }
+  return kX86IsaTypeNone;
+#else
+  return kX86IsaTypeNone;
+#endif
+}
+
+X86IsaType getX86IsaType() {
+  static X86IsaType isa = []() {
+    X86IsaType detected = detectX86IsaType();
+    const char *env = std::getenv("NNDEPLOY_X86_ISA");
+    if (env != nullptr) {
+      std::string limit(env);
+      X86IsaType limit_isa = detected;
+      if (limit == "none") {
+        limit_isa = kX86IsaTypeNone;
+      } else if (limit == "avx2") {
+        limit_isa = kX86IsaTypeAvx2;
+      } else if (limit == "avx512") {
+        limit_isa = kX86IsaTypeAvx512;
+      } else {
+        NNDEPLOY_LOGI("unknown NNDEPLOY_X86_ISA[%s], ignored.\n", env);
+      }
+      detected = std::min(detected, limit_isa);
+    }
+    return detected;
+  }();
+  return isa;
+}
+
+std::string x86IsaTypeToString(X86IsaType isa) {
+  switch (isa) {
+    case kX86IsaTypeAvx2:
+      return "avx2";
+    case kX86IsaTypeAvx512:
+      return "avx512";
+    default:
+      return "none";
+  }
+}
+
+}  // namespace op
+}  // namespace nndeploy
@@ -0,0 +1,226 @@
+
+#include "nndeploy/op/qgemm_kernel.h"
+#include "nndeploy/op/x86/op_include.h"
+#include "nndeploy/op/x86/op_util.h"
+
+namespace nndeploy {
+namespace op {
+
+/**
+ * @brief 读取A微面板中一行的4个s8
+ */
+static inline int32_t loadQgemmA4(const int8_t *a) {
+  int32_t value;
+  memcpy(&value, a, sizeof(value));
+  return value;
+}
+
+/**
+ * @brief 没有vnni时的avx2实现
+ * @note
+ * # 不使用vpmaddubsw：u8 x s8的相邻两项之和会饱和到int16(255 * 127 * 2 >
+ *   32767)，结果与参考实现不一致
+ * # 改为把B零扩展、A符号扩展到int16后用vpmaddwd，每两项的和直接得到int32，
+ *   没有饱和；每列的两个部分和最后用vphaddd合并
+ */
+static NNDEPLOY_X86_TARGET_AVX2 void qgemmMicroKernel6x8Avx2(
+    int k4, const int8_t *a, const uint8_t *b, int32_t *c, int ldc,
+    bool accumulate) {
+  __m256i c00 = _mm256_setzero_si256(), c01 = _mm256_setzero_si256();
+  __m256i c10 = _mm256_setzero_si256(), c11 = _mm256_setzero_si256();
+  __m256i c20 = _mm256_setzero_si256(), c21 = _mm256_setzero_si256();
+  __m256i c30 = _mm256_setzero_si256(), c31 = _mm256_setzero_si256();
+  __m256i c40 = _mm256_setzero_si256(), c41 = _mm256_setzero_si256();
+  __m256i c50 = _mm256_setzero_si256(), c51 = _mm256_setzero_si256();
+  for (int g = 0; g < k4; ++g) {
+    __m256i bv = _mm256_loadu_si256((const __m256i *)b);
+    // 第0~3列与第4~7列，每列4个k
+    __m256i b0 = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(bv));
+    __m256i b1 = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(bv, 1));
+    __m256i av =
+        _mm256_cvtepi8_epi16(_mm_set1_epi32(loadQgemmA4(a)));
+    c00 = _mm256_add_epi32(c00, _mm256_madd_epi16(b0, av));
+    c01 = _mm256_add_epi32(c01, _mm256_madd_epi16(b1, av));
+    av = _mm256_cvtepi8_epi16(_mm_set1_epi32(loadQgemmA4(a + 4)));
+    c10 = _mm256_add_epi32(c10, _mm256_madd_epi16(b0, av));
+    c11 = _mm256_add_epi32(c11, _mm256_madd_epi16(b1, av));
+    av = _mm256_cvtepi8_epi16(_mm_set1_epi32(loadQgemmA4(a + 8)));
+    c20 = _mm256_add_epi32(c20, _mm256_madd_epi16(b0, av));
+    c21 = _mm256_add_epi32(c21, _mm256_madd_epi16(b1, av));
+    av = _mm256_cvtepi8_epi16(_mm_set1_epi32(loadQgemmA4(a + 12)));
+    c30 = _mm256_add_epi32(c30, _mm256_madd_epi16(b0, av));
+    c31 = _mm256_add_epi32(c31, _mm256_madd_epi16(b1, av));
+    av = _mm256_cvtepi8_epi16(_mm_set1_epi32(loadQgemmA4(a + 16)));
+    c40 = _mm256_add_epi32(c40, _mm256_madd_epi16(b0, av));
+    c41 = _mm256_add_epi32(c41, _mm256_madd_epi16(b1, av));
+    av = _mm256_cvtepi8_epi16(_mm_set1_epi32(loadQgemmA4(a + 20)));
+    c50 = _mm256_add_epi32(c50, _mm256_madd_epi16(b0, av));
+    c51 = _mm256_add_epi32(c51, _mm256_madd_epi16(b1, av));
+    a += 6 * 4;
+    b += 8 * 4;
+  }
+  // 合并后按64位重排为第0~7列：(c0c1, c4c5, c2c3, c6c7) -> (c0 ... c7)
+#define NNDEPLOY_X86_STORE_ROW_AVX2(row, r0, r1)                          \
+  do {                                                                    \
+    int32_t *c_row = c + (row) * ldc;                                     \
+    __m256i r = _mm256_permute4x64_epi64(_mm256_hadd_epi32(r0, r1),       \
+                                         _MM_SHUFFLE(3, 1, 2, 0));        \
+    if (accumulate) {                                                     \
+      r = _mm256_add_epi32(r, _mm256_loadu_si256((const __m256i *)c_row)); \
+    }                                                                     \
+    _mm256_storeu_si256((__m256i *)c_row, r);                             \
+  } while (0)
+  NNDEPLOY_X86_STORE_ROW_AVX2(0, c00, c01);
+  NNDEPLOY_X86_STORE_ROW_AVX2(1, c10, c11);
+  NNDEPLOY_X86_STORE_ROW_AVX2(2, c20, c21);
+  NNDEPLOY_X86_STORE_ROW_AVX2(3, c30, c31);
+  NNDEPLOY_X86_STORE_ROW_AVX2(4, c40, c41);
+  NNDEPLOY_X86_STORE_ROW_AVX2(5, c50, c51);
+#undef NNDEPLOY_X86_STORE_ROW_AVX2
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+/**
+ * @brief avx-vnni(vex编码的vpdpbusd)，一条指令完成8列 x 4个k的乘加
+ */
+static NNDEPLOY_X86_TARGET_AVX_VNNI void qgemmMicroKernel6x16AvxVnni(
+    int k4, const int8_t *a, const uint8_t *b, int32_t *c, int ldc,
+    bool accumulate) {
+  __m256i c00 = _mm256_setzero_si256(), c01 = _mm256_setzero_si256();
+  __m256i c10 = _mm256_setzero_si256(), c11 = _mm256_setzero_si256();
+  __m256i c20 = _mm256_setzero_si256(), c21 = _mm256_setzero_si256();
+  __m256i c30 = _mm256_setzero_si256(), c31 = _mm256_setzero_si256();
+  __m256i c40 = _mm256_setzero_si256(), c41 = _mm256_setzero_si256();
+  __m256i c50 = _mm256_setzero_si256(), c51 = _mm256_setzero_si256();
+  for (int g = 0; g < k4; ++g) {
+    __m256i b0 = _mm256_loadu_si256((const __m256i *)b);
+    __m256i b1 = _mm256_loadu_si256((const __m256i *)(b + 32));
+    __m256i av = _mm256_set1_epi32(loadQgemmA4(a));
+    c00 = _mm256_dpbusd_avx_epi32(c00, b0, av);
+    c01 = _mm256_dpbusd_avx_epi32(c01, b1, av);
+    av = _mm256_set1_epi32(loadQgemmA4(a + 4));
+    c10 = _mm256_dpbusd_avx_epi32(c10, b0, av);
+    c11 = _mm256_dpbusd_avx_epi32(c11, b1, av);
+    av = _mm256_set1_epi32(loadQgemmA4(a + 8));
+    c20 = _mm256_dpbusd_avx_epi32(c20, b0, av);
+    c21 = _mm256_dpbusd_avx_epi32(c21, b1, av);
+    av = _mm256_set1_epi32(loadQgemmA4(a + 12));
+    c30 = _mm256_dpbusd_avx_epi32(c30, b0, av);
+    c31 = _mm256_dpbusd_avx_epi32(c31, b1, av);
+    av = _mm256_set1_epi32(loadQgemmA4(a + 16));
+    c40 = _mm256_dpbusd_avx_epi32(c40, b0, av);
+    c41 = _mm256_dpbusd_avx_epi32(c41, b1, av);
+    av = _mm256_set1_epi32(loadQgemmA4(a + 20));
+    c50 = _mm256_dpbusd_avx_epi32(c50, b0, av);
+    c51 = _mm256_dpbusd_avx_epi32(c51, b1, av);
+    a += 6 * 4;
+    b += 16 * 4;
+  }
+#define NNDEPLOY_X86_STORE_ROW_AVX_VNNI(row, r0, r1)                        \
+  do {                                                                      \
+    int32_t *c_row = c + (row) * ldc;                                       \
+    if (accumulate) {                                                       \
+      r0 = _mm256_add_epi32(r0, _mm256_loadu_si256((const __m256i *)c_row)); \
+      r1 = _mm256_add_epi32(                                                \
+          r1, _mm256_loadu_si256((const __m256i *)(c_row + 8)));            \
+    }                                                                       \
+    _mm256_storeu_si256((__m256i *)c_row, r0);                              \
+    _mm256_storeu_si256((__m256i *)(c_row + 8), r1);                        \
+  } while (0)
+  NNDEPLOY_X86_STORE_ROW_AVX_VNNI(0, c00, c01);
+  NNDEPLOY_X86_STORE_ROW_AVX_VNNI(1, c10, c11);
+  NNDEPLOY_X86_STORE_ROW_AVX_VNNI(2, c20, c21);
+  NNDEPLOY_X86_STORE_ROW_AVX_VNNI(3, c30, c31);
+  NNDEPLOY_X86_STORE_ROW_AVX_VNNI(4, c40, c41);
+  NNDEPLOY_X86_STORE_ROW_AVX_VNNI(5, c50, c51);
+#undef NNDEPLOY_X86_STORE_ROW_AVX_VNNI
+}
+
+static NNDEPLOY_X86_TARGET_AVX512_VNNI void qgemmMicroKernel8x32Avx512Vnni(
+    int k4, const int8_t *a, const uint8_t *b, int32_t *c, int ldc,
+    bool accumulate) {
+  __m512i c00 = _mm512_setzero_si512(), c01 = _mm512_setzero_si512();
+  __m512i c10 = _mm512_setzero_si512(), c11 = _mm512_setzero_si512();
+  __m512i c20 = _mm512_setzero_si512(), c21 = _mm512_setzero_si512();
+  __m512i c30 = _mm512_setzero_si512(), c31 = _mm512_setzero_si512();
+  __m512i c40 = _mm512_setzero_si512(), c41 = _mm512_setzero_si512();
+  __m512i c50 = _mm512_setzero_si512(), c51 = _mm512_setzero_si512();
+  __m512i c60 = _mm512_setzero_si512(), c61 = _mm512_setzero_si512();
+  __m512i c70 = _mm512_setzero_si512(), c71 = _mm512_setzero_si512();
+  for (int g = 0; g < k4; ++g) {
+    __m512i b0 = _mm512_loadu_si512(b);
+    __m512i b1 = _mm512_loadu_si512(b + 64);
+    __m512i av = _mm512_set1_epi32(loadQgemmA4(a));
+    c00 = _mm512_dpbusd_epi32(c00, b0, av);
+    c01 = _mm512_dpbusd_epi32(c01, b1, av);
+    av = _mm512_set1_epi32(loadQgemmA4(a + 4));
+    c10 = _mm512_dpbusd_epi32(c10, b0, av);
+    c11 = _mm512_dpbusd_epi32(c11, b1, av);
+    av = _mm512_set1_epi32(loadQgemmA4(a + 8));
+    c20 = _mm512_dpbusd_epi32(c20, b0, av);
+    c21 = _mm512_dpbusd_epi32(c21, b1, av);
+    av = _mm512_set1_epi32(loadQgemmA4(a + 12));
+    c30 = _mm512_dpbusd_epi32(c30, b0, av);
+    c31 = _mm512_dpbusd_epi32(c31, b1, av);
+    av = _mm512_set1_epi32(loadQgemmA4(a + 16));
+    c40 = _mm512_dpbusd_epi32(c40, b0, av);
+    c41 = _mm512_dpbusd_epi32(c41, b1, av);
+    av = _mm512_set1_epi32(loadQgemmA4(a + 20));
+    c50 = _mm512_dpbusd_epi32(c50, b0, av);
+    c51 = _mm512_dpbusd_epi32(c51, b1, av);
+    av = _mm512_set1_epi32(loadQgemmA4(a + 24));
+    c60 = _mm512_dpbusd_epi32(c60, b0, av);
+    c61 = _mm512_dpbusd_epi32(c61, b1, av);
+    av = _mm512_set1_epi32(loadQgemmA4(a + 28));
+    c70 = _mm512_dpbusd_epi32(c70, b0, av);
+    c71 = _mm512_dpbusd_epi32(c71, b1, av);
+    a += 8 * 4;
+    b += 32 * 4;
+  }
+#define NNDEPLOY_X86_STORE_ROW_AVX512_VNNI(row, r0, r1)               \
+  do {                                                                \
+    int32_t *c_row = c + (row) * ldc;                                 \
+    if (accumulate) {                                                 \
+      r0 = _mm512_add_epi32(r0, _mm512_loadu_si512(c_row));           \
+      r1 = _mm512_add_epi32(r1, _mm512_loadu_si512(c_row + 16));      \
+    }                                                                 \
+    _mm512_storeu_si512(c_row, r0);                                   \
+    _mm512_storeu_si512(c_row + 16, r1);                              \
+  } while (0)
+  NNDEPLOY_X86_STORE_ROW_AVX512_VNNI(0, c00, c01);
+  NNDEPLOY_X86_STORE_ROW_AVX512_VNNI(1, c10, c11);
+  NNDEPLOY_X86_STORE_ROW_AVX512_VNNI(2, c20, c21);
+  NNDEPLOY_X86_STORE_ROW_AVX512_VNNI(3, c30, c31);
+  NNDEPLOY_X86_STORE_ROW_AVX512_VNNI(4, c40, c41);
+  NNDEPLOY_X86_STORE_ROW_AVX512_VNNI(5, c50, c51);
+  NNDEPLOY_X86_STORE_ROW_AVX512_VNNI(6, c60, c61);
+  NNDEPLOY_X86_STORE_ROW_AVX512_VNNI(7, c70, c71);
+#undef NNDEPLOY_X86_STORE_ROW_AVX512_VNNI
+}
+#endif
+
+static bool registerX86QgemmMicroKernels() {
+  X86IsaType isa = getX86IsaType();
+  if (isa >= kX86IsaTypeAvx2) {
+    registerQgemmMicroKernel(QgemmMicroKernel(
+        "avx2_6x8", 6, 8, qgemmMicroKernel6x8Avx2, 10));
+  }
+#if defined(__GNUC__) || defined(__clang__)
+  // avx-vnni是avx2一代的扩展，NNDEPLOY_X86_ISA=avx2时仍然使用
+  if (isa >= kX86IsaTypeAvx2 && __builtin_cpu_supports("avxvnni")) {
+    registerQgemmMicroKernel(QgemmMicroKernel(
+        "avx_vnni_6x16", 6, 16, qgemmMicroKernel6x16AvxVnni, 15));
+  }
+  if (isa >= kX86IsaTypeAvx512 && __builtin_cpu_supports("avx512vnni")) {
+    registerQgemmMicroKernel(QgemmMicroKernel(
+        "avx512_vnni_8x32", 8, 32, qgemmMicroKernel8x32Avx512Vnni, 20));
+  }
+#endif
+  return true;
+}
+
+static bool g_x86_qgemm_micro_kernel_register =
+    registerX86QgemmMicroKernels();
+
+}  // namespace op
+}  // namespace nndeploy
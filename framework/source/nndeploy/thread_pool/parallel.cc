@@ -3,19 +3,60 @@
 
 #include "nndeploy/thread_pool/parallel_for_api.h"
 
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__) || defined(__ANDROID__)
+#include <sched.h>
+#endif
+
 namespace nndeploy {
 namespace thread_pool {
 
 static ParallelForApiType g_parallel_for_api_type = kParallelForApiTypeDefault;
 
-int defaultNumberOfThreads() { return 4; }
+int defaultNumberOfThreads() {
+  static int num_threads = []() {
+    int num = (int)std::thread::hardware_concurrency();
+    const char *env = std::getenv("NNDEPLOY_THREAD_NUM");
+    if (env != nullptr && atoi(env) > 0) {
+      num = atoi(env);
+    }
+    return std::max(num, 1);
+  }();
+  return num_threads;
+}
+
+bool bindCurrentThreadToCpu(int cpu_id) {
+  if (cpu_id < 0) {
+    return false;
+  }
+#if defined(_WIN32)
+  if (cpu_id >= (int)(sizeof(DWORD_PTR) * 8)) {
+    return false;
+  }
+  DWORD_PTR mask = (DWORD_PTR)1 << cpu_id;
+  return SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#elif defined(__linux__) || defined(__ANDROID__)
+  if (cpu_id >= CPU_SETSIZE) {
+    return false;
+  }
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  CPU_SET(cpu_id, &mask);
+  // pid为0表示调用线程
+  return sched_setaffinity(0, sizeof(mask), &mask) == 0;
+#else
+  // macos/ios 不支持绑核
+  return false;
+#endif
+}
 
 void setThreadNum(int num) {
-  int num_threads = (num < 0) ? defaultNumberOfThreads() : (unsigned)num;
+  int num_threads = (num < 0) ? defaultNumberOfThreads() : num;
   std::shared_ptr<ParallelForApi> &api =
       getParallelForApi(g_parallel_for_api_type);
   if (api) {
-    api->setThreadNum(num);
+    api->setThreadNum(num_threads);
   }
 }
 
@@ -0,0 +1,29 @@
+
+#include "nndeploy/thread_pool/thread_pool.h"
+
+#include "nndeploy/thread_pool/parallel.h"
+
+namespace nndeploy {
+namespace thread_pool {
+
+ThreadPool *getGlobalThreadPool() {
+  // 进程退出时不析构，避免与仍在运行的任务竞争
+  static ThreadPool *pool = []() {
+    ThreadPool *global_pool = new ThreadPool(defaultNumberOfThreads());
+    const char *env = std::getenv("NNDEPLOY_THREAD_AFFINITY");
+    if (env != nullptr && atoi(env) > 0) {
+      int cpu_num = std::max((int)std::thread::hardware_concurrency(), 1);
+      std::vector<int> cpu_ids;
+      for (int i = 0; i < cpu_num; ++i) {
+        cpu_ids.push_back(i);
+      }
+      global_pool->setCpuAffinity(cpu_ids);
+    }
+    global_pool->init();
+    return global_pool;
+  }();
+  return pool;
+}
+
+}  // namespace thread_pool
+}  // namespace nndeploy
@@ -104,6 +104,96 @@ base::Status computeNMS(const DetectResult &src, std::vector<int> &keep_idxs,
 base::Status fastNMS(const DetectResult &src, std::vector<int> &keep_idxs,
                      const float iou_threshold);
 
+/**
+ * @brief soft-NMS的分数衰减方式
+ */
+enum SoftNMSMethod : int {
+  kSoftNMSMethodLinear = 0x0000,  // score *= 1 - iou（iou > iou_threshold时）
+  kSoftNMSMethodGaussian,         // score *= exp(-iou * iou / sigma)
+};
+
+/**
+ * @brief 按分数排序、按类别分组的NMS，O(nlogn)排序 + 向量化IoU
+ *
+ * @param src 候选框，不要求有序
+ * @param keep_idxs 保留的框在src中的下标，按分数从高到低排列
+ * @param iou_threshold
+ * @param max_detections 保留的框数达到该值时提前结束，<=0表示不限制
+ * @param class_agnostic 为true时不区分类别
+ * @return base::Status
+ * @note
+ * # 每个类别的框平移到互不重叠的区域（类别偏移），一次NMS完成所有类别
+ * # 框按SoA存放，一个保留框与其后所有候选框的IoU用SSE/NEON一次计算4个
+ */
+extern NNDEPLOY_CC_API base::Status computeBatchedNMS(
+    const DetectResult &src, std::vector<int> &keep_idxs,
+    const float iou_threshold, int max_detections = -1,
+    bool class_agnostic = false);
+
+struct NMSBoxes;
+
+/**
+ * @brief SoA存放的候选框，label_/score_/x0_/y0_/x1_/y1_的下标一一对应
+ * @note
+ * # clear()只清空数据、保留容量，跨帧复用同一对象时解码与NMS都不再分配内存
+ * # NMS的中间结果（排序、类别偏移后的坐标、抑制标记）也缓存在该对象中
+ */
+class NNDEPLOY_CC_API DetectCandidates {
+ public:
+  DetectCandidates();
+  ~DetectCandidates();
+
+  void clear();
+  void reserve(int n);
+  int size() const { return (int)score_.size(); }
+  void add(int label, float score, float x0, float y0, float x1, float y1) {
+    label_.push_back(label);
+    score_.push_back(score);
+    x0_.push_back(x0);
+    y0_.push_back(y0);
+    x1_.push_back(x1);
+    y1_.push_back(y1);
+  }
+
+  std::vector<int> label_;
+  std::vector<float> score_;
+  std::vector<float> x0_, y0_, x1_, y1_;
+
+  // NMS的工作区
+  std::shared_ptr<NMSBoxes> boxes_;
+};
+
+/**
+ * @brief 同computeBatchedNMS(const DetectResult &, ...)，候选框为SoA
+ *
+ * @param src 候选框，不要求有序
+ * @param keep_idxs 保留的框在src中的下标，按分数从高到低排列
+ * @note 不分配内存（src与keep_idxs的容量足够时）
+ */
+extern NNDEPLOY_CC_API base::Status computeBatchedNMS(
+    DetectCandidates &src, std::vector<int> &keep_idxs,
+    const float iou_threshold, int max_detections = -1,
+    bool class_agnostic = false);
+
+/**
+ * @brief soft-NMS，与保留框重叠的候选框衰减分数而不是直接删除
+ *
+ * @param src 候选框，保留框的score_会被更新为衰减后的分数
+ * @param keep_idxs 保留的框在src中的下标，按衰减后的分数从高到低排列
+ * @param iou_threshold kSoftNMSMethodLinear时的IoU阈值
+ * @param sigma kSoftNMSMethodGaussian时的参数
+ * @param score_threshold 分数衰减到该值以下的框被删除
+ * @param max_detections 保留的框数达到该值时提前结束，<=0表示不限制
+ * @param class_agnostic 为true时不区分类别
+ * @param method
+ * @return base::Status
+ */
+extern NNDEPLOY_CC_API base::Status computeSoftNMS(
+    DetectResult &src, std::vector<int> &keep_idxs, const float iou_threshold,
+    const float sigma, const float score_threshold, int max_detections = -1,
+    bool class_agnostic = false,
+    SoftNMSMethod method = kSoftNMSMethodGaussian);
+
 }  // namespace detect
 }  // namespace nndeploy
 
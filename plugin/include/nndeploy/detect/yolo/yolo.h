@@ -16,6 +16,7 @@
 #include "nndeploy/dag/graph.h"
 #include "nndeploy/dag/node.h"
 #include "nndeploy/detect/result.h"
+#include "nndeploy/detect/util.h"
 #include "nndeploy/device/buffer.h"
 #include "nndeploy/device/device.h"
 #include "nndeploy/device/memory_pool.h"
@@ -40,6 +41,9 @@ class NNDEPLOY_CC_API YoloPostParam : public base::Param {
   int model_w_;            // 模型输入图像的宽度
 
   int version_ = -1;  // YOLO模型的版本号，默认为-1表示未指定
+
+  int max_detections_ = -1;      // 每张图最多保留的检测框数量，-1表示不限制
+  bool class_agnostic_ = false;  // 为true时不同类别的框之间也做NMS
 };
 
 class NNDEPLOY_CC_API YoloPostProcess : public dag::Node {
@@ -58,10 +62,30 @@ class NNDEPLOY_CC_API YoloPostProcess : public dag::Node {
   }
   virtual ~YoloPostProcess() {}
 
+  /**
+   * @note
+   * # 先用SIMD求每个框所有类别的最大分数，低于阈值的框不再逐类别判断
+   * # 候选框写入SoA缓存后做NMS，缓存跨帧复用，稳态下只为输出分配一次内存
+   * # batch中的各张图在共享线程池上并行解码与NMS
+   */
   virtual base::Status run();
 
+  /**
+   * @brief 输出为[batch, anchors, 5 + num_classes]，分数为objectness * class
+   */
   base::Status runV5V6();
+  /**
+   * @brief 输出为[batch, 4 + num_classes, anchors]，直接按该布局解码，不做转置
+   */
   base::Status runV8V11();
+
+ private:
+  base::Status decode(bool channel_major);
+
+ private:
+  // 每张图一份，跨帧复用
+  std::vector<DetectCandidates> candidates_;
+  std::vector<std::vector<int>> keep_idxs_;
 };
 
 class NNDEPLOY_CC_API YoloGraph : public dag::Graph {
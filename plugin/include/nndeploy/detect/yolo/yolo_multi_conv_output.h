@@ -38,6 +38,8 @@ class NNDEPLOY_CC_API YoloMultiConvOutputPostParam : public base::Param {
   int num_classes_;
   int model_h_;
   int model_w_;
+  int max_detections_ = -1;
+  bool class_agnostic_ = false;
 
   int det_obj_len_ = 1;
   int det_bbox_len_ = 4;
@@ -34,6 +34,8 @@ class NNDEPLOY_CC_API YoloMultiOutputPostParam : public base::Param {
   int num_classes_;
   int model_h_;
   int model_w_;
+  int max_detections_ = -1;
+  bool class_agnostic_ = false;
 
   int anchors_stride_8[6] = {10, 13, 16, 30, 33, 23};    // [1, 3, 80, 80, 85]
   int anchors_stride_16[6] = {30, 61, 62, 45, 59, 119};  // [1, 3, 40, 40, 85]
@@ -44,6 +44,38 @@ class NNDEPLOY_CC_API Infer : public dag::Node {
 
   virtual std::shared_ptr<inference::Inference> getInference();
 
+  /**
+   * @brief 流水线并行时把多帧输入合并为一个batch推理，需在init之前设置
+   * @param max_batch_size 每次推理最多合并的batch，小于等于1时关闭
+   * @param max_wait_ms 收到第一帧后等待后续帧的最长时间
+   * @note
+   * # 推理框架需为动态输入或多batch模型（isBatch()），静态batch时最多合并模型的batch
+   * # 每次run会消费多帧输入，结果按帧拆分后以原有的index依次写入输出边，
+   *   因此只在每个节点常驻一个线程的ParallelPipelineExecutor下生效
+   *   (getDedicatedThreadFlag())，其他执行器下仍逐帧推理
+   */
+  void setBatching(int max_batch_size, int max_wait_ms);
+  int getMaxBatchSize();
+  int getMaxWaitMs();
+
+ private:
+  base::Status runBatch();
+  /**
+   * @brief 一帧的第i个输入能否拷贝到当前batch的第offset行
+   * @note 形状(除第0维)、数据类型与设备需与batch中已有的帧一致，且不超过容量
+   */
+  bool canGatherInput(int i, device::Tensor *tensor, int offset);
+  /**
+   * @brief 把一帧的第i个输入拷贝到合并后输入的第offset行
+   * @note 只在batch的第一帧(offset为0)时重新分配合并后的输入
+   */
+  base::Status gatherInput(int i, device::Tensor *tensor, int offset);
+  /**
+   * @brief 推理已合并的total行，并把输出按帧拆分写入输出边
+   */
+  base::Status runGatheredBatch(const std::vector<int> &indexs,
+                                const std::vector<int> &rows, int total);
+
  private:
   base::InferenceType type_;
   std::shared_ptr<inference::Inference> inference_ = nullptr;
@@ -55,6 +87,12 @@ class NNDEPLOY_CC_API Infer : public dag::Node {
   bool is_output_dynamic_ = false;
   bool can_op_input_ = false;
   bool can_op_output_ = false;
+
+  int max_batch_size_ = 1;
+  int max_wait_ms_ = 0;
+  int batch_capacity_ = 1;  // 每次推理最多合并的行数，为1时不合并
+  int batch_rows_ = 1;      // 合并后输入分配的行数，静态batch时为模型的batch
+  std::vector<device::Tensor *> batch_inputs_;
 };
 
 }  // namespace infer
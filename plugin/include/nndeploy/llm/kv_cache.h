@@ -0,0 +1,176 @@
+
+#ifndef _NNDEPLOY_LLM_KV_CACHE_H_
+#define _NNDEPLOY_LLM_KV_CACHE_H_
+
+#include "nndeploy/base/common.h"
+#include "nndeploy/base/glic_stl_include.h"
+#include "nndeploy/base/log.h"
+#include "nndeploy/base/macro.h"
+#include "nndeploy/base/status.h"
+#include "nndeploy/device/device.h"
+#include "nndeploy/device/tensor.h"
+
+namespace nndeploy {
+namespace llm {
+
+/**
+ * @brief attention_mask为float，position_ids为int，与EmbeddingNode一致
+ */
+struct NNDEPLOY_CC_API KVCacheConfig {
+  // past_key_values的形状，例如[layers, 2, 1, 0, heads, head_dim]，
+  // seq_axis_维的大小被忽略
+  base::IntVector shape_;
+  int batch_axis_ = 2;  // 只被KVCachePool使用
+  int seq_axis_ = 3;
+  int capacity_ = 0;             // 缓存的token数
+  bool sliding_window_ = false;  // 为true时写满后覆盖最早的token
+  base::DataType data_type_ = base::dataTypeOf<float>();
+  base::DataFormat data_format_ = base::DataFormat::kDataFormatS1D;
+};
+
+/**
+ * @brief 预分配的环形KV-cache
+ * @note
+ * # past_key_values按capacity_一次分配，形状固定，第p个token写入第p % capacity_个位置；
+ *   模型每次都看到capacity_个past位置，尚未写入的位置由attention_mask屏蔽，
+ *   因此每个token的解码开销不随上下文增长
+ * # 模型输出的presents中只拷贝新token对应的行，不拷贝整个past
+ * # attention_mask为[1, 1, seq_len, capacity_ + seq_len]，seq_len与上一次相同时
+ *   只更新新写入的位置；position_ids为token的绝对位置，不受环形覆盖的影响
+ * # 写满且sliding_window_为false时append返回错误
+ */
+class NNDEPLOY_CC_API KVCache {
+ public:
+  KVCache();
+  virtual ~KVCache();
+
+  base::Status init(const KVCacheConfig &config);
+  base::Status deinit();
+  /**
+   * @brief 清空缓存，不释放内存
+   */
+  void reset();
+
+  const KVCacheConfig &getConfig() const;
+
+  /**
+   * @brief 作为模型输入的past_key_values，由KVCache持有
+   */
+  device::Tensor *getPastKeyValues();
+  /**
+   * @brief 下一次append的seq_len个token的attention_mask，由KVCache持有
+   */
+  device::Tensor *getAttentionMask(int seq_len);
+  /**
+   * @brief 下一次append的seq_len个token的position_ids，由KVCache持有
+   */
+  device::Tensor *getPositionIds(int seq_len);
+
+  /**
+   * @brief 把presents中最后seq_len个位置写入缓存
+   *
+   * @param presents 模型的输出，除seq_axis_外的形状与past_key_values相同
+   * @param seq_len 新token的个数
+   * @return base::Status
+   */
+  base::Status append(device::Tensor *presents, int seq_len);
+
+  /**
+   * @brief 已处理的token数，即下一个token的位置
+   */
+  int getSeqLen() const;
+  /**
+   * @brief 缓存中有效的token数
+   */
+  int getCachedLen() const;
+  int getCapacity() const;
+  /**
+   * @brief past_key_values、attention_mask与position_ids占用的字节数
+   */
+  size_t getMemorySize() const;
+
+ private:
+  KVCacheConfig config_;
+  // seq_axis_之前与之后各维的乘积
+  size_t outer_ = 0;
+  size_t inner_ = 0;
+
+  device::Tensor *past_key_values_ = nullptr;
+  device::Tensor *attention_mask_ = nullptr;
+  device::Tensor *position_ids_ = nullptr;
+  int mask_seq_len_ = 0;  // attention_mask_当前对应的seq_len
+  int mask_cached_len_ = 0;
+
+  int seq_len_ = 0;
+};
+
+/**
+ * @brief 多个会话共享的KV-cache，每个会话占用batch_axis_上的一行(slot)
+ * @note
+ * # past_key_values为[layers, 2, max_batch, capacity_, heads, head_dim]，一次分配，
+ *   每个slot的写入方式与KVCache相同
+ * # 只用于decode，每个slot每次一个token：attention_mask为
+ *   [max_batch, 1, 1, capacity_ + 1]，position_ids为[max_batch, 1]；
+ *   空闲的slot只保留新token自身，避免softmax全被屏蔽
+ * # 要求batch_axis_ < seq_axis_
+ */
+class NNDEPLOY_CC_API KVCachePool {
+ public:
+  KVCachePool();
+  virtual ~KVCachePool();
+
+  base::Status init(const KVCacheConfig &config, int max_batch);
+  base::Status deinit();
+
+  /**
+   * @brief 分配一个空闲的slot，没有空闲时返回-1
+   */
+  int acquire();
+  void release(int slot);
+  int getMaxBatch() const;
+  int getNumOfFree() const;
+
+  const KVCacheConfig &getConfig() const;
+  device::Tensor *getPastKeyValues();
+  device::Tensor *getAttentionMask();
+  device::Tensor *getPositionIds();
+
+  /**
+   * @brief 把presents第batch_index行的最后seq_len个位置写入slot
+   */
+  base::Status append(int slot, device::Tensor *presents, int batch_index,
+                      int seq_len);
+
+  int getSeqLen(int slot) const;
+  int getCachedLen(int slot) const;
+  int getCapacity() const;
+  /**
+   * @brief 不滑动窗口且slot已写满
+   */
+  bool isFull(int slot) const;
+  size_t getMemorySize() const;
+
+ private:
+  void resetMaskRow(int slot);
+
+ private:
+  KVCacheConfig config_;
+  int max_batch_ = 0;
+  // batch_axis_之前、batch_axis_与seq_axis_之间、seq_axis_之后各维的乘积
+  size_t outer_ = 0;
+  size_t mid_ = 0;
+  size_t inner_ = 0;
+
+  device::Tensor *past_key_values_ = nullptr;
+  device::Tensor *attention_mask_ = nullptr;
+  device::Tensor *position_ids_ = nullptr;
+
+  std::vector<bool> used_;
+  std::vector<int> seq_len_;
+  std::vector<int> mask_cached_len_;
+};
+
+}  // namespace llm
+}  // namespace nndeploy
+
+#endif /* _NNDEPLOY_LLM_KV_CACHE_H_ */
@@ -20,6 +20,8 @@
 #include "nndeploy/device/device.h"
 #include "nndeploy/device/memory_pool.h"
 #include "nndeploy/device/tensor.h"
+#include "nndeploy/llm/kv_cache.h"
+#include "nndeploy/llm/sampler.h"
 #include "nndeploy/tokenizer/tokenizer.h"
 
 namespace nndeploy {
@@ -35,10 +37,21 @@ struct LlmConfig {
   std::string prompt_template_;
   std::string prompt_;
   std::vector<int32_t> kv_init_shape_;
+  // >0时使用预分配的环形KVCache，缓存kv_cache_len_个token
+  int kv_cache_len_ = 0;
+  // 为true时KVCache写满后丢弃最早的token，否则停止生成
+  bool kv_sliding_window_ = false;
 };
 
 LlmConfig parseConfig(const std::string& file_path);
 
+/**
+ * @brief 从tokenizer.txt读取special tokens与stop tokens
+ */
+bool loadStopTokens(const std::string& token_file,
+                    std::vector<int>& special_tokens,
+                    std::vector<int>& stop_tokens);
+
 #define NNDEPLOY_LLAMA2 "NNDEPLOY_LLAMA2"
 #define DELETE_POINTER(ptr) \
   if (ptr != nullptr) {     \
@@ -48,6 +61,7 @@ LlmConfig parseConfig(const std::string& file_path);
 
 class NNDEPLOY_CC_API SampleParam : public base::Param {
  public:
+  SampleParam() { sampler_config_.repetition_penalty_ = 1.1f; }
   ~SampleParam() {
     if (token_ids_ != nullptr) delete token_ids_;
     if (emb_node_ != nullptr) delete emb_node_;
@@ -59,6 +73,7 @@ class NNDEPLOY_CC_API SampleParam : public base::Param {
   bool is_prefill_;
   tokenizer::TokenizerIds history_ids_;
   tokenizer::TokenizerIds stop_tokens_;
+  SamplerConfig sampler_config_;  // 默认为greedy
 };
 
 class NNDEPLOY_CC_API PromptParam : public base::Param {
@@ -78,6 +93,8 @@ class NNDEPLOY_CC_API EmbeddingParam : public base::Param {
   bool is_prefill_ = true;
   std::string embedding_file_;
   device::Tensor* past_kv_;
+  // 不为nullptr时attention_mask、position_ids与past_key_values由KVCache提供
+  KVCache* kv_cache_ = nullptr;
   std::vector<std::vector<int32_t>> token_ids_;
   base::DataType data_type_ = base::dataTypeOf<float>();
   base::DataType posid_data_type_ = base::dataTypeOf<int>();
@@ -130,6 +147,7 @@ class NNDEPLOY_CC_API SampleNode : public dag::Node {
 
  protected:
   bool is_first_;
+  Sampler sampler_;
 };
 
 class NNDEPLOY_CC_API PromptNode : public dag::Node {
@@ -186,11 +204,13 @@ class NNDEPLOY_CC_API LlmPrefillGraph : public dag::Graph {
     DELETE_POINTER(prefill_out_ids_);
     DELETE_POINTER(past_kv_);
     DELETE_POINTER(history_ids_);
+    DELETE_POINTER(kv_cache_);
   }
   virtual base::Status run();
 
  protected:
   void genPastKeyValue();
+  void genKVCache(LlmConfig& config);
   void createPrefillNodesEdges();
   void setParams(bool is_path, base::ModelType model_type,
                   base::DeviceType device_type, LlmConfig& model_value);
@@ -211,6 +231,7 @@ class NNDEPLOY_CC_API LlmPrefillGraph : public dag::Graph {
   dag::Edge* prefill_out_ids_;
 
   device::Tensor* past_kv_ = nullptr;
+  KVCache* kv_cache_ = nullptr;  // 与decode图共享
   tokenizer::TokenizerIds* history_ids_;
   base::InferenceType inference_type_;
   base::IntVector kv_init_shape_;
@@ -264,6 +285,10 @@ class NNDEPLOY_CC_API LlmDecodeGraph : public dag::Loop {
   void createPrefillNodesEdges();
   void setParams(bool is_path, base::ModelType model_type,
                   base::DeviceType device_type, LlmConfig& config);
+  /**
+   * @brief 使用prefill图的KVCache，kv_cache由prefill图持有
+   */
+  void setKVCache(KVCache* kv_cache);
 
  protected:
   void getStopTokens(std::string& token_file);
@@ -300,6 +325,7 @@ class NNDEPLOY_CC_API LlmDecodeGraph : public dag::Loop {
   dag::Edge* decode_out_words_;
 
   device::Tensor* past_kv_;
+  KVCache* kv_cache_ = nullptr;
   tokenizer::TokenizerIds* history_ids_;
 
   base::InferenceType inference_type_;
@@ -0,0 +1,99 @@
+
+#ifndef _NNDEPLOY_LLM_SAMPLER_H_
+#define _NNDEPLOY_LLM_SAMPLER_H_
+
+#include "nndeploy/base/common.h"
+#include "nndeploy/base/glic_stl_include.h"
+#include "nndeploy/base/log.h"
+#include "nndeploy/base/macro.h"
+#include "nndeploy/base/status.h"
+
+namespace nndeploy {
+namespace llm {
+
+/**
+ * @brief 采样参数，各项的作用顺序与transformers一致：
+ * repetition penalty -> temperature -> top-k -> top-p -> min-p
+ */
+struct NNDEPLOY_CC_API SamplerConfig {
+  float temperature_ = 0.0f;         // <=0时为greedy
+  int top_k_ = 0;                    // <=0时不限制
+  float top_p_ = 1.0f;               // >=1时不限制
+  float min_p_ = 0.0f;               // 概率低于min_p_ * 最大概率的token被删除
+  float repetition_penalty_ = 1.0f;  // 1.0时不惩罚
+  uint64_t seed_ = 0;
+};
+
+/**
+ * @brief 从一行logits中采样下一个token
+ * @note
+ * # 最大值、softmax的exp与求和用SSE/NEON计算
+ * # top-k用大小为k的堆选出，top-p按logit分桶统计概率之和，只对阈值以上的桶排序；
+ *   min-p先于top-p过滤，两者都不对整个词表排序
+ * # 重复惩罚按历史token去重，去重标记、候选下标与概率都缓存在对象中，
+ *   词表大小不变时每个token不再分配内存
+ * # 随机数由seed_初始化，相同的seed_与输入得到相同的采样序列
+ */
+class NNDEPLOY_CC_API Sampler {
+ public:
+  Sampler();
+  explicit Sampler(const SamplerConfig &config);
+  virtual ~Sampler();
+
+  /**
+   * @brief seed_变化时重新初始化随机数生成器
+   */
+  void setConfig(const SamplerConfig &config);
+  const SamplerConfig &getConfig() const;
+  void setSeed(uint64_t seed);
+
+  /**
+   * @brief 采样一个token
+   *
+   * @param logits [vocab_size]，会被原地施加重复惩罚
+   * @param vocab_size
+   * @param history_ids 已生成的token，用于重复惩罚
+   * @return int32_t 采样得到的token，vocab_size <= 0时返回-1
+   */
+  int32_t sample(float *logits, int vocab_size,
+                 const std::vector<int32_t> &history_ids);
+
+  /**
+   * @brief 最大值的下标，多个最大值时取第一个
+   */
+  static int32_t argmax(const float *logits, int vocab_size);
+
+ private:
+  void applyRepetitionPenalty(float *logits, int vocab_size,
+                              const std::vector<int32_t> &history_ids);
+  /**
+   * @brief logit最大的k个token写入candidates[0, k)，不排序
+   */
+  int selectTopK(const float *logits, int vocab_size, int k,
+                 int32_t *candidates);
+  /**
+   * @brief candidates[0, n)按概率从高到低排序后，保留概率之和达到target的最短前缀
+   * @return 保留的个数，sum更新为保留的概率之和
+   */
+  int selectTopP(const float *logits, float max_logit, float scale,
+                 const float *probs, float target, int32_t *candidates, int n,
+                 float &sum);
+  /**
+   * @brief 按概率从候选中采样，candidates为nullptr时候选为[0, n)
+   */
+  int32_t pick(const float *probs, const int32_t *candidates, int n,
+               float sum);
+
+ private:
+  SamplerConfig config_;
+  std::mt19937_64 rng_;
+
+  std::vector<uint8_t> seen_;
+  std::vector<int32_t> candidates_;
+  std::vector<float> probs_;
+};
+
+}  // namespace llm
+}  // namespace nndeploy
+
+#endif /* _NNDEPLOY_LLM_SAMPLER_H_ */
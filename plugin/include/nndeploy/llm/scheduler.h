@@ -0,0 +1,169 @@
+
+#ifndef _NNDEPLOY_LLM_SCHEDULER_H_
+#define _NNDEPLOY_LLM_SCHEDULER_H_
+
+#include "nndeploy/base/common.h"
+#include "nndeploy/base/glic_stl_include.h"
+#include "nndeploy/base/log.h"
+#include "nndeploy/base/macro.h"
+#include "nndeploy/base/status.h"
+#include "nndeploy/device/device.h"
+#include "nndeploy/device/tensor.h"
+#include "nndeploy/inference/inference.h"
+#include "nndeploy/llm/kv_cache.h"
+#include "nndeploy/llm/llama2.h"
+#include "nndeploy/llm/sampler.h"
+
+namespace nndeploy {
+namespace llm {
+
+enum LlmSessionState : int {
+  kLlmSessionStateWaiting = 0x0000,
+  kLlmSessionStateDecoding,
+  kLlmSessionStateFinished,
+  kLlmSessionStateFailed,
+};
+
+struct NNDEPLOY_CC_API LlmSessionParam {
+  LlmSessionParam() { sampler_config_.repetition_penalty_ = 1.1f; }
+
+  SamplerConfig sampler_config_;      // 默认为greedy，与SampleParam一致
+  std::vector<int32_t> stop_tokens_;  // 为空时使用tokenizer_txt中的stop tokens
+  int max_new_tokens_ = 256;
+};
+
+/**
+ * @brief 一个对话请求
+ * @note 除state_外的成员由调度线程修改，只能在token回调中或结束后读取
+ */
+class NNDEPLOY_CC_API LlmSession {
+ public:
+  LlmSession(int id, const std::vector<int32_t> &prompt_ids,
+             const LlmSessionParam &param);
+  virtual ~LlmSession();
+
+  bool isDone() const;
+
+ public:
+  int id_;
+  std::atomic<LlmSessionState> state_;
+  LlmSessionParam param_;
+  Sampler sampler_;
+  std::vector<int32_t> prompt_ids_;
+  std::vector<int32_t> history_ids_;  // prompt与生成的token，用于重复惩罚
+  std::vector<int32_t> output_ids_;   // 生成的token，不含stop token
+  int slot_ = -1;                     // KVCachePool中的slot
+  int32_t next_token_ = -1;           // 下一步decode的输入
+};
+
+/**
+ * @brief 每生成一个token调用一次，在调度线程中执行
+ */
+using LlmTokenCallback =
+    std::function<void(LlmSession *session, int32_t token)>;
+
+struct NNDEPLOY_CC_API LlmSchedulerParam {
+  int max_batch_ = 4;  // 同时decode的会话数
+  // 每个step最多prefill的会话数，限制新请求对正在decode的会话的延迟影响
+  int max_prefill_per_step_ = 1;
+};
+
+/**
+ * @brief 多会话连续批处理(continuous batching)
+ * @note
+ * # 每个会话在KVCachePool中占用一行，会话结束后立即释放，等待中的请求在下一个
+ *   step被接纳，不需要等整个batch结束
+ * # step：先对新接纳的会话逐个prefill(batch为1)，再把所有decode中的会话的
+ *   一个token合并为一次推理
+ * # 每个会话有独立的采样参数、随机数、stop tokens与最大生成长度
+ * # 模型需要以动态batch导出：inputs_embeds为[seq_len, batch, hidden]，
+ *   attention_mask为[batch, 1, seq_len, kv_seq_len]，position_ids为
+ *   [batch, seq_len]，past_key_values与presents在第2维为batch
+ * # addSession与getSession可以在其他线程调用，step与run只能在一个线程调用
+ */
+class NNDEPLOY_CC_API LlmSessionScheduler {
+ public:
+  LlmSessionScheduler();
+  virtual ~LlmSessionScheduler();
+
+  /**
+   * @brief kv_cache_len_为0时每个会话缓存max_seq_len_个token
+   */
+  base::Status init(const LlmConfig &config, const LlmSchedulerParam &param,
+                    base::InferenceType inference_type,
+                    base::DeviceType device_type, base::ModelType model_type,
+                    bool is_path);
+  base::Status deinit();
+
+  void setTokenCallback(LlmTokenCallback callback);
+
+  /**
+   * @brief 添加一个请求
+   * @return 会话id，失败时返回-1
+   */
+  int addSession(const std::vector<int32_t> &prompt_ids,
+                 const LlmSessionParam &param = LlmSessionParam());
+  std::shared_ptr<LlmSession> getSession(int id);
+  /**
+   * @brief 删除已结束的会话
+   */
+  void removeSession(int id);
+
+  /**
+   * @brief 是否有等待或decode中的会话
+   */
+  bool hasWork();
+  /**
+   * @brief 接纳等待中的请求并prefill，再做一次批量decode
+   */
+  base::Status step();
+  /**
+   * @brief 反复step直到没有等待或decode中的会话
+   */
+  base::Status run();
+
+  const KVCachePool &getKVCachePool() const;
+
+ private:
+  base::Status prefill(LlmSession *session);
+  base::Status decode();
+  /**
+   * @brief 采样并检查结束条件，返回会话是否结束
+   */
+  bool sampleToken(LlmSession *session, float *logits, int vocab_size);
+  void finish(LlmSession *session, LlmSessionState state);
+
+  base::Status runInference(inference::Inference *inference,
+                            const std::vector<device::Tensor *> &inputs,
+                            device::Tensor *&logits,
+                            device::Tensor *&presents);
+  void readEmbedding(int32_t token, float *dst);
+
+ private:
+  LlmSchedulerParam param_;
+  base::DeviceType device_type_;
+  int hidden_size_ = 0;
+  std::vector<int32_t> stop_tokens_;
+  FILE *embedding_file_ = nullptr;
+  std::vector<int16_t> embedding_buffer_;
+
+  std::shared_ptr<inference::Inference> prefill_inference_;
+  std::shared_ptr<inference::Inference> decode_inference_;
+  KVCachePool kv_cache_pool_;
+  device::Tensor *prefill_past_kv_ = nullptr;  // seq_len为0的past_key_values
+  device::Tensor *decode_embeds_ = nullptr;    // [1, max_batch, hidden]
+
+  LlmTokenCallback callback_;
+
+  std::mutex mutex_;
+  int next_id_ = 0;
+  std::deque<std::shared_ptr<LlmSession>> waiting_;
+  std::map<int, std::shared_ptr<LlmSession>> sessions_;
+  // 按slot索引，空闲的slot为nullptr，只由调度线程访问
+  std::vector<std::shared_ptr<LlmSession>> running_;
+};
+
+}  // namespace llm
+}  // namespace nndeploy
+
+#endif /* _NNDEPLOY_LLM_SCHEDULER_H_ */
@@ -0,0 +1,82 @@
+
+#ifndef _NNDEPLOY_PREPROCESS_FUSED_PREPROCESS_H_
+#define _NNDEPLOY_PREPROCESS_FUSED_PREPROCESS_H_
+
+#include "nndeploy/base/common.h"
+#include "nndeploy/base/glic_stl_include.h"
+#include "nndeploy/base/log.h"
+#include "nndeploy/base/macro.h"
+#include "nndeploy/base/status.h"
+#include "nndeploy/base/type.h"
+#include "nndeploy/device/tensor.h"
+
+namespace nndeploy {
+namespace preprocess {
+
+/**
+ * @brief 融合前处理的参数
+ * @note
+ * # 目标像素(x, y)在源图像上的采样坐标为
+ *   (x * scale_x_ + offset_x_, y * scale_y_ + offset_y_)，双线性插值
+ * # [roi_x_, roi_x_ + roi_w_) x [roi_y_, roi_y_ + roi_h_)之外的目标像素取border_val_，
+ *   之内超出源图像的采样点复制边缘像素
+ * # 输出 = 颜色转换后的像素值 * mul_[c] + add_[c]，c为目标通道；
+ *   border_val_同样是目标通道顺序的像素值
+ */
+struct NNDEPLOY_CC_API FusedPreprocessParam {
+  base::PixelType src_pixel_type_ = base::kPixelTypeBGR;
+  base::PixelType dst_pixel_type_ = base::kPixelTypeRGB;
+
+  float scale_x_ = 1.0f;
+  float offset_x_ = 0.0f;
+  float scale_y_ = 1.0f;
+  float offset_y_ = 0.0f;
+
+  int roi_x_ = 0;
+  int roi_y_ = 0;
+  int roi_w_ = -1;  // -1表示到目标图像的边界
+  int roi_h_ = -1;
+  float border_val_[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+  float mul_[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+  float add_[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+  /**
+   * @brief 把src_w x src_h的图像缩放到目标图像的roi区域，与cv::resize的像素中心对齐方式一致
+   */
+  void setResize(int src_w, int src_h, int roi_x, int roi_y, int roi_w,
+                 int roi_h);
+  /**
+   * @brief 按scale / std和-mean / std设置mul_和add_，与OpenCvConvert::normalize一致
+   */
+  void setNormalize(const float *scale, const float *mean, const float *std);
+};
+
+/**
+ * @brief 单次遍历完成 cvtColor + 双线性resize(及平移/填充) + normalize + HWC->CHW
+ * @note
+ * # 源图像为uint8的GRAY/RGB/BGR/RGBA/BGRA，行间距为src_stride字节
+ * # 输出为fp32/fp16的NCHW/NHWC tensor，直接写入dst，不产生中间图像
+ * # 颜色转换与归一化都是线性变换，先插值再转换与先转换再插值的结果相同
+ * # 逐行缓存水平插值的结果，每一行源图像只读取一次；按输出的行分块并行
+ * # x86上运行时检测avx2，arm上使用neon，其余平台为标量实现
+ */
+class NNDEPLOY_CC_API FusedPreprocess {
+ public:
+  /**
+   * @brief 是否支持该组合，不支持时由调用方回退到opencv的实现
+   */
+  static bool isSupport(base::PixelType src_pixel_type,
+                        base::PixelType dst_pixel_type,
+                        base::InterpType interp_type, base::DataType data_type,
+                        base::DataFormat data_format);
+
+  static base::Status run(const uint8_t *src, int src_h, int src_w,
+                          int src_stride, const FusedPreprocessParam &param,
+                          device::Tensor *dst);
+};
+
+}  // namespace preprocess
+}  // namespace nndeploy
+
+#endif /* _NNDEPLOY_PREPROCESS_FUSED_PREPROCESS_H_ */
@@ -22,6 +22,7 @@
 #include "nndeploy/device/device.h"
 #include "nndeploy/device/memory_pool.h"
 #include "nndeploy/device/tensor.h"
+#include "nndeploy/op/op_cache.h"
 #include "nndeploy/preprocess/convert_to.h"
 #include "nndeploy/stable_diffusion/scheduler.h"
 #include "nndeploy/stable_diffusion/type.h"
@@ -63,6 +64,9 @@ class NNDEPLOY_CC_API DDIMScheduler : public Scheduler {
 
   std::vector<float> timesteps_;  // 时间步序列
   std::vector<float> variance_;   // 方差
+
+ protected:
+  op::TensorArena arena_;  // step中的噪声
 };
 
 }  // namespace stable_diffusion
@@ -0,0 +1,95 @@
+
+#ifndef _NNDEPLOY_MODEL_STABLE_DIFFUSION_DPM_SOLVER_SCHEDULER_H_
+#define _NNDEPLOY_MODEL_STABLE_DIFFUSION_DPM_SOLVER_SCHEDULER_H_
+
+#include <random>
+
+#include "nndeploy/base/any.h"
+#include "nndeploy/base/common.h"
+#include "nndeploy/base/glic_stl_include.h"
+#include "nndeploy/base/log.h"
+#include "nndeploy/base/macro.h"
+#include "nndeploy/base/object.h"
+#include "nndeploy/base/opencv_include.h"
+#include "nndeploy/base/param.h"
+#include "nndeploy/base/status.h"
+#include "nndeploy/base/string.h"
+#include "nndeploy/dag/edge.h"
+#include "nndeploy/dag/graph.h"
+#include "nndeploy/dag/loop.h"
+#include "nndeploy/dag/node.h"
+#include "nndeploy/device/buffer.h"
+#include "nndeploy/device/device.h"
+#include "nndeploy/device/memory_pool.h"
+#include "nndeploy/device/tensor.h"
+#include "nndeploy/preprocess/convert_to.h"
+#include "nndeploy/stable_diffusion/scheduler.h"
+#include "nndeploy/stable_diffusion/type.h"
+
+namespace nndeploy {
+namespace stable_diffusion {
+
+/**
+ * @brief DPM-Solver++ 2M(多步二阶)调度器
+ * @note
+ * # https://arxiv.org/abs/2211.01095，对应diffusers中
+ *   algorithm_type="dpmsolver++"的DPMSolverMultistepScheduler
+ * # 20步左右即可达到DDIM 50步的质量
+ * # use_karras_sigmas_时(默认，即DPM++ 2M Karras)sigma从时间步
+ *   num_train_timesteps - 1的sigma按Karras的方式取到时间步0的sigma，
+ *   时间步由sigma反推，可以是小数，终点的sigma为0
+ * # 否则时间步按linspace从num_train_timesteps - 1均匀取到0，终点的sigma为
+ *   时间步0的sigma，set_alpha_to_one_时为0
+ * # 终点的sigma为0时最后一步只能用一阶，直接得到预测的x0
+ * # lower_order_final且步数少于15时最后一步用一阶
+ * # 二阶更新需要上一步的x0，保存在history_中，每一步由fusedSchedulerStep
+ *   一次遍历读出上一步的x0并写入这一步的x0
+ * # 支持solver_order_为1/2，solver_type_为midpoint/heun，
+ *   不支持thresholding_
+ */
+class NNDEPLOY_CC_API DPMSolverScheduler : public Scheduler {
+ public:
+  DPMSolverScheduler(SchedulerType scheduler_type);
+  virtual ~DPMSolverScheduler();
+
+  virtual base::Status init();
+  virtual base::Status deinit();
+
+  virtual base::Status setTimesteps();
+
+  virtual device::Tensor *scaleModelInput(device::Tensor *sample, int index);
+
+  virtual base::Status configure();
+
+  /**
+   * @note 没有随机项，忽略eta/use_clipped_model_output/generator/
+   *  variance_noise；idx与上一次调用的idx不连续时从一阶重新开始
+   */
+  virtual base::Status step(device::Tensor *output, device::Tensor *sample,
+                            int idx, float timestep, float eta = 0,
+                            bool use_clipped_model_output = false,
+                            std::mt19937 generator = std::mt19937(),
+                            device::Tensor *variance_noise = nullptr);
+
+  virtual base::Status addNoise(device::Tensor *init_latents,
+                                device::Tensor *noise, int idx,
+                                int latent_timestep);
+
+  virtual std::vector<float> &getTimestep();
+
+ public:
+  std::vector<float> alphas_cumprod_;  // alpha的累积乘积
+
+  std::vector<float> timesteps_;  // 时间步序列
+  // sigma = sqrt((1 - α) / α)，比timesteps_多一个末尾的0
+  std::vector<float> sigmas_;
+
+ protected:
+  device::Tensor *history_ = nullptr;  // 上一步的x0，fp32
+  int last_idx_ = -1;                  // 上一次step的idx
+};
+
+}  // namespace stable_diffusion
+}  // namespace nndeploy
+
+#endif
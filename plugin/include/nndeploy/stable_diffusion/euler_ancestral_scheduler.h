@@ -0,0 +1,96 @@
+
+#ifndef _NNDEPLOY_MODEL_STABLE_DIFFUSION_EULER_ANCESTRAL_SCHEDULER_H_
+#define _NNDEPLOY_MODEL_STABLE_DIFFUSION_EULER_ANCESTRAL_SCHEDULER_H_
+
+#include <random>
+
+#include "nndeploy/base/any.h"
+#include "nndeploy/base/common.h"
+#include "nndeploy/base/glic_stl_include.h"
+#include "nndeploy/base/log.h"
+#include "nndeploy/base/macro.h"
+#include "nndeploy/base/object.h"
+#include "nndeploy/base/opencv_include.h"
+#include "nndeploy/base/param.h"
+#include "nndeploy/base/status.h"
+#include "nndeploy/base/string.h"
+#include "nndeploy/dag/edge.h"
+#include "nndeploy/dag/graph.h"
+#include "nndeploy/dag/loop.h"
+#include "nndeploy/dag/node.h"
+#include "nndeploy/device/buffer.h"
+#include "nndeploy/device/device.h"
+#include "nndeploy/device/memory_pool.h"
+#include "nndeploy/device/tensor.h"
+#include "nndeploy/op/op_cache.h"
+#include "nndeploy/preprocess/convert_to.h"
+#include "nndeploy/stable_diffusion/scheduler.h"
+#include "nndeploy/stable_diffusion/type.h"
+
+namespace nndeploy {
+namespace stable_diffusion {
+
+/**
+ * @brief Euler ancestral调度器
+ * @note
+ * # 对应k-diffusion中的sample_euler_ancestral与diffusers中的
+ *   EulerAncestralDiscreteScheduler，20~30步即可得到较好的结果
+ * # 时间步按linspace从num_train_timesteps - 1均匀取到0(可以是小数)，
+ *   sigma在整数时间步之间线性插值
+ * # 模型输入需要经过scaleModelInput缩放，初始噪声需要乘以getInitNoiseSigma()
+ * # 每一步都加入新的噪声，与eta无关
+ */
+class NNDEPLOY_CC_API EulerAncestralScheduler : public Scheduler {
+ public:
+  EulerAncestralScheduler(SchedulerType scheduler_type);
+  virtual ~EulerAncestralScheduler();
+
+  virtual base::Status init();
+  virtual base::Status deinit();
+
+  virtual base::Status setTimesteps();
+
+  /**
+   * @brief sample / sqrt(sigma^2 + 1)
+   * @note 返回的张量由调度器持有，在下一次scaleModelInput或deinit之前有效
+   */
+  virtual device::Tensor *scaleModelInput(device::Tensor *sample, int index);
+
+  virtual base::Status configure();
+
+  /**
+   * @note variance_noise为nullptr时由generator与idx生成噪声
+   */
+  virtual base::Status step(device::Tensor *output, device::Tensor *sample,
+                            int idx, float timestep, float eta = 0,
+                            bool use_clipped_model_output = false,
+                            std::mt19937 generator = std::mt19937(),
+                            device::Tensor *variance_noise = nullptr);
+
+  /**
+   * @brief init_latents = init_latents + sigma * noise
+   */
+  virtual base::Status addNoise(device::Tensor *init_latents,
+                                device::Tensor *noise, int idx,
+                                int latent_timestep);
+
+  virtual std::vector<float> &getTimestep();
+
+  virtual float getInitNoiseSigma();
+
+ public:
+  std::vector<float> alphas_cumprod_;  // alpha的累积乘积
+
+  std::vector<float> timesteps_;  // 时间步序列
+  // sigma = sqrt((1 - α) / α)，比timesteps_多一个末尾的0
+  std::vector<float> sigmas_;
+
+ protected:
+  op::TensorArena input_arena_;  // scaleModelInput的输出
+  op::TensorArena noise_arena_;  // step中的噪声
+};
+
+}  // namespace stable_diffusion
+}  // namespace nndeploy
+
+#endif
@@ -53,6 +53,7 @@ class NNDEPLOY_CC_API SchedulerParam : public base::Param {
   std::string algorithm_type_ = "dpmsolver++";
   std::string solver_type_ = "midpoint";
   bool lower_order_final = true;
+  bool use_karras_sigmas_ = true;  // sigma按Karras et al. (2022)的方式取值
 };
 
 class NNDEPLOY_CC_API Scheduler {
@@ -134,6 +135,13 @@ class NNDEPLOY_CC_API Scheduler {
    */
   virtual std::vector<float> &getTimestep() = 0;
 
+  /**
+   * @brief 初始噪声的标准差，initializeLatents中用于缩放初始噪声
+   *
+   * @return float
+   */
+  virtual float getInitNoiseSigma() { return 1.0f; }
+
  protected:
   SchedulerType scheduler_type_ = kSchedulerTypeNotSupport;
   SchedulerParam *scheduler_param_;
@@ -199,6 +207,15 @@ extern NNDEPLOY_CC_API Scheduler *createScheduler(SchedulerType type);
 void customLinspace(float start, float end, int steps,
                     std::vector<float> &values);
 
+/**
+ * @brief scaled_linear的beta调度下alpha的累积乘积
+ *
+ * @param param
+ * @param alphas_cumprod
+ */
+void getAlphasCumprod(SchedulerParam *param,
+                      std::vector<float> &alphas_cumprod);
+
 /**
  * @brief
  *
@@ -210,6 +227,49 @@ void customLinspace(float start, float end, int steps,
 base::Status initializeLatents(std::mt19937 &generator, float init_noise_sigma,
                                device ::Tensor *latents);
 
+/**
+ * @brief 调度器一步的系数，各调度器的step都可以写成如下的逐元素计算
+ *  x0 = clamp(x0_sample * sample + x0_model * model_output, clip_min, clip_max)
+ *  eps = eps_sample * sample + eps_model * model_output + eps_x0 * x0
+ *  sample = out_sample * sample + out_x0 * x0 + out_eps * eps +
+ *           out_history * history + out_noise * noise
+ *  history = x0
+ */
+struct NNDEPLOY_CC_API SchedulerStepCoeff {
+  float x0_sample_ = 0.0f;
+  float x0_model_ = 0.0f;
+  float clip_min_ = -std::numeric_limits<float>::infinity();
+  float clip_max_ = std::numeric_limits<float>::infinity();
+  float eps_sample_ = 0.0f;
+  float eps_model_ = 0.0f;
+  float eps_x0_ = 0.0f;
+  float out_sample_ = 0.0f;
+  float out_x0_ = 0.0f;
+  float out_eps_ = 0.0f;
+  float out_history_ = 0.0f;
+  float out_noise_ = 0.0f;
+};
+
+/**
+ * @brief 融合的step，一次遍历完成整步计算，不产生临时张量
+ *
+ * @param coeff
+ * @param model_output 模型输出，不被修改
+ * @param sample 输入x_t，原地更新为x_t-1
+ * @param history 不为nullptr时先读出上一步的x0，再写入这一步的x0
+ * @param noise 为nullptr时忽略out_noise_
+ * @return base::Status
+ * @note
+ * # 张量须在host上且元素数相同，支持fp32/fp16/bf16，各张量的类型可以不同，
+ *   非fp32的张量按块转为fp32计算
+ * # 按段划分任务，通过thread_pool::parallelFor多线程执行
+ */
+base::Status fusedSchedulerStep(const SchedulerStepCoeff &coeff,
+                                device::Tensor *model_output,
+                                device::Tensor *sample,
+                                device::Tensor *history = nullptr,
+                                device::Tensor *noise = nullptr);
+
 }  // namespace stable_diffusion
 }  // namespace nndeploy
 
@@ -1,6 +1,15 @@
 
 #include "nndeploy/detect/util.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define NNDEPLOY_DETECT_NMS_SSE
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define NNDEPLOY_DETECT_NMS_NEON
+#endif
+
 namespace nndeploy {
 namespace detect {
 
@@ -146,5 +155,356 @@ base::Status fastNMS(const DetectResult &src, std::vector<int> &keep_idxs,
   return base::kStatusCodeOk;
 }
 
+/**
+ * @brief 按分数从高到低排列的SoA候选框，坐标已加上类别偏移
+ */
+struct NMSBoxes {
+  std::vector<int> order_;  // 在src中的下标
+  std::vector<float> score_;
+  std::vector<float> x0_, y0_, x1_, y1_;
+  std::vector<float> area_;
+  std::vector<int32_t> suppressed_;
+
+  /**
+   * @brief order_按分数从高到低排列，分数相同时保持在src中的顺序
+   * @note 与std::stable_sort结果相同，但std::sort不申请临时内存
+   */
+  void sortByScore(int n, const float *score) {
+    order_.resize(n);
+    for (int i = 0; i < n; ++i) {
+      order_[i] = i;
+    }
+    std::sort(order_.begin(), order_.end(), [score](int a, int b) {
+      if (score[a] != score[b]) {
+        return score[a] > score[b];
+      }
+      return a < b;
+    });
+  }
+
+  void resize(int n) {
+    score_.resize(n);
+    x0_.resize(n);
+    y0_.resize(n);
+    x1_.resize(n);
+    y1_.resize(n);
+    area_.resize(n);
+  }
+
+  void set(int i, int label, float score, float step, float x0, float y0,
+           float x1, float y1) {
+    float offset = step * label;
+    score_[i] = score;
+    x0_[i] = x0 + offset;
+    y0_[i] = y0 + offset;
+    x1_[i] = x1 + offset;
+    y1_[i] = y1 + offset;
+    // 面积用未偏移的坐标计算，避免精度损失；非法框面积为0
+    area_[i] = std::max(x1 - x0, 0.0f) * std::max(y1 - y0, 0.0f);
+  }
+
+  void init(const DetectResult &src, bool class_agnostic) {
+    int n = src.bboxs_.size();
+    score_.resize(n);
+    for (int i = 0; i < n; ++i) {
+      score_[i] = src.bboxs_[i].score_;
+    }
+    sortByScore(n, score_.data());
+
+    // 不同类别的框平移到互不重叠的区域
+    float min_coord = 0.0f, max_coord = 0.0f;
+    for (const auto &bbox : src.bboxs_) {
+      for (int k = 0; k < 4; ++k) {
+        min_coord = std::min(min_coord, bbox.bbox_[k]);
+        max_coord = std::max(max_coord, bbox.bbox_[k]);
+      }
+    }
+    float step = class_agnostic ? 0.0f : max_coord - min_coord + 1.0f;
+
+    resize(n);
+    for (int i = 0; i < n; ++i) {
+      const DetectBBoxResult &bbox = src.bboxs_[order_[i]];
+      set(i, bbox.label_id_, bbox.score_, step, bbox.bbox_[0], bbox.bbox_[1],
+          bbox.bbox_[2], bbox.bbox_[3]);
+    }
+  }
+
+  void init(const DetectCandidates &src, bool class_agnostic) {
+    int n = src.size();
+    sortByScore(n, src.score_.data());
+
+    float min_coord = 0.0f, max_coord = 0.0f;
+    for (int i = 0; i < n; ++i) {
+      min_coord = std::min(min_coord, std::min(src.x0_[i], src.y0_[i]));
+      min_coord = std::min(min_coord, std::min(src.x1_[i], src.y1_[i]));
+      max_coord = std::max(max_coord, std::max(src.x0_[i], src.y0_[i]));
+      max_coord = std::max(max_coord, std::max(src.x1_[i], src.y1_[i]));
+    }
+    float step = class_agnostic ? 0.0f : max_coord - min_coord + 1.0f;
+
+    resize(n);
+    for (int i = 0; i < n; ++i) {
+      int k = order_[i];
+      set(i, src.label_[k], src.score_[k], step, src.x0_[k], src.y0_[k],
+          src.x1_[k], src.y1_[k]);
+    }
+  }
+
+  void swap(int i, int j) {
+    std::swap(order_[i], order_[j]);
+    std::swap(score_[i], score_[j]);
+    std::swap(x0_[i], x0_[j]);
+    std::swap(y0_[i], y0_[j]);
+    std::swap(x1_[i], x1_[j]);
+    std::swap(y1_[i], y1_[j]);
+    std::swap(area_[i], area_[j]);
+  }
+};
+
+namespace {
+
+/**
+ * @brief 第i个框与[begin, end)中框的IoU大于iou_threshold时标记为抑制
+ * @note 用inter > iou_threshold * union判断，避免除法
+ */
+void suppressByIoU(const NMSBoxes &boxes, int i, int begin, int end,
+                   float iou_threshold, int32_t *suppressed) {
+  const float bx0 = boxes.x0_[i], by0 = boxes.y0_[i];
+  const float bx1 = boxes.x1_[i], by1 = boxes.y1_[i];
+  const float barea = boxes.area_[i];
+  const float *x0 = boxes.x0_.data(), *y0 = boxes.y0_.data();
+  const float *x1 = boxes.x1_.data(), *y1 = boxes.y1_.data();
+  const float *area = boxes.area_.data();
+  int j = begin;
+#if defined(NNDEPLOY_DETECT_NMS_SSE)
+  const __m128 vbx0 = _mm_set1_ps(bx0), vby0 = _mm_set1_ps(by0);
+  const __m128 vbx1 = _mm_set1_ps(bx1), vby1 = _mm_set1_ps(by1);
+  const __m128 vbarea = _mm_set1_ps(barea);
+  const __m128 vthreshold = _mm_set1_ps(iou_threshold);
+  const __m128 vzero = _mm_setzero_ps();
+  for (; j + 4 <= end; j += 4) {
+    __m128 w = _mm_sub_ps(_mm_min_ps(vbx1, _mm_loadu_ps(x1 + j)),
+                          _mm_max_ps(vbx0, _mm_loadu_ps(x0 + j)));
+    __m128 h = _mm_sub_ps(_mm_min_ps(vby1, _mm_loadu_ps(y1 + j)),
+                          _mm_max_ps(vby0, _mm_loadu_ps(y0 + j)));
+    __m128 inter = _mm_mul_ps(_mm_max_ps(w, vzero), _mm_max_ps(h, vzero));
+    __m128 uni = _mm_sub_ps(_mm_add_ps(vbarea, _mm_loadu_ps(area + j)), inter);
+    __m128 mask = _mm_cmpgt_ps(inter, _mm_mul_ps(vthreshold, uni));
+    __m128i *dst = (__m128i *)(suppressed + j);
+    _mm_storeu_si128(dst, _mm_or_si128(_mm_loadu_si128(dst),
+                                       _mm_castps_si128(mask)));
+  }
+#elif defined(NNDEPLOY_DETECT_NMS_NEON)
+  const float32x4_t vbx0 = vdupq_n_f32(bx0), vby0 = vdupq_n_f32(by0);
+  const float32x4_t vbx1 = vdupq_n_f32(bx1), vby1 = vdupq_n_f32(by1);
+  const float32x4_t vbarea = vdupq_n_f32(barea);
+  const float32x4_t vthreshold = vdupq_n_f32(iou_threshold);
+  const float32x4_t vzero = vdupq_n_f32(0.0f);
+  for (; j + 4 <= end; j += 4) {
+    float32x4_t w = vsubq_f32(vminq_f32(vbx1, vld1q_f32(x1 + j)),
+                              vmaxq_f32(vbx0, vld1q_f32(x0 + j)));
+    float32x4_t h = vsubq_f32(vminq_f32(vby1, vld1q_f32(y1 + j)),
+                              vmaxq_f32(vby0, vld1q_f32(y0 + j)));
+    float32x4_t inter = vmulq_f32(vmaxq_f32(w, vzero), vmaxq_f32(h, vzero));
+    float32x4_t uni = vsubq_f32(vaddq_f32(vbarea, vld1q_f32(area + j)), inter);
+    uint32x4_t mask = vcgtq_f32(inter, vmulq_f32(vthreshold, uni));
+    int32x4_t old = vld1q_s32(suppressed + j);
+    vst1q_s32(suppressed + j, vorrq_s32(old, vreinterpretq_s32_u32(mask)));
+  }
+#endif
+  for (; j < end; ++j) {
+    float w = std::min(bx1, x1[j]) - std::max(bx0, x0[j]);
+    float h = std::min(by1, y1[j]) - std::max(by0, y0[j]);
+    float inter = std::max(w, 0.0f) * std::max(h, 0.0f);
+    float uni = barea + area[j] - inter;
+    if (inter > iou_threshold * uni) {
+      suppressed[j] = -1;
+    }
+  }
+}
+
+/**
+ * @brief 第i个框与[begin, end)中框的IoU
+ */
+void computeIoUs(const NMSBoxes &boxes, int i, int begin, int end,
+                 float *ious) {
+  const float bx0 = boxes.x0_[i], by0 = boxes.y0_[i];
+  const float bx1 = boxes.x1_[i], by1 = boxes.y1_[i];
+  const float barea = boxes.area_[i];
+  const float *x0 = boxes.x0_.data(), *y0 = boxes.y0_.data();
+  const float *x1 = boxes.x1_.data(), *y1 = boxes.y1_.data();
+  const float *area = boxes.area_.data();
+  int j = begin;
+#if defined(NNDEPLOY_DETECT_NMS_SSE)
+  const __m128 vbx0 = _mm_set1_ps(bx0), vby0 = _mm_set1_ps(by0);
+  const __m128 vbx1 = _mm_set1_ps(bx1), vby1 = _mm_set1_ps(by1);
+  const __m128 vbarea = _mm_set1_ps(barea);
+  const __m128 vzero = _mm_setzero_ps();
+  for (; j + 4 <= end; j += 4) {
+    __m128 w = _mm_sub_ps(_mm_min_ps(vbx1, _mm_loadu_ps(x1 + j)),
+                          _mm_max_ps(vbx0, _mm_loadu_ps(x0 + j)));
+    __m128 h = _mm_sub_ps(_mm_min_ps(vby1, _mm_loadu_ps(y1 + j)),
+                          _mm_max_ps(vby0, _mm_loadu_ps(y0 + j)));
+    __m128 inter = _mm_mul_ps(_mm_max_ps(w, vzero), _mm_max_ps(h, vzero));
+    __m128 uni = _mm_sub_ps(_mm_add_ps(vbarea, _mm_loadu_ps(area + j)), inter);
+    // union为0时IoU为0
+    __m128 valid = _mm_cmpgt_ps(uni, vzero);
+    __m128 iou = _mm_and_ps(valid, _mm_div_ps(inter, _mm_max_ps(uni, vzero)));
+    _mm_storeu_ps(ious + j - begin, iou);
+  }
+#elif defined(NNDEPLOY_DETECT_NMS_NEON)
+  const float32x4_t vbx0 = vdupq_n_f32(bx0), vby0 = vdupq_n_f32(by0);
+  const float32x4_t vbx1 = vdupq_n_f32(bx1), vby1 = vdupq_n_f32(by1);
+  const float32x4_t vbarea = vdupq_n_f32(barea);
+  const float32x4_t vzero = vdupq_n_f32(0.0f);
+  for (; j + 4 <= end; j += 4) {
+    float32x4_t w = vsubq_f32(vminq_f32(vbx1, vld1q_f32(x1 + j)),
+                              vmaxq_f32(vbx0, vld1q_f32(x0 + j)));
+    float32x4_t h = vsubq_f32(vminq_f32(vby1, vld1q_f32(y1 + j)),
+                              vmaxq_f32(vby0, vld1q_f32(y0 + j)));
+    float32x4_t inter = vmulq_f32(vmaxq_f32(w, vzero), vmaxq_f32(h, vzero));
+    float32x4_t uni = vsubq_f32(vaddq_f32(vbarea, vld1q_f32(area + j)), inter);
+    uint32x4_t valid = vcgtq_f32(uni, vzero);
+    float32x4_t iou = vdivq_f32(inter, vmaxq_f32(uni, vzero));
+    iou = vreinterpretq_f32_u32(
+        vandq_u32(valid, vreinterpretq_u32_f32(iou)));
+    vst1q_f32(ious + j - begin, iou);
+  }
+#endif
+  for (; j < end; ++j) {
+    float w = std::min(bx1, x1[j]) - std::max(bx0, x0[j]);
+    float h = std::min(by1, y1[j]) - std::max(by0, y0[j]);
+    float inter = std::max(w, 0.0f) * std::max(h, 0.0f);
+    float uni = barea + area[j] - inter;
+    ious[j - begin] = uni > 0.0f ? inter / uni : 0.0f;
+  }
+}
+
+base::Status runNMS(NMSBoxes &boxes, int n, std::vector<int> &keep_idxs,
+                    float iou_threshold, int max_detections) {
+  boxes.suppressed_.assign(n, 0);
+  int32_t *suppressed = boxes.suppressed_.data();
+  for (int i = 0; i < n; ++i) {
+    if (suppressed[i] != 0) {
+      continue;
+    }
+    keep_idxs.push_back(boxes.order_[i]);
+    if (max_detections > 0 && (int)keep_idxs.size() >= max_detections) {
+      break;
+    }
+    suppressByIoU(boxes, i, i + 1, n, iou_threshold, suppressed);
+  }
+  return base::kStatusCodeOk;
+}
+
+}  // namespace
+
+base::Status computeBatchedNMS(const DetectResult &src,
+                               std::vector<int> &keep_idxs,
+                               const float iou_threshold, int max_detections,
+                               bool class_agnostic) {
+  keep_idxs.clear();
+  int n = src.bboxs_.size();
+  if (n == 0) {
+    return base::kStatusCodeOk;
+  }
+  NMSBoxes boxes;
+  boxes.init(src, class_agnostic);
+  return runNMS(boxes, n, keep_idxs, iou_threshold, max_detections);
+}
+
+DetectCandidates::DetectCandidates() : boxes_(std::make_shared<NMSBoxes>()) {}
+
+DetectCandidates::~DetectCandidates() {}
+
+void DetectCandidates::clear() {
+  label_.clear();
+  score_.clear();
+  x0_.clear();
+  y0_.clear();
+  x1_.clear();
+  y1_.clear();
+}
+
+void DetectCandidates::reserve(int n) {
+  label_.reserve(n);
+  score_.reserve(n);
+  x0_.reserve(n);
+  y0_.reserve(n);
+  x1_.reserve(n);
+  y1_.reserve(n);
+}
+
+base::Status computeBatchedNMS(DetectCandidates &src,
+                               std::vector<int> &keep_idxs,
+                               const float iou_threshold, int max_detections,
+                               bool class_agnostic) {
+  keep_idxs.clear();
+  int n = src.size();
+  if (n == 0) {
+    return base::kStatusCodeOk;
+  }
+  src.boxes_->init(src, class_agnostic);
+  return runNMS(*src.boxes_, n, keep_idxs, iou_threshold, max_detections);
+}
+
+base::Status computeSoftNMS(DetectResult &src, std::vector<int> &keep_idxs,
+                            const float iou_threshold, const float sigma,
+                            const float score_threshold, int max_detections,
+                            bool class_agnostic, SoftNMSMethod method) {
+  keep_idxs.clear();
+  int n = src.bboxs_.size();
+  if (n == 0) {
+    return base::kStatusCodeOk;
+  }
+  if (method == kSoftNMSMethodGaussian && sigma <= 0.0f) {
+    NNDEPLOY_LOGE("sigma[%f] must be positive.\n", sigma);
+    return base::kStatusCodeErrorInvalidParam;
+  }
+  NMSBoxes boxes;
+  boxes.init(src, class_agnostic);
+  std::vector<float> ious(n);
+  // [k, n)为尚未处理的框
+  for (int k = 0; k < n; ++k) {
+    int best = k;
+    for (int j = k + 1; j < n; ++j) {
+      if (boxes.score_[j] > boxes.score_[best]) {
+        best = j;
+      }
+    }
+    if (boxes.score_[best] < score_threshold) {
+      break;
+    }
+    boxes.swap(k, best);
+    keep_idxs.push_back(boxes.order_[k]);
+    src.bboxs_[boxes.order_[k]].score_ = boxes.score_[k];
+    if (max_detections > 0 && (int)keep_idxs.size() >= max_detections) {
+      break;
+    }
+
+    computeIoUs(boxes, k, k + 1, n, ious.data());
+    for (int j = k + 1; j < n; ++j) {
+      float iou = ious[j - k - 1];
+      if (method == kSoftNMSMethodLinear) {
+        if (iou > iou_threshold) {
+          boxes.score_[j] *= 1.0f - iou;
+        }
+      } else {
+        boxes.score_[j] *= std::exp(-iou * iou / sigma);
+      }
+    }
+    // 删除分数过低的框，缩小后续的计算范围
+    for (int j = k + 1; j < n;) {
+      if (boxes.score_[j] < score_threshold) {
+        boxes.swap(j, n - 1);
+        n--;
+      } else {
+        j++;
+      }
+    }
+  }
+  return base::kStatusCodeOk;
+}
+
 }  // namespace detect
 }  // namespace nndeploy
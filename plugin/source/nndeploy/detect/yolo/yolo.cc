@@ -18,10 +18,195 @@
 #include "nndeploy/device/tensor.h"
 #include "nndeploy/infer/infer.h"
 #include "nndeploy/preprocess/cvtcolor_resize.h"
+#include "nndeploy/thread_pool/parallel.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define NNDEPLOY_DETECT_YOLO_SSE
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define NNDEPLOY_DETECT_YOLO_NEON
+#endif
 
 namespace nndeploy {
 namespace detect {
 
+namespace {
+
+inline void addBoxes(float x_center, float y_center, float object_w,
+                     float object_h, const float *scores, int score_step,
+                     float objectness, int num_classes,
+                     const YoloPostParam &param, DetectCandidates &candidates) {
+  float x0 = x_center - object_w * 0.5f;
+  x0 = x0 > 0.0f ? x0 : 0.0f;
+  float y0 = y_center - object_h * 0.5f;
+  y0 = y0 > 0.0f ? y0 : 0.0f;
+  float x1 = x_center + object_w * 0.5f;
+  x1 = x1 < param.model_w_ ? x1 : param.model_w_;
+  float y1 = y_center + object_h * 0.5f;
+  y1 = y1 < param.model_h_ ? y1 : param.model_h_;
+  for (int class_idx = 0; class_idx < num_classes; ++class_idx) {
+    float score = objectness * scores[class_idx * score_step];
+    if (score > param.score_threshold_) {
+      candidates.add(class_idx, score, x0, y0, x1, y1);
+    }
+  }
+}
+
+/**
+ * @brief data[0, n)的最大值
+ */
+float maxScore(const float *data, int n) {
+  float max_score = -FLT_MAX;
+  int i = 0;
+#if defined(NNDEPLOY_DETECT_YOLO_SSE)
+  if (n >= 4) {
+    __m128 vmax = _mm_loadu_ps(data);
+    for (i = 4; i + 4 <= n; i += 4) {
+      vmax = _mm_max_ps(_mm_loadu_ps(data + i), vmax);
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, vmax);
+    max_score = std::max(std::max(lanes[0], lanes[1]),
+                         std::max(lanes[2], lanes[3]));
+  }
+#elif defined(NNDEPLOY_DETECT_YOLO_NEON)
+  if (n >= 4) {
+    float32x4_t vmax = vld1q_f32(data);
+    for (i = 4; i + 4 <= n; i += 4) {
+      vmax = vmaxq_f32(vld1q_f32(data + i), vmax);
+    }
+    float lanes[4];
+    vst1q_f32(lanes, vmax);
+    max_score = std::max(std::max(lanes[0], lanes[1]),
+                         std::max(lanes[2], lanes[3]));
+  }
+#endif
+  for (; i < n; ++i) {
+    max_score = std::max(data[i], max_score);
+  }
+  return max_score;
+}
+
+/**
+ * @brief [anchors, 5 + num_classes]，每行先用objectness * 最大类别分数过滤
+ */
+void decodeAnchorMajor(const float *data, int anchors, int width,
+                       const YoloPostParam &param,
+                       DetectCandidates &candidates) {
+  int num_classes = std::min(param.num_classes_, width - 5);
+  for (int h = 0; h < anchors; ++h) {
+    const float *data_row = data + h * width;
+    float objectness = data_row[4];
+    // objectness非负时objectness * max等于各类别分数的最大值
+    if (objectness >= 0.0f &&
+        !(objectness * maxScore(data_row + 5, num_classes) >
+          param.score_threshold_)) {
+      continue;
+    }
+    addBoxes(data_row[0], data_row[1], data_row[2], data_row[3], data_row + 5,
+             1, objectness, num_classes, param, candidates);
+  }
+}
+
+inline void addAnchor(const float *data, int anchors, int num_classes,
+                      int i, const YoloPostParam &param,
+                      DetectCandidates &candidates) {
+  addBoxes(data[i], data[anchors + i], data[2 * anchors + i],
+           data[3 * anchors + i], data + 4 * anchors + i, anchors, 1.0f,
+           num_classes, param, candidates);
+}
+
+/**
+ * @brief [4 + num_classes, anchors]，相邻的框在内存中连续，一次求4个框的最大分数
+ */
+void decodeChannelMajor(const float *data, int channels, int anchors,
+                        const YoloPostParam &param,
+                        DetectCandidates &candidates) {
+  int num_classes = std::min(param.num_classes_, channels - 4);
+  const float *scores = data + 4 * anchors;
+  int a = 0;
+#if defined(NNDEPLOY_DETECT_YOLO_SSE)
+  float max_scores[4];
+  for (; a + 4 <= anchors; a += 4) {
+    __m128 vmax = _mm_set1_ps(-FLT_MAX);
+    for (int c = 0; c < num_classes; ++c) {
+      vmax = _mm_max_ps(_mm_loadu_ps(scores + c * anchors + a), vmax);
+    }
+    _mm_storeu_ps(max_scores, vmax);
+    for (int k = 0; k < 4; ++k) {
+      if (max_scores[k] > param.score_threshold_) {
+        addAnchor(data, anchors, num_classes, a + k, param, candidates);
+      }
+    }
+  }
+#elif defined(NNDEPLOY_DETECT_YOLO_NEON)
+  float max_scores[4];
+  for (; a + 4 <= anchors; a += 4) {
+    float32x4_t vmax = vdupq_n_f32(-FLT_MAX);
+    for (int c = 0; c < num_classes; ++c) {
+      vmax = vmaxq_f32(vld1q_f32(scores + c * anchors + a), vmax);
+    }
+    vst1q_f32(max_scores, vmax);
+    for (int k = 0; k < 4; ++k) {
+      if (max_scores[k] > param.score_threshold_) {
+        addAnchor(data, anchors, num_classes, a + k, param, candidates);
+      }
+    }
+  }
+#endif
+  for (; a < anchors; ++a) {
+    float max_score = -FLT_MAX;
+    for (int c = 0; c < num_classes; ++c) {
+      max_score = std::max(scores[c * anchors + a], max_score);
+    }
+    if (max_score > param.score_threshold_) {
+      addAnchor(data, anchors, num_classes, a, param, candidates);
+    }
+  }
+}
+
+class YoloDecodeBody : public thread_pool::ParallelLoopBody {
+ public:
+  YoloDecodeBody(const float *data, int height, int width, bool channel_major,
+                 const YoloPostParam &param,
+                 std::vector<DetectCandidates> &candidates,
+                 std::vector<std::vector<int>> &keep_idxs)
+      : data_(data),
+        height_(height),
+        width_(width),
+        channel_major_(channel_major),
+        param_(param),
+        candidates_(candidates),
+        keep_idxs_(keep_idxs) {}
+  virtual void operator()(const base::Range &range) const {
+    for (int b = range.start_; b < range.end_; ++b) {
+      const float *data_batch = data_ + (size_t)b * height_ * width_;
+      DetectCandidates &candidates = candidates_[b];
+      candidates.clear();
+      if (channel_major_) {
+        decodeChannelMajor(data_batch, height_, width_, param_, candidates);
+      } else {
+        decodeAnchorMajor(data_batch, height_, width_, param_, candidates);
+      }
+      computeBatchedNMS(candidates, keep_idxs_[b], param_.nms_threshold_,
+                        param_.max_detections_, param_.class_agnostic_);
+    }
+  }
+
+ private:
+  const float *data_;
+  int height_;
+  int width_;
+  bool channel_major_;
+  const YoloPostParam &param_;
+  std::vector<DetectCandidates> &candidates_;
+  std::vector<std::vector<int>> &keep_idxs_;
+};
+
+}  // namespace
+
 base::Status YoloPostProcess::run() {
   // NNDEPLOY_LOGE("YoloPostProcess::run!Thread ID: %d.\n",
   //               std::this_thread::get_id());
@@ -38,144 +223,55 @@ base::Status YoloPostProcess::run() {
   return base::kStatusCodeOk;
 }
 
-base::Status YoloPostProcess::runV5V6() {
-  YoloPostParam *param = (YoloPostParam *)param_.get();
-  float score_threshold = param->score_threshold_;
-  int num_classes = param->num_classes_;
-
-  device::Tensor *tensor = inputs_[0]->getTensor(this);
-  float *data = (float *)tensor->getData();
-  int batch = tensor->getShapeIndex(0);
-  int height = tensor->getShapeIndex(1);
-  int width = tensor->getShapeIndex(2);
+base::Status YoloPostProcess::runV5V6() { return decode(false); }
 
-  DetectResult *results = new DetectResult();
+base::Status YoloPostProcess::runV8V11() { return decode(true); }
 
-  for (int b = 0; b < batch; ++b) {
-    // NNDEPLOY_LOGE("bk\n");
-    float *data_batch = data + b * height * width;
-    DetectResult results_batch;
-    for (int h = 0; h < height; ++h) {
-      float *data_row = data_batch + h * width;
-      float x_center = data_row[0];
-      float y_center = data_row[1];
-      float object_w = data_row[2];
-      float object_h = data_row[3];
-      float x0 = x_center - object_w * 0.5f;
-      x0 = x0 > 0.0 ? x0 : 0.0;
-      float y0 = y_center - object_h * 0.5f;
-      y0 = y0 > 0.0 ? y0 : 0.0;
-      float x1 = x_center + object_w * 0.5f;
-      x1 = x1 < param->model_w_ ? x1 : param->model_w_;
-      float y1 = y_center + object_h * 0.5f;
-      y1 = y1 < param->model_h_ ? y1 : param->model_h_;
-      float box_objectness = data_row[4];
-      for (int class_idx = 0; class_idx < num_classes; ++class_idx) {
-        float score = box_objectness * data_row[5 + class_idx];
-        if (score > score_threshold) {
-          DetectBBoxResult bbox;
-          bbox.index_ = b;
-          bbox.label_id_ = class_idx;
-          bbox.score_ = score;
-          bbox.bbox_[0] = x0;
-          bbox.bbox_[1] = y0;
-          bbox.bbox_[2] = x1;
-          bbox.bbox_[3] = y1;
-          // NNDEPLOY_LOGE("score:%f, x0:%f, y0:%f, x1:%f, y1:%f\n", score, x0,
-          // y0,
-          //               x1, y1);
-          results_batch.bboxs_.emplace_back(bbox);
-        }
-      }
-    }
-    std::vector<int> keep_idxs(results_batch.bboxs_.size());
-    computeNMS(results_batch, keep_idxs, param->nms_threshold_);
-    for (auto i = 0; i < keep_idxs.size(); ++i) {
-      auto n = keep_idxs[i];
-      if (n < 0) {
-        continue;
-      }
-      results_batch.bboxs_[n].bbox_[0] /= param->model_w_;
-      results_batch.bboxs_[n].bbox_[1] /= param->model_h_;
-      results_batch.bboxs_[n].bbox_[2] /= param->model_w_;
-      results_batch.bboxs_[n].bbox_[3] /= param->model_h_;
-      results->bboxs_.emplace_back(results_batch.bboxs_[n]);
-    }
-  }
-  outputs_[0]->set(results, inputs_[0]->getIndex(this), false);
-  return base::kStatusCodeOk;
-}
-
-base::Status YoloPostProcess::runV8V11() {
+base::Status YoloPostProcess::decode(bool channel_major) {
   YoloPostParam *param = (YoloPostParam *)param_.get();
-  float score_threshold = param->score_threshold_;
-  int num_classes = param->num_classes_;
 
   device::Tensor *tensor = inputs_[0]->getTensor(this);
-  // NNDEPLOY_LOGI("**********%d,%d,%d,%d", tensor->getBatch(),
-  //               tensor->getChannel(), tensor->getHeight(),
-  //               tensor->getWidth());
   float *data = (float *)tensor->getData();
   int batch = tensor->getShapeIndex(0);
   int height = tensor->getShapeIndex(1);
   int width = tensor->getShapeIndex(2);
+  int min_width = channel_major ? 1 : 5;
+  int min_height = channel_major ? 4 : 0;
+  if (width < min_width || height < min_height) {
+    NNDEPLOY_LOGE("Invalid output shape [%d, %d, %d] for yolo v%d.\n", batch,
+                  height, width, param->version_);
+    return base::kStatusCodeErrorInvalidParam;
+  }
 
-  cv::Mat cv_mat_src(height, width, CV_32FC1, data);
-  cv::Mat cv_mat_dst(width, height, CV_32FC1);
-  cv::transpose(cv_mat_src, cv_mat_dst);
-  std::swap(height, width);
-  data = (float *)cv_mat_dst.data;
+  if ((int)candidates_.size() < batch) {
+    candidates_.resize(batch);
+    keep_idxs_.resize(batch);
+  }
+  YoloDecodeBody body(data, height, width, channel_major, *param,
+                      candidates_, keep_idxs_);
+  thread_pool::parallelFor(base::Range(0, batch), body);
 
+  int total = 0;
+  for (int b = 0; b < batch; ++b) {
+    total += keep_idxs_[b].size();
+  }
   DetectResult *results = new DetectResult();
-
+  results->bboxs_.reserve(total);
   for (int b = 0; b < batch; ++b) {
-    float *data_batch = data + b * height * width;
-    DetectResult results_batch;
-    for (int h = 0; h < height; ++h) {
-      float *data_row = data_batch + h * width;
-      float x_center = data_row[0];
-      float y_center = data_row[1];
-      float object_w = data_row[2];
-      float object_h = data_row[3];
-      float x0 = x_center - object_w * 0.5f;
-      x0 = x0 > 0.0 ? x0 : 0.0;
-      float y0 = y_center - object_h * 0.5f;
-      y0 = y0 > 0.0 ? y0 : 0.0;
-      float x1 = x_center + object_w * 0.5f;
-      x1 = x1 < param->model_w_ ? x1 : param->model_w_;
-      float y1 = y_center + object_h * 0.5f;
-      y1 = y1 < param->model_h_ ? y1 : param->model_h_;
-      for (int class_idx = 0; class_idx < num_classes; ++class_idx) {
-        float score = data_row[4 + class_idx];
-        if (score > score_threshold) {
-          DetectBBoxResult bbox;
-          bbox.index_ = b;
-          bbox.label_id_ = class_idx;
-          bbox.score_ = score;
-          bbox.bbox_[0] = x0;
-          bbox.bbox_[1] = y0;
-          bbox.bbox_[2] = x1;
-          bbox.bbox_[3] = y1;
-          results_batch.bboxs_.emplace_back(bbox);
-        }
-      }
-    }
-    std::vector<int> keep_idxs(results_batch.bboxs_.size());
-    computeNMS(results_batch, keep_idxs, param->nms_threshold_);
-    for (auto i = 0; i < keep_idxs.size(); ++i) {
-      auto n = keep_idxs[i];
-      if (n < 0) {
-        continue;
-      }
-      results_batch.bboxs_[n].bbox_[0] /= param->model_w_;
-      results_batch.bboxs_[n].bbox_[1] /= param->model_h_;
-      results_batch.bboxs_[n].bbox_[2] /= param->model_w_;
-      results_batch.bboxs_[n].bbox_[3] /= param->model_h_;
-      results->bboxs_.emplace_back(results_batch.bboxs_[n]);
+    const DetectCandidates &candidates = candidates_[b];
+    for (int n : keep_idxs_[b]) {
+      DetectBBoxResult bbox;
+      bbox.index_ = b;
+      bbox.label_id_ = candidates.label_[n];
+      bbox.score_ = candidates.score_[n];
+      bbox.bbox_[0] = candidates.x0_[n] / param->model_w_;
+      bbox.bbox_[1] = candidates.y0_[n] / param->model_h_;
+      bbox.bbox_[2] = candidates.x1_[n] / param->model_w_;
+      bbox.bbox_[3] = candidates.y1_[n] / param->model_h_;
+      results->bboxs_.emplace_back(bbox);
     }
   }
   outputs_[0]->set(results, inputs_[0]->getIndex(this), false);
-  // NNDEPLOY_LOGE("postprocess!\n");
   return base::kStatusCodeOk;
 }
 
@@ -169,8 +169,9 @@ base::Status YoloMultiConvOutputPostProcess::run() {
                       param->model_w_, param->model_h_, param->det_len_,
                       tensor_stride, param->score_threshold_, &results_batch);
   }
-  std::vector<int> keep_idxs(results_batch.bboxs_.size());
-  fastNMS(results_batch, keep_idxs, param->nms_threshold_);
+  std::vector<int> keep_idxs;
+  computeBatchedNMS(results_batch, keep_idxs, param->nms_threshold_,
+                    param->max_detections_, param->class_agnostic_);
   for (auto i = 0; i < keep_idxs.size(); ++i) {
     auto n = keep_idxs[i];
     if (n < 0) {
@@ -1,6 +1,8 @@
 
 #include "nndeploy/infer/infer.h"
 
+#include "nndeploy/base/shape.h"
+
 namespace nndeploy {
 namespace infer {
 
@@ -209,6 +211,23 @@ base::Status Infer::init() {
       input_type_info_[i]->setEdgeName(input_names[i]);
     }
   }
+
+  batch_capacity_ = 1;
+  batch_rows_ = 1;
+  if (max_batch_size_ > 1 && parallel_type_ == base::kParallelTypePipeline) {
+    if (is_input_dynamic_) {
+      batch_capacity_ = max_batch_size_;
+      batch_rows_ = max_batch_size_;
+    } else if (inference_->isBatch() && !input_names.empty()) {
+      base::IntVector shape = inference_->getInputShape(input_names[0]);
+      batch_rows_ = shape.empty() ? 1 : shape[0];
+      batch_capacity_ = std::min(max_batch_size_, batch_rows_);
+    } else {
+      NNDEPLOY_LOGW("node[%s] inference does not support batch.\n",
+                    name_.c_str());
+    }
+  }
+
   std::vector<std::string> output_names = inference_->getAllOutputTensorName();
   for (int i = output_type_info_.size(); i < output_names.size(); i++) {
     this->setOutputTypeInfo<device::Tensor>();
@@ -226,6 +245,12 @@ base::Status Infer::deinit() {
   base::Status status = base::kStatusCodeOk;
   status = inference_->deinit();
   NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "deinit failed");
+  for (auto tensor : batch_inputs_) {
+    if (tensor != nullptr) {
+      delete tensor;
+    }
+  }
+  batch_inputs_.clear();
   return status;
 }
 
@@ -273,6 +298,11 @@ base::Status Infer::setMemory(device::Buffer *buffer) {
 
 base::Status Infer::run() {
   // NNDEPLOY_LOGE("Infer::run!Thread ID: %d.\n", std::this_thread::get_id());
+  // 只有节点独占线程时才能在一次run中消费多帧，
+  // 按帧调度run的执行器(ParallelPipelineTaskExecutor)逐帧推理
+  if (batch_capacity_ > 1 && getDedicatedThreadFlag()) {
+    return runBatch();
+  }
   base::Status status = base::kStatusCodeOk;
   std::vector<device::Tensor *> tensors;
   std::vector<int> indexs;
@@ -375,6 +405,198 @@ std::shared_ptr<inference::Inference> Infer::getInference() {
   return inference_;
 }
 
+void Infer::setBatching(int max_batch_size, int max_wait_ms) {
+  max_batch_size_ = max_batch_size;
+  max_wait_ms_ = std::max(max_wait_ms, 0);
+}
+int Infer::getMaxBatchSize() { return max_batch_size_; }
+int Infer::getMaxWaitMs() { return max_wait_ms_; }
+
+bool Infer::canGatherInput(int i, device::Tensor *tensor, int offset) {
+  device::TensorDesc desc = tensor->getDesc();
+  if (desc.shape_.empty() || offset + desc.shape_[0] > batch_capacity_) {
+    return false;
+  }
+  if (offset == 0 || i >= (int)batch_inputs_.size() ||
+      batch_inputs_[i] == nullptr) {
+    return true;
+  }
+  desc.shape_[0] = batch_rows_;
+  return batch_inputs_[i]->getDesc() == desc &&
+         batch_inputs_[i]->getDevice() == tensor->getDevice();
+}
+
+base::Status Infer::gatherInput(int i, device::Tensor *tensor, int offset) {
+  device::TensorDesc desc = tensor->getDesc();
+  if (desc.shape_.empty()) {
+    NNDEPLOY_LOGE("input[%d] shape is empty.\n", i);
+    return base::kStatusCodeErrorInvalidValue;
+  }
+  int rows = desc.shape_[0];
+  if (offset + rows > batch_rows_) {
+    NNDEPLOY_LOGE("input[%d] batch[%d] exceeds max batch[%d].\n", i,
+                  offset + rows, batch_rows_);
+    return base::kStatusCodeErrorInvalidValue;
+  }
+  desc.shape_[0] = batch_rows_;
+  while (i >= (int)batch_inputs_.size()) {
+    batch_inputs_.push_back(nullptr);
+  }
+  device::Tensor *&batch_input = batch_inputs_[i];
+  if (batch_input != nullptr && (batch_input->getDesc() != desc ||
+                                 batch_input->getDevice() !=
+                                     tensor->getDevice())) {
+    // 只在batch的第一帧重新分配，否则已拷贝的帧会丢失
+    if (offset != 0) {
+      NNDEPLOY_LOGE("input[%d] changed in the middle of a batch.\n", i);
+      return base::kStatusCodeErrorInvalidValue;
+    }
+    delete batch_input;
+    batch_input = nullptr;
+  }
+  if (batch_input == nullptr) {
+    std::string name = tensor->getName();
+    if (inference_input_names_.find(name) == inference_input_names_.end()) {
+      name = input_type_info_[i]->getEdgeName();
+    }
+    batch_input = new device::Tensor(tensor->getDevice(), desc, name);
+  }
+  size_t row_bytes = base::shapeCount(desc.shape_, 1) * desc.data_type_.size();
+  return tensor->getDevice()->copy(
+      tensor->getData(), (uint8_t *)batch_input->getData() + offset * row_bytes,
+      rows * row_bytes);
+}
+
+base::Status Infer::runBatch() {
+  base::Status status = base::kStatusCodeOk;
+  // 边上的数据包在消费下一帧后可能被复用，每帧取到后立即拷贝
+  std::vector<int> indexs;
+  std::vector<int> rows;
+  int total = 0;
+  auto deadline = std::chrono::steady_clock::now() +
+                  std::chrono::milliseconds(max_wait_ms_);
+  std::vector<device::Tensor *> tensors(inputs_.size());
+  while (true) {
+    int index = -1;
+    for (int i = 0; i < inputs_.size(); i++) {
+      // getTensor等待数据写入完成后再取index
+      tensors[i] = inputs_[i]->getTensor(this);
+      if (i == 0) {
+        index = inputs_[i]->getIndex(this);
+      } else if (inputs_[i]->getIndex(this) != index) {
+        NNDEPLOY_LOGE("index not equal");
+        return base::kStatusCodeErrorInvalidValue;
+      }
+    }
+    // 形状、设备变化或放不下这一帧时，先推理已合并的帧，这一帧开始新的batch
+    bool fit = true;
+    for (int i = 0; i < inputs_.size(); i++) {
+      fit = fit && canGatherInput(i, tensors[i], total);
+    }
+    if (!fit && total > 0) {
+      status = runGatheredBatch(indexs, rows, total);
+      NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                             "runGatheredBatch failed");
+      indexs.clear();
+      rows.clear();
+      total = 0;
+      deadline = std::chrono::steady_clock::now() +
+                 std::chrono::milliseconds(max_wait_ms_);
+    }
+    for (int i = 0; i < inputs_.size(); i++) {
+      status = gatherInput(i, tensors[i], total);
+      NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                             "gatherInput failed");
+    }
+    int frame_rows = tensors[0]->getShape()[0];
+    indexs.emplace_back(index);
+    rows.emplace_back(frame_rows);
+    total += frame_rows;
+    // 放不下下一帧或等待超时后开始推理
+    if (total + frame_rows > batch_capacity_) {
+      break;
+    }
+    int wait_ms = (int)std::chrono::duration_cast<std::chrono::milliseconds>(
+                      deadline - std::chrono::steady_clock::now())
+                      .count();
+    if (!inputs_[0]->waitNext(this, wait_ms)) {
+      break;
+    }
+    if (updateInput() != base::kEdgeUpdateFlagComplete) {
+      break;
+    }
+  }
+  return runGatheredBatch(indexs, rows, total);
+}
+
+base::Status Infer::runGatheredBatch(const std::vector<int> &indexs,
+                                     const std::vector<int> &rows,
+                                     int total) {
+  base::Status status = base::kStatusCodeOk;
+  // 动态输入时按实际的行数推理
+  int used_rows = is_input_dynamic_ ? total : batch_rows_;
+  std::vector<device::Tensor *> input_tensors;
+  base::ShapeMap shape_map;
+  for (auto batch_input : batch_inputs_) {
+    device::TensorDesc desc = batch_input->getDesc();
+    desc.shape_[0] = used_rows;
+    device::Tensor *input =
+        new device::Tensor(batch_input->getDevice(), desc,
+                           batch_input->getData(), batch_input->getName());
+    input_tensors.emplace_back(input);
+    shape_map[input->getName()] = desc.shape_;
+  }
+  if (is_input_dynamic_) {
+    inference_->reshape(shape_map);
+  }
+  for (auto input : input_tensors) {
+    inference_->setInputTensor(input->getName(), input);
+  }
+  status = inference_->run();
+  for (auto input : input_tensors) {
+    delete input;
+  }
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "run failed");
+
+  // 按帧拆分输出
+  for (int i = 0; i < outputs_.size(); i++) {
+    std::string name = outputs_[i]->getName();
+    if (inference_output_names_.find(name) == inference_output_names_.end()) {
+      name = output_type_info_[i]->getEdgeName();
+    }
+    device::Tensor *tensor =
+        inference_->getOutputTensorAfterRun(name, device_type_, true);
+    if (tensor == nullptr) {
+      NNDEPLOY_LOGE("can't getOutputTensorAfterRun[%s].\n", name.c_str());
+      return base::kStatusCodeErrorInvalidParam;
+    }
+    device::TensorDesc desc = tensor->getDesc();
+    if (desc.shape_.empty() || desc.shape_[0] % used_rows != 0) {
+      NNDEPLOY_LOGE("output[%s] can't be split by batch.\n", name.c_str());
+      delete tensor;
+      return base::kStatusCodeErrorInvalidValue;
+    }
+    int rows_per_input = desc.shape_[0] / used_rows;
+    size_t row_bytes =
+        base::shapeCount(desc.shape_, 1) * desc.data_type_.size();
+    device::Device *device = tensor->getDevice();
+    size_t offset = 0;
+    for (int f = 0; f < indexs.size(); f++) {
+      device::TensorDesc frame_desc = desc;
+      frame_desc.shape_[0] = rows[f] * rows_per_input;
+      device::Tensor *frame_tensor =
+          new device::Tensor(device, frame_desc, tensor->getName());
+      size_t bytes = frame_desc.shape_[0] * row_bytes;
+      device->copy((uint8_t *)tensor->getData() + offset,
+                   frame_tensor->getData(), bytes);
+      offset += bytes;
+      outputs_[i]->set(frame_tensor, indexs[f], false);
+    }
+    delete tensor;
+  }
+  return status;
+}
+
 REGISTER_NODE("nndeploy::infer::Infer", Infer);
 
 }  // namespace infer
@@ -0,0 +1,461 @@
+#include "nndeploy/llm/kv_cache.h"
+
+namespace nndeploy {
+namespace llm {
+
+namespace {
+
+device::Tensor *createHostTensor(const base::IntVector &shape,
+                                 base::DataType data_type,
+                                 base::DataFormat data_format,
+                                 const std::string &name) {
+  device::TensorDesc desc;
+  desc.data_type_ = data_type;
+  desc.data_format_ = data_format;
+  desc.shape_ = shape;
+  device::Tensor *tensor =
+      new device::Tensor(device::getDefaultHostDevice(), desc, name);
+  if (tensor->getData() == nullptr) {
+    NNDEPLOY_LOGE("Failed to allocate %s.\n", name.c_str());
+    delete tensor;
+    return nullptr;
+  }
+  return tensor;
+}
+
+void deleteTensor(device::Tensor *&tensor) {
+  if (tensor != nullptr) {
+    delete tensor;
+    tensor = nullptr;
+  }
+}
+
+/**
+ * @brief src为一行中的src_seq_len个位置，把最后seq_len个位置写入环形的dst，
+ * 第一个位置写入start % capacity
+ */
+void copyToRing(const uint8_t *src, int src_seq_len, uint8_t *dst,
+                int capacity, int start, int seq_len, size_t row_bytes) {
+  src += (size_t)(src_seq_len - seq_len) * row_bytes;
+  int slot = start % capacity;
+  int first = std::min(seq_len, capacity - slot);
+  memcpy(dst + slot * row_bytes, src, first * row_bytes);
+  if (first < seq_len) {
+    memcpy(dst, src + first * row_bytes, (seq_len - first) * row_bytes);
+  }
+}
+
+/**
+ * @brief 检查presents除seq_axis外与shape一致，返回presents在seq_axis上的长度，
+ * 不一致时返回-1
+ */
+int checkPresents(device::Tensor *presents, const KVCacheConfig &config,
+                  int batch_axis, int seq_len) {
+  base::IntVector shape = presents->getShape();
+  if (shape.size() != config.shape_.size() ||
+      presents->getDataType() != config.data_type_) {
+    NNDEPLOY_LOGE("presents does not match past_key_values.\n");
+    return -1;
+  }
+  for (int i = 0; i < (int)shape.size(); ++i) {
+    if (i != config.seq_axis_ && i != batch_axis &&
+        shape[i] != config.shape_[i]) {
+      NNDEPLOY_LOGE("presents does not match past_key_values.\n");
+      return -1;
+    }
+  }
+  int src_seq_len = shape[config.seq_axis_];
+  if (src_seq_len < seq_len) {
+    NNDEPLOY_LOGE("presents only has %d positions, append=%d.\n", src_seq_len,
+                  seq_len);
+    return -1;
+  }
+  return src_seq_len;
+}
+
+}  // namespace
+
+KVCache::KVCache() {}
+
+KVCache::~KVCache() { deinit(); }
+
+base::Status KVCache::init(const KVCacheConfig &config) {
+  deinit();
+  int rank = static_cast<int>(config.shape_.size());
+  if (config.capacity_ <= 0 || config.seq_axis_ < 0 ||
+      config.seq_axis_ >= rank) {
+    NNDEPLOY_LOGE("Invalid kv cache config, capacity=%d, seq_axis=%d.\n",
+                  config.capacity_, config.seq_axis_);
+    return base::kStatusCodeErrorInvalidParam;
+  }
+  config_ = config;
+  outer_ = 1;
+  inner_ = 1;
+  for (int i = 0; i < rank; ++i) {
+    if (i < config_.seq_axis_) {
+      outer_ *= config_.shape_[i];
+    } else if (i > config_.seq_axis_) {
+      inner_ *= config_.shape_[i];
+    }
+  }
+  if (outer_ == 0 || inner_ == 0) {
+    NNDEPLOY_LOGE("Invalid kv cache shape.\n");
+    return base::kStatusCodeErrorInvalidParam;
+  }
+
+  base::IntVector shape = config_.shape_;
+  shape[config_.seq_axis_] = config_.capacity_;
+  past_key_values_ = createHostTensor(shape, config_.data_type_,
+                                      config_.data_format_, "past_key_values");
+  if (past_key_values_ == nullptr) {
+    return base::kStatusCodeErrorOutOfMemory;
+  }
+  // 未写入的位置被attention_mask屏蔽，清零只是为了避免NaN参与计算
+  memset(past_key_values_->getData(), 0, past_key_values_->getSize());
+  reset();
+  return base::kStatusCodeOk;
+}
+
+base::Status KVCache::deinit() {
+  deleteTensor(past_key_values_);
+  deleteTensor(attention_mask_);
+  deleteTensor(position_ids_);
+  reset();
+  return base::kStatusCodeOk;
+}
+
+void KVCache::reset() {
+  seq_len_ = 0;
+  mask_seq_len_ = 0;
+  mask_cached_len_ = 0;
+}
+
+const KVCacheConfig &KVCache::getConfig() const { return config_; }
+
+device::Tensor *KVCache::getPastKeyValues() { return past_key_values_; }
+
+device::Tensor *KVCache::getAttentionMask(int seq_len) {
+  if (past_key_values_ == nullptr || seq_len <= 0) {
+    return nullptr;
+  }
+  int capacity = config_.capacity_;
+  int cached_len = getCachedLen();
+  int kv_seq_len = capacity + seq_len;
+  const float lowest = std::numeric_limits<float>::lowest();
+
+  if (attention_mask_ == nullptr || mask_seq_len_ != seq_len) {
+    deleteTensor(attention_mask_);
+    attention_mask_ =
+        createHostTensor({1, 1, seq_len, kv_seq_len}, base::dataTypeOf<float>(),
+                         config_.data_format_, "attention_mask");
+    if (attention_mask_ == nullptr) {
+      return nullptr;
+    }
+    // 列[0, capacity)为缓存的位置，列[capacity, capacity + seq_len)为新token
+    float *ptr = (float *)attention_mask_->getData();
+    for (int i = 0; i < seq_len; ++i) {
+      float *row = ptr + (size_t)i * kv_seq_len;
+      std::fill(row, row + cached_len, 0.0f);
+      std::fill(row + cached_len, row + capacity, lowest);
+      for (int j = 0; j < seq_len; ++j) {
+        row[capacity + j] = j > i ? lowest : 0.0f;
+      }
+    }
+    mask_seq_len_ = seq_len;
+    mask_cached_len_ = cached_len;
+  } else if (mask_cached_len_ != cached_len) {
+    // 缓存只会增长，写满后不再变化，只需放开新写入的位置
+    float *ptr = (float *)attention_mask_->getData();
+    for (int i = 0; i < seq_len; ++i) {
+      float *row = ptr + (size_t)i * kv_seq_len;
+      std::fill(row + mask_cached_len_, row + cached_len, 0.0f);
+    }
+    mask_cached_len_ = cached_len;
+  }
+  return attention_mask_;
+}
+
+device::Tensor *KVCache::getPositionIds(int seq_len) {
+  if (past_key_values_ == nullptr || seq_len <= 0) {
+    return nullptr;
+  }
+  if (position_ids_ == nullptr || position_ids_->getShapeIndex(1) != seq_len) {
+    deleteTensor(position_ids_);
+    position_ids_ = createHostTensor({1, seq_len}, base::dataTypeOf<int>(),
+                                     config_.data_format_, "position_ids");
+    if (position_ids_ == nullptr) {
+      return nullptr;
+    }
+  }
+  int *ptr = (int *)position_ids_->getData();
+  for (int i = 0; i < seq_len; ++i) {
+    ptr[i] = seq_len_ + i;
+  }
+  return position_ids_;
+}
+
+base::Status KVCache::append(device::Tensor *presents, int seq_len) {
+  if (past_key_values_ == nullptr) {
+    NNDEPLOY_LOGE("KVCache is not initialized.\n");
+    return base::kStatusCodeErrorNullParam;
+  }
+  if (presents == nullptr || seq_len <= 0) {
+    NNDEPLOY_LOGE("Invalid presents or seq_len.\n");
+    return base::kStatusCodeErrorInvalidParam;
+  }
+  int capacity = config_.capacity_;
+  if (seq_len > capacity ||
+      (!config_.sliding_window_ && seq_len_ + seq_len > capacity)) {
+    NNDEPLOY_LOGE("KVCache is full, capacity=%d, seq_len=%d, append=%d.\n",
+                  capacity, seq_len_, seq_len);
+    return base::kStatusCodeErrorOutOfMemory;
+  }
+
+  int src_seq_len = checkPresents(presents, config_, -1, seq_len);
+  if (src_seq_len < 0) {
+    return base::kStatusCodeErrorInvalidParam;
+  }
+
+  // 只拷贝presents末尾seq_len个位置，每个token的开销与上下文长度无关
+  size_t row_bytes = inner_ * config_.data_type_.size();
+  const uint8_t *src = (const uint8_t *)presents->getData();
+  uint8_t *dst = (uint8_t *)past_key_values_->getData();
+  for (size_t o = 0; o < outer_; ++o) {
+    copyToRing(src + o * src_seq_len * row_bytes, src_seq_len,
+               dst + o * capacity * row_bytes, capacity, seq_len_, seq_len,
+               row_bytes);
+  }
+  seq_len_ += seq_len;
+  return base::kStatusCodeOk;
+}
+
+int KVCache::getSeqLen() const { return seq_len_; }
+
+int KVCache::getCachedLen() const {
+  return std::min(seq_len_, config_.capacity_);
+}
+
+int KVCache::getCapacity() const { return config_.capacity_; }
+
+size_t KVCache::getMemorySize() const {
+  size_t size = 0;
+  for (device::Tensor *tensor :
+       {past_key_values_, attention_mask_, position_ids_}) {
+    if (tensor != nullptr) {
+      size += tensor->getSize();
+    }
+  }
+  return size;
+}
+
+KVCachePool::KVCachePool() {}
+
+KVCachePool::~KVCachePool() { deinit(); }
+
+base::Status KVCachePool::init(const KVCacheConfig &config, int max_batch) {
+  deinit();
+  int rank = static_cast<int>(config.shape_.size());
+  if (config.capacity_ <= 0 || max_batch <= 0 || config.batch_axis_ < 0 ||
+      config.batch_axis_ >= config.seq_axis_ || config.seq_axis_ >= rank) {
+    NNDEPLOY_LOGE(
+        "Invalid kv cache pool config, capacity=%d, max_batch=%d, "
+        "batch_axis=%d, seq_axis=%d.\n",
+        config.capacity_, max_batch, config.batch_axis_, config.seq_axis_);
+    return base::kStatusCodeErrorInvalidParam;
+  }
+  config_ = config;
+  max_batch_ = max_batch;
+  outer_ = 1;
+  mid_ = 1;
+  inner_ = 1;
+  for (int i = 0; i < rank; ++i) {
+    if (i < config_.batch_axis_) {
+      outer_ *= config_.shape_[i];
+    } else if (i > config_.batch_axis_ && i < config_.seq_axis_) {
+      mid_ *= config_.shape_[i];
+    } else if (i > config_.seq_axis_) {
+      inner_ *= config_.shape_[i];
+    }
+  }
+  if (outer_ == 0 || mid_ == 0 || inner_ == 0) {
+    NNDEPLOY_LOGE("Invalid kv cache pool shape.\n");
+    return base::kStatusCodeErrorInvalidParam;
+  }
+
+  base::IntVector shape = config_.shape_;
+  shape[config_.batch_axis_] = max_batch_;
+  shape[config_.seq_axis_] = config_.capacity_;
+  past_key_values_ = createHostTensor(shape, config_.data_type_,
+                                      config_.data_format_, "past_key_values");
+  attention_mask_ = createHostTensor(
+      {max_batch_, 1, 1, config_.capacity_ + 1}, base::dataTypeOf<float>(),
+      config_.data_format_, "attention_mask");
+  position_ids_ = createHostTensor({max_batch_, 1}, base::dataTypeOf<int>(),
+                                   config_.data_format_, "position_ids");
+  if (past_key_values_ == nullptr || attention_mask_ == nullptr ||
+      position_ids_ == nullptr) {
+    deinit();
+    return base::kStatusCodeErrorOutOfMemory;
+  }
+  memset(past_key_values_->getData(), 0, past_key_values_->getSize());
+
+  used_.assign(max_batch_, false);
+  seq_len_.assign(max_batch_, 0);
+  mask_cached_len_.assign(max_batch_, 0);
+  for (int slot = 0; slot < max_batch_; ++slot) {
+    resetMaskRow(slot);
+  }
+  return base::kStatusCodeOk;
+}
+
+base::Status KVCachePool::deinit() {
+  deleteTensor(past_key_values_);
+  deleteTensor(attention_mask_);
+  deleteTensor(position_ids_);
+  used_.clear();
+  seq_len_.clear();
+  mask_cached_len_.clear();
+  max_batch_ = 0;
+  return base::kStatusCodeOk;
+}
+
+int KVCachePool::acquire() {
+  for (int slot = 0; slot < max_batch_; ++slot) {
+    if (!used_[slot]) {
+      used_[slot] = true;
+      seq_len_[slot] = 0;
+      resetMaskRow(slot);
+      return slot;
+    }
+  }
+  return -1;
+}
+
+void KVCachePool::release(int slot) {
+  if (slot < 0 || slot >= max_batch_) {
+    return;
+  }
+  used_[slot] = false;
+  seq_len_[slot] = 0;
+  resetMaskRow(slot);
+}
+
+int KVCachePool::getMaxBatch() const { return max_batch_; }
+
+int KVCachePool::getNumOfFree() const {
+  return static_cast<int>(std::count(used_.begin(), used_.end(), false));
+}
+
+const KVCacheConfig &KVCachePool::getConfig() const { return config_; }
+
+device::Tensor *KVCachePool::getPastKeyValues() { return past_key_values_; }
+
+device::Tensor *KVCachePool::getAttentionMask() {
+  if (attention_mask_ == nullptr) {
+    return nullptr;
+  }
+  // 每个slot只放开上一次之后新写入的位置
+  size_t row_len = config_.capacity_ + 1;
+  float *ptr = (float *)attention_mask_->getData();
+  for (int slot = 0; slot < max_batch_; ++slot) {
+    int cached_len = getCachedLen(slot);
+    if (used_[slot] && mask_cached_len_[slot] != cached_len) {
+      float *row = ptr + slot * row_len;
+      std::fill(row + mask_cached_len_[slot], row + cached_len, 0.0f);
+      mask_cached_len_[slot] = cached_len;
+    }
+  }
+  return attention_mask_;
+}
+
+device::Tensor *KVCachePool::getPositionIds() {
+  if (position_ids_ == nullptr) {
+    return nullptr;
+  }
+  int *ptr = (int *)position_ids_->getData();
+  for (int slot = 0; slot < max_batch_; ++slot) {
+    ptr[slot] = used_[slot] ? seq_len_[slot] : 0;
+  }
+  return position_ids_;
+}
+
+base::Status KVCachePool::append(int slot, device::Tensor *presents,
+                                 int batch_index, int seq_len) {
+  if (past_key_values_ == nullptr) {
+    NNDEPLOY_LOGE("KVCachePool is not initialized.\n");
+    return base::kStatusCodeErrorNullParam;
+  }
+  if (slot < 0 || slot >= max_batch_ || !used_[slot] || presents == nullptr ||
+      seq_len <= 0) {
+    NNDEPLOY_LOGE("Invalid slot, presents or seq_len.\n");
+    return base::kStatusCodeErrorInvalidParam;
+  }
+  int capacity = config_.capacity_;
+  if (seq_len > capacity ||
+      (!config_.sliding_window_ && seq_len_[slot] + seq_len > capacity)) {
+    NNDEPLOY_LOGE("slot[%d] is full, capacity=%d, seq_len=%d, append=%d.\n",
+                  slot, capacity, seq_len_[slot], seq_len);
+    return base::kStatusCodeErrorOutOfMemory;
+  }
+  int src_seq_len =
+      checkPresents(presents, config_, config_.batch_axis_, seq_len);
+  if (src_seq_len < 0) {
+    return base::kStatusCodeErrorInvalidParam;
+  }
+  int src_batch = presents->getShapeIndex(config_.batch_axis_);
+  if (batch_index < 0 || batch_index >= src_batch) {
+    NNDEPLOY_LOGE("batch_index %d is out of range %d.\n", batch_index,
+                  src_batch);
+    return base::kStatusCodeErrorInvalidParam;
+  }
+
+  size_t row_bytes = inner_ * config_.data_type_.size();
+  const uint8_t *src = (const uint8_t *)presents->getData();
+  uint8_t *dst = (uint8_t *)past_key_values_->getData();
+  for (size_t o = 0; o < outer_; ++o) {
+    for (size_t m = 0; m < mid_; ++m) {
+      size_t src_row = (o * src_batch + batch_index) * mid_ + m;
+      size_t dst_row = (o * max_batch_ + slot) * mid_ + m;
+      copyToRing(src + src_row * src_seq_len * row_bytes, src_seq_len,
+                 dst + dst_row * capacity * row_bytes, capacity,
+                 seq_len_[slot], seq_len, row_bytes);
+    }
+  }
+  seq_len_[slot] += seq_len;
+  return base::kStatusCodeOk;
+}
+
+int KVCachePool::getSeqLen(int slot) const { return seq_len_[slot]; }
+
+int KVCachePool::getCachedLen(int slot) const {
+  return std::min(seq_len_[slot], config_.capacity_);
+}
+
+int KVCachePool::getCapacity() const { return config_.capacity_; }
+
+bool KVCachePool::isFull(int slot) const {
+  return !config_.sliding_window_ && seq_len_[slot] >= config_.capacity_;
+}
+
+size_t KVCachePool::getMemorySize() const {
+  size_t size = 0;
+  for (device::Tensor *tensor :
+       {past_key_values_, attention_mask_, position_ids_}) {
+    if (tensor != nullptr) {
+      size += tensor->getSize();
+    }
+  }
+  return size;
+}
+
+void KVCachePool::resetMaskRow(int slot) {
+  size_t row_len = config_.capacity_ + 1;
+  float *row = (float *)attention_mask_->getData() + slot * row_len;
+  std::fill(row, row + config_.capacity_,
+            std::numeric_limits<float>::lowest());
+  row[config_.capacity_] = 0.0f;
+  mask_cached_len_[slot] = 0;
+}
+
+}  // namespace llm
+}  // namespace nndeploy
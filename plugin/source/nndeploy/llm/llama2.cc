@@ -69,6 +69,14 @@ LlmConfig parseConfig(const std::string& file_path) {
   config.kv_init_shape_.insert(config.kv_init_shape_.begin(),
                                config.layer_nums_);
 
+  // optional
+  if (llm_config.HasMember("kv_cache_len")) {
+    config.kv_cache_len_ = llm_config["kv_cache_len"].GetInt();
+  }
+  if (llm_config.HasMember("kv_sliding_window")) {
+    config.kv_sliding_window_ = llm_config["kv_sliding_window"].GetBool();
+  }
+
   //NNDEPLOY_LOGI("Graph params:\n"); 
   //NNDEPLOY_LOGI("layer_num=%d\n", config.layer_nums_);
   //NNDEPLOY_LOGI("hidden_size=%d\n", config.hidden_size_);
@@ -224,14 +232,35 @@ base::Status EmbeddingNode::run() {
   int hidden_size = embedding_param->hidden_size_;
   int seq_len = token_ids[0].size();
   int all_seq_len = embedding_param->all_seq_len_;
+
+  auto inputs_embeds =
+      genEmbedding(token_ids[0], seq_len, hidden_size, embedding_param->data_type_,
+                embedding_param->data_format_, embedding_file);
+
+  /* kv cache owns attention_mask, position_ids and past_key_values, they are
+    updated incrementally instead of being regenerated */
+  KVCache* kv_cache = embedding_param->kv_cache_;
+  if (kv_cache != nullptr) {
+    auto attention_mask = kv_cache->getAttentionMask(seq_len);
+    auto position_ids = kv_cache->getPositionIds(seq_len);
+    if (attention_mask == nullptr || position_ids == nullptr) {
+      NNDEPLOY_LOGE("kv cache failed to generate inputs.\n");
+      return base::kStatusCodeErrorOutOfMemory;
+    }
+    past_kv_ = kv_cache->getPastKeyValues();
+    if (is_first_) is_first_ = false;
+    outputs_[0]->set(inputs_embeds, inputs_[0]->getIndex(this), false);
+    outputs_[1]->set(attention_mask, inputs_[0]->getIndex(this), true);
+    outputs_[2]->set(position_ids, inputs_[0]->getIndex(this), true);
+    outputs_[3]->set(past_kv_, inputs_[0]->getIndex(this), true);
+    return status;
+  }
+
   past_kv_ = embedding_param->past_kv_;
   past_kv_->setName("past_key_values");
 
   /* considering sample node will update past_kv,
     past_kv has already been set in create_prefill_nodes_edges */
-  auto inputs_embeds =
-      genEmbedding(token_ids[0], seq_len, hidden_size, embedding_param->data_type_,
-                embedding_param->data_format_, embedding_file);
 
   auto attention_mask =
       genAttentionMask(seq_len, all_seq_len, embedding_param->data_type_,
@@ -262,8 +291,10 @@ base::Status SampleNode::run() {
             sample_params->emb_node_));
     sample_params->history_ids_.ids_ = token_ids->ids_;
   }
-  std::vector<int32_t> history_ids = sample_params->history_ids_.ids_[0];
+  const std::vector<int32_t>& history_ids =
+      sample_params->history_ids_.ids_[0];
 
+  sampler_.setConfig(sample_params->sampler_config_);
   int32_t out_token_id = sample(logits, history_ids);
   tokenizer::TokenizerIds* out_token = new tokenizer::TokenizerIds();
 
@@ -284,30 +315,18 @@ base::Status SampleNode::run() {
 
 int32_t SampleNode::sample(device::Tensor* logits,
                            const std::vector<int>& history_ids) {
-  std::unordered_set<int> ids_set(history_ids.begin(), history_ids.end());
   auto scores = (float*)logits->getData();
   auto shape = logits->getShape();
-  auto size = std::accumulate(shape.begin(), shape.end(), 1,
+  // logits为[1, seq_len, vocab_size]时取最后一个位置
+  int vocab_size = shape.empty() ? 0 : shape.back();
+  auto size = std::accumulate(shape.begin(), shape.end(), (int64_t)1,
                               std::multiplies<int64_t>());
-  // repetition penalty
-  const float repetition_penalty = 1.1;
-  for (auto id : ids_set) {
-    float score = scores[id];
-    scores[id] =
-        score < 0 ? score * repetition_penalty : score / repetition_penalty;
-  }
-  // argmax
-  float max_score = 0;
-  int token_id = 0;
-  for (int i = 0; i < size; i++) {
-    float score = scores[i];
-    if (score > max_score) {
-      max_score = score;
-      token_id = i;
-    }
+  if (vocab_size <= 0 || size < vocab_size) {
+    NNDEPLOY_LOGE("Invalid logits shape.\n");
+    return -1;
   }
-
-  return token_id;
+  scores += size - vocab_size;
+  return sampler_.sample(scores, vocab_size, history_ids);
 }
 
 base::Status LlmPrefillGraph::run() {
@@ -319,10 +338,24 @@ base::Status LlmPrefillGraph::run() {
   SampleParam* sample_params =
       dynamic_cast<SampleParam*>(prefill_sample_node_->getParam());
 
+  if (kv_cache_ != nullptr) {
+    kv_cache_->reset();
+  }
+
   status = executor_->run();
   NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "executor run failed!");
   history_ids_->ids_.push_back(sample_params->history_ids_.ids_[0]);
 
+  /* only the prompt tokens are appended, the predicted token is fed to the
+    first decode step */
+  if (kv_cache_ != nullptr) {
+    int seq_len = embedding_param->history_ids_.ids_[0].size();
+    status = kv_cache_->append(
+        prefill_presents_->getTensor(prefill_infer_node_), seq_len);
+    NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                           "kv cache append failed!");
+  }
+
   setRunningFlag(false);
   return status;
 }
@@ -336,6 +369,25 @@ void LlmPrefillGraph::genPastKeyValue() {
   past_kv_ = new device::Tensor(device, past_kv_desc, "past_key_values");
 }
 
+void LlmPrefillGraph::genKVCache(LlmConfig& config) {
+  if (config.kv_cache_len_ <= 0) {
+    return;
+  }
+  KVCacheConfig kv_config;
+  kv_config.shape_ = kv_init_shape_;
+  kv_config.capacity_ = config.kv_cache_len_;
+  kv_config.sliding_window_ = config.kv_sliding_window_;
+  kv_cache_ = new KVCache();
+  base::Status status = kv_cache_->init(kv_config);
+  if (status != base::kStatusCodeOk) {
+    NNDEPLOY_LOGE("kv cache init failed, fallback to growing past kv.\n");
+    DELETE_POINTER(kv_cache_);
+    return;
+  }
+  NNDEPLOY_LOGI("kv cache: %d tokens, %zu bytes.\n", kv_cache_->getCapacity(),
+                kv_cache_->getMemorySize());
+}
+
 void LlmPrefillGraph::createPrefillNodesEdges() {
   /* token node */
   prefill_token_ids_ = createEdge("prefill_token_ids");
@@ -379,6 +431,8 @@ void LlmPrefillGraph::setParams(bool is_path, base::ModelType model_type,
   embedding_param->embedding_file_ = config.embedding_file_;
   embedding_param->past_kv_ = past_kv_;
   embedding_param->is_prefill_ = true;
+  genKVCache(config);
+  embedding_param->kv_cache_ = kv_cache_;
 
   /* token params */
   tokenizer::TokenizerPraram* token_param =
@@ -406,11 +460,13 @@ void LlmPrefillGraph::setParams(bool is_path, base::ModelType model_type,
   sample_params->is_prefill_ = true;
 }
 
-void LlmDecodeGraph::getStopTokens(std::string& token_file) {
+bool loadStopTokens(const std::string& token_file,
+                    std::vector<int>& special_tokens,
+                    std::vector<int>& stop_tokens) {
   std::ifstream tok_file(token_file);
   if (!tok_file.good()) {
     printf("Failed: can't load tokenzier from: %s.\n", token_file.c_str());
-    return;
+    return false;
   }
 
   std::string line;
@@ -428,18 +484,23 @@ void LlmDecodeGraph::getStopTokens(std::string& token_file) {
 
   if (special_num) {
     // load special tokens
-    special_tokens_.resize(special_num);
+    special_tokens.resize(special_num);
     for (int i = 0; i < special_num; i++) {
-      specail_line >> special_tokens_[i];
+      specail_line >> special_tokens[i];
     }
   }
   if (stop_num) {
     // load stop tokens
-    stop_tokens_.resize(stop_num);
+    stop_tokens.resize(stop_num);
     for (int i = 0; i < stop_num; i++) {
-      specail_line >> stop_tokens_[i];
+      specail_line >> stop_tokens[i];
     }
   }
+  return true;
+}
+
+void LlmDecodeGraph::getStopTokens(std::string& token_file) {
+  loadStopTokens(token_file, special_tokens_, stop_tokens_);
 }
 
 void LlmDecodeGraph::createPrefillNodesEdges() {
@@ -514,6 +575,13 @@ void LlmDecodeGraph::setParams(bool is_path, base::ModelType model_type,
   token_param->json_blob_ = config.tokenizer_json_;
 }
 
+void LlmDecodeGraph::setKVCache(KVCache* kv_cache) {
+  kv_cache_ = kv_cache;
+  EmbeddingParam* embedding_param =
+      dynamic_cast<EmbeddingParam*>(decode_embedding_node_->getParam());
+  embedding_param->kv_cache_ = kv_cache_;
+}
+
 int LlmDecodeGraph::loops() {
   /* simply return maximum seqence length */
   return max_seq_len_;
@@ -526,7 +594,14 @@ base::Status LlmDecodeGraph::run() {
 
   int iters = loops();
   for (int i = 0; i < iters; ++i) {
-    if (isStop()) {
+    /* without sliding window decoding stops when kv cache is full */
+    bool kv_cache_full = kv_cache_ != nullptr &&
+                         !kv_cache_->getConfig().sliding_window_ &&
+                         kv_cache_->getSeqLen() >= kv_cache_->getCapacity();
+    if (kv_cache_full) {
+      NNDEPLOY_LOGW("kv cache is full, stop decoding.\n");
+    }
+    if (isStop() || kv_cache_full) {
       tokenizer::TokenizerText* word =
           (tokenizer::TokenizerText*)(decode_out_words_->getParam(
               decode_node_));
@@ -559,6 +634,8 @@ base::Status LlmDecodeGraph::run() {
     }
     embedding_param->gen_seq_len_++;
 
+    int seq_len = embedding_param->token_ids_[0].size();
+
     status = executor_->run();
     NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "executor runfailed!");
 
@@ -566,8 +643,15 @@ base::Status LlmDecodeGraph::run() {
     tokenizer::TokenizerIds* token_id =
         (tokenizer::TokenizerIds*)(decode_out_ids_->getParam(
             decode_sample_node_));
-    *(embedding_param->past_kv_) =
-        *(decode_presents_->getTensor(decode_infer_node_));
+    if (kv_cache_ != nullptr) {
+      status = kv_cache_->append(
+          decode_presents_->getTensor(decode_infer_node_), seq_len);
+      NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                             "kv cache append failed!");
+    } else {
+      *(embedding_param->past_kv_) =
+          *(decode_presents_->getTensor(decode_infer_node_));
+    }
 
     /* first time decode ==> size of token_id->ids_[0] is 2 */
     if (token_id->ids_[0].size() == 2) {
@@ -620,6 +704,7 @@ dag::Graph* createLlmLlama2Graph(const std::string& name,
       "llama2_decode", prefill_out, decode_out, prefill_graph->past_kv_,
       prefill_graph->history_ids_, inference_type, device_type, model_type,
       is_path, config);
+  decode_graph->setKVCache(prefill_graph->kv_cache_);
   llama2_graph->addNode(decode_graph);
 
   return llama2_graph;
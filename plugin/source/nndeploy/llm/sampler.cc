@@ -0,0 +1,413 @@
+#include "nndeploy/llm/sampler.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define NNDEPLOY_LLM_SAMPLER_SSE
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define NNDEPLOY_LLM_SAMPLER_NEON
+#endif
+
+namespace nndeploy {
+namespace llm {
+
+namespace {
+
+// exp(x) = 2^n * exp(r)，r = x - n * ln2，exp(r)用cephes的多项式近似
+const float kExpMin = -80.0f;  // 结果不会是非规格化数
+const float kLog2e = 1.44269504088896341f;
+const float kLn2Hi = 0.693359375f;
+const float kLn2Lo = -2.12194440e-4f;
+const float kExpP0 = 1.9875691500e-4f;
+const float kExpP1 = 1.3981999507e-3f;
+const float kExpP2 = 8.3334519073e-3f;
+const float kExpP3 = 4.1665795894e-2f;
+const float kExpP4 = 1.6666665459e-1f;
+const float kExpP5 = 5.0000001201e-1f;
+
+#if defined(NNDEPLOY_LLM_SAMPLER_SSE)
+inline __m128 expPs(__m128 x) {
+  x = _mm_max_ps(x, _mm_set1_ps(kExpMin));
+  __m128 fx = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(kLog2e)),
+                         _mm_set1_ps(0.5f));
+  // floor(fx)
+  __m128 tx = _mm_cvtepi32_ps(_mm_cvttps_epi32(fx));
+  __m128 mask = _mm_and_ps(_mm_cmpgt_ps(tx, fx), _mm_set1_ps(1.0f));
+  fx = _mm_sub_ps(tx, mask);
+  x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(kLn2Hi)));
+  x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(kLn2Lo)));
+  __m128 z = _mm_mul_ps(x, x);
+  __m128 y = _mm_set1_ps(kExpP0);
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(kExpP1));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(kExpP2));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(kExpP3));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(kExpP4));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(kExpP5));
+  y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(y, z), x), _mm_set1_ps(1.0f));
+  __m128i n = _mm_add_epi32(_mm_cvttps_epi32(fx), _mm_set1_epi32(127));
+  return _mm_mul_ps(y, _mm_castsi128_ps(_mm_slli_epi32(n, 23)));
+}
+
+inline float horizontalSum(__m128 v) {
+  float lanes[4];
+  _mm_storeu_ps(lanes, v);
+  return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+#elif defined(NNDEPLOY_LLM_SAMPLER_NEON)
+inline float32x4_t expPs(float32x4_t x) {
+  x = vmaxq_f32(x, vdupq_n_f32(kExpMin));
+  float32x4_t fx = vmlaq_f32(vdupq_n_f32(0.5f), x, vdupq_n_f32(kLog2e));
+  // floor(fx)
+  float32x4_t tx = vcvtq_f32_s32(vcvtq_s32_f32(fx));
+  uint32x4_t mask = vandq_u32(vcgtq_f32(tx, fx),
+                              vreinterpretq_u32_f32(vdupq_n_f32(1.0f)));
+  fx = vsubq_f32(tx, vreinterpretq_f32_u32(mask));
+  x = vmlsq_f32(x, fx, vdupq_n_f32(kLn2Hi));
+  x = vmlsq_f32(x, fx, vdupq_n_f32(kLn2Lo));
+  float32x4_t z = vmulq_f32(x, x);
+  float32x4_t y = vdupq_n_f32(kExpP0);
+  y = vmlaq_f32(vdupq_n_f32(kExpP1), y, x);
+  y = vmlaq_f32(vdupq_n_f32(kExpP2), y, x);
+  y = vmlaq_f32(vdupq_n_f32(kExpP3), y, x);
+  y = vmlaq_f32(vdupq_n_f32(kExpP4), y, x);
+  y = vmlaq_f32(vdupq_n_f32(kExpP5), y, x);
+  y = vaddq_f32(vmlaq_f32(x, y, z), vdupq_n_f32(1.0f));
+  int32x4_t n = vaddq_s32(vcvtq_s32_f32(fx), vdupq_n_s32(127));
+  return vmulq_f32(y, vreinterpretq_f32_s32(vshlq_n_s32(n, 23)));
+}
+
+inline float horizontalSum(float32x4_t v) {
+  float lanes[4];
+  vst1q_f32(lanes, v);
+  return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+#endif
+
+float maxValue(const float *x, int n) {
+  float max_value = x[0];
+  int i = 0;
+#if defined(NNDEPLOY_LLM_SAMPLER_SSE)
+  if (n >= 16) {
+    // 4组累加器，隐藏max指令的延迟
+    __m128 vmax0 = _mm_loadu_ps(x), vmax1 = _mm_loadu_ps(x + 4);
+    __m128 vmax2 = _mm_loadu_ps(x + 8), vmax3 = _mm_loadu_ps(x + 12);
+    for (i = 16; i + 16 <= n; i += 16) {
+      vmax0 = _mm_max_ps(_mm_loadu_ps(x + i), vmax0);
+      vmax1 = _mm_max_ps(_mm_loadu_ps(x + i + 4), vmax1);
+      vmax2 = _mm_max_ps(_mm_loadu_ps(x + i + 8), vmax2);
+      vmax3 = _mm_max_ps(_mm_loadu_ps(x + i + 12), vmax3);
+    }
+    __m128 vmax =
+        _mm_max_ps(_mm_max_ps(vmax0, vmax1), _mm_max_ps(vmax2, vmax3));
+    float lanes[4];
+    _mm_storeu_ps(lanes, vmax);
+    max_value = std::max(std::max(lanes[0], lanes[1]),
+                         std::max(lanes[2], lanes[3]));
+  }
+#elif defined(NNDEPLOY_LLM_SAMPLER_NEON)
+  if (n >= 16) {
+    float32x4_t vmax0 = vld1q_f32(x), vmax1 = vld1q_f32(x + 4);
+    float32x4_t vmax2 = vld1q_f32(x + 8), vmax3 = vld1q_f32(x + 12);
+    for (i = 16; i + 16 <= n; i += 16) {
+      vmax0 = vmaxq_f32(vld1q_f32(x + i), vmax0);
+      vmax1 = vmaxq_f32(vld1q_f32(x + i + 4), vmax1);
+      vmax2 = vmaxq_f32(vld1q_f32(x + i + 8), vmax2);
+      vmax3 = vmaxq_f32(vld1q_f32(x + i + 12), vmax3);
+    }
+    float32x4_t vmax =
+        vmaxq_f32(vmaxq_f32(vmax0, vmax1), vmaxq_f32(vmax2, vmax3));
+    float lanes[4];
+    vst1q_f32(lanes, vmax);
+    max_value = std::max(std::max(lanes[0], lanes[1]),
+                         std::max(lanes[2], lanes[3]));
+  }
+#endif
+  for (; i < n; ++i) {
+    max_value = std::max(x[i], max_value);
+  }
+  return max_value;
+}
+
+/**
+ * @brief y[i] = exp((x[i] - max_value) * scale)，返回y之和
+ */
+float expSum(const float *x, int n, float max_value, float scale, float *y) {
+  float sum = 0.0f;
+  int i = 0;
+#if defined(NNDEPLOY_LLM_SAMPLER_SSE)
+  __m128 vmax = _mm_set1_ps(max_value);
+  __m128 vscale = _mm_set1_ps(scale);
+  __m128 vsum = _mm_setzero_ps();
+  for (; i + 4 <= n; i += 4) {
+    __m128 v = expPs(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(x + i), vmax), vscale));
+    _mm_storeu_ps(y + i, v);
+    vsum = _mm_add_ps(vsum, v);
+  }
+  sum = horizontalSum(vsum);
+#elif defined(NNDEPLOY_LLM_SAMPLER_NEON)
+  float32x4_t vmax = vdupq_n_f32(max_value);
+  float32x4_t vscale = vdupq_n_f32(scale);
+  float32x4_t vsum = vdupq_n_f32(0.0f);
+  for (; i + 4 <= n; i += 4) {
+    float32x4_t v =
+        expPs(vmulq_f32(vsubq_f32(vld1q_f32(x + i), vmax), vscale));
+    vst1q_f32(y + i, v);
+    vsum = vaddq_f32(vsum, v);
+  }
+  sum = horizontalSum(vsum);
+#endif
+  for (; i < n; ++i) {
+    y[i] = std::exp(std::max((x[i] - max_value) * scale, kExpMin));
+    sum += y[i];
+  }
+  return sum;
+}
+
+}  // namespace
+
+Sampler::Sampler() : rng_(config_.seed_) {}
+
+Sampler::Sampler(const SamplerConfig &config)
+    : config_(config), rng_(config.seed_) {}
+
+Sampler::~Sampler() {}
+
+void Sampler::setConfig(const SamplerConfig &config) {
+  if (config.seed_ != config_.seed_) {
+    rng_.seed(config.seed_);
+  }
+  config_ = config;
+}
+
+const SamplerConfig &Sampler::getConfig() const { return config_; }
+
+void Sampler::setSeed(uint64_t seed) {
+  config_.seed_ = seed;
+  rng_.seed(seed);
+}
+
+int32_t Sampler::argmax(const float *logits, int vocab_size) {
+  if (vocab_size <= 0) {
+    return -1;
+  }
+  // 先求最大值，再找第一个等于最大值的位置，两次遍历都是向量化的
+  float max_value = maxValue(logits, vocab_size);
+  int i = 0;
+#if defined(NNDEPLOY_LLM_SAMPLER_SSE)
+  __m128 vmax = _mm_set1_ps(max_value);
+  for (; i + 4 <= vocab_size; i += 4) {
+    int mask = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(logits + i), vmax));
+    if (mask != 0) {
+      break;
+    }
+  }
+#elif defined(NNDEPLOY_LLM_SAMPLER_NEON)
+  float32x4_t vmax = vdupq_n_f32(max_value);
+  for (; i + 4 <= vocab_size; i += 4) {
+    uint32x4_t mask = vceqq_f32(vld1q_f32(logits + i), vmax);
+    uint32x2_t fold = vorr_u32(vget_low_u32(mask), vget_high_u32(mask));
+    if (vget_lane_u32(vpmax_u32(fold, fold), 0) != 0) {
+      break;
+    }
+  }
+#endif
+  for (; i < vocab_size; ++i) {
+    if (logits[i] == max_value) {
+      return i;
+    }
+  }
+  // 存在NaN时退化为标量比较
+  int32_t max_index = 0;
+  for (i = 1; i < vocab_size; ++i) {
+    if (logits[i] > logits[max_index]) {
+      max_index = i;
+    }
+  }
+  return max_index;
+}
+
+void Sampler::applyRepetitionPenalty(float *logits, int vocab_size,
+                                     const std::vector<int32_t> &history_ids) {
+  const float penalty = config_.repetition_penalty_;
+  if (penalty == 1.0f || history_ids.empty()) {
+    return;
+  }
+  // 只访问历史中出现的token，seen_用完后清零，下次无需重新初始化
+  if ((int)seen_.size() < vocab_size) {
+    seen_.resize(vocab_size, 0);
+  }
+  for (int32_t id : history_ids) {
+    if (id < 0 || id >= vocab_size || seen_[id] != 0) {
+      continue;
+    }
+    seen_[id] = 1;
+    float score = logits[id];
+    logits[id] = score < 0.0f ? score * penalty : score / penalty;
+  }
+  for (int32_t id : history_ids) {
+    if (id >= 0 && id < vocab_size) {
+      seen_[id] = 0;
+    }
+  }
+}
+
+int32_t Sampler::sample(float *logits, int vocab_size,
+                        const std::vector<int32_t> &history_ids) {
+  if (logits == nullptr || vocab_size <= 0) {
+    return -1;
+  }
+  applyRepetitionPenalty(logits, vocab_size, history_ids);
+  if (config_.temperature_ <= 0.0f || config_.top_k_ == 1) {
+    return argmax(logits, vocab_size);
+  }
+
+  float max_logit = maxValue(logits, vocab_size);
+  float scale = 1.0f / config_.temperature_;
+  probs_.resize(vocab_size);
+  float *probs = probs_.data();
+  bool top_k = config_.top_k_ > 0 && config_.top_k_ < vocab_size;
+  bool top_p = config_.top_p_ < 1.0f;
+  bool min_p = config_.min_p_ > 0.0f;
+
+  // 只有temperature时直接在整个词表上采样
+  if (!top_k && !top_p && !min_p) {
+    float sum = expSum(logits, vocab_size, max_logit, scale, probs);
+    return pick(probs, nullptr, vocab_size, sum);
+  }
+
+  // probs为未归一化的概率，最大的为1；candidates_[0, n)为候选，sum为其概率之和
+  candidates_.resize(vocab_size);
+  int32_t *candidates = candidates_.data();
+  int n = vocab_size;
+  float sum = 0.0f;
+  if (top_k) {
+    n = selectTopK(logits, vocab_size, config_.top_k_, candidates);
+    for (int i = 0; i < n; ++i) {
+      int32_t id = candidates[i];
+      probs[id] = std::exp(std::max((logits[id] - max_logit) * scale, kExpMin));
+      sum += probs[id];
+    }
+  } else {
+    std::iota(candidates, candidates + vocab_size, 0);
+    sum = expSum(logits, n, max_logit, scale, probs);
+  }
+
+  // top-p与min-p保留的都是按概率排序后的前缀，结果为较短的那个前缀；
+  // top-p的阈值按min-p之前的概率之和计算
+  float target = config_.top_p_ * sum;
+  if (min_p) {
+    int keep = 0;
+    float kept = 0.0f;
+    for (int i = 0; i < n; ++i) {
+      int32_t id = candidates[i];
+      if (probs[id] >= config_.min_p_) {
+        candidates[keep++] = id;
+        kept += probs[id];
+      }
+    }
+    if (keep == 0) {
+      return argmax(logits, vocab_size);
+    }
+    n = keep;
+    sum = kept;
+    // min-p的前缀概率之和不足top_p时比top-p的前缀短
+    top_p = top_p && kept > target;
+  }
+  if (top_p) {
+    n = selectTopP(logits, max_logit, scale, probs, target, candidates, n,
+                   sum);
+  }
+  return pick(probs, candidates, n, sum);
+}
+
+int Sampler::selectTopK(const float *logits, int vocab_size, int k,
+                        int32_t *candidates) {
+  auto greater = [logits](int32_t a, int32_t b) {
+    return logits[a] > logits[b] || (logits[a] == logits[b] && a < b);
+  };
+  if (k > vocab_size / 8) {
+    std::iota(candidates, candidates + vocab_size, 0);
+    std::nth_element(candidates, candidates + k - 1, candidates + vocab_size,
+                     greater);
+    return k;
+  }
+  // 大小为k的小顶堆，大部分logit只与堆顶比较一次
+  std::iota(candidates, candidates + k, 0);
+  std::make_heap(candidates, candidates + k, greater);
+  for (int32_t i = k; i < vocab_size; ++i) {
+    if (logits[i] > logits[candidates[0]]) {
+      std::pop_heap(candidates, candidates + k, greater);
+      candidates[k - 1] = i;
+      std::push_heap(candidates, candidates + k, greater);
+    }
+  }
+  return k;
+}
+
+int Sampler::selectTopP(const float *logits, float max_logit, float scale,
+                        const float *probs, float target, int32_t *candidates,
+                        int n, float &sum) {
+  // 按(max_logit - logit) * scale分桶，桶越小概率越大；
+  // 累加到target所在的桶为止，只对这些桶中的候选排序
+  const int kBuckets = 256;
+  const float kRange = -kExpMin;
+  const float bucket_scale = kBuckets / kRange * scale;
+  auto bucketOf = [&](int32_t id) {
+    float x = (max_logit - logits[id]) * bucket_scale;
+    return x < kBuckets - 1 ? (int)x : kBuckets - 1;
+  };
+  float mass[kBuckets] = {0.0f};
+  for (int i = 0; i < n; ++i) {
+    int32_t id = candidates[i];
+    mass[bucketOf(id)] += probs[id];
+  }
+  int last = 0;
+  float cumulative = mass[0];
+  while (cumulative < target && last + 1 < kBuckets) {
+    cumulative += mass[++last];
+  }
+  int32_t *end = std::partition(
+      candidates, candidates + n,
+      [&](int32_t id) { return bucketOf(id) <= last; });
+  int k = end - candidates;
+
+  std::sort(candidates, end, [probs](int32_t a, int32_t b) {
+    return probs[a] > probs[b] || (probs[a] == probs[b] && a < b);
+  });
+  cumulative = 0.0f;
+  int keep = 0;
+  while (keep < k) {
+    cumulative += probs[candidates[keep++]];
+    if (cumulative >= target) {
+      break;
+    }
+  }
+  sum = cumulative;
+  return keep;
+}
+
+int32_t Sampler::pick(const float *probs, const int32_t *candidates, int n,
+                      float sum) {
+  std::uniform_real_distribution<float> dist(0.0f, sum);
+  float r = dist(rng_);
+  if (candidates == nullptr) {
+    for (int i = 0; i < n; ++i) {
+      r -= probs[i];
+      if (r < 0.0f) {
+        return i;
+      }
+    }
+    return n - 1;
+  }
+  for (int i = 0; i < n; ++i) {
+    r -= probs[candidates[i]];
+    if (r < 0.0f) {
+      return candidates[i];
+    }
+  }
+  return candidates[n - 1];
+}
+
+}  // namespace llm
+}  // namespace nndeploy
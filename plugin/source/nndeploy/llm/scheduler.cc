@@ -0,0 +1,413 @@
+#include "nndeploy/llm/scheduler.h"
+
+namespace nndeploy {
+namespace llm {
+
+namespace {
+
+device::Tensor *createHostTensor(const base::IntVector &shape,
+                                 base::DataType data_type,
+                                 const std::string &name) {
+  device::TensorDesc desc;
+  desc.data_type_ = data_type;
+  desc.data_format_ = base::DataFormat::kDataFormatS1D;
+  desc.shape_ = shape;
+  return new device::Tensor(device::getDefaultHostDevice(), desc, name);
+}
+
+}  // namespace
+
+LlmSession::LlmSession(int id, const std::vector<int32_t> &prompt_ids,
+                       const LlmSessionParam &param)
+    : id_(id),
+      state_(kLlmSessionStateWaiting),
+      param_(param),
+      sampler_(param.sampler_config_),
+      prompt_ids_(prompt_ids),
+      history_ids_(prompt_ids) {}
+
+LlmSession::~LlmSession() {}
+
+bool LlmSession::isDone() const {
+  LlmSessionState state = state_.load();
+  return state == kLlmSessionStateFinished || state == kLlmSessionStateFailed;
+}
+
+LlmSessionScheduler::LlmSessionScheduler() {}
+
+LlmSessionScheduler::~LlmSessionScheduler() { deinit(); }
+
+base::Status LlmSessionScheduler::init(const LlmConfig &config,
+                                       const LlmSchedulerParam &param,
+                                       base::InferenceType inference_type,
+                                       base::DeviceType device_type,
+                                       base::ModelType model_type,
+                                       bool is_path) {
+  base::Status status = base::kStatusCodeOk;
+  deinit();
+  if (param.max_batch_ <= 0 || param.max_prefill_per_step_ <= 0) {
+    NNDEPLOY_LOGE("Invalid scheduler param.\n");
+    return base::kStatusCodeErrorInvalidParam;
+  }
+  param_ = param;
+  device_type_ = device_type;
+  hidden_size_ = config.hidden_size_;
+
+  std::vector<int> special_tokens;
+  loadStopTokens(config.tokenizer_txt_, special_tokens, stop_tokens_);
+
+  embedding_file_ = fopen(config.embedding_file_.c_str(), "rb");
+  if (embedding_file_ == nullptr) {
+    NNDEPLOY_LOGE("Could not open %s.\n", config.embedding_file_.c_str());
+    return base::kStatusCodeErrorIO;
+  }
+  embedding_buffer_.resize(hidden_size_);
+
+  /* prefill and decode use separate sessions, as LlmPrefillGraph and
+    LlmDecodeGraph do */
+  for (auto *inference : {&prefill_inference_, &decode_inference_}) {
+    *inference = inference::createInference(inference_type);
+    if (*inference == nullptr) {
+      NNDEPLOY_LOGE("createInference failed.\n");
+      return base::kStatusCodeErrorNotSupport;
+    }
+    inference::InferenceParam *inference_param =
+        (inference::InferenceParam *)((*inference)->getParam());
+    inference_param->is_path_ = is_path;
+    inference_param->model_value_ = {config.model_value_};
+    inference_param->device_type_ = device_type;
+    inference_param->model_type_ = model_type;
+    status = (*inference)->init();
+    NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                           "inference init failed!");
+  }
+
+  KVCacheConfig kv_config;
+  kv_config.shape_ = config.kv_init_shape_;
+  kv_config.capacity_ =
+      config.kv_cache_len_ > 0 ? config.kv_cache_len_ : config.max_seq_len_;
+  kv_config.sliding_window_ = config.kv_sliding_window_;
+  status = kv_cache_pool_.init(kv_config, param_.max_batch_);
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                         "kv cache pool init failed!");
+  NNDEPLOY_LOGI("kv cache pool: %d x %d tokens, %zu bytes.\n",
+                param_.max_batch_, kv_config.capacity_,
+                kv_cache_pool_.getMemorySize());
+
+  prefill_past_kv_ = createHostTensor(config.kv_init_shape_,
+                                      kv_config.data_type_, "past_key_values");
+  decode_embeds_ =
+      createHostTensor({1, param_.max_batch_, hidden_size_},
+                       base::dataTypeOf<float>(), "input_ids");
+  running_.assign(param_.max_batch_, nullptr);
+  return status;
+}
+
+base::Status LlmSessionScheduler::deinit() {
+  if (prefill_inference_ != nullptr) {
+    prefill_inference_->deinit();
+    prefill_inference_ = nullptr;
+  }
+  if (decode_inference_ != nullptr) {
+    decode_inference_->deinit();
+    decode_inference_ = nullptr;
+  }
+  kv_cache_pool_.deinit();
+  DELETE_POINTER(prefill_past_kv_);
+  DELETE_POINTER(decode_embeds_);
+  if (embedding_file_ != nullptr) {
+    fclose(embedding_file_);
+    embedding_file_ = nullptr;
+  }
+  running_.clear();
+  std::lock_guard<std::mutex> lock(mutex_);
+  waiting_.clear();
+  sessions_.clear();
+  return base::kStatusCodeOk;
+}
+
+void LlmSessionScheduler::setTokenCallback(LlmTokenCallback callback) {
+  callback_ = callback;
+}
+
+int LlmSessionScheduler::addSession(const std::vector<int32_t> &prompt_ids,
+                                    const LlmSessionParam &param) {
+  if (prompt_ids.empty()) {
+    NNDEPLOY_LOGE("prompt is empty.\n");
+    return -1;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  int id = next_id_++;
+  auto session = std::make_shared<LlmSession>(id, prompt_ids, param);
+  if (session->param_.stop_tokens_.empty()) {
+    session->param_.stop_tokens_ = stop_tokens_;
+  }
+  sessions_[id] = session;
+  waiting_.push_back(session);
+  return id;
+}
+
+std::shared_ptr<LlmSession> LlmSessionScheduler::getSession(int id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = sessions_.find(id);
+  return iter == sessions_.end() ? nullptr : iter->second;
+}
+
+void LlmSessionScheduler::removeSession(int id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = sessions_.find(id);
+  if (iter != sessions_.end() && iter->second->isDone()) {
+    sessions_.erase(iter);
+  }
+}
+
+bool LlmSessionScheduler::hasWork() {
+  for (auto &session : running_) {
+    if (session != nullptr) {
+      return true;
+    }
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  return !waiting_.empty();
+}
+
+base::Status LlmSessionScheduler::step() {
+  base::Status status = base::kStatusCodeOk;
+
+  /* admit waiting sessions into free slots */
+  std::vector<std::shared_ptr<LlmSession>> admitted;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int num = std::min(param_.max_prefill_per_step_,
+                       kv_cache_pool_.getNumOfFree());
+    while ((int)admitted.size() < num && !waiting_.empty()) {
+      admitted.push_back(waiting_.front());
+      waiting_.pop_front();
+    }
+  }
+  for (auto &session : admitted) {
+    session->slot_ = kv_cache_pool_.acquire();
+    running_[session->slot_] = session;
+    status = prefill(session.get());
+    if (status != base::kStatusCodeOk) {
+      NNDEPLOY_LOGE("session[%d] prefill failed.\n", session->id_);
+      finish(session.get(), kLlmSessionStateFailed);
+    }
+  }
+
+  return decode();
+}
+
+base::Status LlmSessionScheduler::run() {
+  base::Status status = base::kStatusCodeOk;
+  while (hasWork()) {
+    status = step();
+    NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "step failed!");
+  }
+  return status;
+}
+
+const KVCachePool &LlmSessionScheduler::getKVCachePool() const {
+  return kv_cache_pool_;
+}
+
+base::Status LlmSessionScheduler::prefill(LlmSession *session) {
+  base::Status status = base::kStatusCodeOk;
+  int seq_len = session->prompt_ids_.size();
+  if (seq_len > kv_cache_pool_.getCapacity()) {
+    NNDEPLOY_LOGE("prompt length %d exceeds kv cache length %d.\n", seq_len,
+                  kv_cache_pool_.getCapacity());
+    return base::kStatusCodeErrorOutOfMemory;
+  }
+
+  /* same inputs as EmbeddingNode with an empty past */
+  std::unique_ptr<device::Tensor> inputs_embeds(createHostTensor(
+      {seq_len, 1, hidden_size_}, base::dataTypeOf<float>(), "input_ids"));
+  std::unique_ptr<device::Tensor> attention_mask(
+      createHostTensor({1, 1, seq_len, seq_len}, base::dataTypeOf<float>(),
+                       "attention_mask"));
+  std::unique_ptr<device::Tensor> position_ids(createHostTensor(
+      {1, seq_len}, base::dataTypeOf<int>(), "position_ids"));
+  float *embeds = (float *)inputs_embeds->getData();
+  float *mask = (float *)attention_mask->getData();
+  int *positions = (int *)position_ids->getData();
+  for (int i = 0; i < seq_len; ++i) {
+    readEmbedding(session->prompt_ids_[i], embeds + (size_t)i * hidden_size_);
+    for (int j = 0; j < seq_len; ++j) {
+      mask[(size_t)i * seq_len + j] =
+          j > i ? std::numeric_limits<float>::lowest() : 0.0f;
+    }
+    positions[i] = i;
+  }
+
+  device::Tensor *logits = nullptr;
+  device::Tensor *presents = nullptr;
+  status = runInference(prefill_inference_.get(),
+                        {inputs_embeds.get(), attention_mask.get(),
+                         position_ids.get(), prefill_past_kv_},
+                        logits, presents);
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "prefill failed!");
+  std::unique_ptr<device::Tensor> logits_guard(logits);
+  std::unique_ptr<device::Tensor> presents_guard(presents);
+
+  status = kv_cache_pool_.append(session->slot_, presents, 0, seq_len);
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                         "kv cache append failed!");
+  session->state_ = kLlmSessionStateDecoding;
+
+  // 取最后一个位置的logits
+  auto shape = logits->getShape();
+  int vocab_size = shape.empty() ? 0 : shape.back();
+  size_t size = logits->getSize() / sizeof(float);
+  if (vocab_size <= 0 || size < (size_t)vocab_size) {
+    NNDEPLOY_LOGE("Invalid logits shape.\n");
+    return base::kStatusCodeErrorInvalidValue;
+  }
+  float *scores = (float *)logits->getData() + size - vocab_size;
+  sampleToken(session, scores, vocab_size);
+  return status;
+}
+
+base::Status LlmSessionScheduler::decode() {
+  base::Status status = base::kStatusCodeOk;
+  int max_batch = param_.max_batch_;
+  int num_running = 0;
+  float *embeds = (float *)decode_embeds_->getData();
+  for (int slot = 0; slot < max_batch; ++slot) {
+    float *row = embeds + (size_t)slot * hidden_size_;
+    LlmSession *session = running_[slot].get();
+    if (session == nullptr) {
+      std::fill(row, row + hidden_size_, 0.0f);
+      continue;
+    }
+    readEmbedding(session->next_token_, row);
+    num_running++;
+  }
+  if (num_running == 0) {
+    return status;
+  }
+
+  device::Tensor *logits = nullptr;
+  device::Tensor *presents = nullptr;
+  status = runInference(decode_inference_.get(),
+                        {decode_embeds_, kv_cache_pool_.getAttentionMask(),
+                         kv_cache_pool_.getPositionIds(),
+                         kv_cache_pool_.getPastKeyValues()},
+                        logits, presents);
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "decode failed!");
+  std::unique_ptr<device::Tensor> logits_guard(logits);
+  std::unique_ptr<device::Tensor> presents_guard(presents);
+
+  // 每个slot一行logits，取每行最后vocab_size个
+  auto shape = logits->getShape();
+  int vocab_size = shape.empty() ? 0 : shape.back();
+  size_t row_size = logits->getSize() / sizeof(float) / max_batch;
+  if (vocab_size <= 0 || row_size < (size_t)vocab_size) {
+    NNDEPLOY_LOGE("Invalid logits shape.\n");
+    return base::kStatusCodeErrorInvalidValue;
+  }
+  float *data = (float *)logits->getData();
+  for (int slot = 0; slot < max_batch; ++slot) {
+    // finish会清空running_[slot]，回调结束前保持会话有效
+    std::shared_ptr<LlmSession> session = running_[slot];
+    if (session == nullptr) {
+      continue;
+    }
+    base::Status append_status =
+        kv_cache_pool_.append(slot, presents, slot, 1);
+    if (append_status != base::kStatusCodeOk) {
+      finish(session.get(), kLlmSessionStateFailed);
+      continue;
+    }
+    float *scores = data + slot * row_size + row_size - vocab_size;
+    sampleToken(session.get(), scores, vocab_size);
+  }
+  return status;
+}
+
+bool LlmSessionScheduler::sampleToken(LlmSession *session, float *logits,
+                                      int vocab_size) {
+  int32_t token =
+      session->sampler_.sample(logits, vocab_size, session->history_ids_);
+  session->history_ids_.push_back(token);
+  const std::vector<int32_t> &stop_tokens = session->param_.stop_tokens_;
+  bool is_stop = std::find(stop_tokens.begin(), stop_tokens.end(), token) !=
+                 stop_tokens.end();
+  if (!is_stop) {
+    session->output_ids_.push_back(token);
+    session->next_token_ = token;
+  }
+  // 下一步decode需要一个空位
+  bool done = is_stop || token < 0 ||
+              (int)session->output_ids_.size() >=
+                  session->param_.max_new_tokens_ ||
+              kv_cache_pool_.isFull(session->slot_);
+  if (done) {
+    finish(session, kLlmSessionStateFinished);
+  }
+  if (callback_) {
+    callback_(session, token);
+  }
+  return done;
+}
+
+void LlmSessionScheduler::finish(LlmSession *session, LlmSessionState state) {
+  if (session->slot_ >= 0) {
+    kv_cache_pool_.release(session->slot_);
+    running_[session->slot_] = nullptr;
+    session->slot_ = -1;
+  }
+  session->state_ = state;
+}
+
+base::Status LlmSessionScheduler::runInference(
+    inference::Inference *inference,
+    const std::vector<device::Tensor *> &inputs, device::Tensor *&logits,
+    device::Tensor *&presents) {
+  base::Status status = base::kStatusCodeOk;
+  if (inference->isInputDynamic()) {
+    base::ShapeMap shape_map;
+    for (auto input : inputs) {
+      shape_map[input->getName()] = input->getShape();
+    }
+    status = inference->reshape(shape_map);
+    NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "reshape failed!");
+  }
+  for (auto input : inputs) {
+    status = inference->setInputTensor(input->getName(), input);
+    NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                           "setInputTensor failed!");
+  }
+  status = inference->run();
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "run failed!");
+  logits = inference->getOutputTensorAfterRun("logits", device_type_, false);
+  presents =
+      inference->getOutputTensorAfterRun("presents", device_type_, false);
+  if (logits == nullptr || presents == nullptr) {
+    NNDEPLOY_LOGE("can't get logits or presents.\n");
+    DELETE_POINTER(logits);
+    DELETE_POINTER(presents);
+    return base::kStatusCodeErrorInvalidValue;
+  }
+  return status;
+}
+
+void LlmSessionScheduler::readEmbedding(int32_t token, float *dst) {
+  /* embeddings are stored as bf16, same as EmbeddingNode::genEmbedding */
+  size_t size = hidden_size_ * sizeof(int16_t);
+  fseek(embedding_file_, (long)token * size, SEEK_SET);
+  size_t bytes_read = fread(embedding_buffer_.data(), 1, size, embedding_file_);
+  if (bytes_read != size) {
+    NNDEPLOY_LOGE("read embedding of token %d failed.\n", token);
+    std::fill(dst, dst + hidden_size_, 0.0f);
+    return;
+  }
+  int16_t *ptr = (int16_t *)dst;
+  for (int j = 0; j < hidden_size_; j++) {
+    ptr[j * 2] = 0;
+    ptr[j * 2 + 1] = embedding_buffer_[j];
+  }
+}
+
+}  // namespace llm
+}  // namespace nndeploy
@@ -1,6 +1,7 @@
 
 #include "nndeploy/preprocess/cvtcolor_resize.h"
 
+#include "nndeploy/preprocess/fused_preprocess.h"
 #include "nndeploy/preprocess/util.h"
 
 namespace nndeploy {
@@ -30,6 +31,29 @@ base::Status CvtColorResize::run() {
   int h = dst->getHeight();
   int w = dst->getWidth();
 
+  // uint8图像走融合的单次遍历实现，不产生中间图像
+  if (src->depth() == CV_8U &&
+      src->channels() == getChannelByPixelType(tmp_param->src_pixel_type_) &&
+      FusedPreprocess::isSupport(
+          tmp_param->src_pixel_type_, tmp_param->dst_pixel_type_,
+          tmp_param->interp_type_, tmp_param->data_type_,
+          tmp_param->data_format_)) {
+    FusedPreprocessParam fused_param;
+    fused_param.src_pixel_type_ = tmp_param->src_pixel_type_;
+    fused_param.dst_pixel_type_ = tmp_param->dst_pixel_type_;
+    fused_param.setResize(src->cols, src->rows, 0, 0, w, h);
+    if (tmp_param->normalize_) {
+      fused_param.setNormalize(tmp_param->scale_, tmp_param->mean_,
+                               tmp_param->std_);
+    }
+    base::Status status = FusedPreprocess::run(
+        src->data, src->rows, src->cols, (int)src->step[0], fused_param, dst);
+    NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                           "FusedPreprocess::run failed");
+    outputs_[0]->notifyWritten(dst);
+    return base::kStatusCodeOk;
+  }
+
   cv::Mat tmp_cvt;
   if (tmp_param->src_pixel_type_ != tmp_param->dst_pixel_type_) {
     base::CvtColorType cvt_type = base::calCvtColorType(
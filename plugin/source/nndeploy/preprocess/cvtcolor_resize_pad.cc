@@ -1,6 +1,7 @@
 
 #include "nndeploy/preprocess/cvtcolor_resize_pad.h"
 
+#include "nndeploy/preprocess/fused_preprocess.h"
 #include "nndeploy/preprocess/opencv_util.h"
 #include "nndeploy/preprocess/util.h"
 
@@ -29,6 +30,51 @@ base::Status CvtColorResizePad::run() {
   int h = dst->getHeight();
   int w = dst->getWidth();
 
+  int origin_h = src->rows;
+  int origin_w = src->cols;
+  float scale_h = (float)h / origin_h;
+  float scale_w = (float)w / origin_w;
+  int new_h, new_w;
+  if (scale_h < scale_w) {
+    new_w = std::round(origin_w * scale_h);
+    new_h = h;
+  } else {
+    new_h = std::round(origin_h * scale_w);
+    new_w = w;
+  }
+
+  // uint8图像且常量填充时走融合的单次遍历实现，填充区域直接写归一化后的边界值
+  if (src->depth() == CV_8U &&
+      src->channels() == getChannelByPixelType(tmp_param->src_pixel_type_) &&
+      tmp_param->border_type_ == base::kBorderTypeConstant &&
+      FusedPreprocess::isSupport(
+          tmp_param->src_pixel_type_, tmp_param->dst_pixel_type_,
+          tmp_param->interp_type_, tmp_param->data_type_,
+          tmp_param->data_format_)) {
+    tmp_param->top_ = 0;
+    tmp_param->bottom_ = h - new_h - tmp_param->top_;
+    tmp_param->left_ = 0;
+    tmp_param->right_ = w - new_w - tmp_param->left_;
+    FusedPreprocessParam fused_param;
+    fused_param.src_pixel_type_ = tmp_param->src_pixel_type_;
+    fused_param.dst_pixel_type_ = tmp_param->dst_pixel_type_;
+    fused_param.setResize(origin_w, origin_h, tmp_param->left_,
+                          tmp_param->top_, new_w, new_h);
+    for (int i = 0; i < 4; ++i) {
+      fused_param.border_val_[i] = (float)tmp_param->border_val_.val_[i];
+    }
+    if (tmp_param->normalize_) {
+      fused_param.setNormalize(tmp_param->scale_, tmp_param->mean_,
+                               tmp_param->std_);
+    }
+    base::Status status = FusedPreprocess::run(
+        src->data, origin_h, origin_w, (int)src->step[0], fused_param, dst);
+    NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                           "FusedPreprocess::run failed");
+    outputs_[0]->notifyWritten(dst);
+    return base::kStatusCodeOk;
+  }
+
   cv::Mat tmp_cvt;
   if (tmp_param->src_pixel_type_ != tmp_param->dst_pixel_type_) {
     base::CvtColorType cvt_type = base::calCvtColorType(
@@ -42,19 +88,6 @@ base::Status CvtColorResizePad::run() {
   } else {
     tmp_cvt = *src;
   }
-
-  int origin_h = src->rows;
-  int origin_w = src->cols;
-  float scale_h = (float)h / origin_h;
-  float scale_w = (float)w / origin_w;
-  int new_h, new_w;
-  if (scale_h < scale_w) {
-    new_w = std::round(origin_w * scale_h);
-    new_h = h;
-  } else {
-    new_h = std::round(origin_h * scale_w);
-    new_w = w;
-  }
   cv::Mat tmp_resize;
   if (tmp_param->interp_type_ != base::kInterpTypeNotSupport) {
     int interp_type =
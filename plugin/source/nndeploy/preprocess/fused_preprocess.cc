@@ -0,0 +1,532 @@
+
+#include "nndeploy/preprocess/fused_preprocess.h"
+
+#include "nndeploy/base/half.h"
+#include "nndeploy/thread_pool/parallel.h"
+
+// cpu特性检测在op模块中，未编译op时x86上使用标量实现
+#if defined(ENABLE_NNDEPLOY_DEVICE_X86) && defined(ENABLE_NNDEPLOY_OP) && \
+    (defined(__x86_64__) || defined(_M_X64) || defined(__i386__))
+#include "nndeploy/op/x86/op_util.h"
+#define NNDEPLOY_PREPROCESS_FUSED_AVX2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define NNDEPLOY_PREPROCESS_FUSED_NEON
+#endif
+
+namespace nndeploy {
+namespace preprocess {
+
+namespace {
+
+// 像素类型的通道数以及R/G/B/A所在的通道，-1表示没有该通道
+struct PixelLayout {
+  int channel_ = 0;
+  int r_ = -1;
+  int g_ = -1;
+  int b_ = -1;
+  int a_ = -1;
+};
+
+bool getPixelLayout(base::PixelType pixel_type, PixelLayout &layout) {
+  switch (pixel_type) {
+    case base::kPixelTypeGRAY:
+      layout.channel_ = 1;
+      return true;
+    case base::kPixelTypeRGB:
+      layout = {3, 0, 1, 2, -1};
+      return true;
+    case base::kPixelTypeBGR:
+      layout = {3, 2, 1, 0, -1};
+      return true;
+    case base::kPixelTypeRGBA:
+      layout = {4, 0, 1, 2, 3};
+      return true;
+    case base::kPixelTypeBGRA:
+      layout = {4, 2, 1, 0, 3};
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief 目标通道c = sum_k weight[c][k] * 源通道k + bias[c]
+ * @note 灰度系数与cv::cvtColor一致，缺少的alpha通道补255
+ */
+bool getColorMatrix(base::PixelType src_pixel_type,
+                    base::PixelType dst_pixel_type, float weight[4][4],
+                    float bias[4], int &src_channel, int &dst_channel) {
+  PixelLayout src, dst;
+  if (!getPixelLayout(src_pixel_type, src) ||
+      !getPixelLayout(dst_pixel_type, dst)) {
+    return false;
+  }
+  src_channel = src.channel_;
+  dst_channel = dst.channel_;
+  for (int c = 0; c < 4; ++c) {
+    bias[c] = 0.0f;
+    for (int k = 0; k < 4; ++k) {
+      weight[c][k] = 0.0f;
+    }
+  }
+  if (dst.channel_ == 1) {
+    if (src.channel_ == 1) {
+      weight[0][0] = 1.0f;
+    } else {
+      weight[0][src.r_] = 0.299f;
+      weight[0][src.g_] = 0.587f;
+      weight[0][src.b_] = 0.114f;
+    }
+    return true;
+  }
+  int dst_index[3] = {dst.r_, dst.g_, dst.b_};
+  int src_index[3] = {src.r_, src.g_, src.b_};
+  for (int i = 0; i < 3; ++i) {
+    weight[dst_index[i]][src.channel_ == 1 ? 0 : src_index[i]] = 1.0f;
+  }
+  if (dst.a_ >= 0) {
+    if (src.a_ >= 0) {
+      weight[dst.a_][src.a_] = 1.0f;
+    } else {
+      bias[dst.a_] = 255.0f;
+    }
+  }
+  return true;
+}
+
+struct FusedKernel {
+  const uint8_t *src_;
+  int src_h_;
+  int src_w_;
+  int src_stride_;
+  int src_channel_;
+  int dst_channel_;
+  int dst_h_;
+  int dst_w_;
+  bool is_planar_;
+  bool is_fp16_;
+  void *dst_;
+
+  int roi_x0_, roi_x1_, roi_y0_, roi_y1_;
+  float scale_y_;
+  float offset_y_;
+  // roi内每一列的两个采样点(字节偏移)与第二个点的权重
+  std::vector<int> x0_, x1_;
+  std::vector<float> fx_;
+
+  float weight_[4][4];
+  float bias_[4];
+  float border_[4];  // 已归一化的边界值
+  bool use_simd_ = false;
+
+  template <int CS>
+  void resizeRow(int sy, float *row) const;
+  void resizeRow(int sy, float *row) const;
+  void blendRow(const float *a, const float *b, float fy, float **out,
+                int step) const;
+  void runRows(int y_begin, int y_end) const;
+};
+
+template <int CS>
+void FusedKernel::resizeRow(int sy, float *row) const {
+  const uint8_t *line = src_ + (size_t)sy * src_stride_;
+  int n = roi_x1_ - roi_x0_;
+  for (int x = 0; x < n; ++x) {
+    const uint8_t *p0 = line + x0_[x];
+    const uint8_t *p1 = line + x1_[x];
+    float f = fx_[x];
+    for (int k = 0; k < CS; ++k) {
+      float v0 = p0[k];
+      row[k * n + x] = v0 + (p1[k] - v0) * f;
+    }
+  }
+}
+
+void FusedKernel::resizeRow(int sy, float *row) const {
+  switch (src_channel_) {
+    case 1:
+      resizeRow<1>(sy, row);
+      break;
+    case 3:
+      resizeRow<3>(sy, row);
+      break;
+    default:
+      resizeRow<4>(sy, row);
+      break;
+  }
+}
+
+template <int CS, int CD>
+void blendRowScalar(const float *a, const float *b, int n, int begin,
+                    float fy, const float (*weight)[4], const float *bias,
+                    float **out, int step) {
+  for (int x = begin; x < n; ++x) {
+    float v[CS];
+    for (int k = 0; k < CS; ++k) {
+      float v0 = a[k * n + x];
+      v[k] = v0 + (b[k * n + x] - v0) * fy;
+    }
+    for (int c = 0; c < CD; ++c) {
+      float acc = bias[c];
+      for (int k = 0; k < CS; ++k) {
+        acc += weight[c][k] * v[k];
+      }
+      out[c][x * step] = acc;
+    }
+  }
+}
+
+template <int CS>
+void blendRowScalar(const float *a, const float *b, int n, int begin,
+                    int dst_channel, float fy, const float (*weight)[4],
+                    const float *bias, float **out, int step) {
+  switch (dst_channel) {
+    case 1:
+      blendRowScalar<CS, 1>(a, b, n, begin, fy, weight, bias, out, step);
+      break;
+    case 3:
+      blendRowScalar<CS, 3>(a, b, n, begin, fy, weight, bias, out, step);
+      break;
+    default:
+      blendRowScalar<CS, 4>(a, b, n, begin, fy, weight, bias, out, step);
+      break;
+  }
+}
+
+// 按通道数展开，通道数只有1/3/4
+void blendRowScalar(const float *a, const float *b, int n, int begin,
+                    int src_channel, int dst_channel, float fy,
+                    const float (*weight)[4], const float *bias, float **out,
+                    int step) {
+  switch (src_channel) {
+    case 1:
+      blendRowScalar<1>(a, b, n, begin, dst_channel, fy, weight, bias, out,
+                        step);
+      break;
+    case 3:
+      blendRowScalar<3>(a, b, n, begin, dst_channel, fy, weight, bias, out,
+                        step);
+      break;
+    default:
+      blendRowScalar<4>(a, b, n, begin, dst_channel, fy, weight, bias, out,
+                        step);
+      break;
+  }
+}
+
+#if defined(NNDEPLOY_PREPROCESS_FUSED_AVX2)
+NNDEPLOY_X86_TARGET_AVX2 int blendRowAvx2(const float *a, const float *b,
+                                          int n, int src_channel,
+                                          int dst_channel, float fy,
+                                          const float (*weight)[4],
+                                          const float *bias, float **out) {
+  __m256 vfy = _mm256_set1_ps(fy);
+  int x = 0;
+  for (; x + 8 <= n; x += 8) {
+    __m256 v[4];
+    for (int k = 0; k < src_channel; ++k) {
+      __m256 va = _mm256_loadu_ps(a + k * n + x);
+      __m256 vb = _mm256_loadu_ps(b + k * n + x);
+      v[k] = _mm256_fmadd_ps(_mm256_sub_ps(vb, va), vfy, va);
+    }
+    for (int c = 0; c < dst_channel; ++c) {
+      __m256 acc = _mm256_set1_ps(bias[c]);
+      for (int k = 0; k < src_channel; ++k) {
+        acc = _mm256_fmadd_ps(_mm256_set1_ps(weight[c][k]), v[k], acc);
+      }
+      _mm256_storeu_ps(out[c] + x, acc);
+    }
+  }
+  return x;
+}
+#elif defined(NNDEPLOY_PREPROCESS_FUSED_NEON)
+int blendRowNeon(const float *a, const float *b, int n, int src_channel,
+                 int dst_channel, float fy, const float (*weight)[4],
+                 const float *bias, float **out) {
+  float32x4_t vfy = vdupq_n_f32(fy);
+  int x = 0;
+  for (; x + 4 <= n; x += 4) {
+    float32x4_t v[4];
+    for (int k = 0; k < src_channel; ++k) {
+      float32x4_t va = vld1q_f32(a + k * n + x);
+      float32x4_t vb = vld1q_f32(b + k * n + x);
+      v[k] = vmlaq_f32(va, vsubq_f32(vb, va), vfy);
+    }
+    for (int c = 0; c < dst_channel; ++c) {
+      float32x4_t acc = vdupq_n_f32(bias[c]);
+      for (int k = 0; k < src_channel; ++k) {
+        acc = vmlaq_f32(acc, v[k], vdupq_n_f32(weight[c][k]));
+      }
+      vst1q_f32(out[c] + x, acc);
+    }
+  }
+  return x;
+}
+#endif
+
+void FusedKernel::blendRow(const float *a, const float *b, float fy,
+                           float **out, int step) const {
+  int n = roi_x1_ - roi_x0_;
+  int x = 0;
+  // 向量化只用于planar的输出
+  if (step == 1 && use_simd_) {
+#if defined(NNDEPLOY_PREPROCESS_FUSED_AVX2)
+    x = blendRowAvx2(a, b, n, src_channel_, dst_channel_, fy, weight_, bias_,
+                     out);
+#elif defined(NNDEPLOY_PREPROCESS_FUSED_NEON)
+    x = blendRowNeon(a, b, n, src_channel_, dst_channel_, fy, weight_, bias_,
+                     out);
+#endif
+  }
+  blendRowScalar(a, b, n, x, src_channel_, dst_channel_, fy, weight_, bias_,
+                 out, step);
+}
+
+void FusedKernel::runRows(int y_begin, int y_end) const {
+  int n = roi_x1_ - roi_x0_;
+  std::vector<float> rows(2 * (size_t)src_channel_ * std::max(n, 1));
+  float *row[2] = {rows.data(), rows.data() + (size_t)src_channel_ * n};
+  int row_index[2] = {-1, -1};
+  // fp16先写到fp32的行缓存，再整行转换
+  std::vector<float> line;
+  if (is_fp16_) {
+    line.resize((size_t)dst_channel_ * dst_w_);
+  }
+  size_t plane = (size_t)dst_h_ * dst_w_;
+
+  for (int y = y_begin; y < y_end; ++y) {
+    float *out[4];
+    int step = is_planar_ ? 1 : dst_channel_;
+    for (int c = 0; c < dst_channel_; ++c) {
+      if (is_fp16_) {
+        out[c] = line.data() + (is_planar_ ? c * dst_w_ : c);
+      } else if (is_planar_) {
+        out[c] = (float *)dst_ + c * plane + (size_t)y * dst_w_;
+      } else {
+        out[c] = (float *)dst_ + (size_t)y * dst_w_ * dst_channel_ + c;
+      }
+    }
+
+    bool inside = y >= roi_y0_ && y < roi_y1_ && n > 0;
+    for (int c = 0; c < dst_channel_; ++c) {
+      int x_end = inside ? roi_x0_ : dst_w_;
+      for (int x = 0; x < x_end; ++x) {
+        out[c][x * step] = border_[c];
+      }
+      for (int x = inside ? roi_x1_ : dst_w_; x < dst_w_; ++x) {
+        out[c][x * step] = border_[c];
+      }
+    }
+    if (inside) {
+      float sy = y * scale_y_ + offset_y_;
+      int y0 = (int)std::floor(sy);
+      float fy = sy - y0;
+      if (y0 < 0) {
+        y0 = 0;
+        fy = 0.0f;
+      } else if (y0 >= src_h_ - 1) {
+        y0 = src_h_ - 1;
+        fy = 0.0f;
+      }
+      int y1 = std::min(y0 + 1, src_h_ - 1);
+      // 缓存上一行的水平插值结果，相邻的目标行共享源图像的行
+      if (row_index[0] != y0) {
+        if (row_index[1] == y0) {
+          std::swap(row[0], row[1]);
+          std::swap(row_index[0], row_index[1]);
+        } else {
+          resizeRow(y0, row[0]);
+          row_index[0] = y0;
+        }
+      }
+      if (row_index[1] != y1) {
+        resizeRow(y1, row[1]);
+        row_index[1] = y1;
+      }
+      float *roi_out[4];
+      for (int c = 0; c < dst_channel_; ++c) {
+        roi_out[c] = out[c] + roi_x0_ * step;
+      }
+      blendRow(row[0], row[1], fy, roi_out, step);
+    }
+
+    if (is_fp16_) {
+      uint16_t *dst = (uint16_t *)dst_;
+      if (is_planar_) {
+        for (int c = 0; c < dst_channel_; ++c) {
+          base::convertFromFloatToFp16(line.data() + c * dst_w_,
+                                       dst + c * plane + (size_t)y * dst_w_,
+                                       dst_w_);
+        }
+      } else {
+        base::convertFromFloatToFp16(
+            line.data(), dst + (size_t)y * dst_w_ * dst_channel_,
+            dst_w_ * dst_channel_);
+      }
+    }
+  }
+}
+
+class FusedPreprocessBody : public thread_pool::ParallelLoopBody {
+ public:
+  FusedPreprocessBody(const FusedKernel &kernel, int rows_per_stripe)
+      : kernel_(kernel), rows_per_stripe_(rows_per_stripe) {}
+  virtual void operator()(const base::Range &range) const {
+    int y_begin = range.start_ * rows_per_stripe_;
+    int y_end = std::min(range.end_ * rows_per_stripe_, kernel_.dst_h_);
+    kernel_.runRows(y_begin, y_end);
+  }
+
+ private:
+  const FusedKernel &kernel_;
+  int rows_per_stripe_;
+};
+
+bool isFp16(const base::DataType &data_type) {
+  return data_type.code_ == base::kDataTypeCodeFp && data_type.bits_ == 16 &&
+         data_type.lanes_ == 1;
+}
+
+bool isFp32(const base::DataType &data_type) {
+  return data_type.code_ == base::kDataTypeCodeFp && data_type.bits_ == 32 &&
+         data_type.lanes_ == 1;
+}
+
+}  // namespace
+
+void FusedPreprocessParam::setResize(int src_w, int src_h, int roi_x,
+                                     int roi_y, int roi_w, int roi_h) {
+  scale_x_ = (float)src_w / roi_w;
+  scale_y_ = (float)src_h / roi_h;
+  offset_x_ = (0.5f - roi_x) * scale_x_ - 0.5f;
+  offset_y_ = (0.5f - roi_y) * scale_y_ - 0.5f;
+  roi_x_ = roi_x;
+  roi_y_ = roi_y;
+  roi_w_ = roi_w;
+  roi_h_ = roi_h;
+}
+
+void FusedPreprocessParam::setNormalize(const float *scale, const float *mean,
+                                        const float *std) {
+  for (int c = 0; c < 4; ++c) {
+    mul_[c] = scale[c] / std[c];
+    add_[c] = -mean[c] / std[c];
+  }
+}
+
+bool FusedPreprocess::isSupport(base::PixelType src_pixel_type,
+                                base::PixelType dst_pixel_type,
+                                base::InterpType interp_type,
+                                base::DataType data_type,
+                                base::DataFormat data_format) {
+  PixelLayout layout;
+  if (!getPixelLayout(src_pixel_type, layout) ||
+      !getPixelLayout(dst_pixel_type, layout)) {
+    return false;
+  }
+  if (interp_type != base::kInterpTypeLinear) {
+    return false;
+  }
+  if (!isFp32(data_type) && !isFp16(data_type)) {
+    return false;
+  }
+  return data_format == base::kDataFormatNCHW ||
+         data_format == base::kDataFormatNHWC;
+}
+
+base::Status FusedPreprocess::run(const uint8_t *src, int src_h, int src_w,
+                                  int src_stride,
+                                  const FusedPreprocessParam &param,
+                                  device::Tensor *dst) {
+  if (src == nullptr || dst == nullptr || src_h <= 0 || src_w <= 0) {
+    NNDEPLOY_LOGE("invalid src or dst.\n");
+    return base::kStatusCodeErrorInvalidParam;
+  }
+  FusedKernel kernel;
+  if (!getColorMatrix(param.src_pixel_type_, param.dst_pixel_type_,
+                      kernel.weight_, kernel.bias_, kernel.src_channel_,
+                      kernel.dst_channel_)) {
+    NNDEPLOY_LOGE("pixel type not support.\n");
+    return base::kStatusCodeErrorNotSupport;
+  }
+  base::DataType data_type = dst->getDataType();
+  base::DataFormat data_format = dst->getDataFormat();
+  if (!isSupport(param.src_pixel_type_, param.dst_pixel_type_,
+                 base::kInterpTypeLinear, data_type, data_format)) {
+    NNDEPLOY_LOGE("data type or data format not support.\n");
+    return base::kStatusCodeErrorNotSupport;
+  }
+  if (dst->getChannel() != kernel.dst_channel_) {
+    NNDEPLOY_LOGE("dst channel[%d] is not equal to dst pixel type[%d].\n",
+                  dst->getChannel(), kernel.dst_channel_);
+    return base::kStatusCodeErrorInvalidParam;
+  }
+  kernel.src_ = src;
+  kernel.src_h_ = src_h;
+  kernel.src_w_ = src_w;
+  kernel.src_stride_ = src_stride;
+  kernel.dst_h_ = dst->getHeight();
+  kernel.dst_w_ = dst->getWidth();
+  kernel.is_planar_ = data_format == base::kDataFormatNCHW;
+  kernel.is_fp16_ = isFp16(data_type);
+  kernel.dst_ = dst->getData();
+  if (kernel.dst_ == nullptr) {
+    NNDEPLOY_LOGE("dst is not allocated.\n");
+    return base::kStatusCodeErrorInvalidParam;
+  }
+
+  int roi_w = param.roi_w_ < 0 ? kernel.dst_w_ - param.roi_x_ : param.roi_w_;
+  int roi_h = param.roi_h_ < 0 ? kernel.dst_h_ - param.roi_y_ : param.roi_h_;
+  kernel.roi_x0_ = std::max(param.roi_x_, 0);
+  kernel.roi_y0_ = std::max(param.roi_y_, 0);
+  kernel.roi_x1_ = std::max(std::min(param.roi_x_ + roi_w, kernel.dst_w_),
+                            kernel.roi_x0_);
+  kernel.roi_y1_ = std::max(std::min(param.roi_y_ + roi_h, kernel.dst_h_),
+                            kernel.roi_y0_);
+  kernel.scale_y_ = param.scale_y_;
+  kernel.offset_y_ = param.offset_y_;
+  for (int c = 0; c < kernel.dst_channel_; ++c) {
+    for (int k = 0; k < kernel.src_channel_; ++k) {
+      kernel.weight_[c][k] *= param.mul_[c];
+    }
+    kernel.bias_[c] = kernel.bias_[c] * param.mul_[c] + param.add_[c];
+    kernel.border_[c] = param.border_val_[c] * param.mul_[c] + param.add_[c];
+  }
+
+  int n = kernel.roi_x1_ - kernel.roi_x0_;
+  kernel.x0_.resize(n);
+  kernel.x1_.resize(n);
+  kernel.fx_.resize(n);
+  for (int i = 0; i < n; ++i) {
+    float sx = (kernel.roi_x0_ + i) * param.scale_x_ + param.offset_x_;
+    int x0 = (int)std::floor(sx);
+    float fx = sx - x0;
+    if (x0 < 0) {
+      x0 = 0;
+      fx = 0.0f;
+    } else if (x0 >= src_w - 1) {
+      x0 = src_w - 1;
+      fx = 0.0f;
+    }
+    kernel.x0_[i] = x0 * kernel.src_channel_;
+    kernel.x1_[i] = std::min(x0 + 1, src_w - 1) * kernel.src_channel_;
+    kernel.fx_[i] = fx;
+  }
+
+#if defined(NNDEPLOY_PREPROCESS_FUSED_AVX2)
+  kernel.use_simd_ = op::getX86IsaType() >= op::kX86IsaTypeAvx2;
+#elif defined(NNDEPLOY_PREPROCESS_FUSED_NEON)
+  kernel.use_simd_ = true;
+#endif
+
+  // 每块至少32行，块边界处的源图像行会被相邻两块各读一次
+  const int rows_per_stripe = 32;
+  int stripes = (kernel.dst_h_ + rows_per_stripe - 1) / rows_per_stripe;
+  FusedPreprocessBody body(kernel, rows_per_stripe);
+  thread_pool::parallelFor(base::Range(0, stripes), body);
+  return base::kStatusCodeOk;
+}
+
+}  // namespace preprocess
+}  // namespace nndeploy
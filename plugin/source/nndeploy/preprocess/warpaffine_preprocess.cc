@@ -1,5 +1,6 @@
 #include "nndeploy/preprocess/warpaffine_preprocess.h"
 
+#include "nndeploy/preprocess/fused_preprocess.h"
 #include "nndeploy/preprocess/opencv_util.h"
 #include "nndeploy/preprocess/util.h"
 
@@ -46,6 +47,44 @@ base::Status WarpaffinePreprocess::run() {
   i2d[4] = scale;
   i2d[5] = (-scale * origin_h + h + scale - 1) * 0.5;
 
+  // 只有缩放与平移，uint8图像走融合的单次遍历实现
+  if (src->type() == CV_8UC3 &&
+      FusedPreprocess::isSupport(base::kPixelTypeBGR, base::kPixelTypeRGB,
+                                 base::kInterpTypeLinear, desc.data_type_,
+                                 desc.data_format_)) {
+    FusedPreprocessParam fused_param;
+    // 与下面的实现一致：输出通道与源通道顺序相反
+    fused_param.src_pixel_type_ = base::kPixelTypeBGR;
+    fused_param.dst_pixel_type_ = base::kPixelTypeRGB;
+    fused_param.scale_x_ = 1.0f / scale;
+    fused_param.offset_x_ = -i2d[2] / scale;
+    fused_param.scale_y_ = 1.0f / scale;
+    fused_param.offset_y_ = -i2d[5] / scale;
+    // 采样点落在源图像内的目标区域，之外为常量边界
+    int x0 = std::max((int)std::ceil(i2d[2] - 0.5f * scale), 0);
+    int x1 =
+        std::min((int)std::floor(i2d[2] + (origin_w - 0.5f) * scale) + 1, w);
+    int y0 = std::max((int)std::ceil(i2d[5] - 0.5f * scale), 0);
+    int y1 =
+        std::min((int)std::floor(i2d[5] + (origin_h - 0.5f) * scale) + 1, h);
+    fused_param.roi_x_ = x0;
+    fused_param.roi_y_ = y0;
+    fused_param.roi_w_ = std::max(x1 - x0, 0);
+    fused_param.roi_h_ = std::max(y1 - y0, 0);
+    // 与下面的实现一致：mean_按源通道索引，std_按源通道索引+1，不乘scale_
+    for (int i = 0; i < 3; ++i) {
+      fused_param.mul_[i] = 1.0f / tmp_param->std_[3 - i];
+      fused_param.add_[i] = -tmp_param->mean_[2 - i] / tmp_param->std_[3 - i];
+      fused_param.border_val_[i] = (float)tmp_param->const_value_;
+    }
+    base::Status status = FusedPreprocess::run(
+        src->data, origin_h, origin_w, (int)src->step[0], fused_param, dst);
+    NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                           "FusedPreprocess::run failed");
+    outputs_[0]->notifyWritten(dst);
+    return base::kStatusCodeOk;
+  }
+
   cv::Mat m2x3_i2d(2, 3, CV_32F, i2d);
   cv::Mat m2x3_d2i(2, 3, CV_32F, d2i);
   cv::invertAffineTransform(m2x3_i2d, m2x3_d2i);
@@ -2,7 +2,6 @@
 #include "nndeploy/stable_diffusion/ddim_scheduler.h"
 
 #include "nndeploy/infer/infer.h"
-#include "nndeploy/op/op_binary.h"
 #include "nndeploy/stable_diffusion/scheduler.h"
 
 namespace nndeploy {
@@ -19,24 +18,8 @@ DDIMScheduler::~DDIMScheduler() {}
 base::Status DDIMScheduler::init() {
   base::Status status = base::kStatusCodeOk;
 
-  // # this schedule is very specific to the latent diffusion model.
-  // ##计算betas，它们是方差的平方根，从beta_start的平方根到beta_end的平方根
-  std::vector<float> betas;
-  betas.resize(scheduler_param_->num_train_timesteps_);
-  customLinspace(std::sqrt(scheduler_param_->beta_start_),
-                 std::sqrt(scheduler_param_->beta_end_),
-                 scheduler_param_->num_train_timesteps_, betas);
-  // ## 计算alphas，它们是1减去beta的平方
-  std::vector<float> alphas(scheduler_param_->num_train_timesteps_, 0.0f);
-  for (int i = 0; i < scheduler_param_->num_train_timesteps_; i++) {
-    alphas[i] = 1 - betas[i] * betas[i];
-  }
-  // ## alphas_cumprod_
-  alphas_cumprod_.resize(scheduler_param_->num_train_timesteps_, 0.0f);
-  alphas_cumprod_[0] = alphas[0];
-  for (int i = 1; i < scheduler_param_->num_train_timesteps_; i++) {
-    alphas_cumprod_[i] = alphas_cumprod_[i - 1] * alphas[i];
-  }
+  // alphas_cumprod_
+  getAlphasCumprod(scheduler_param_, alphas_cumprod_);
 
   // # At every step in ddim, we are looking into the previousalphas_cumprod
   // For the final step, there is no previous alphas_cumprod because we are
@@ -60,6 +43,7 @@ base::Status DDIMScheduler::init() {
 
 base::Status DDIMScheduler::deinit() {
   base::Status status = base::kStatusCodeOk;
+  arena_.clear();
   return status;
 }
 
@@ -126,64 +110,46 @@ base::Status DDIMScheduler::configure() {
  * # - eta -> η
  * # - pred_sample_direction -> "direction pointing to x_t"
  * # - pred_prev_sample -> "x_t-1"
+ * # output为模型输出，x_t-1写回sample，output不被修改
+ * # 各步骤都是sample与output的线性组合(clip除外)，先算出系数，
+ *   再由fusedSchedulerStep一次遍历完成，不产生临时张量
  */
 base::Status DDIMScheduler::step(
     device::Tensor *output, device::Tensor *sample, int idx, float timestep,
     float eta, bool use_clipped_model_output, std::mt19937 generator,
     device::Tensor *variance_noise) {  // discussion
   base::Status status = base::kStatusCodeOk;
-  device::Device *host_device = device::getDefaultHostDevice();
-
-  //
-  int prev_idx = idx + 1;
-
-  float alpha_prod_t = alphas_cumprod_[idx];
-  device::TensorDesc alpha_prod_t_desc(base::dataTypeOf<float>(),
-                                       base::kDataFormatN, {1});
-  device::Tensor alpha_prod_t_tensor(host_device, alpha_prod_t_desc);
-  alpha_prod_t_tensor.set(alpha_prod_t);
-  float alpha_prod_t_sqrt = std::sqrt(alpha_prod_t);
-  device::Tensor alpha_prod_t_sqrt_tensor(host_device, alpha_prod_t_desc);
-  alpha_prod_t_sqrt_tensor.set(alpha_prod_t_sqrt);
-
-  float alpha_prod_t_prev = (prev_idx < scheduler_param_->num_train_timesteps_)
-                                ? alphas_cumprod_[prev_idx]
-                                : final_alpha_cumprod_;
-  device::TensorDesc alpha_prod_t_prev_desc(base::dataTypeOf<float>(),
-                                            base::kDataFormatN, {1});
-  device::Tensor alpha_prod_t_prev_tensor(host_device, alpha_prod_t_prev_desc);
-  alpha_prod_t_prev_tensor.set(alpha_prod_t_prev);
+  arena_.reset();
 
-  float beta_prod_t = 1.0 - alpha_prod_t;
-  device::TensorDesc beta_prod_t_desc(base::dataTypeOf<float>(),
-                                      base::kDataFormatN, {1});
-  device::Tensor beta_prod_t_tensor(host_device, beta_prod_t_desc);
-  beta_prod_t_tensor.set(beta_prod_t);
-  float beta_prod_t_sqrt = std::sqrt(beta_prod_t);
-  device::Tensor beta_prod_t_sqrt_tensor(host_device, beta_prod_t_desc);
-  beta_prod_t_sqrt_tensor.set(beta_prod_t_sqrt);
+  // 1. get previous step value (=t-1)
+  int64_t step_ratio = (int64_t)scheduler_param_->num_train_timesteps_ /
+                       (int64_t)scheduler_param_->num_inference_steps_;
+  int64_t t = (int64_t)timesteps_[idx];
+  int64_t prev_t = t - step_ratio;
+
+  // 2. compute alphas, betas
+  double alpha_prod_t = alphas_cumprod_[t];
+  double alpha_prod_t_prev =
+      (prev_t >= 0) ? alphas_cumprod_[prev_t] : final_alpha_cumprod_;
+  double alpha_sqrt = std::sqrt(alpha_prod_t);
+  double beta_sqrt = std::sqrt(1.0 - alpha_prod_t);
 
   // 3. compute predicted original sample from predicted noise also called
   // "predicted x_0" of formula(12) from https: //arxiv.org/pdf/2010.02502.pdf
-  device::Tensor pred_original_sample(output->getDevice(), output->getDesc());
+  SchedulerStepCoeff coeff;
   if (scheduler_param_->prediction_type_ == "epsilon") {
-    device::Tensor tmp1(output->getDevice(), output->getDesc());
-    op::mul(&beta_prod_t_sqrt_tensor, output, &tmp1);
-    device::Tensor tmp2(output->getDevice(), output->getDesc());
-    op::sub(sample, &tmp1, &tmp2);
-    op::div(&tmp2, &tmp1, &alpha_prod_t_sqrt_tensor);
+    coeff.x0_sample_ = 1.0 / alpha_sqrt;
+    coeff.x0_model_ = -beta_sqrt / alpha_sqrt;
+    coeff.eps_model_ = 1.0f;
   } else if (scheduler_param_->prediction_type_ == "sample") {
-    output->copyTo(&pred_original_sample);
+    coeff.x0_model_ = 1.0f;
+    coeff.eps_sample_ = 1.0 / beta_sqrt;
+    coeff.eps_x0_ = -alpha_sqrt / beta_sqrt;
   } else if (scheduler_param_->prediction_type_ == "v_prediction") {
-    device::Tensor sample_tmp(sample->getDevice(), sample->getDesc());
-    op::mul(&alpha_prod_t_sqrt_tensor, sample, &sample_tmp);
-    device::Tensor model_output_tmp(output->getDevice(), output->getDesc());
-    op::mul(&beta_prod_t_sqrt_tensor, output, &model_output_tmp);
-    op::sub(&sample_tmp, &model_output_tmp, &pred_original_sample);
-
-    op::mul(&beta_prod_t_sqrt_tensor, sample, &sample_tmp);
-    op::mul(&alpha_prod_t_sqrt_tensor, output, &model_output_tmp);
-    op::add(&sample_tmp, &model_output_tmp, output);
+    coeff.x0_sample_ = alpha_sqrt;
+    coeff.x0_model_ = -beta_sqrt;
+    coeff.eps_sample_ = beta_sqrt;
+    coeff.eps_model_ = alpha_sqrt;
   } else {
     NNDEPLOY_LOGE("Invalid prediction type!\n");
     return base::kStatusCodeErrorInvalidValue;
@@ -191,69 +157,69 @@ base::Status DDIMScheduler::step(
 
   // # 4. Clip "predicted x_0"
   if (scheduler_param_->clip_sample_) {
-    op::clamp(&pred_original_sample, -1.0f, 1.0f, &pred_original_sample);
+    coeff.clip_min_ = -1.0f;
+    coeff.clip_max_ = 1.0f;
   }
 
   // # 5. compute variance : "sigma_t(η)"->see formula(16)
   // σ_t = sqrt((1 − α_t−1) / (1 − α_t)) * sqrt(1 − α_t / α_t−1)
-  float variance = variance_[idx];
-  float std_dev_t = eta * sqrtf(variance);
+  double variance = variance_[idx];
+  double std_dev_t = eta * std::sqrt(variance);
 
   if (use_clipped_model_output) {
-    // the output is always re-derived from the clipped x_0 in Glide
-    device::Tensor pred_original_sample_tmp(pred_original_sample.getDevice(),
-                                            pred_original_sample.getDesc());
-    op::mul(&alpha_prod_t_sqrt_tensor, &pred_original_sample,
-            &pred_original_sample_tmp);
-    device::Tensor sample_tmp(sample->getDevice(), sample->getDesc());
-    op::sub(sample, &pred_original_sample_tmp, &sample_tmp);
-    op::div(&sample_tmp, &beta_prod_t_sqrt_tensor, output);
+    // the pred_epsilon is always re-derived from the clipped x_0 in Glide
+    coeff.eps_sample_ = 1.0 / beta_sqrt;
+    coeff.eps_model_ = 0.0f;
+    coeff.eps_x0_ = -alpha_sqrt / beta_sqrt;
   }
 
   // # 6. compute "direction pointing to x_t" of formula (12) from
   // https://arxiv.org/pdf/2010.02502.pdf
-  float coff_model_output =
-      std::sqrt(1 - alpha_prod_t_prev - std_dev_t * std_dev_t);
-  device::Tensor coff_model_output_tensor(host_device, beta_prod_t_desc);
-  coff_model_output_tensor.set(coff_model_output);
-  device::Tensor pred_sample_direction(output->getDevice(), output->getDesc());
-  op::mul(&coff_model_output_tensor, output, &pred_sample_direction);
+  coeff.out_eps_ = std::sqrt(
+      std::max(1.0 - alpha_prod_t_prev - std_dev_t * std_dev_t, 0.0));
 
   // # 7. compute x_t without "random noise" of formula(12) from https:
   // //arxiv.org/pdf/2010.02502.pdf
-  float alpha_prod_t_prev_sqrt = std::sqrt(alpha_prod_t_prev);
-  device::Tensor pred_original_sample_temp;
-  // pred_original_sample_temp = alpha_prod_t_prev_sqrt * pred_original_sample;
-  // op::mul
-  device::Tensor prev_sample;
-  // prev_sample = pred_original_sample_temp + pred_sample_direction;
-  // op::add
+  coeff.out_x0_ = std::sqrt(alpha_prod_t_prev);
+
+  if (eta > 0.0f) {
+    if (variance_noise == nullptr) {
+      variance_noise = arena_.allocate(sample->getDevice(), sample->getDesc());
+      // step按值传入generator，混入idx使每一步的噪声不同
+      status = device::randnTensor(
+          generator, 0.0f, 1.0f, variance_noise,
+          (int64_t)(generator() + (uint32_t)idx * 0x9E3779B9u));
+      NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "randn failed!");
+    }
+    coeff.out_noise_ = std_dev_t;
+  } else {
+    variance_noise = nullptr;
+  }
+
+  status = fusedSchedulerStep(coeff, output, sample, nullptr, variance_noise);
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                         "fusedSchedulerStep failed");
 
   return status;
 }
 
+/**
+ * @brief init_latents = sqrt(α_t) * init_latents + sqrt(1 - α_t) * noise
+ * @note 把noise当作模型输出(eps)，复用fusedSchedulerStep
+ */
 base::Status DDIMScheduler::addNoise(device::Tensor *init_latents,
                                      device::Tensor *noise, int idx,
                                      int latent_timestep) {
   base::Status status = base::kStatusCodeOk;
-  device::Device *host_device = device::getDefaultHostDevice();
-
-  float sqrt_alpha_prod = std::sqrt(alphas_cumprod_[idx]);
-  device::TensorDesc sqrt_alpha_prod_desc(base::dataTypeOf<float>(),
-                                          base::kDataFormatN, {1});
-  device::Tensor sqrt_alpha_prod_tensor(host_device, sqrt_alpha_prod_desc);
-  sqrt_alpha_prod_tensor.set(sqrt_alpha_prod);
-  op::mul(&sqrt_alpha_prod_tensor, init_latents, init_latents);
-
-  float sqrt_one_minus_alpha_prod = std::sqrt(1.0f - alphas_cumprod_[idx]);
-  device::TensorDesc sqrt_one_minus_alpha_prod_desc(base::dataTypeOf<float>(),
-                                                    base::kDataFormatN, {1});
-  device::Tensor sqrt_one_minus_alpha_prod_tensor(host_device,
-                                                  sqrt_alpha_prod_desc);
-  sqrt_one_minus_alpha_prod_tensor.set(sqrt_one_minus_alpha_prod);
-  op::mul(&sqrt_one_minus_alpha_prod_tensor, noise, noise);
-
-  op::add(init_latents, noise, init_latents);
+
+  SchedulerStepCoeff coeff;
+  coeff.x0_sample_ = 1.0f;
+  coeff.eps_model_ = 1.0f;
+  coeff.out_x0_ = std::sqrt(alphas_cumprod_[idx]);
+  coeff.out_eps_ = std::sqrt(1.0f - alphas_cumprod_[idx]);
+  status = fusedSchedulerStep(coeff, noise, init_latents);
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                         "fusedSchedulerStep failed");
 
   return status;
 }
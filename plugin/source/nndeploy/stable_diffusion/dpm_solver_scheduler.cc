@@ -0,0 +1,246 @@
+
+#include "nndeploy/stable_diffusion/dpm_solver_scheduler.h"
+
+#include "nndeploy/stable_diffusion/scheduler.h"
+
+namespace nndeploy {
+namespace stable_diffusion {
+
+TypeSchedulerRegister<TypeSchedulerCreator<DPMSolverScheduler>>
+    g_dpm_solver_scheduler_register(kSchedulerTypeDPM);
+
+DPMSolverScheduler::DPMSolverScheduler(SchedulerType scheduler_type)
+    : Scheduler(scheduler_type) {}
+
+DPMSolverScheduler::~DPMSolverScheduler() {
+  if (history_ != nullptr) {
+    delete history_;
+    history_ = nullptr;
+  }
+}
+
+base::Status DPMSolverScheduler::init() {
+  base::Status status = base::kStatusCodeOk;
+
+  if (scheduler_param_->algorithm_type_ != "dpmsolver++") {
+    NNDEPLOY_LOGE("algorithm_type %s is not supported!\n",
+                  scheduler_param_->algorithm_type_.c_str());
+    return base::kStatusCodeErrorNotSupport;
+  }
+  if (scheduler_param_->solver_type_ != "midpoint" &&
+      scheduler_param_->solver_type_ != "heun") {
+    NNDEPLOY_LOGE("solver_type %s is not supported!\n",
+                  scheduler_param_->solver_type_.c_str());
+    return base::kStatusCodeErrorNotSupport;
+  }
+  if (scheduler_param_->solver_order_ != 1 &&
+      scheduler_param_->solver_order_ != 2) {
+    NNDEPLOY_LOGE("solver_order %d is not supported!\n",
+                  scheduler_param_->solver_order_);
+    return base::kStatusCodeErrorNotSupport;
+  }
+  if (scheduler_param_->thresholding_) {
+    NNDEPLOY_LOGE("thresholding is not supported!\n");
+    return base::kStatusCodeErrorNotSupport;
+  }
+
+  getAlphasCumprod(scheduler_param_, alphas_cumprod_);
+
+  return status;
+}
+
+base::Status DPMSolverScheduler::deinit() {
+  base::Status status = base::kStatusCodeOk;
+  if (history_ != nullptr) {
+    delete history_;
+    history_ = nullptr;
+  }
+  last_idx_ = -1;
+  return status;
+}
+
+base::Status DPMSolverScheduler::setTimesteps() {
+  base::Status status = base::kStatusCodeOk;
+  int num_train_timesteps = scheduler_param_->num_train_timesteps_;
+  int num_inference_steps = scheduler_param_->num_inference_steps_;
+  if (num_inference_steps <= 0 || num_inference_steps > num_train_timesteps) {
+    NNDEPLOY_LOGE("num_inference_steps %d is invalid!\n", num_inference_steps);
+    return base::kStatusCodeErrorInvalidParam;
+  }
+  timesteps_.resize(num_inference_steps);
+  sigmas_.resize(num_inference_steps + 1);
+  std::vector<double> log_sigmas(num_train_timesteps);
+  for (int i = 0; i < num_train_timesteps; i++) {
+    log_sigmas[i] = 0.5 * std::log((1.0 - alphas_cumprod_[i]) /
+                                   alphas_cumprod_[i]);
+  }
+  if (scheduler_param_->use_karras_sigmas_) {
+    // sigma^(1/rho)在[sigma_max, sigma_min]上均匀取值，rho = 7，
+    // 时间步由log(sigma)在整数时间步之间线性插值反推，可以是小数
+    const double rho = 7.0;
+    double max_inv_rho = std::exp(log_sigmas.back() / rho);
+    double min_inv_rho = std::exp(log_sigmas.front() / rho);
+    for (int i = 0; i < num_inference_steps; i++) {
+      double ramp = num_inference_steps == 1
+                        ? 0.0
+                        : (double)i / (num_inference_steps - 1);
+      double sigma =
+          std::pow(max_inv_rho + ramp * (min_inv_rho - max_inv_rho), rho);
+      double log_sigma = std::log(sigma);
+      int low = (int)(std::upper_bound(log_sigmas.begin(), log_sigmas.end(),
+                                       log_sigma) -
+                      log_sigmas.begin()) -
+                1;
+      low = std::min(std::max(low, 0), num_train_timesteps - 2);
+      double w = (log_sigma - log_sigmas[low]) /
+                 (log_sigmas[low + 1] - log_sigmas[low]);
+      w = std::min(std::max(w, 0.0), 1.0);
+      timesteps_[i] = (float)(low + w);
+      sigmas_[i] = (float)sigma;
+    }
+    // 最后一个sigma已经是sigma_min，终点为0
+    sigmas_[num_inference_steps] = 0.0f;
+  } else {
+    // linspace(0, num_train_timesteps - 1, num_inference_steps + 1)
+    // .round()[::-1][:-1]
+    for (int i = 0; i < num_inference_steps; i++) {
+      int64_t t = (int64_t)std::round((double)(num_train_timesteps - 1) *
+                                      (num_inference_steps - i) /
+                                      num_inference_steps);
+      timesteps_[i] = (float)t;
+      sigmas_[i] = std::exp(log_sigmas[t]);
+    }
+    // final_sigmas_type：sigma_min(与DDIM的final_alpha_cumprod_一致)或zero
+    sigmas_[num_inference_steps] = scheduler_param_->set_alpha_to_one_
+                                       ? 0.0f
+                                       : std::exp(log_sigmas.front());
+  }
+  last_idx_ = -1;
+  return status;
+}
+
+device::Tensor *DPMSolverScheduler::scaleModelInput(device::Tensor *sample,
+                                                    int index) {
+  return sample;
+}
+
+base::Status DPMSolverScheduler::configure() { return base::kStatusCodeOk; }
+
+/**
+ * @brief
+ * @note
+ * # 记α_t = 1 / sqrt(σ_t^2 + 1)，σ'_t = σ_t * α_t，λ_t = log(α_t / σ'_t)，
+ *   h = λ_t - λ_s0 = log(σ_s0 / σ_t)，exp(-h) = σ_t / σ_s0
+ * # 一阶：x_t = (σ'_t / σ'_s0) * x - α_t * (exp(-h) - 1) * D0
+ * # 二阶：D1 = (D0 - x0_s1) / r0，r0 = h_0 / h，
+ *   midpoint: x_t += -0.5 * α_t * (exp(-h) - 1) * D1
+ *   heun: x_t += α_t * ((exp(-h) - 1) / h + 1) * D1
+ * # 都是sample、x0与上一步x0的线性组合，由fusedSchedulerStep一次遍历完成
+ */
+base::Status DPMSolverScheduler::step(device::Tensor *output,
+                                      device::Tensor *sample, int idx,
+                                      float timestep, float eta,
+                                      bool use_clipped_model_output,
+                                      std::mt19937 generator,
+                                      device::Tensor *variance_noise) {
+  base::Status status = base::kStatusCodeOk;
+  int num_inference_steps = (int)timesteps_.size();
+  if (idx < 0 || idx >= num_inference_steps) {
+    NNDEPLOY_LOGE("idx %d is out of range!\n", idx);
+    return base::kStatusCodeErrorInvalidParam;
+  }
+
+  // history_保存fp32的x0，形状变化时重新分配
+  device::TensorDesc history_desc = sample->getDesc();
+  history_desc.data_type_ = base::dataTypeOf<float>();
+  if (history_ == nullptr || history_->getShape() != history_desc.shape_) {
+    if (history_ != nullptr) {
+      delete history_;
+    }
+    history_ = new device::Tensor(device::getDefaultHostDevice(),
+                                  history_desc, "dpm_solver_history");
+    last_idx_ = -1;
+  }
+  bool has_history = idx > 0 && idx == last_idx_ + 1;
+  if (!has_history) {
+    // 一阶时不读history_，清零避免未初始化的内存中有NaN
+    history_->set(0.0f);
+  }
+
+  double sigma_s0 = sigmas_[idx];
+  double sigma_t = sigmas_[idx + 1];
+  double alpha_s0 = 1.0 / std::sqrt(sigma_s0 * sigma_s0 + 1.0);
+  double alpha_t = 1.0 / std::sqrt(sigma_t * sigma_t + 1.0);
+  double vp_sigma_s0 = sigma_s0 * alpha_s0;
+
+  // 模型输出转为x0(data prediction)
+  SchedulerStepCoeff coeff;
+  if (scheduler_param_->prediction_type_ == "epsilon") {
+    coeff.x0_sample_ = 1.0 / alpha_s0;
+    coeff.x0_model_ = -vp_sigma_s0 / alpha_s0;
+  } else if (scheduler_param_->prediction_type_ == "sample") {
+    coeff.x0_model_ = 1.0f;
+  } else if (scheduler_param_->prediction_type_ == "v_prediction") {
+    coeff.x0_sample_ = alpha_s0;
+    coeff.x0_model_ = -vp_sigma_s0;
+  } else {
+    NNDEPLOY_LOGE("Invalid prediction type!\n");
+    return base::kStatusCodeErrorInvalidValue;
+  }
+  if (scheduler_param_->clip_sample_) {
+    coeff.clip_min_ = -1.0f;
+    coeff.clip_max_ = 1.0f;
+  }
+
+  double exp_neg_h = sigma_t / sigma_s0;
+  double k = alpha_t * (1.0 - exp_neg_h);
+  coeff.out_sample_ = (sigma_t * alpha_t) / vp_sigma_s0;
+  coeff.out_x0_ = k;
+  // sigma为0时h为无穷大，只能用一阶；步数较少时最后一步用一阶更稳定
+  bool lower_order_final = scheduler_param_->lower_order_final &&
+                           idx == num_inference_steps - 1 &&
+                           num_inference_steps < 15;
+  bool second_order = scheduler_param_->solver_order_ == 2 && has_history &&
+                      sigma_t > 0.0 && !lower_order_final;
+  if (second_order) {
+    double sigma_s1 = sigmas_[idx - 1];
+    double h = std::log(sigma_s0 / sigma_t);
+    double h_0 = std::log(sigma_s1 / sigma_s0);
+    double r0 = h_0 / h;
+    // D1的系数
+    double d1 = scheduler_param_->solver_type_ == "midpoint"
+                    ? 0.5 * k
+                    : alpha_t * ((exp_neg_h - 1.0) / h + 1.0);
+    coeff.out_x0_ = k + d1 / r0;
+    coeff.out_history_ = -d1 / r0;
+  }
+
+  status = fusedSchedulerStep(coeff, output, sample, history_);
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                         "fusedSchedulerStep failed");
+  last_idx_ = idx;
+
+  return status;
+}
+
+base::Status DPMSolverScheduler::addNoise(device::Tensor *init_latents,
+                                          device::Tensor *noise, int idx,
+                                          int latent_timestep) {
+  base::Status status = base::kStatusCodeOk;
+
+  SchedulerStepCoeff coeff;
+  coeff.x0_sample_ = 1.0f;
+  coeff.eps_model_ = 1.0f;
+  coeff.out_x0_ = std::sqrt(alphas_cumprod_[idx]);
+  coeff.out_eps_ = std::sqrt(1.0f - alphas_cumprod_[idx]);
+  status = fusedSchedulerStep(coeff, noise, init_latents);
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                         "fusedSchedulerStep failed");
+
+  return status;
+}
+
+std::vector<float> &DPMSolverScheduler::getTimestep() { return timesteps_; }
+
+}  // namespace stable_diffusion
+}  // namespace nndeploy
@@ -0,0 +1,191 @@
+
+#include "nndeploy/stable_diffusion/euler_ancestral_scheduler.h"
+
+#include "nndeploy/op/elementwise_kernel.h"
+#include "nndeploy/stable_diffusion/scheduler.h"
+
+namespace nndeploy {
+namespace stable_diffusion {
+
+TypeSchedulerRegister<TypeSchedulerCreator<EulerAncestralScheduler>>
+    g_euler_ancestral_scheduler_register(kSchedulerTypeEulerA);
+
+EulerAncestralScheduler::EulerAncestralScheduler(SchedulerType scheduler_type)
+    : Scheduler(scheduler_type) {}
+
+EulerAncestralScheduler::~EulerAncestralScheduler() {}
+
+base::Status EulerAncestralScheduler::init() {
+  base::Status status = base::kStatusCodeOk;
+  getAlphasCumprod(scheduler_param_, alphas_cumprod_);
+  return status;
+}
+
+base::Status EulerAncestralScheduler::deinit() {
+  base::Status status = base::kStatusCodeOk;
+  input_arena_.clear();
+  noise_arena_.clear();
+  return status;
+}
+
+base::Status EulerAncestralScheduler::setTimesteps() {
+  base::Status status = base::kStatusCodeOk;
+  int num_train_timesteps = scheduler_param_->num_train_timesteps_;
+  int num_inference_steps = scheduler_param_->num_inference_steps_;
+  if (num_inference_steps <= 0) {
+    NNDEPLOY_LOGE("num_inference_steps %d is invalid!\n", num_inference_steps);
+    return base::kStatusCodeErrorInvalidParam;
+  }
+  // linspace(0, num_train_timesteps - 1, num_inference_steps)[::-1]
+  timesteps_.resize(num_inference_steps);
+  sigmas_.resize(num_inference_steps + 1);
+  for (int i = 0; i < num_inference_steps; i++) {
+    double t = num_inference_steps == 1
+                   ? (double)(num_train_timesteps - 1)
+                   : (double)(num_train_timesteps - 1) *
+                         (num_inference_steps - 1 - i) /
+                         (num_inference_steps - 1);
+    timesteps_[i] = (float)t;
+    // 在相邻的整数时间步之间线性插值
+    int64_t low = (int64_t)std::floor(t);
+    int64_t high = std::min<int64_t>(low + 1, num_train_timesteps - 1);
+    double w = t - low;
+    double sigma_low =
+        std::sqrt((1.0 - alphas_cumprod_[low]) / alphas_cumprod_[low]);
+    double sigma_high =
+        std::sqrt((1.0 - alphas_cumprod_[high]) / alphas_cumprod_[high]);
+    sigmas_[i] = (1.0 - w) * sigma_low + w * sigma_high;
+  }
+  sigmas_[num_inference_steps] = 0.0f;
+  return status;
+}
+
+device::Tensor *EulerAncestralScheduler::scaleModelInput(
+    device::Tensor *sample, int index) {
+  input_arena_.reset();
+  device::Tensor *model_input =
+      input_arena_.allocate(sample->getDevice(), sample->getDesc());
+  float sigma = sigmas_[index];
+  std::vector<op::ElementwiseUnary> scale = {
+      op::ElementwiseUnary(op::kElementwiseUnaryTypeLinear,
+                           1.0f / std::sqrt(sigma * sigma + 1.0f), 0.0f)};
+  base::Status status =
+      op::elementwiseUnary(scale, op::ElementwiseOperand(sample),
+                           op::ElementwiseOperand(model_input));
+  if (status != base::kStatusCodeOk) {
+    NNDEPLOY_LOGE("scaleModelInput failed!\n");
+    return nullptr;
+  }
+  return model_input;
+}
+
+base::Status EulerAncestralScheduler::configure() {
+  return base::kStatusCodeOk;
+}
+
+/**
+ * @brief
+ * @note
+ * # σ_up = sqrt(σ_to^2 * (σ_from^2 - σ_to^2) / σ_from^2)，
+ *   σ_down = sqrt(σ_to^2 - σ_up^2)
+ * # x_t-1 = x + (x - x0) / σ * (σ_down - σ) + σ_up * noise
+ * # 是sample、x0与噪声的线性组合，由fusedSchedulerStep一次遍历完成
+ */
+base::Status EulerAncestralScheduler::step(
+    device::Tensor *output, device::Tensor *sample, int idx, float timestep,
+    float eta, bool use_clipped_model_output, std::mt19937 generator,
+    device::Tensor *variance_noise) {
+  base::Status status = base::kStatusCodeOk;
+  if (idx < 0 || idx >= (int)timesteps_.size()) {
+    NNDEPLOY_LOGE("idx %d is out of range!\n", idx);
+    return base::kStatusCodeErrorInvalidParam;
+  }
+  noise_arena_.reset();
+
+  double sigma = sigmas_[idx];
+  double sigma_to = sigmas_[idx + 1];
+
+  // 1. compute predicted original sample (x_0) from sigma-scaled predicted
+  // noise
+  SchedulerStepCoeff coeff;
+  if (scheduler_param_->prediction_type_ == "epsilon") {
+    coeff.x0_sample_ = 1.0f;
+    coeff.x0_model_ = -sigma;
+  } else if (scheduler_param_->prediction_type_ == "sample") {
+    coeff.x0_model_ = 1.0f;
+  } else if (scheduler_param_->prediction_type_ == "v_prediction") {
+    // x0 = model_output * c_out + sample * c_skip
+    coeff.x0_sample_ = 1.0 / (sigma * sigma + 1.0);
+    coeff.x0_model_ = -sigma / std::sqrt(sigma * sigma + 1.0);
+  } else {
+    NNDEPLOY_LOGE("Invalid prediction type!\n");
+    return base::kStatusCodeErrorInvalidValue;
+  }
+  if (scheduler_param_->clip_sample_) {
+    coeff.clip_min_ = -1.0f;
+    coeff.clip_max_ = 1.0f;
+  }
+
+  // 2. ancestral step
+  double sigma_up = std::sqrt(sigma_to * sigma_to *
+                              (sigma * sigma - sigma_to * sigma_to) /
+                              (sigma * sigma));
+  double sigma_down =
+      std::sqrt(std::max(sigma_to * sigma_to - sigma_up * sigma_up, 0.0));
+  double dt = sigma_down - sigma;
+  coeff.out_sample_ = 1.0 + dt / sigma;
+  coeff.out_x0_ = -dt / sigma;
+
+  if (sigma_up > 0.0) {
+    if (variance_noise == nullptr) {
+      variance_noise =
+          noise_arena_.allocate(sample->getDevice(), sample->getDesc());
+      // step按值传入generator，混入idx使每一步的噪声不同
+      status = device::randnTensor(
+          generator, 0.0f, 1.0f, variance_noise,
+          (int64_t)(generator() + (uint32_t)idx * 0x9E3779B9u));
+      NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "randn failed!");
+    }
+    coeff.out_noise_ = sigma_up;
+  } else {
+    variance_noise = nullptr;
+  }
+
+  status = fusedSchedulerStep(coeff, output, sample, nullptr, variance_noise);
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                         "fusedSchedulerStep failed");
+
+  return status;
+}
+
+base::Status EulerAncestralScheduler::addNoise(device::Tensor *init_latents,
+                                               device::Tensor *noise, int idx,
+                                               int latent_timestep) {
+  base::Status status = base::kStatusCodeOk;
+
+  SchedulerStepCoeff coeff;
+  coeff.x0_sample_ = 1.0f;
+  coeff.eps_model_ = 1.0f;
+  coeff.out_x0_ = 1.0f;
+  coeff.out_eps_ = sigmas_[idx];
+  status = fusedSchedulerStep(coeff, noise, init_latents);
+  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                         "fusedSchedulerStep failed");
+
+  return status;
+}
+
+std::vector<float> &EulerAncestralScheduler::getTimestep() {
+  return timesteps_;
+}
+
+float EulerAncestralScheduler::getInitNoiseSigma() {
+  // 第一步的sigma最大
+  if (sigmas_.empty()) {
+    return 1.0f;
+  }
+  return std::sqrt(sigmas_.front() * sigmas_.front() + 1.0f);
+}
+
+}  // namespace stable_diffusion
+}  // namespace nndeploy
@@ -2,7 +2,9 @@
 #include "nndeploy/stable_diffusion/scheduler.h"
 
 #include "nndeploy/infer/infer.h"
+#include "nndeploy/op/elementwise_kernel.h"
 #include "nndeploy/op/op_binary.h"
+#include "nndeploy/thread_pool/parallel.h"
 
 namespace nndeploy {
 namespace stable_diffusion {
@@ -39,6 +41,27 @@ void customLinspace(float start, float end, int steps,
   }
 }
 
+void getAlphasCumprod(SchedulerParam *param,
+                      std::vector<float> &alphas_cumprod) {
+  // # this schedule is very specific to the latent diffusion model.
+  // ##计算betas，它们是方差的平方根，从beta_start的平方根到beta_end的平方根
+  std::vector<float> betas;
+  betas.resize(param->num_train_timesteps_);
+  customLinspace(std::sqrt(param->beta_start_), std::sqrt(param->beta_end_),
+                 param->num_train_timesteps_, betas);
+  // ## 计算alphas，它们是1减去beta的平方
+  std::vector<float> alphas(param->num_train_timesteps_, 0.0f);
+  for (int i = 0; i < param->num_train_timesteps_; i++) {
+    alphas[i] = 1 - betas[i] * betas[i];
+  }
+  // ## alphas_cumprod
+  alphas_cumprod.resize(param->num_train_timesteps_, 0.0f);
+  alphas_cumprod[0] = alphas[0];
+  for (int i = 1; i < param->num_train_timesteps_; i++) {
+    alphas_cumprod[i] = alphas_cumprod[i - 1] * alphas[i];
+  }
+}
+
 base::Status initializeLatents(std::mt19937 &generator, float init_noise_sigma,
                                device ::Tensor *latents) {
   base::Status status = base::kStatusCodeOk;
@@ -47,12 +70,218 @@ base::Status initializeLatents(std::mt19937 &generator, float init_noise_sigma,
   // scheduler
   status = device::randnTensor(generator, 0.0, 1.0, latents);
   NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "randn failed!");
-  // TODO:op::mul
-  // status = op::mul(latents, init_noise_sigma, latents);
-  NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "mul failed!");
+  if (init_noise_sigma != 1.0f) {
+    std::vector<op::ElementwiseUnary> scale = {op::ElementwiseUnary(
+        op::kElementwiseUnaryTypeLinear, init_noise_sigma, 0.0f)};
+    status = op::elementwiseUnary(scale, op::ElementwiseOperand(latents),
+                                  op::ElementwiseOperand(latents));
+    NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "mul failed!");
+  }
 
   return status;
 }
 
+namespace {
+
+static const int kSchedulerStepBlock = 1024;
+static const int64_t kSchedulerStepGrain = 16384;
+
+struct SchedulerStepArg {
+  char *data_ = nullptr;
+  int elem_size_ = 4;
+  bool fp32_ = true;
+  op::ElementwiseLoadFunc load_ = nullptr;
+  op::ElementwiseStoreFunc store_ = nullptr;
+};
+
+base::Status makeSchedulerStepArg(const char *name, device::Tensor *tensor,
+                                  int64_t size, SchedulerStepArg &arg) {
+  if (tensor == nullptr) {
+    return base::kStatusCodeOk;
+  }
+  if (!device::isHostDeviceType(tensor->getDeviceType())) {
+    NNDEPLOY_LOGE("%s must be on host device.\n", name);
+    return base::kStatusCodeErrorNotSupport;
+  }
+  int64_t count = 1;
+  for (auto dim : tensor->getShape()) {
+    count *= dim;
+  }
+  if (count != size) {
+    NNDEPLOY_LOGE("%s has %lld elements, expect %lld.\n", name,
+                  (long long)count, (long long)size);
+    return base::kStatusCodeErrorInvalidParam;
+  }
+  const op::ElementwiseKernel &kernel = op::getElementwiseKernel();
+  base::DataType data_type = tensor->getDataType();
+  arg.data_ = static_cast<char *>(tensor->getData());
+  if (data_type == base::dataTypeOf<float>()) {
+    arg.elem_size_ = 4;
+    arg.fp32_ = true;
+  } else if (data_type.code_ == base::kDataTypeCodeFp &&
+             data_type.bits_ == 16 && data_type.lanes_ == 1) {
+    arg.elem_size_ = 2;
+    arg.fp32_ = false;
+    arg.load_ = kernel.load_fp16_;
+    arg.store_ = kernel.store_fp16_;
+  } else if (data_type.code_ == base::kDataTypeCodeBFp &&
+             data_type.bits_ == 16 && data_type.lanes_ == 1) {
+    arg.elem_size_ = 2;
+    arg.fp32_ = false;
+    arg.load_ = kernel.load_bfp16_;
+    arg.store_ = kernel.store_bfp16_;
+  } else {
+    NNDEPLOY_LOGE("%s data type %s is not supported.\n", name,
+                  base::dataTypeToString(data_type).c_str());
+    return base::kStatusCodeErrorNotSupport;
+  }
+  if (arg.data_ == nullptr && size > 0) {
+    NNDEPLOY_LOGE("%s data is nullptr.\n", name);
+    return base::kStatusCodeErrorNullParam;
+  }
+  return base::kStatusCodeOk;
+}
+
+typedef void (*SchedulerStepFunc)(const SchedulerStepCoeff &c,
+                                  const float *model, float *sample,
+                                  float *history, const float *noise, int n);
+
+template <bool kHistory, bool kNoise>
+void schedulerStepBlock(const SchedulerStepCoeff &c,
+                        const float *__restrict model,
+                        float *__restrict sample, float *__restrict history,
+                        const float *__restrict noise, int n) {
+  // 系数放入局部变量，各张量互不重叠，编译器可以直接向量化
+  const float x0_sample = c.x0_sample_, x0_model = c.x0_model_;
+  const float clip_min = c.clip_min_, clip_max = c.clip_max_;
+  const float eps_sample = c.eps_sample_, eps_model = c.eps_model_;
+  const float eps_x0 = c.eps_x0_;
+  const float out_sample = c.out_sample_, out_x0 = c.out_x0_;
+  const float out_eps = c.out_eps_, out_history = c.out_history_;
+  const float out_noise = c.out_noise_;
+  for (int i = 0; i < n; ++i) {
+    float s = sample[i];
+    float m = model[i];
+    float x0 = x0_sample * s + x0_model * m;
+    x0 = x0 > clip_min ? x0 : clip_min;
+    x0 = x0 < clip_max ? x0 : clip_max;
+    float eps = eps_sample * s + eps_model * m + eps_x0 * x0;
+    float out = out_sample * s + out_x0 * x0 + out_eps * eps;
+    if (kHistory) {
+      out += out_history * history[i];
+      history[i] = x0;
+    }
+    if (kNoise) {
+      out += out_noise * noise[i];
+    }
+    sample[i] = out;
+  }
+}
+
+/**
+ * @brief 四个张量依次为model_output/sample/history/noise
+ */
+struct SchedulerStepProblem {
+  SchedulerStepCoeff coeff_;
+  SchedulerStepFunc func_;
+  SchedulerStepArg args_[4];
+  int64_t size_;
+};
+
+class SchedulerStepParallelBody : public thread_pool::ParallelLoopBody {
+ public:
+  explicit SchedulerStepParallelBody(const SchedulerStepProblem &problem)
+      : problem_(problem) {}
+
+  virtual void operator()(const base::Range &range) const {
+    const SchedulerStepProblem &p = problem_;
+    float buffers[4][kSchedulerStepBlock];
+    for (int task = range.start_; task < range.end_; ++task) {
+      int64_t begin = task * kSchedulerStepGrain;
+      int64_t end = std::min(begin + kSchedulerStepGrain, p.size_);
+      for (int64_t i = begin; i < end; i += kSchedulerStepBlock) {
+        const int n =
+            static_cast<int>(std::min<int64_t>(kSchedulerStepBlock, end - i));
+        float *ptrs[4] = {nullptr, nullptr, nullptr, nullptr};
+        for (int k = 0; k < 4; ++k) {
+          const SchedulerStepArg &arg = p.args_[k];
+          if (arg.data_ == nullptr) {
+            continue;
+          }
+          char *src = arg.data_ + i * arg.elem_size_;
+          if (arg.fp32_) {
+            ptrs[k] = reinterpret_cast<float *>(src);
+          } else {
+            arg.load_(src, buffers[k], n);
+            ptrs[k] = buffers[k];
+          }
+        }
+        p.func_(p.coeff_, ptrs[0], ptrs[1], ptrs[2], ptrs[3], n);
+        // 只有sample与history被写入
+        for (int k = 1; k < 3; ++k) {
+          const SchedulerStepArg &arg = p.args_[k];
+          if (arg.data_ != nullptr && !arg.fp32_) {
+            arg.store_(buffers[k], arg.data_ + i * arg.elem_size_, n);
+          }
+        }
+      }
+    }
+  }
+
+ private:
+  const SchedulerStepProblem &problem_;
+};
+
+}  // namespace
+
+base::Status fusedSchedulerStep(const SchedulerStepCoeff &coeff,
+                                device::Tensor *model_output,
+                                device::Tensor *sample,
+                                device::Tensor *history,
+                                device::Tensor *noise) {
+  if (model_output == nullptr || sample == nullptr) {
+    NNDEPLOY_LOGE("model_output or sample is nullptr.\n");
+    return base::kStatusCodeErrorNullParam;
+  }
+  SchedulerStepProblem p;
+  p.coeff_ = coeff;
+  p.size_ = 1;
+  for (auto dim : sample->getShape()) {
+    p.size_ *= dim;
+  }
+  if (p.size_ == 0) {
+    return base::kStatusCodeOk;
+  }
+  device::Tensor *tensors[4] = {model_output, sample, history, noise};
+  const char *names[4] = {"model_output", "sample", "history", "noise"};
+  for (int k = 0; k < 4; ++k) {
+    base::Status status =
+        makeSchedulerStepArg(names[k], tensors[k], p.size_, p.args_[k]);
+    NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk,
+                           "makeSchedulerStepArg failed");
+  }
+  if (history != nullptr) {
+    p.func_ = noise != nullptr ? schedulerStepBlock<true, true>
+                               : schedulerStepBlock<true, false>;
+  } else {
+    p.func_ = noise != nullptr ? schedulerStepBlock<false, true>
+                               : schedulerStepBlock<false, false>;
+  }
+
+  int64_t num_tasks = (p.size_ + kSchedulerStepGrain - 1) / kSchedulerStepGrain;
+  if (num_tasks > INT_MAX) {
+    NNDEPLOY_LOGE("tensor is too large.\n");
+    return base::kStatusCodeErrorInvalidParam;
+  }
+  SchedulerStepParallelBody body(p);
+  if (num_tasks == 1) {
+    body(base::Range(0, 1));
+  } else {
+    thread_pool::parallelFor(base::Range(0, static_cast<int>(num_tasks)),
+                             body);
+  }
+  return base::kStatusCodeOk;
+}
+
 }  // namespace stable_diffusion
 }  // namespace nndeploy
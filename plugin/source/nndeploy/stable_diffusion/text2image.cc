@@ -34,6 +34,7 @@ class Text2ImagesSchedulerUNet : public dag::Loop {
 
     status = scheduler_->configure();
     NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "configure failed!");
+    init_noise_sigma_ = scheduler_->getInitNoiseSigma();
 
     status = Loop::init();
     NNDEPLOY_RETURN_ON_NEQ(status, base::kStatusCodeOk, "Loop::init failed!");
@@ -204,6 +204,7 @@ NNDEPLOY_API_PYBIND11_MODULE("base", m) {
       .value("Embed", MemoryPoolType::kMemoryPoolTypeEmbed)
       .value("Unity", MemoryPoolType::kMemoryPoolTypeUnity)
       .value("ChunkIndepend", MemoryPoolType::kMemoryPoolTypeChunkIndepend)
+      .value("Caching", MemoryPoolType::kMemoryPoolTypeCaching)
       .export_values();
 
   // TODO
@@ -46,6 +46,9 @@ NNDEPLOY_API_PYBIND11_MODULE("dag", m) {
       .def("set_graph_node_share_stream", &Graph::setGraphNodeShareStream,
            py::arg("flag"))
       .def("get_graph_node_share_stream", &Graph::getGraphNodeShareStream)
+      .def("set_pipeline_inflight", &Graph::setPipelineInflight,
+           py::arg("num"))
+      .def("get_pipeline_inflight", &Graph::getPipelineInflight)
       .def("update_node_io", &Graph::updateNodeIO, py::arg("node"),
            py::arg("inputs"), py::arg("outputs"))
       .def("mark_input_edge", &Graph::markInputEdge, py::arg("inputs"))
@@ -16,7 +16,9 @@ NNDEPLOY_API_PYBIND11_MODULE("detect", m) {
       .def_readwrite("num_classes_", &YoloPostParam::num_classes_)
       .def_readwrite("model_h_", &YoloPostParam::model_h_)
       .def_readwrite("model_w_", &YoloPostParam::model_w_)
-      .def_readwrite("version_", &YoloPostParam::version_);
+      .def_readwrite("version_", &YoloPostParam::version_)
+      .def_readwrite("max_detections_", &YoloPostParam::max_detections_)
+      .def_readwrite("class_agnostic_", &YoloPostParam::class_agnostic_);
 
   // 导出YoloPostProcess类
   py::class_<YoloPostProcess, dag::Node>(m, "YoloPostProcess")
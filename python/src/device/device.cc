@@ -271,6 +271,11 @@ NNDEPLOY_API_PYBIND11_MODULE("device", m) {
       //     },
       //     py::arg("events"))
       .def("get_device_type", &Device::getDeviceType)
+      .def("enable_memory_pool", &Device::enableMemoryPool,
+           py::arg("memory_pool_type"))
+      .def("disable_memory_pool", &Device::disableMemoryPool)
+      .def("get_memory_pool", &Device::getMemoryPool,
+           py::return_value_policy::reference)
       .def("init", &Device::init)
       .def("deinit", &Device::deinit)
       .def("__str__", [](const Device &self) {
@@ -65,6 +65,16 @@ class PyMemoryPool : public MemoryPool {
 };
 
 NNDEPLOY_API_PYBIND11_MODULE("device", m) {
+  py::class_<MemoryPoolStats>(m, "MemoryPoolStats")
+      .def(py::init<>())
+      .def_readonly("reserved_size", &MemoryPoolStats::reserved_size_)
+      .def_readonly("allocated_size", &MemoryPoolStats::allocated_size_)
+      .def_readonly("peak_allocated_size",
+                    &MemoryPoolStats::peak_allocated_size_)
+      .def_readonly("cached_size", &MemoryPoolStats::cached_size_)
+      .def_readonly("allocate_count", &MemoryPoolStats::allocate_count_)
+      .def_readonly("cache_hit_count", &MemoryPoolStats::cache_hit_count_);
+
   py::class_<MemoryPool, PyMemoryPool>(m, "MemoryPool", py::dynamic_attr())
       .def(py::init<Device *, base::MemoryPoolType>(), py::arg("device"),
            py::arg("memory_pool_type"),
@@ -100,6 +110,10 @@ NNDEPLOY_API_PYBIND11_MODULE("device", m) {
            "MemoryPool")
       .def("deallocate_pinned", &MemoryPool::deallocatePinned, py::arg("ptr"),
            "Deallocate pinned memory allocated from the MemoryPool")
+      .def("trim", &MemoryPool::trim,
+           "Return the cached free memory to the device")
+      .def("get_stats", &MemoryPool::getStats,
+           "Get the statistics of the MemoryPool")
       .def("get_device", &MemoryPool::getDevice,
            py::return_value_policy::reference,
            "Get the Device object associated with the MemoryPool")